@@ -0,0 +1,1485 @@
+/**************************************************************************//**
+ * @file
+ * Benchmarks for the EVEL library.
+ *
+ * Each benchmark times one of the library's hot paths against the simpler
+ * implementation it replaced, so that the two can be compared on the target.
+ *
+ * License
+ * -------
+ *
+ * Copyright(c) <2016>, AT&T Intellectual Property.  All other rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ * must display the following acknowledgement:  This product includes software
+ * developed by the AT&T.
+ * 4. Neither the name of AT&T nor the names of its contributors may be used to
+ * endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY AT&T INTELLECTUAL PROPERTY ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL AT&T INTELLECTUAL PROPERTY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "evel.h"
+#include "evel_internal.h"
+#include "ring_buffer.h"
+#include "metadata.h"
+#include "evel_throttle.h"
+#include "evel_compress.h"
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static void bench_ring_buffer();
+static void bench_json_numbers();
+static void bench_json_strings();
+static void bench_header();
+static void bench_event_arena();
+static void bench_event_pool();
+static void bench_sequence();
+static void bench_throttle();
+static void bench_compress();
+
+/**************************************************************************//**
+ * A benchmark which can be selected by name on the command line.
+ *****************************************************************************/
+typedef struct evel_bench
+{
+  const char * name;
+  void (*run)(void);
+} EVEL_BENCH;
+
+static const EVEL_BENCH evel_benches[] = {
+  {"ring_buffer", bench_ring_buffer},
+  {"json_numbers", bench_json_numbers},
+  {"json_strings", bench_json_strings},
+  {"header", bench_header},
+  {"event_arena", bench_event_arena},
+  {"event_pool", bench_event_pool},
+  {"sequence", bench_sequence},
+  {"throttle", bench_throttle},
+  {"compress", bench_compress},
+  {NULL, NULL}
+};
+
+/**************************************************************************//**
+ * Main function.
+ *
+ * Runs the benchmarks named on the command line, or all of them if none are
+ * named.
+ *
+ * @param[in] argc  Argument count.
+ * @param[in] argv  Argument vector - names of the benchmarks to run.
+ *****************************************************************************/
+int main(int argc, char ** argv)
+{
+  int ii;
+  int jj;
+  int found;
+
+  /***************************************************************************/
+  /* Keep the library quiet: logging would swamp what's being measured.      */
+  /***************************************************************************/
+  debug_level = EVEL_LOG_MAX;
+
+  for (ii = 0; evel_benches[ii].name != NULL; ii++)
+  {
+    found = (argc < 2);
+    for (jj = 1; jj < argc; jj++)
+    {
+      if (strcmp(argv[jj], evel_benches[ii].name) == 0)
+      {
+        found = 1;
+      }
+    }
+    if (found)
+    {
+      printf("%s\n", evel_benches[ii].name);
+      evel_benches[ii].run();
+    }
+  }
+
+  return 0;
+}
+
+/**************************************************************************//**
+ * Read the monotonic clock.
+ *
+ * @returns Time in nanoseconds.
+ *****************************************************************************/
+static unsigned long long bench_now_ns()
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long long) now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   RING BUFFER                                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/**************************************************************************//**
+ * Locked ring buffer.
+ *
+ * The mutex-per-operation ring buffer which the lock-free one replaced, kept
+ * here as the baseline.
+ *****************************************************************************/
+typedef struct locked_ring_buffer
+{
+  int size;
+  int next_write;
+  int next_read;
+  void ** ring;
+  pthread_cond_t ring_cv;
+  pthread_mutex_t ring_mutex;
+} locked_ring_buffer;
+
+static void locked_ring_buffer_initialize(locked_ring_buffer * buffer,
+                                          int size)
+{
+  pthread_mutex_init(&buffer->ring_mutex, NULL);
+  pthread_cond_init(&buffer->ring_cv, NULL);
+  buffer->ring = malloc(size * sizeof(void *));
+  assert(buffer->ring != NULL);
+  buffer->next_write = 0;
+  buffer->next_read = 0;
+  buffer->size = size;
+}
+
+static void * locked_ring_buffer_read(locked_ring_buffer * buffer)
+{
+  void *msg = NULL;
+
+  pthread_mutex_lock(&buffer->ring_mutex);
+  while (buffer->next_read == buffer->next_write)
+  {
+    pthread_cond_wait(&buffer->ring_cv, &buffer->ring_mutex);
+  }
+  msg = (buffer->ring)[buffer->next_read];
+  buffer->ring[buffer->next_read] = NULL;
+  buffer->next_read = (buffer->next_read + 1) % buffer->size;
+  pthread_mutex_unlock(&buffer->ring_mutex);
+
+  return msg;
+}
+
+static int locked_ring_buffer_write(locked_ring_buffer * buffer, void * msg)
+{
+  int item_count = 0;
+  int items_written = 0;
+
+  pthread_mutex_lock(&buffer->ring_mutex);
+  item_count = (buffer->next_write - buffer->next_read) % buffer->size;
+  if (item_count < 0)
+  {
+    item_count += buffer->size;
+  }
+  if (item_count < buffer->size - 1)
+  {
+    buffer->ring[buffer->next_write] = msg;
+    buffer->next_write = (buffer->next_write + 1) % buffer->size;
+    items_written = 1;
+  }
+  pthread_cond_signal(&buffer->ring_cv);
+  pthread_mutex_unlock(&buffer->ring_mutex);
+
+  return items_written;
+}
+
+/*****************************************************************************/
+/* How much work each ring buffer run does.                                  */
+/*****************************************************************************/
+#define BENCH_RING_CAPACITY 128
+#define BENCH_RING_ITEMS 2000000
+
+/**************************************************************************//**
+ * State shared by the threads of one ring buffer run.
+ *****************************************************************************/
+typedef struct bench_ring
+{
+  int locked;
+  int producers;
+  int items_per_producer;
+  ring_buffer lock_free_ring;
+  locked_ring_buffer locked_ring;
+  unsigned long long full;
+} BENCH_RING;
+
+static int bench_ring_write(BENCH_RING * bench, void * msg)
+{
+  return bench->locked ?
+         locked_ring_buffer_write(&bench->locked_ring, msg) :
+         ring_buffer_write(&bench->lock_free_ring, msg);
+}
+
+static void * bench_ring_read(BENCH_RING * bench)
+{
+  return bench->locked ?
+         locked_ring_buffer_read(&bench->locked_ring) :
+         ring_buffer_read(&bench->lock_free_ring);
+}
+
+/**************************************************************************//**
+ * Producer thread: write its share of items, yielding while the ring is full.
+ *****************************************************************************/
+static void * bench_ring_producer(void * arg)
+{
+  BENCH_RING * bench = arg;
+  unsigned long long full = 0;
+  int ii;
+
+  for (ii = 1; ii <= bench->items_per_producer; ii++)
+  {
+    while (!bench_ring_write(bench, (void *) (uintptr_t) ii))
+    {
+      full++;
+      sched_yield();
+    }
+  }
+  __atomic_add_fetch(&bench->full, full, __ATOMIC_RELAXED);
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Time the given number of producers feeding a single consumer.
+ *****************************************************************************/
+static void bench_ring_buffer_run(const int locked, const int producers)
+{
+  BENCH_RING bench;
+  pthread_t threads[producers];
+  unsigned long long start;
+  unsigned long long elapsed;
+  void * msg;
+  int total;
+  int ii;
+
+  memset(&bench, 0, sizeof(bench));
+  bench.locked = locked;
+  bench.producers = producers;
+  bench.items_per_producer = BENCH_RING_ITEMS / producers;
+  total = bench.items_per_producer * producers;
+  if (locked)
+  {
+    locked_ring_buffer_initialize(&bench.locked_ring, BENCH_RING_CAPACITY);
+  }
+  else
+  {
+    ring_buffer_initialize(&bench.lock_free_ring, BENCH_RING_CAPACITY);
+  }
+
+  start = bench_now_ns();
+  for (ii = 0; ii < producers; ii++)
+  {
+    pthread_create(&threads[ii], NULL, bench_ring_producer, &bench);
+  }
+  for (ii = 0; ii < total; ii++)
+  {
+    msg = bench_ring_read(&bench);
+    assert(msg != NULL);
+  }
+  elapsed = bench_now_ns() - start;
+  for (ii = 0; ii < producers; ii++)
+  {
+    pthread_join(threads[ii], NULL);
+  }
+
+  printf("  %-10s producers=%-3d %8.1f ns/op %12.0f ops/s  full=%llu\n",
+         locked ? "locked" : "lock-free",
+         producers,
+         (double) elapsed / total,
+         total * 1e9 / elapsed,
+         bench.full);
+
+  free(locked ? (void *) bench.locked_ring.ring :
+                (void *) bench.lock_free_ring.ring);
+}
+
+/**************************************************************************//**
+ * Compare the lock-free ring buffer with the locked one it replaced, with
+ * increasing numbers of producer threads.
+ *****************************************************************************/
+static void bench_ring_buffer()
+{
+  const int producers[] = {1, 4, 32};
+  unsigned int ii;
+
+  for (ii = 0; ii < sizeof(producers) / sizeof(producers[0]); ii++)
+  {
+    bench_ring_buffer_run(1, producers[ii]);
+    bench_ring_buffer_run(0, producers[ii]);
+  }
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   JSON NUMBERS                                                            */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* How much work each number formatting run does.                            */
+/*****************************************************************************/
+#define BENCH_NUMBER_VALUES 4096
+#define BENCH_NUMBER_ROUNDS 200
+#define BENCH_NUMBER_BUFFER 262144
+#define BENCH_NUMBER_CPUS 64
+
+/**************************************************************************//**
+ * The kinds of number field being compared.
+ *****************************************************************************/
+typedef enum {
+  BENCH_NUMBER_INT,
+  BENCH_NUMBER_ULL,
+  BENCH_NUMBER_DOUBLE_2DP,
+  BENCH_NUMBER_DOUBLE_FULL,
+  BENCH_NUMBER_MAX
+} BENCH_NUMBER;
+
+static const char * const bench_number_names[BENCH_NUMBER_MAX] = {
+  "int", "ull", "double 2dp", "double full"
+};
+
+/**************************************************************************//**
+ * Values of each kind, shared by both encodings.
+ *****************************************************************************/
+typedef struct bench_numbers
+{
+  int ints[BENCH_NUMBER_VALUES];
+  unsigned long long ulls[BENCH_NUMBER_VALUES];
+  double doubles[BENCH_NUMBER_VALUES];
+} BENCH_NUMBERS;
+
+/**************************************************************************//**
+ * Fill in values of the given kind, typical of those found in measurements.
+ *****************************************************************************/
+static void bench_numbers_fill(BENCH_NUMBERS * numbers,
+                               const BENCH_NUMBER kind)
+{
+  int ii;
+
+  srand(1);
+  for (ii = 0; ii < BENCH_NUMBER_VALUES; ii++)
+  {
+    numbers->ints[ii] = rand() % 100000;
+    numbers->ulls[ii] = ((unsigned long long) rand() << 20) + rand();
+    numbers->doubles[ii] = (kind == BENCH_NUMBER_DOUBLE_2DP) ?
+                           (rand() % 10000) / 100.0 :
+                           rand() * 100.0 / RAND_MAX;
+  }
+}
+
+/**************************************************************************//**
+ * Encode a field the way the encoder did before it formatted numbers itself,
+ * with snprintf() and six decimal places for doubles.
+ *****************************************************************************/
+static void bench_snprintf_field(EVEL_JSON_BUFFER * jbuf,
+                                 const BENCH_NUMBERS * numbers,
+                                 const BENCH_NUMBER kind,
+                                 const int index)
+{
+  const char * comma = (jbuf->json[jbuf->offset - 1] == '{') ? "" : ", ";
+
+  switch (kind)
+  {
+    case BENCH_NUMBER_INT:
+      jbuf->offset += snprintf(jbuf->json + jbuf->offset,
+                               jbuf->max_size - jbuf->offset,
+                               "%s\"%s\": %d",
+                               comma,
+                               "packetsIn",
+                               numbers->ints[index]);
+      break;
+
+    case BENCH_NUMBER_ULL:
+      jbuf->offset += snprintf(jbuf->json + jbuf->offset,
+                               jbuf->max_size - jbuf->offset,
+                               "%s\"%s\": %llu",
+                               comma,
+                               "bytesIn",
+                               numbers->ulls[index]);
+      break;
+
+    default:
+      jbuf->offset += snprintf(jbuf->json + jbuf->offset,
+                               jbuf->max_size - jbuf->offset,
+                               "%s\"%s\": %1f",
+                               comma,
+                               "percentUsage",
+                               numbers->doubles[index]);
+      break;
+  }
+}
+
+/**************************************************************************//**
+ * Encode a field with the encoder's own number formatting.
+ *****************************************************************************/
+static void bench_encoder_field(EVEL_JSON_BUFFER * jbuf,
+                                const BENCH_NUMBERS * numbers,
+                                const BENCH_NUMBER kind,
+                                const int index)
+{
+  switch (kind)
+  {
+    case BENCH_NUMBER_INT:
+      evel_enc_kv_int(jbuf, "packetsIn", numbers->ints[index]);
+      break;
+
+    case BENCH_NUMBER_ULL:
+      evel_enc_kv_ull(jbuf, "bytesIn", numbers->ulls[index]);
+      break;
+
+    default:
+      evel_enc_kv_double(jbuf, "percentUsage", numbers->doubles[index]);
+      break;
+  }
+}
+
+/**************************************************************************//**
+ * Time one way of encoding fields of one kind.
+ *
+ * @returns Average nanoseconds per field.  The average bytes per field are
+ *          returned through bytes.
+ *****************************************************************************/
+static double bench_json_numbers_run(
+  const BENCH_NUMBERS * numbers,
+  const BENCH_NUMBER kind,
+  void (*encode)(EVEL_JSON_BUFFER *, const BENCH_NUMBERS *,
+                 const BENCH_NUMBER, const int),
+  double * bytes)
+{
+  static char json[BENCH_NUMBER_BUFFER];
+  EVEL_JSON_BUFFER jbuf;
+  unsigned long long start;
+  unsigned long long elapsed;
+  unsigned long long total_bytes = 0;
+  int round;
+  int ii;
+
+  start = bench_now_ns();
+  for (round = 0; round < BENCH_NUMBER_ROUNDS; round++)
+  {
+    /*************************************************************************/
+    /* Each round encodes every value into a fresh object.                   */
+    /*************************************************************************/
+    evel_json_buffer_init(&jbuf, json, BENCH_NUMBER_BUFFER, NULL);
+    evel_json_open_object(&jbuf);
+    for (ii = 0; ii < BENCH_NUMBER_VALUES; ii++)
+    {
+      encode(&jbuf, numbers, kind, ii);
+    }
+    total_bytes += jbuf.offset - 1;
+  }
+  elapsed = bench_now_ns() - start;
+
+  *bytes = (double) total_bytes / BENCH_NUMBER_ROUNDS / BENCH_NUMBER_VALUES;
+  return (double) elapsed / BENCH_NUMBER_ROUNDS / BENCH_NUMBER_VALUES;
+}
+
+/**************************************************************************//**
+ * Compare the size of a measurement event with doubles written to six
+ * decimal places and written in the shortest form.
+ *****************************************************************************/
+static void bench_json_numbers_event()
+{
+  EVENT_MEASUREMENT * measurement = NULL;
+  EVEL_JSON_ARENA * arena = NULL;
+  EVEL_JSON_BUFFER jbuf;
+  char cpu_id[32];
+  char number[64];
+  double usage;
+  int event_size;
+  int padding = 0;
+  int ii;
+
+  /***************************************************************************/
+  /* CPU usage percentages to two decimal places, as most VNFs report them.  */
+  /***************************************************************************/
+  srand(1);
+  measurement = evel_new_measurement(5.5);
+  assert(measurement != NULL);
+  for (ii = 0; ii < BENCH_NUMBER_CPUS; ii++)
+  {
+    sprintf(cpu_id, "cpu%d", ii);
+    usage = (rand() % 10000) / 100.0;
+    evel_measurement_new_cpu_use_add(measurement, cpu_id, usage);
+
+    /*************************************************************************/
+    /* Work out how much longer six decimal places would have made it.       */
+    /*************************************************************************/
+    evel_json_buffer_init(&jbuf, number, sizeof(number), NULL);
+    evel_enc_kv_double(&jbuf, "k", usage);
+    padding += snprintf(NULL, 0, "\"k\": %1f", usage) - jbuf.offset;
+  }
+  evel_json_buffer_init(&jbuf, number, sizeof(number), NULL);
+  evel_enc_kv_double(&jbuf, "k", 5.5);
+  padding += snprintf(NULL, 0, "\"k\": %1f", 5.5) - jbuf.offset;
+
+  arena = evel_json_thread_arena();
+  assert(arena != NULL);
+  event_size = evel_json_encode_event_arena(arena,
+                                            (EVENT_HEADER *) measurement);
+
+  printf("  measurement with %d CPUs: %d bytes/event before, %d after\n",
+         BENCH_NUMBER_CPUS,
+         event_size + padding,
+         event_size);
+
+  evel_free_event(measurement);
+}
+
+/**************************************************************************//**
+ * Compare the encoder's number formatting with the snprintf() formatting it
+ * replaced, field by field, then for a whole measurement event.
+ *****************************************************************************/
+static void bench_json_numbers()
+{
+  BENCH_NUMBERS * numbers = malloc(sizeof(BENCH_NUMBERS));
+  double before_ns;
+  double after_ns;
+  double before_bytes;
+  double after_bytes;
+  int kind;
+
+  assert(numbers != NULL);
+  for (kind = 0; kind < BENCH_NUMBER_MAX; kind++)
+  {
+    bench_numbers_fill(numbers, kind);
+    before_ns = bench_json_numbers_run(numbers,
+                                       kind,
+                                       bench_snprintf_field,
+                                       &before_bytes);
+    after_ns = bench_json_numbers_run(numbers,
+                                      kind,
+                                      bench_encoder_field,
+                                      &after_bytes);
+    printf("  %-12s %7.1f ns/field before, %7.1f after;"
+           " %5.1f bytes/field before, %5.1f after\n",
+           bench_number_names[kind],
+           before_ns,
+           after_ns,
+           before_bytes,
+           after_bytes);
+  }
+  free(numbers);
+
+  bench_json_numbers_event();
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   JSON STRINGS                                                            */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* How much work each string escaping run does.                              */
+/*****************************************************************************/
+#define BENCH_STRING_ROUNDS 20000
+#define BENCH_STRING_BUFFER 262144
+#define BENCH_STRING_FIELDS 64
+
+/**************************************************************************//**
+ * Strings of the kinds found in events.
+ *****************************************************************************/
+static const char * const bench_string_names[] = {
+  "short",
+  "syslog",
+  "quoted",
+  NULL
+};
+
+static const char * const bench_string_values[] = {
+  "vnf-instance-0042",
+  "Jan 12 06:30:00 vnf-host-7 sshd[1234]: Accepted publickey for operator "
+  "from 10.0.0.15 port 51234 ssh2: RSA SHA256:0123456789abcdefghijklmnopqr"
+  "stuvwxyzABCDEFGHIJKLMN; session opened for user operator by (uid=0) and "
+  "the connection was logged by the audit subsystem",
+  "Interface \"eth0\" on C:\\ports\\0 went down\n\tat line 12 of "
+  "\"netcfg\"; see C:\\logs\\net.log for details\n",
+  NULL
+};
+
+/**************************************************************************//**
+ * Encode a field the way the encoder did before it scanned for clean runs,
+ * escaping only quotes and backslashes a byte at a time.
+ *****************************************************************************/
+static void bench_byte_string_field(EVEL_JSON_BUFFER * jbuf,
+                                    const char * const key,
+                                    const char * const value)
+{
+  int index;
+  int length;
+
+  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
+                           jbuf->max_size - jbuf->offset,
+                           "%s\"%s\": \"",
+                           (jbuf->json[jbuf->offset - 1] == '{') ? "" : ", ",
+                           key);
+  length = strlen(value);
+  for (index = 0; index < length; index++)
+  {
+    if (jbuf->offset + 2 >= jbuf->max_size)
+    {
+      break;
+    }
+    if ((value[index] == '"') || (value[index] == '\\'))
+    {
+      jbuf->json[jbuf->offset] = '\\';
+      jbuf->offset++;
+    }
+    jbuf->json[jbuf->offset] = value[index];
+    jbuf->offset++;
+  }
+  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
+                           jbuf->max_size - jbuf->offset,
+                           "\"");
+}
+
+/**************************************************************************//**
+ * Time one way of encoding string fields.
+ *
+ * @returns Average nanoseconds per field.
+ *****************************************************************************/
+static double bench_json_strings_run(
+  const char * const value,
+  void (*encode)(EVEL_JSON_BUFFER *, const char * const, const char * const))
+{
+  static char json[BENCH_STRING_BUFFER];
+  EVEL_JSON_BUFFER jbuf;
+  unsigned long long start;
+  int round;
+  int ii;
+
+  start = bench_now_ns();
+  for (round = 0; round < BENCH_STRING_ROUNDS; round++)
+  {
+    evel_json_buffer_init(&jbuf, json, BENCH_STRING_BUFFER, NULL);
+    evel_json_open_object(&jbuf);
+    for (ii = 0; ii < BENCH_STRING_FIELDS; ii++)
+    {
+      encode(&jbuf, "alarmText", value);
+    }
+  }
+
+  return (double) (bench_now_ns() - start) /
+         BENCH_STRING_ROUNDS / BENCH_STRING_FIELDS;
+}
+
+/**************************************************************************//**
+ * Compare the encoder's string escaping with the byte at a time loop it
+ * replaced.
+ *****************************************************************************/
+static void bench_json_strings()
+{
+  double before_ns;
+  double after_ns;
+  int length;
+  int ii;
+
+  for (ii = 0; bench_string_names[ii] != NULL; ii++)
+  {
+    length = strlen(bench_string_values[ii]);
+    before_ns = bench_json_strings_run(bench_string_values[ii],
+                                       bench_byte_string_field);
+    after_ns = bench_json_strings_run(bench_string_values[ii],
+                                      evel_enc_kv_string);
+    printf("  %-8s %4d bytes: %7.1f ns/field before, %7.1f after;"
+           " %6.0f MB/s before, %6.0f after\n",
+           bench_string_names[ii],
+           length,
+           before_ns,
+           after_ns,
+           length * 1000.0 / before_ns,
+           length * 1000.0 / after_ns);
+  }
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   EVENT HEADER                                                            */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* How many heartbeats each header run creates and encodes.                  */
+/*****************************************************************************/
+#define BENCH_HEADER_EVENTS 200000
+
+/**************************************************************************//**
+ * Time creating, encoding and freeing heartbeats, which are nothing but the
+ * commonEventHeader.
+ *****************************************************************************/
+static void bench_header()
+{
+  EVEL_JSON_ARENA * arena = NULL;
+  EVENT_HEADER * heartbeat = NULL;
+  unsigned long long start;
+  unsigned long long create_ns = 0;
+  unsigned long long encode_ns = 0;
+  unsigned long long free_ns = 0;
+  int ii;
+
+  openstack_metadata_initialize();
+  arena = evel_json_thread_arena();
+  assert(arena != NULL);
+
+  for (ii = 0; ii < BENCH_HEADER_EVENTS; ii++)
+  {
+    start = bench_now_ns();
+    heartbeat = evel_new_heartbeat();
+    create_ns += bench_now_ns() - start;
+    assert(heartbeat != NULL);
+
+    start = bench_now_ns();
+    evel_json_encode_event_arena(arena, heartbeat);
+    encode_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    evel_free_event(heartbeat);
+    free_ns += bench_now_ns() - start;
+  }
+
+  printf("  heartbeat: %7.1f ns to create, %7.1f to encode, %7.1f to free\n",
+         (double) create_ns / BENCH_HEADER_EVENTS,
+         (double) encode_ns / BENCH_HEADER_EVENTS,
+         (double) free_ns / BENCH_HEADER_EVENTS);
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   EVENT ARENAS                                                            */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* How many events of each domain each arena run creates and frees, and the  */
+/* size of the first chunk of each event's arena.                            */
+/*****************************************************************************/
+#define BENCH_ARENA_EVENTS 100000
+#define BENCH_ARENA_SIZE 2048
+
+/*****************************************************************************/
+/* The bench counts heap allocations by interposing the allocator.           */
+/*****************************************************************************/
+extern void * __libc_malloc(size_t size);
+extern void * __libc_calloc(size_t count, size_t size);
+extern void * __libc_realloc(void * memory, size_t size);
+
+static int bench_counting_mallocs = 0;
+static unsigned long long bench_mallocs = 0;
+
+void * malloc(size_t size)
+{
+  bench_mallocs += bench_counting_mallocs;
+  return __libc_malloc(size);
+}
+
+void * calloc(size_t count, size_t size)
+{
+  bench_mallocs += bench_counting_mallocs;
+  return __libc_calloc(count, size);
+}
+
+void * realloc(void * memory, size_t size)
+{
+  bench_mallocs += bench_counting_mallocs;
+  return __libc_realloc(memory, size);
+}
+
+/*****************************************************************************/
+/* Factories for a representative event in each domain.                      */
+/*****************************************************************************/
+static EVENT_HEADER * bench_arena_heartbeat()
+{
+  return evel_new_heartbeat();
+}
+
+static EVENT_HEADER * bench_arena_fault()
+{
+  EVENT_FAULT * fault = evel_new_fault("My alarm condition",
+                                       "It broke very badly",
+                                       EVEL_PRIORITY_NORMAL,
+                                       EVEL_SEVERITY_MAJOR,
+                                       EVEL_SOURCE_VIRTUAL_MACHINE,
+                                       EVEL_VF_STATUS_ACTIVE);
+  evel_fault_type_set(fault, "Bad things happen...");
+  evel_fault_interface_set(fault, "My Interface Card");
+  evel_fault_addl_info_add(fault, "name1", "value1");
+  evel_fault_addl_info_add(fault, "name2", "value2");
+  return (EVENT_HEADER *) fault;
+}
+
+static EVENT_HEADER * bench_arena_measurement()
+{
+  EVENT_MEASUREMENT * measurement = evel_new_measurement(5.5);
+  MEASUREMENT_CPU_USE * cpu_use = NULL;
+  MEASUREMENT_LATENCY_BUCKET * bucket = NULL;
+  MEASUREMENT_VNIC_PERFORMANCE * vnic_performance = NULL;
+
+  evel_measurement_type_set(measurement, "Perf management...");
+  cpu_use = evel_measurement_new_cpu_use_add(measurement, "cpu1", 11.11);
+  evel_measurement_cpu_use_idle_set(cpu_use, 22.22);
+  cpu_use = evel_measurement_new_cpu_use_add(measurement, "cpu2", 22.22);
+  evel_measurement_cpu_use_idle_set(cpu_use, 12.22);
+  evel_measurement_new_mem_use_add(measurement, "mem1", "vm1", 100.0);
+  evel_measurement_custom_measurement_add(measurement, "group1", "name1",
+                                          "value1");
+  bucket = evel_new_meas_latency_bucket(20);
+  evel_meas_latency_bucket_add(measurement, bucket);
+  vnic_performance = evel_measurement_new_vnic_performance("eth0", "true");
+  evel_vnic_performance_rx_bcast_pkt_acc_set(vnic_performance, 11);
+  evel_meas_vnic_performance_add(measurement, vnic_performance);
+  return (EVENT_HEADER *) measurement;
+}
+
+static EVENT_HEADER * bench_arena_state_change()
+{
+  EVENT_STATE_CHANGE * state_change = evel_new_state_change(
+    EVEL_ENTITY_STATE_IN_SERVICE, EVEL_ENTITY_STATE_OUT_OF_SERVICE, "eth0");
+  evel_state_change_addl_field_add(state_change, "name1", "value1");
+  evel_state_change_addl_field_add(state_change, "name2", "value2");
+  return (EVENT_HEADER *) state_change;
+}
+
+static EVENT_HEADER * bench_arena_syslog()
+{
+  EVENT_SYSLOG * syslog = evel_new_syslog(EVEL_SOURCE_VIRTUAL_MACHINE,
+                                          "Most serious error on VM",
+                                          "SYSLOG_TAG");
+  evel_syslog_event_source_host_set(syslog, "Virtual host");
+  evel_syslog_proc_set(syslog, "Process");
+  evel_syslog_s_data_set(syslog, "extra information");
+  return (EVENT_HEADER *) syslog;
+}
+
+typedef struct bench_arena_domain
+{
+  const char * name;
+  EVENT_HEADER * (*create)();
+} BENCH_ARENA_DOMAIN;
+
+static const BENCH_ARENA_DOMAIN bench_arena_domains[] = {
+  {"heartbeat", bench_arena_heartbeat},
+  {"fault", bench_arena_fault},
+  {"measurement", bench_arena_measurement},
+  {"state_change", bench_arena_state_change},
+  {"syslog", bench_arena_syslog},
+  {NULL, NULL}
+};
+
+/**************************************************************************//**
+ * Create and free events in one domain, reporting heap allocations and
+ * nanoseconds per event.
+ *****************************************************************************/
+static void bench_event_arena_run(const BENCH_ARENA_DOMAIN * const domain,
+                                  double * const mallocs,
+                                  double * const ns)
+{
+  EVENT_HEADER * event = NULL;
+  unsigned long long start;
+  int ii;
+
+  bench_mallocs = 0;
+  bench_counting_mallocs = 1;
+  start = bench_now_ns();
+  for (ii = 0; ii < BENCH_ARENA_EVENTS; ii++)
+  {
+    event = domain->create();
+    assert(event != NULL);
+    evel_free_event(event);
+  }
+  *ns = (double) (bench_now_ns() - start) / BENCH_ARENA_EVENTS;
+  bench_counting_mallocs = 0;
+  *mallocs = (double) bench_mallocs / BENCH_ARENA_EVENTS;
+}
+
+/**************************************************************************//**
+ * Compare building and tearing down events with and without arenas.
+ *****************************************************************************/
+static void bench_event_arena()
+{
+  double before_mallocs;
+  double before_ns;
+  double after_mallocs;
+  double after_ns;
+  int ii;
+
+  openstack_metadata_initialize();
+  evel_set_event_pool_limits(0, 0);
+
+  for (ii = 0; bench_arena_domains[ii].name != NULL; ii++)
+  {
+    evel_set_event_arena_size(0);
+    bench_event_arena_run(&bench_arena_domains[ii],
+                          &before_mallocs,
+                          &before_ns);
+    evel_set_event_arena_size(BENCH_ARENA_SIZE);
+    bench_event_arena_run(&bench_arena_domains[ii],
+                          &after_mallocs,
+                          &after_ns);
+    printf("  %-12s %5.1f mallocs/event before, %4.1f after;"
+           " %7.1f ns to build and free before, %7.1f after\n",
+           bench_arena_domains[ii].name,
+           before_mallocs,
+           after_mallocs,
+           before_ns,
+           after_ns);
+  }
+  evel_set_event_arena_size(0);
+  evel_set_event_pool_limits(16, 64);
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   EVENT POOLS                                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* How many events are handed from the raising thread to the freeing thread  */
+/* at a time, like a burst of events being posted.                           */
+/*****************************************************************************/
+#define BENCH_POOL_BURST 32
+
+typedef struct bench_pool_handoff
+{
+  const BENCH_ARENA_DOMAIN * domain;
+  pthread_barrier_t barrier;
+  EVENT_HEADER * events[BENCH_POOL_BURST];
+} BENCH_POOL_HANDOFF;
+
+/**************************************************************************//**
+ * Free each burst of events once the raising thread has created it.
+ *****************************************************************************/
+static void * bench_pool_freer(void * arg)
+{
+  BENCH_POOL_HANDOFF * handoff = arg;
+  int ii;
+  int jj;
+
+  for (ii = 0; ii < BENCH_ARENA_EVENTS / BENCH_POOL_BURST; ii++)
+  {
+    pthread_barrier_wait(&handoff->barrier);
+    for (jj = 0; jj < BENCH_POOL_BURST; jj++)
+    {
+      evel_free_event(handoff->events[jj]);
+    }
+    pthread_barrier_wait(&handoff->barrier);
+  }
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Create events on this thread and free them on another, as the event
+ * handler does once they are posted, reporting heap allocations and
+ * nanoseconds per event.
+ *****************************************************************************/
+static void bench_event_pool_run(const BENCH_ARENA_DOMAIN * const domain,
+                                 double * const mallocs,
+                                 double * const ns)
+{
+  BENCH_POOL_HANDOFF handoff;
+  pthread_t freer;
+  unsigned long long start;
+  int ii;
+  int jj;
+
+  handoff.domain = domain;
+  pthread_barrier_init(&handoff.barrier, NULL, 2);
+  pthread_create(&freer, NULL, bench_pool_freer, &handoff);
+
+  bench_mallocs = 0;
+  bench_counting_mallocs = 1;
+  start = bench_now_ns();
+  for (ii = 0; ii < BENCH_ARENA_EVENTS / BENCH_POOL_BURST; ii++)
+  {
+    for (jj = 0; jj < BENCH_POOL_BURST; jj++)
+    {
+      handoff.events[jj] = domain->create();
+      assert(handoff.events[jj] != NULL);
+    }
+    pthread_barrier_wait(&handoff.barrier);
+    pthread_barrier_wait(&handoff.barrier);
+  }
+  *ns = (double) (bench_now_ns() - start) / BENCH_ARENA_EVENTS;
+  bench_counting_mallocs = 0;
+  *mallocs = (double) bench_mallocs / BENCH_ARENA_EVENTS;
+
+  pthread_join(freer, NULL);
+  pthread_barrier_destroy(&handoff.barrier);
+}
+
+/**************************************************************************//**
+ * Compare creating events on one thread and freeing them on another with no
+ * pooling, with pooling, and with pooled arenas.
+ *****************************************************************************/
+static void bench_event_pool()
+{
+  double mallocs[3];
+  double ns[3];
+  int ii;
+
+  openstack_metadata_initialize();
+
+  for (ii = 0; bench_arena_domains[ii].name != NULL; ii++)
+  {
+    evel_set_event_pool_limits(0, 0);
+    bench_event_pool_run(&bench_arena_domains[ii], &mallocs[0], &ns[0]);
+    evel_set_event_pool_limits(BENCH_POOL_BURST, 4 * BENCH_POOL_BURST);
+    bench_event_pool_run(&bench_arena_domains[ii], &mallocs[1], &ns[1]);
+    evel_set_event_arena_size(BENCH_ARENA_SIZE);
+    bench_event_pool_run(&bench_arena_domains[ii], &mallocs[2], &ns[2]);
+    evel_set_event_arena_size(0);
+    printf("  %-12s mallocs/event %5.1f unpooled, %4.1f pooled,"
+           " %4.1f pooled arenas; ns/event %7.1f, %7.1f, %7.1f\n",
+           bench_arena_domains[ii].name,
+           mallocs[0],
+           mallocs[1],
+           mallocs[2],
+           ns[0],
+           ns[1],
+           ns[2]);
+  }
+  evel_set_event_pool_limits(16, 64);
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   EVENT SEQUENCE                                                          */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* How many heartbeats each thread creates in a sequence run.                */
+/*****************************************************************************/
+#define BENCH_SEQUENCE_EVENTS 200000
+#define BENCH_SEQUENCE_MAX_THREADS 4
+
+/**************************************************************************//**
+ * Create and free heartbeats as fast as possible.
+ *****************************************************************************/
+static void * bench_sequence_producer(void * arg)
+{
+  EVENT_HEADER * heartbeat = NULL;
+  int ii;
+
+  (void) arg;
+  for (ii = 0; ii < BENCH_SEQUENCE_EVENTS; ii++)
+  {
+    heartbeat = evel_new_heartbeat();
+    assert(heartbeat != NULL);
+    evel_free_event(heartbeat);
+  }
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Time heartbeat creation on several threads at once, with each thread
+ * taking sequence numbers singly and in blocks.
+ *****************************************************************************/
+static void bench_sequence()
+{
+  static const int block_sizes[] = {0, 64};
+  pthread_t threads[BENCH_SEQUENCE_MAX_THREADS];
+  unsigned long long start;
+  double ns;
+  int threads_count;
+  int block;
+  int ii;
+
+  openstack_metadata_initialize();
+
+  for (threads_count = 1;
+       threads_count <= BENCH_SEQUENCE_MAX_THREADS;
+       threads_count *= 2)
+  {
+    for (block = 0; block < 2; block++)
+    {
+      evel_set_event_sequence_block(block_sizes[block]);
+      start = bench_now_ns();
+      for (ii = 0; ii < threads_count; ii++)
+      {
+        pthread_create(&threads[ii], NULL, bench_sequence_producer, NULL);
+      }
+      for (ii = 0; ii < threads_count; ii++)
+      {
+        pthread_join(threads[ii], NULL);
+      }
+      ns = (double) (bench_now_ns() - start) /
+           (BENCH_SEQUENCE_EVENTS * threads_count);
+      printf("  %d thread%s, block %2d: %7.1f ns/heartbeat\n",
+             threads_count,
+             (threads_count == 1) ? " " : "s",
+             block_sizes[block],
+             ns);
+    }
+  }
+  evel_set_event_sequence_block(0);
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   THROTTLED ENCODING                                                      */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* How many times each throttle run encodes the measurement, how many CPUs   */
+/* and features the measurement carries, and how many times each lookup is   */
+/* timed.                                                                    */
+/*****************************************************************************/
+#define BENCH_THROTTLE_EVENTS 20000
+#define BENCH_THROTTLE_ITEMS 128
+#define BENCH_THROTTLE_LOOKUPS 2000000
+
+/*****************************************************************************/
+/* A specification suppressing some measurement fields and name-value pairs. */
+/*****************************************************************************/
+static const char * const bench_throttle_spec =
+  "{"
+  "\"commandList\": ["
+  "{"
+  "\"command\": {"
+  "\"commandType\": \"throttlingSpecification\", "
+  "\"eventDomainThrottleSpecification\": {"
+  "\"eventDomain\": \"measurementsForVfScaling\", "
+  "\"suppressedFieldNames\": ["
+  "\"concurrentSessions\", "
+  "\"configuredEntities\", "
+  "\"eventType\"], "
+  "\"suppressedNvPairsList\": ["
+  "{"
+  "\"nvPairFieldName\": \"cpuUsageArray\", "
+  "\"suppressedNvPairNames\": [\"cpu1\", \"cpu3\", \"cpu5\"]"
+  "}, "
+  "{"
+  "\"nvPairFieldName\": \"featureUsageArray\", "
+  "\"suppressedNvPairNames\": [\"feature2\", \"feature4\"]"
+  "}]}}}"
+  "]"
+  "}";
+
+/**************************************************************************//**
+ * Build a measurement with many CPUs and features, each of which is checked
+ * against the name-value pairs to suppress.
+ *****************************************************************************/
+static EVENT_HEADER * bench_throttle_measurement()
+{
+  EVENT_MEASUREMENT * measurement = evel_new_measurement(5.5);
+  char name[32];
+  int ii;
+
+  evel_measurement_type_set(measurement, "Perf management...");
+  evel_measurement_conc_sess_set(measurement, 1);
+  evel_measurement_cfg_ents_set(measurement, 2);
+  evel_measurement_request_rate_set(measurement, 3);
+  evel_measurement_media_port_use_set(measurement, 4);
+  for (ii = 0; ii < BENCH_THROTTLE_ITEMS; ii++)
+  {
+    sprintf(name, "cpu%d", ii);
+    evel_measurement_new_cpu_use_add(measurement, name, 11.11);
+    sprintf(name, "feature%d", ii);
+    evel_measurement_feature_use_add(measurement, name, ii);
+  }
+  return (EVENT_HEADER *) measurement;
+}
+
+/**************************************************************************//**
+ * Time encoding a large measurement.
+ *
+ * @returns Nanoseconds per encode.
+ *****************************************************************************/
+static double bench_throttle_run(EVEL_JSON_ARENA * arena,
+                                 EVENT_HEADER * measurement)
+{
+  unsigned long long start;
+  int ii;
+
+  start = bench_now_ns();
+  for (ii = 0; ii < BENCH_THROTTLE_EVENTS; ii++)
+  {
+    evel_json_encode_event_arena(arena, measurement);
+  }
+  return (double) (bench_now_ns() - start) / BENCH_THROTTLE_EVENTS;
+}
+
+/**************************************************************************//**
+ * Time the lookups the encoder makes for each optional field and each
+ * name-value pair.
+ *****************************************************************************/
+static void bench_throttle_lookups()
+{
+  EVEL_THROTTLE_SPEC * throttle_spec = NULL;
+  unsigned long long start;
+  int suppressed = 0;
+  int ii;
+
+  evel_throttle_read_begin();
+  throttle_spec = evel_get_throttle_spec(EVEL_DOMAIN_MEASUREMENT);
+  assert(throttle_spec != NULL);
+
+  start = bench_now_ns();
+  for (ii = 0; ii < BENCH_THROTTLE_LOOKUPS; ii++)
+  {
+    suppressed += evel_throttle_suppress_field(throttle_spec, "requestRate");
+  }
+  printf("  field:       %9.1f ns/lookup\n",
+         (double) (bench_now_ns() - start) / BENCH_THROTTLE_LOOKUPS);
+
+  start = bench_now_ns();
+  for (ii = 0; ii < BENCH_THROTTLE_LOOKUPS; ii++)
+  {
+    suppressed += evel_throttle_suppress_nv_pair(throttle_spec,
+                                                 "cpuUsageArray",
+                                                 "cpu12");
+  }
+  printf("  nv pair:     %9.1f ns/lookup\n",
+         (double) (bench_now_ns() - start) / BENCH_THROTTLE_LOOKUPS);
+
+  evel_throttle_read_end();
+  assert(suppressed == 0);
+}
+
+/**************************************************************************//**
+ * Time encoding a large measurement with and without a throttle
+ * specification for its domain, and the lookups themselves.
+ *****************************************************************************/
+static void bench_throttle()
+{
+  EVEL_JSON_ARENA * arena = NULL;
+  EVENT_HEADER * measurement = NULL;
+  MEMORY_CHUNK chunk;
+  MEMORY_CHUNK post;
+
+  openstack_metadata_initialize();
+  arena = evel_json_thread_arena();
+  assert(arena != NULL);
+  measurement = bench_throttle_measurement();
+  assert(measurement != NULL);
+
+  evel_throttle_initialize();
+  printf("  unthrottled: %9.1f ns/measurement\n",
+         bench_throttle_run(arena, measurement));
+
+  chunk.memory = strdup(bench_throttle_spec);
+  chunk.size = strlen(bench_throttle_spec) + 1;
+  post.memory = NULL;
+  post.size = 0;
+  evel_handle_event_response(&chunk, &post);
+  free(chunk.memory);
+  assert(post.memory == NULL);
+  printf("  throttled:   %9.1f ns/measurement\n",
+         bench_throttle_run(arena, measurement));
+  bench_throttle_lookups();
+
+  evel_free_event(measurement);
+  evel_throttle_terminate();
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   COMPRESSION                                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* How many times each body is compressed, and how many measurements go in   */
+/* the batch.                                                                */
+/*****************************************************************************/
+#define BENCH_COMPRESS_POSTS 2000
+#define BENCH_COMPRESS_BATCH 20
+
+/**************************************************************************//**
+ * A post body to compress.
+ *****************************************************************************/
+typedef struct bench_compress_body
+{
+  const char * name;
+  char * body;
+  int size;
+} BENCH_COMPRESS_BODY;
+
+/**************************************************************************//**
+ * Compress a body repeatedly, either reusing the compressor or setting it up
+ * afresh each time.
+ *
+ * @returns Nanoseconds per post.
+ *****************************************************************************/
+static double bench_compress_run(const BENCH_COMPRESS_BODY * const body,
+                                 const int level,
+                                 const int reuse,
+                                 int * const compressed_size)
+{
+  EVEL_COMPRESSOR compressor;
+  char * output = NULL;
+  int capacity = 0;
+  unsigned long long start;
+  int ii;
+
+  evel_compressor_initialize(&compressor);
+  start = bench_now_ns();
+  for (ii = 0; ii < BENCH_COMPRESS_POSTS; ii++)
+  {
+    if (!reuse)
+    {
+      evel_compressor_free(&compressor);
+    }
+    *compressed_size = evel_compress(&compressor,
+                                     level,
+                                     body->body,
+                                     body->size,
+                                     &output,
+                                     &capacity);
+    assert(*compressed_size > 0);
+  }
+  start = bench_now_ns() - start;
+  evel_compressor_free(&compressor);
+  free(output);
+
+  return (double) start / BENCH_COMPRESS_POSTS;
+}
+
+/**************************************************************************//**
+ * Report the compression ratio and CPU cost of compressing the bodies of
+ * posts of the representative events, a large measurement and a batch of
+ * measurements, at a few compression levels.
+ *****************************************************************************/
+static void bench_compress()
+{
+  static const int levels[] = {1, 6, 9};
+  BENCH_COMPRESS_BODY bodies[16];
+  EVEL_JSON_ARENA * arena = NULL;
+  EVENT_HEADER * event = NULL;
+  int num_bodies = 0;
+  int compressed_size = 0;
+  int json_size = 0;
+  int offset = 0;
+  double reused_ns;
+  double fresh_ns;
+  int ii;
+  int jj;
+
+  openstack_metadata_initialize();
+  arena = evel_json_thread_arena();
+  assert(arena != NULL);
+
+  /***************************************************************************/
+  /* Encode the bodies, as a post of each event on its own and a batch.      */
+  /***************************************************************************/
+  for (ii = 0; bench_arena_domains[ii].name != NULL; ii++)
+  {
+    event = bench_arena_domains[ii].create();
+    bodies[num_bodies].name = bench_arena_domains[ii].name;
+    bodies[num_bodies].size = evel_json_encode_event_arena(arena, event);
+    bodies[num_bodies].body = strdup(arena->json);
+    num_bodies++;
+    evel_free_event(event);
+  }
+
+  event = bench_throttle_measurement();
+  bodies[num_bodies].name = "measurement_big";
+  bodies[num_bodies].size = evel_json_encode_event_arena(arena, event);
+  bodies[num_bodies].body = strdup(arena->json);
+  num_bodies++;
+  evel_free_event(event);
+
+  bodies[num_bodies].name = "batch";
+  bodies[num_bodies].body = malloc(EVEL_MAX_JSON_BODY * BENCH_COMPRESS_BATCH);
+  assert(bodies[num_bodies].body != NULL);
+  offset = sprintf(bodies[num_bodies].body, "{\"eventList\": [");
+  for (ii = 0; ii < BENCH_COMPRESS_BATCH; ii++)
+  {
+    event = bench_arena_measurement();
+    json_size = evel_json_encode_event_list_entry_arena(arena, event);
+    offset += sprintf(bodies[num_bodies].body + offset,
+                      "%s%.*s",
+                      (ii > 0) ? ", " : "",
+                      json_size,
+                      arena->json);
+    evel_free_event(event);
+  }
+  offset += sprintf(bodies[num_bodies].body + offset, "]}");
+  bodies[num_bodies].size = offset;
+  num_bodies++;
+
+  /***************************************************************************/
+  /* Compress each body at each level, reusing the compressor, and at the    */
+  /* default level setting it up for each post too.                          */
+  /***************************************************************************/
+  for (ii = 0; ii < num_bodies; ii++)
+  {
+    printf("  %-16s %6d bytes\n", bodies[ii].name, bodies[ii].size);
+    for (jj = 0; jj < (int) (sizeof(levels) / sizeof(levels[0])); jj++)
+    {
+      reused_ns = bench_compress_run(&bodies[ii],
+                                     levels[jj],
+                                     1,
+                                     &compressed_size);
+      printf("    level %d: %6d bytes, %5.1fx smaller, %9.1f ns/post,"
+             " %6.1f MB/s",
+             levels[jj],
+             compressed_size,
+             (double) bodies[ii].size / compressed_size,
+             reused_ns,
+             bodies[ii].size * 1000.0 / reused_ns);
+      if (levels[jj] == 6)
+      {
+        fresh_ns = bench_compress_run(&bodies[ii],
+                                      levels[jj],
+                                      0,
+                                      &compressed_size);
+        printf(", %9.1f ns/post set up afresh", fresh_ns);
+      }
+      printf("\n");
+    }
+    free(bodies[ii].body);
+  }
+}
@@ -0,0 +1,279 @@
+/**************************************************************************//**
+ * @file
+ * A simple bump allocator.
+ *
+ * @note  No thread protection so you will need to use appropriate
+ * synchronization if use spans multiple threads.
+ *
+ * License
+ * -------
+ *
+ * Copyright(c) <2016>, AT&T Intellectual Property.  All other rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:  This product includes
+ *    software developed by the AT&T.
+ * 4. Neither the name of AT&T nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY AT&T INTELLECTUAL PROPERTY ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL AT&T INTELLECTUAL PROPERTY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "evel.h"
+
+/*****************************************************************************/
+/* Alignment of every allocation, enough for any type.                       */
+/*****************************************************************************/
+#define ARENA_ALIGNMENT 16
+#define ARENA_ALIGN(SIZE) \
+  (((SIZE) + ARENA_ALIGNMENT - 1) & ~((size_t) ARENA_ALIGNMENT - 1))
+
+/**************************************************************************//**
+ * Arena creation.
+ *
+ * Create an arena whose first chunk has room for @p chunk_size bytes, rounded
+ * up to the alignment of each allocation so that an allocation of
+ * @p chunk_size bytes fits in it.  Each further chunk is twice the size of
+ * the one before, so that the number of chunks grows only with the log of the
+ * memory used.
+ *
+ * @param   chunk_size  Size of the first chunk.
+ *
+ * @returns Pointer to the arena, or NULL if it could not be allocated.
+******************************************************************************/
+ARENA * arena_create(const size_t chunk_size)
+{
+  ARENA * arena = NULL;
+  const size_t header_size = ARENA_ALIGN(sizeof(ARENA));
+  const size_t size = ARENA_ALIGN(chunk_size);
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(chunk_size > 0);
+
+  arena = malloc(header_size + size);
+  if (arena != NULL)
+  {
+    arena->chunks = NULL;
+    arena->cleanups = NULL;
+    arena->size = size;
+    arena->next = (char *) arena + header_size;
+    arena->end = arena->next + size;
+    arena->chunk_size = size;
+    arena->mallocs = 1;
+    arena->bytes = header_size + size;
+  }
+
+  EVEL_EXIT();
+
+  return arena;
+}
+
+/**************************************************************************//**
+ * Allocate memory from an arena.
+ *
+ * @param   arena   Pointer to the arena.
+ * @param   size    Number of bytes required.
+ *
+ * @returns Pointer to the memory, which is not initialized, or NULL if a new
+ *          chunk was needed and could not be allocated.
+******************************************************************************/
+void * arena_alloc(ARENA * arena, const size_t size)
+{
+  const size_t header_size = ARENA_ALIGN(sizeof(ARENA_CHUNK));
+  const size_t aligned_size = ARENA_ALIGN(size);
+  ARENA_CHUNK * chunk = NULL;
+  size_t chunk_size;
+  void * memory = NULL;
+
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(arena != NULL);
+
+  if ((size_t) (arena->end - arena->next) < aligned_size)
+  {
+    /*************************************************************************/
+    /* Start a new chunk.  What was left of the last one is abandoned.       */
+    /*************************************************************************/
+    chunk_size = arena->chunk_size * 2;
+    if (chunk_size < aligned_size)
+    {
+      chunk_size = aligned_size;
+    }
+    chunk = malloc(header_size + chunk_size);
+    if (chunk == NULL)
+    {
+      goto exit_label;
+    }
+    chunk->next = arena->chunks;
+    chunk->size = chunk_size;
+    arena->chunks = chunk;
+    arena->next = (char *) chunk + header_size;
+    arena->end = arena->next + chunk_size;
+    arena->chunk_size = chunk_size;
+    arena->mallocs++;
+    arena->bytes += header_size + chunk_size;
+  }
+
+  memory = arena->next;
+  arena->next += aligned_size;
+
+exit_label:
+  return memory;
+}
+
+/**************************************************************************//**
+ * Copy a string into an arena.
+ *
+ * @param   arena   Pointer to the arena.
+ * @param   value   The string to copy.
+ *
+ * @returns Pointer to the copy, or NULL if it could not be allocated.
+******************************************************************************/
+char * arena_strdup(ARENA * arena, const char * const value)
+{
+  const size_t size = strlen(value) + 1;
+  char * copy = NULL;
+
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(arena != NULL);
+  assert(value != NULL);
+
+  copy = arena_alloc(arena, size);
+  if (copy != NULL)
+  {
+    memcpy(copy, value, size);
+  }
+
+  return copy;
+}
+
+/**************************************************************************//**
+ * Hand an object allocated outside an arena over to the arena.
+ *
+ * The object is destroyed, most recently adopted first, when the arena is.
+ *
+ * @param   arena   Pointer to the arena.
+ * @param   destroy Function which releases the object.
+ * @param   object  The object to adopt.
+ *
+ * @returns true if the object was adopted, false if there was no memory.
+******************************************************************************/
+bool arena_adopt(ARENA * arena,
+                 void (*destroy)(void * object),
+                 void * object)
+{
+  ARENA_CLEANUP * cleanup = NULL;
+
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(arena != NULL);
+  assert(destroy != NULL);
+
+  cleanup = arena_alloc(arena, sizeof(ARENA_CLEANUP));
+  if (cleanup != NULL)
+  {
+    cleanup->next = arena->cleanups;
+    cleanup->destroy = destroy;
+    cleanup->object = object;
+    arena->cleanups = cleanup;
+  }
+
+  return (cleanup != NULL);
+}
+
+/**************************************************************************//**
+ * Arena reset.
+ *
+ * Destroy any adopted objects and release all the memory allocated from the
+ * arena, keeping only the first chunk, so that the arena can be reused as if
+ * it had just been created.
+ *
+ * @param   arena   Pointer to the arena.
+******************************************************************************/
+void arena_reset(ARENA * arena)
+{
+  const size_t header_size = ARENA_ALIGN(sizeof(ARENA));
+  ARENA_CHUNK * chunk = NULL;
+  ARENA_CHUNK * next = NULL;
+  ARENA_CLEANUP * cleanup = NULL;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(arena != NULL);
+
+  for (cleanup = arena->cleanups; cleanup != NULL; cleanup = cleanup->next)
+  {
+    cleanup->destroy(cleanup->object);
+  }
+  for (chunk = arena->chunks; chunk != NULL; chunk = next)
+  {
+    next = chunk->next;
+    free(chunk);
+  }
+  arena->chunks = NULL;
+  arena->cleanups = NULL;
+  arena->next = (char *) arena + header_size;
+  arena->end = arena->next + arena->size;
+  arena->chunk_size = arena->size;
+  arena->mallocs = 1;
+  arena->bytes = header_size + arena->size;
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Arena destruction.
+ *
+ * Destroy any adopted objects, then release all the memory allocated from the
+ * arena, and the arena itself.
+ *
+ * @param   arena   Pointer to the arena.
+******************************************************************************/
+void arena_destroy(ARENA * arena)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(arena != NULL);
+
+  arena_reset(arena);
+  free(arena);
+
+  EVEL_EXIT();
+}
@@ -0,0 +1,92 @@
+#ifndef ARENA_INCLUDED
+#define ARENA_INCLUDED
+
+/**************************************************************************//**
+ * @file
+ * A simple bump allocator.
+ *
+ * Memory is handed out in order from a chunk, with further chunks added as
+ * needed, and is only ever released all at once by destroying the arena.
+ *
+ * @note  No thread protection so you will need to use appropriate
+ * synchronization if use spans multiple threads.
+ *
+ * License
+ * -------
+ *
+ * Copyright(c) <2016>, AT&T Intellectual Property.  All other rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:  This product includes
+ *    software developed by the AT&T.
+ * 4. Neither the name of AT&T nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY AT&T INTELLECTUAL PROPERTY ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL AT&T INTELLECTUAL PROPERTY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**************************************************************************//**
+ * A chunk of arena memory.  Allocations follow the header.
+ *****************************************************************************/
+typedef struct arena_chunk
+{
+  struct arena_chunk * next;
+  size_t size;
+} ARENA_CHUNK;
+
+/**************************************************************************//**
+ * An object allocated outside an arena which is destroyed with it.
+ *****************************************************************************/
+typedef struct arena_cleanup
+{
+  struct arena_cleanup * next;
+  void (*destroy)(void * object);
+  void * object;
+} ARENA_CLEANUP;
+
+/**************************************************************************//**
+ * Arena structure.  The arena lives at the start of its first chunk.
+ *****************************************************************************/
+typedef struct arena
+{
+  ARENA_CHUNK * chunks;
+  ARENA_CLEANUP * cleanups;
+  size_t size;
+  char * next;
+  char * end;
+  size_t chunk_size;
+  int mallocs;
+  size_t bytes;
+} ARENA;
+
+ARENA * arena_create(const size_t chunk_size);
+void * arena_alloc(ARENA * arena, const size_t size);
+char * arena_strdup(ARENA * arena, const char * const value);
+bool arena_adopt(ARENA * arena,
+                 void (*destroy)(void * object),
+                 void * object);
+void arena_reset(ARENA * arena);
+void arena_destroy(ARENA * arena);
+
+#endif
@@ -132,6 +132,24 @@ void dlist_push_first(DLIST * list, void * item)
 void dlist_push_last(DLIST * list, void * item)
 {
   DLIST_ITEM * new_element = NULL;
+
+  new_element = malloc(sizeof(DLIST_ITEM));
+  assert(new_element != NULL);
+  dlist_push_last_element(list, new_element, item);
+}
+
+/**************************************************************************//**
+ * Add an item to the end of the list, using an element the caller has
+ * allocated.
+ *
+ * @param   list        Pointer to the list.
+ * @param   new_element The element to link into the list.
+ * @param   item        The item the element holds.
+******************************************************************************/
+void dlist_push_last_element(DLIST * list,
+                             DLIST_ITEM * new_element,
+                             void * item)
+{
   DLIST_ITEM * current_tail = NULL;
 
   /***************************************************************************/
@@ -139,11 +157,10 @@ void dlist_push_last(DLIST * list, void * item)
   /* the list - not sure you'd want to, but let it happen.                   */
   /***************************************************************************/
   assert(list != NULL);
+  assert(new_element != NULL);
 
   current_tail = list->tail;
 
-  new_element = malloc(sizeof(DLIST_ITEM));
-  assert(new_element != NULL);
   new_element->next = NULL;
   new_element->previous = current_tail;
   new_element->item = item;
@@ -61,6 +61,9 @@ void dlist_initialize(DLIST * list);
 void * dlist_pop_last(DLIST * list);
 void dlist_push_first(DLIST * list, void * item);
 void dlist_push_last(DLIST * list, void * item);
+void dlist_push_last_element(DLIST * list,
+                             DLIST_ITEM * new_element,
+                             void * item);
 DLIST_ITEM * dlist_get_first(DLIST * list);
 DLIST_ITEM * dlist_get_last(DLIST * list);
 DLIST_ITEM * dlist_get_next(DLIST_ITEM * item);
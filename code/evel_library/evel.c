@@ -62,6 +62,25 @@ EVEL_SOURCE_TYPES event_source_type = EVEL_SOURCE_OTHER;
  *****************************************************************************/
 char *functional_role = NULL;
 
+/**************************************************************************//**
+ * The listener endpoints added to the one given to ::evel_initialize.
+ *****************************************************************************/
+static char * evel_endpoint_fqdns[EVEL_MAX_ENDPOINTS - 1];
+static int evel_endpoint_ports[EVEL_MAX_ENDPOINTS - 1];
+static int evel_num_added_endpoints = 0;
+
+/*****************************************************************************/
+/* Prototypes of locally scoped functions.                                   */
+/*****************************************************************************/
+static EVEL_ERR_CODES evel_build_api_urls(const char * const fqdn,
+                                          const int port,
+                                          const char * const path,
+                                          const char * const topic,
+                                          const int secure,
+                                          char * const event_api_url,
+                                          char * const batch_api_url,
+                                          char * const throt_api_url);
+
 /**************************************************************************//**
  * Library initialization.
  *
@@ -101,15 +120,69 @@ EVEL_ERR_CODES evel_initialize(const char * const fqdn,
                                const char * const role,
                                int verbosity
                                )
+{
+  return evel_initialize_ext(fqdn,
+                             port,
+                             path,
+                             topic,
+                             secure,
+                             username,
+                             password,
+                             source_type,
+                             role,
+                             verbosity,
+                             NULL);
+}
+
+/**************************************************************************//**
+ * Library initialization, with further options.
+ *
+ * Initialize the EVEL library, setting the limits on the events waiting to
+ * be sent.
+ *
+ * @note  This function initializes the cURL library.  Applications making use
+ *        of libcurl may need to pull the initialization out of here.  Note
+ *        also that this function is not threadsafe as a result - refer to
+ *        libcurl's API documentation for relevant warnings.
+ *
+ * @sa  Matching Term function.
+ *
+ * @param   fqdn    The API's FQDN or IP address.
+ * @param   port    The API's port.
+ * @param   path    The optional path (may be NULL).
+ * @param   topic   The optional topic part of the URL (may be NULL).
+ * @param   secure  Whether to use HTTPS (0=HTTP, 1=HTTPS)
+ * @param   username  Username for Basic Authentication of requests.
+ * @param   password  Password for Basic Authentication of requests.
+ * @param   source_type The kind of node we represent.
+ * @param   role    The role this node undertakes.
+ * @param   verbosity  0 for normal operation, positive values for chattier
+ *                        logs.
+ * @param   options    The further options, or NULL for the defaults.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      On success
+ * @retval  ::EVEL_ERR_CODES  On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_initialize_ext(const char * const fqdn,
+                                   int port,
+                                   const char * const path,
+                                   const char * const topic,
+                                   int secure,
+                                   const char * const username,
+                                   const char * const password,
+                                   EVEL_SOURCE_TYPES source_type,
+                                   const char * const role,
+                                   int verbosity,
+                                   const EVEL_INIT_OPTIONS * const options)
 {
   EVEL_ERR_CODES rc = EVEL_SUCCESS;
-  char base_api_url[EVEL_MAX_URL_LEN + 1] = {0};
   char event_api_url[EVEL_MAX_URL_LEN + 1] = {0};
+  char batch_api_url[EVEL_MAX_URL_LEN + 1] = {0};
   char throt_api_url[EVEL_MAX_URL_LEN + 1] = {0};
-  char path_url[EVEL_MAX_URL_LEN + 1] = {0};
-  char topic_url[EVEL_MAX_URL_LEN + 1] = {0};
-  char version_string[10] = {0};
-  int offset;
+  int queue_depth = EVEL_EVENT_BUFFER_DEPTH;
+  size_t queue_max_bytes = 0;
+  int ii;
 
   /***************************************************************************/
   /* Check assumptions.                                                      */
@@ -118,6 +191,16 @@ EVEL_ERR_CODES evel_initialize(const char * const fqdn,
   assert(port > 0 && port <= 65535);
   assert(source_type < EVEL_MAX_SOURCE_TYPES);
   assert(role != NULL);
+  assert((options == NULL) || (options->queue_depth >= 0));
+
+  if (options != NULL)
+  {
+    if (options->queue_depth > 0)
+    {
+      queue_depth = options->queue_depth;
+    }
+    queue_max_bytes = options->queue_max_bytes;
+  }
 
   /***************************************************************************/
   /* Start logging so we can report on progress.                             */
@@ -149,6 +232,8 @@ EVEL_ERR_CODES evel_initialize(const char * const fqdn,
   EVEL_INFO("Event Source Type is: %d", source_type);
   EVEL_INFO("Functional Role is: %s", role);
   EVEL_INFO("Log verbosity is: %d", verbosity);
+  EVEL_INFO("Queue depth is: %d", queue_depth);
+  EVEL_INFO("Queue memory budget is: %zu", queue_max_bytes);
 
   /***************************************************************************/
   /* Initialize event throttling to the default state.                       */
@@ -162,65 +247,61 @@ EVEL_ERR_CODES evel_initialize(const char * const fqdn,
   functional_role = strdup(role);
 
   /***************************************************************************/
-  /* Ensure there are no trailing zeroes and unnecessary decimal points in   */
-  /* the version.                                                            */
+  /* Build the URLs to the APIs on the listener.                             */
   /***************************************************************************/
-  offset = sprintf(version_string, "%d", EVEL_API_MAJOR_VERSION);
-
-  if (EVEL_API_MINOR_VERSION != 0)
+  rc = evel_build_api_urls(fqdn,
+                           port,
+                           path,
+                           topic,
+                           secure,
+                           event_api_url,
+                           batch_api_url,
+                           throt_api_url);
+  if (rc != EVEL_SUCCESS)
   {
-    sprintf(version_string + offset, ".%d", EVEL_API_MINOR_VERSION);
+    goto exit_label;
   }
 
-  /***************************************************************************/
-  /* Build a common base of the API URLs.                                    */
-  /***************************************************************************/
-  strcpy(path_url, "/");
-  snprintf(base_api_url,
-           EVEL_MAX_URL_LEN,
-           "%s://%s:%d%s/eventListener/v%s",
-           secure ? "https" : "http",
-           fqdn,
-           port,
-           (((path != NULL) && (strlen(path) > 0)) ?
-            strncat(path_url, path, EVEL_MAX_URL_LEN) : ""),
-           version_string);
-
-  /***************************************************************************/
-  /* Build the URL to the event API.                                         */
-  /***************************************************************************/
-  strcpy(topic_url, "/");
-  snprintf(event_api_url,
-           EVEL_MAX_URL_LEN,
-           "%s%s",
-           base_api_url,
-           (((topic != NULL) && (strlen(topic) > 0)) ?
-            strncat(topic_url, topic, EVEL_MAX_URL_LEN) : ""));
-  EVEL_INFO("Vendor Event Listener API is located at: %s", event_api_url);
-
-  /***************************************************************************/
-  /* Build the URL to the throttling API.                                    */
-  /***************************************************************************/
-  snprintf(throt_api_url,
-           EVEL_MAX_URL_LEN,
-           "%s/clientThrottlingState",
-           base_api_url);
-  EVEL_INFO("Vendor Event Throttling API is located at: %s", throt_api_url);
-
   /***************************************************************************/
   /* Spin-up the event-handler, which gets cURL readied for use.             */
   /***************************************************************************/
   rc = event_handler_initialize(event_api_url,
+                                batch_api_url,
                                 throt_api_url,
                                 username,
                                 password,
-                                verbosity);
+                                verbosity,
+                                queue_depth,
+                                queue_max_bytes);
   if (rc != EVEL_SUCCESS)
   {
     log_error_state("Failed to initialize event handler (including cURL)");
     goto exit_label;
   }
 
+  /***************************************************************************/
+  /* Add the other listener endpoints, which share the path and topic.       */
+  /***************************************************************************/
+  for (ii = 0; ii < evel_num_added_endpoints; ii++)
+  {
+    EVEL_INFO("Backup API server is: %s:%d",
+              evel_endpoint_fqdns[ii],
+              evel_endpoint_ports[ii]);
+    rc = evel_build_api_urls(evel_endpoint_fqdns[ii],
+                             evel_endpoint_ports[ii],
+                             path,
+                             topic,
+                             secure,
+                             event_api_url,
+                             batch_api_url,
+                             throt_api_url);
+    if (rc != EVEL_SUCCESS)
+    {
+      goto exit_label;
+    }
+    event_handler_add_endpoint(event_api_url, batch_api_url, throt_api_url);
+  }
+
   /***************************************************************************/
   /* Extract the metadata from OpenStack. If we fail to extract it, we       */
   /* record that in the logs, but carry on, assuming we're in a test         */
@@ -248,6 +329,155 @@ exit_label:
   return(rc);
 }
 
+/**************************************************************************//**
+ * Build the URLs to the APIs on a listener.
+ *
+ * @param   fqdn    The API's FQDN or IP address.
+ * @param   port    The API's port.
+ * @param   path    The optional path (may be NULL).
+ * @param   topic   The optional topic part of the URL (may be NULL).
+ * @param   secure  Whether to use HTTPS (0=HTTP, 1=HTTPS)
+ * @param[out] event_api_url  Filled in with the URL to the event API.
+ * @param[out] batch_api_url  Filled in with the URL to the batch API.
+ * @param[out] throt_api_url  Filled in with the URL to the throttling API.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      On success
+ * @retval  EVEL_ERR_GEN_FAIL A URL would be longer than ::EVEL_MAX_URL_LEN.
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_build_api_urls(const char * const fqdn,
+                                          const int port,
+                                          const char * const path,
+                                          const char * const topic,
+                                          const int secure,
+                                          char * const event_api_url,
+                                          char * const batch_api_url,
+                                          char * const throt_api_url)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  char base_api_url[EVEL_MAX_URL_LEN + 1] = {0};
+  char path_url[EVEL_MAX_URL_LEN + 1] = {0};
+  char topic_url[EVEL_MAX_URL_LEN + 1] = {0};
+  char version_string[10] = {0};
+  int offset;
+
+  /***************************************************************************/
+  /* Ensure there are no trailing zeroes and unnecessary decimal points in   */
+  /* the version.                                                            */
+  /***************************************************************************/
+  offset = sprintf(version_string, "%d", EVEL_API_MAJOR_VERSION);
+
+  if (EVEL_API_MINOR_VERSION != 0)
+  {
+    sprintf(version_string + offset, ".%d", EVEL_API_MINOR_VERSION);
+  }
+
+  /***************************************************************************/
+  /* Build a common base of the API URLs.                                    */
+  /***************************************************************************/
+  strcpy(path_url, "/");
+  if (snprintf(base_api_url,
+               EVEL_MAX_URL_LEN,
+               "%s://%s:%d%s/eventListener/v%s",
+               secure ? "https" : "http",
+               fqdn,
+               port,
+               (((path != NULL) && (strlen(path) > 0)) ?
+                strncat(path_url, path, EVEL_MAX_URL_LEN) : ""),
+               version_string) >= EVEL_MAX_URL_LEN)
+  {
+    log_error_state("API URL for %s is too long", fqdn);
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Build the URL to the event API.                                         */
+  /***************************************************************************/
+  strcpy(topic_url, "/");
+  if (snprintf(event_api_url,
+               EVEL_MAX_URL_LEN,
+               "%s%s",
+               base_api_url,
+               (((topic != NULL) && (strlen(topic) > 0)) ?
+                strncat(topic_url, topic, EVEL_MAX_URL_LEN) : ""))
+      >= EVEL_MAX_URL_LEN)
+  {
+    log_error_state("Event API URL for %s is too long", fqdn);
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+  EVEL_INFO("Vendor Event Listener API is located at: %s", event_api_url);
+
+  /***************************************************************************/
+  /* Build the URL to the batch API, used when several events are posted     */
+  /* together as an eventList.                                               */
+  /***************************************************************************/
+  if (snprintf(batch_api_url,
+               EVEL_MAX_URL_LEN,
+               "%s/eventBatch",
+               base_api_url) >= EVEL_MAX_URL_LEN)
+  {
+    log_error_state("Batch API URL for %s is too long", fqdn);
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+  EVEL_INFO("Vendor Event Listener batch API is located at: %s",
+            batch_api_url);
+
+  /***************************************************************************/
+  /* Build the URL to the throttling API.                                    */
+  /***************************************************************************/
+  if (snprintf(throt_api_url,
+               EVEL_MAX_URL_LEN,
+               "%s/clientThrottlingState",
+               base_api_url) >= EVEL_MAX_URL_LEN)
+  {
+    log_error_state("Throttling API URL for %s is too long", fqdn);
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+  EVEL_INFO("Vendor Event Throttling API is located at: %s", throt_api_url);
+
+exit_label:
+  return(rc);
+}
+
+/**************************************************************************//**
+ * Add a listener endpoint.
+ *
+ * @param fqdn      The endpoint's FQDN or IP address.
+ * @param port      The endpoint's port.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL There are already ::EVEL_MAX_ENDPOINTS.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_add_endpoint(const char * const fqdn, const int port)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(fqdn != NULL);
+  assert(port > 0 && port <= 65535);
+
+  if (evel_num_added_endpoints >= EVEL_MAX_ENDPOINTS - 1)
+  {
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  evel_endpoint_fqdns[evel_num_added_endpoints] = strdup(fqdn);
+  assert(evel_endpoint_fqdns[evel_num_added_endpoints] != NULL);
+  evel_endpoint_ports[evel_num_added_endpoints] = port;
+  evel_num_added_endpoints++;
+
+exit_label:
+  return(rc);
+}
+
 /**************************************************************************//**
  * Clean up the EVEL library.
  *
@@ -279,6 +509,12 @@ EVEL_ERR_CODES evel_terminate(void)
   /* Clean up allocated memory.                                              */
   /***************************************************************************/
   free(functional_role);
+  while (evel_num_added_endpoints > 0)
+  {
+    free(evel_endpoint_fqdns[--evel_num_added_endpoints]);
+  }
+  evel_header_cache_terminate();
+  evel_event_pool_terminate();
 
   /***************************************************************************/
   /* Clean up event throttling.                                              */
@@ -293,6 +529,9 @@ EVEL_ERR_CODES evel_terminate(void)
  * Free an event.
  *
  * Free off the event supplied.  Will free all the contained allocated memory.
+ * An event built in an arena is released along with everything it owns by
+ * resetting the arena.  The event's structure is kept for reuse by the next
+ * event in the same domain if the event pools have room for it.
  *
  * @note  It is safe to free a NULL pointer.
  *****************************************************************************/
@@ -301,7 +540,12 @@ void evel_free_event(void * event)
   EVENT_HEADER * evt_ptr = event;
   EVEL_ENTER();
 
-  if (event != NULL)
+  if (event != NULL && evt_ptr->arena != NULL)
+  {
+    EVEL_DEBUG("Event at %lp is in an arena", evt_ptr);
+    evel_release_event(evt_ptr, evt_ptr->event_domain);
+  }
+  else if (event != NULL)
   {
     /*************************************************************************/
     /* Work out what kind of event we're dealing with so we can cast it      */
@@ -320,77 +564,77 @@ void evel_free_event(void * event)
       EVEL_DEBUG("Event is a Heartbeat at %lp", evt_ptr);
       evel_free_header(evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_HEADER));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_HEARTBEAT);
       break;
 
     case EVEL_DOMAIN_FAULT:
       EVEL_DEBUG("Event is a Fault at %lp", evt_ptr);
       evel_free_fault((EVENT_FAULT *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_FAULT));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_FAULT);
       break;
 
     case EVEL_DOMAIN_MEASUREMENT:
       EVEL_DEBUG("Event is a Measurement at %lp", evt_ptr);
       evel_free_measurement((EVENT_MEASUREMENT *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_MEASUREMENT));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_MEASUREMENT);
       break;
 
     case EVEL_DOMAIN_MOBILE_FLOW:
       EVEL_DEBUG("Event is a Mobile Flow at %lp", evt_ptr);
       evel_free_mobile_flow((EVENT_MOBILE_FLOW *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_MOBILE_FLOW));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_MOBILE_FLOW);
       break;
 
     case EVEL_DOMAIN_REPORT:
       EVEL_DEBUG("Event is a Report at %lp", evt_ptr);
       evel_free_report((EVENT_REPORT *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_REPORT));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_REPORT);
       break;
 
     case EVEL_DOMAIN_HEARTBEAT_FIELD:
       EVEL_DEBUG("Event is a Heartbeat Field Event at %lp", evt_ptr);
       evel_free_hrtbt_field((EVENT_HEARTBEAT_FIELD *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_HEARTBEAT_FIELD));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_HEARTBEAT_FIELD);
       break;
 
     case EVEL_DOMAIN_SIPSIGNALING:
       EVEL_DEBUG("Event is a Signaling at %lp", evt_ptr);
       evel_free_signaling((EVENT_SIGNALING *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_SIGNALING));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_SIPSIGNALING);
       break;
 
     case EVEL_DOMAIN_STATE_CHANGE:
       EVEL_DEBUG("Event is a State Change at %lp", evt_ptr);
       evel_free_state_change((EVENT_STATE_CHANGE *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_STATE_CHANGE));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_STATE_CHANGE);
       break;
 
     case EVEL_DOMAIN_SYSLOG:
       EVEL_DEBUG("Event is a Syslog at %lp", evt_ptr);
       evel_free_syslog((EVENT_SYSLOG *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_SYSLOG));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_SYSLOG);
       break;
 
     case EVEL_DOMAIN_OTHER:
       EVEL_DEBUG("Event is an Other at %lp", evt_ptr);
       evel_free_other((EVENT_OTHER *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_OTHER));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_OTHER);
       break;
 
     case EVEL_DOMAIN_VOICE_QUALITY:
       EVEL_DEBUG("Event is an VoiceQuality at %lp", evt_ptr);
       evel_free_voice_quality((EVENT_VOICE_QUALITY *)evt_ptr);
       memset(evt_ptr, 0, sizeof(EVENT_VOICE_QUALITY));
-      free(evt_ptr);
+      evel_release_event(evt_ptr, EVEL_DOMAIN_VOICE_QUALITY);
       break;
 
     default:
@@ -54,7 +54,8 @@ extern "C" {
 
 #include "jsmn.h"
 #include "double_list.h"
-#include "hashtable.h"
+#include "hash_map.h"
+#include "arena.h"
 
 /*****************************************************************************/
 /* Supported API version.                                                    */
@@ -79,6 +80,8 @@ typedef enum {
   EVEL_BAD_METADATA,              /** OpenStack metadata invalid format.     */
   EVEL_BAD_JSON_FORMAT,           /** JSON failed to parse correctly.        */
   EVEL_JSON_KEY_NOT_FOUND,        /** Failed to find the specified JSON key. */
+  EVEL_SPOOL_FAIL,                /** The spool directory couldn't be used.  */
+  EVEL_FLUSH_TIMEOUT,             /** Events still being sent at timeout.    */
   EVEL_MAX_ERROR_CODES            /** Maximum number of valid error codes.   */
 } EVEL_ERR_CODES;
 
@@ -110,8 +113,8 @@ typedef enum {
 static const int EVEL_MEASUREMENT_INTERVAL_UKNOWN = 0;
 
 /**************************************************************************//**
- * How many events can be backed-up before we start dropping events on the
- * floor.
+ * How many events of each priority can be backed-up before we start dropping
+ * events on the floor, unless set by ::evel_initialize_ext.
  *
  * @note  This value should be tuned in accordance with expected burstiness of
  *        the event load and the expected response time of the ECOMP event
@@ -145,6 +148,188 @@ typedef enum {
   EVEL_MAX_DOMAINS            /** Maximum number of recognized Event types.  */
 } EVEL_EVENT_DOMAINS;
 
+/**************************************************************************//**
+ * Fields which the Event Listener can ask for throttling to suppress, either
+ * as field names or as fields holding name-value pairs.  Each has a fixed ID
+ * so that suppression can be tested without looking up the name.
+ * JSON equivalent field: suppressedFieldNames, nvPairFieldName
+ *****************************************************************************/
+typedef enum {
+  EVEL_FIELD_ADDITIONAL_FIELDS,          /** additionalFields               */
+  EVEL_FIELD_ADDITIONAL_INFORMATION,     /** additionalInformation          */
+  EVEL_FIELD_ADDITIONAL_MEASUREMENTS,    /** additionalMeasurements         */
+  EVEL_FIELD_ALARM_ADDITIONAL_INFORMATION,/** alarmAdditionalInformation    */
+  EVEL_FIELD_ALARM_INTERFACE_A,          /** alarmInterfaceA                */
+  EVEL_FIELD_APP_PROTOCOL_TYPE,          /** appProtocolType                */
+  EVEL_FIELD_APP_PROTOCOL_VERSION,       /** appProtocolVersion             */
+  EVEL_FIELD_APPLICATION_TYPE,           /** applicationType                */
+  EVEL_FIELD_CID,                        /** cid                            */
+  EVEL_FIELD_CODEC_USAGE_ARRAY,          /** codecUsageArray                */
+  EVEL_FIELD_COMPRESSED_SIP,             /** compressedSip                  */
+  EVEL_FIELD_CONCURRENT_SESSIONS,        /** concurrentSessions             */
+  EVEL_FIELD_CONFIGURED_ENTITIES,        /** configuredEntities             */
+  EVEL_FIELD_CONNECTION_TYPE,            /** connectionType                 */
+  EVEL_FIELD_CORRELATOR,                 /** correlator                     */
+  EVEL_FIELD_CPU_IDLE,                   /** cpuIdle                        */
+  EVEL_FIELD_CPU_USAGE_ARRAY,            /** cpuUsageArray                  */
+  EVEL_FIELD_CPU_USAGE_INTERRUPT,        /** cpuUsageInterrupt              */
+  EVEL_FIELD_CPU_USAGE_NICE,             /** cpuUsageNice                   */
+  EVEL_FIELD_CPU_USAGE_SOFT_IRQ,         /** cpuUsageSoftIrq                */
+  EVEL_FIELD_CPU_USAGE_STEAL,            /** cpuUsageSteal                  */
+  EVEL_FIELD_CPU_USAGE_SYSTEM,           /** cpuUsageSystem                 */
+  EVEL_FIELD_CPU_USAGE_USER,             /** cpuUsageUser                   */
+  EVEL_FIELD_CPU_WAIT,                   /** cpuWait                        */
+  EVEL_FIELD_DISK_IO_TIME_AVG,           /** diskIoTimeAvg                  */
+  EVEL_FIELD_DISK_IO_TIME_LAST,          /** diskIoTimeLast                 */
+  EVEL_FIELD_DISK_IO_TIME_MAX,           /** diskIoTimeMax                  */
+  EVEL_FIELD_DISK_IO_TIME_MIN,           /** diskIoTimeMin                  */
+  EVEL_FIELD_DISK_MERGED_READ_AVG,       /** diskMergedReadAvg              */
+  EVEL_FIELD_DISK_MERGED_READ_LAST,      /** diskMergedReadLast             */
+  EVEL_FIELD_DISK_MERGED_READ_MAX,       /** diskMergedReadMax              */
+  EVEL_FIELD_DISK_MERGED_READ_MIN,       /** diskMergedReadMin              */
+  EVEL_FIELD_DISK_MERGED_WRITE_AVG,      /** diskMergedWriteAvg             */
+  EVEL_FIELD_DISK_MERGED_WRITE_LAST,     /** diskMergedWriteLast            */
+  EVEL_FIELD_DISK_MERGED_WRITE_MAX,      /** diskMergedWriteMax             */
+  EVEL_FIELD_DISK_MERGED_WRITE_MIN,      /** diskMergedWriteMin             */
+  EVEL_FIELD_DISK_OCTETS_READ_AVG,       /** diskOctetsReadAvg              */
+  EVEL_FIELD_DISK_OCTETS_READ_LAST,      /** diskOctetsReadLast             */
+  EVEL_FIELD_DISK_OCTETS_READ_MAX,       /** diskOctetsReadMax              */
+  EVEL_FIELD_DISK_OCTETS_READ_MIN,       /** diskOctetsReadMin              */
+  EVEL_FIELD_DISK_OCTETS_WRITE_AVG,      /** diskOctetsWriteAvg             */
+  EVEL_FIELD_DISK_OCTETS_WRITE_LAST,     /** diskOctetsWriteLast            */
+  EVEL_FIELD_DISK_OCTETS_WRITE_MAX,      /** diskOctetsWriteMax             */
+  EVEL_FIELD_DISK_OCTETS_WRITE_MIN,      /** diskOctetsWriteMin             */
+  EVEL_FIELD_DISK_OPS_READ_AVG,          /** diskOpsReadAvg                 */
+  EVEL_FIELD_DISK_OPS_READ_LAST,         /** diskOpsReadLast                */
+  EVEL_FIELD_DISK_OPS_READ_MAX,          /** diskOpsReadMax                 */
+  EVEL_FIELD_DISK_OPS_READ_MIN,          /** diskOpsReadMin                 */
+  EVEL_FIELD_DISK_OPS_WRITE_AVG,         /** diskOpsWriteAvg                */
+  EVEL_FIELD_DISK_OPS_WRITE_LAST,        /** diskOpsWriteLast               */
+  EVEL_FIELD_DISK_OPS_WRITE_MAX,         /** diskOpsWriteMax                */
+  EVEL_FIELD_DISK_OPS_WRITE_MIN,         /** diskOpsWriteMin                */
+  EVEL_FIELD_DISK_PENDING_OPERATIONS_AVG,/** diskPendingOperationsAvg       */
+  EVEL_FIELD_DISK_PENDING_OPERATIONS_LAST,/** diskPendingOperationsLast     */
+  EVEL_FIELD_DISK_PENDING_OPERATIONS_MAX,/** diskPendingOperationsMax       */
+  EVEL_FIELD_DISK_PENDING_OPERATIONS_MIN,/** diskPendingOperationsMin       */
+  EVEL_FIELD_DISK_TIME_READ_AVG,         /** diskTimeReadAvg                */
+  EVEL_FIELD_DISK_TIME_READ_LAST,        /** diskTimeReadLast               */
+  EVEL_FIELD_DISK_TIME_READ_MAX,         /** diskTimeReadMax                */
+  EVEL_FIELD_DISK_TIME_READ_MIN,         /** diskTimeReadMin                */
+  EVEL_FIELD_DISK_TIME_WRITE_AVG,        /** diskTimeWriteAvg               */
+  EVEL_FIELD_DISK_TIME_WRITE_LAST,       /** diskTimeWriteLast              */
+  EVEL_FIELD_DISK_TIME_WRITE_MAX,        /** diskTimeWriteMax               */
+  EVEL_FIELD_DISK_TIME_WRITE_MIN,        /** diskTimeWriteMin               */
+  EVEL_FIELD_DISK_USAGE_ARRAY,           /** diskUsageArray                 */
+  EVEL_FIELD_DUR_CONNECTION_FAILED_STATUS,/** durConnectionFailedStatus     */
+  EVEL_FIELD_DUR_TUNNEL_FAILED_STATUS,   /** durTunnelFailedStatus          */
+  EVEL_FIELD_ECGI,                       /** ecgi                           */
+  EVEL_FIELD_END_OF_CALL_VQM_SUMMARIES,  /** endOfCallVqmSummaries          */
+  EVEL_FIELD_ENDPOINT_JITTER,            /** endpointJitter                 */
+  EVEL_FIELD_ENDPOINT_RTP_OCTETS_DISCARDED,/** endpointRtpOctetsDiscarded   */
+  EVEL_FIELD_ENDPOINT_RTP_OCTETS_RECEIVED,/** endpointRtpOctetsReceived     */
+  EVEL_FIELD_ENDPOINT_RTP_OCTETS_SENT,   /** endpointRtpOctetsSent          */
+  EVEL_FIELD_ENDPOINT_RTP_PACKETS_DISCARDED,/** endpointRtpPacketsDiscarded */
+  EVEL_FIELD_ENDPOINT_RTP_PACKETS_RECEIVED,/** endpointRtpPacketsReceived   */
+  EVEL_FIELD_ENDPOINT_RTP_PACKETS_SENT,  /** endpointRtpPacketsSent         */
+  EVEL_FIELD_ERRORS,                     /** errors                         */
+  EVEL_FIELD_EVENT_CATEGORY,             /** eventCategory                  */
+  EVEL_FIELD_EVENT_SOURCE_HOST,          /** eventSourceHost                */
+  EVEL_FIELD_EVENT_TYPE,                 /** eventType                      */
+  EVEL_FIELD_FEATURE_USAGE_ARRAY,        /** featureUsageArray              */
+  EVEL_FIELD_FILESYSTEM_USAGE_ARRAY,     /** filesystemUsageArray           */
+  EVEL_FIELD_FLOW_ACTIVATED_BY,          /** flowActivatedBy                */
+  EVEL_FIELD_FLOW_ACTIVATION_TIME,       /** flowActivationTime             */
+  EVEL_FIELD_FLOW_DEACTIVATED_BY,        /** flowDeactivatedBy              */
+  EVEL_FIELD_GTP_CONNECTION_STATUS,      /** gtpConnectionStatus            */
+  EVEL_FIELD_GTP_PROTOCOL_TYPE,          /** gtpProtocolType                */
+  EVEL_FIELD_GTP_TUNNEL_STATUS,          /** gtpTunnelStatus                */
+  EVEL_FIELD_GTP_VERSION,                /** gtpVersion                     */
+  EVEL_FIELD_HASH_OF_NAME_VALUE_PAIR_ARRAYS,/** hashOfNameValuePairArrays   */
+  EVEL_FIELD_HIGH_END_OF_LATENCY_BUCKET, /** highEndOfLatencyBucket         */
+  EVEL_FIELD_HTTP_HEADER,                /** httpHeader                     */
+  EVEL_FIELD_IMEI,                       /** imei                           */
+  EVEL_FIELD_IMSI,                       /** imsi                           */
+  EVEL_FIELD_JSON_OBJECTS,               /** jsonObjects                    */
+  EVEL_FIELD_KEY_ORDER,                  /** keyOrder                       */
+  EVEL_FIELD_KEY_VALUE,                  /** keyValue                       */
+  EVEL_FIELD_LAC,                        /** lac                            */
+  EVEL_FIELD_LARGE_PACKET_RTT,           /** largePacketRtt                 */
+  EVEL_FIELD_LARGE_PACKET_THRESHOLD,     /** largePacketThreshold           */
+  EVEL_FIELD_LATENCY_DISTRIBUTION,       /** latencyDistribution            */
+  EVEL_FIELD_LOCAL_IP_ADDRESS,           /** localIpAddress                 */
+  EVEL_FIELD_LOCAL_JITTER,               /** localJitter                    */
+  EVEL_FIELD_LOCAL_PORT,                 /** localPort                      */
+  EVEL_FIELD_LOCAL_RTP_OCTETS_DISCARDED, /** localRtpOctetsDiscarded        */
+  EVEL_FIELD_LOCAL_RTP_OCTETS_RECEIVED,  /** localRtpOctetsReceived         */
+  EVEL_FIELD_LOCAL_RTP_OCTETS_SENT,      /** localRtpOctetsSent             */
+  EVEL_FIELD_LOCAL_RTP_PACKETS_DISCARDED,/** localRtpPacketsDiscarded       */
+  EVEL_FIELD_LOCAL_RTP_PACKETS_RECEIVED, /** localRtpPacketsReceived        */
+  EVEL_FIELD_LOCAL_RTP_PACKETS_SENT,     /** localRtpPacketsSent            */
+  EVEL_FIELD_LOW_END_OF_LATENCY_BUCKET,  /** lowEndOfLatencyBucket          */
+  EVEL_FIELD_MAX_RECEIVE_BIT_RATE,       /** maxReceiveBitRate              */
+  EVEL_FIELD_MAX_TRANSMIT_BIT_RATE,      /** maxTransmitBitRate             */
+  EVEL_FIELD_MCC,                        /** mcc                            */
+  EVEL_FIELD_MEAN_REQUEST_LATENCY,       /** meanRequestLatency             */
+  EVEL_FIELD_MEASUREMENTS,               /** measurements                   */
+  EVEL_FIELD_MEMORY_CACHED,              /** memoryCached                   */
+  EVEL_FIELD_MEMORY_CONFIGURED,          /** memoryConfigured               */
+  EVEL_FIELD_MEMORY_FREE,                /** memoryFree                     */
+  EVEL_FIELD_MEMORY_SLAB_RECL,           /** memorySlabRecl                 */
+  EVEL_FIELD_MEMORY_SLAB_UNRECL,         /** memorySlabUnrecl               */
+  EVEL_FIELD_MEMORY_USAGE_ARRAY,         /** memoryUsageArray               */
+  EVEL_FIELD_MEMORY_USED,                /** memoryUsed                     */
+  EVEL_FIELD_MNC,                        /** mnc                            */
+  EVEL_FIELD_MOS_CQE,                    /** mosCqe                         */
+  EVEL_FIELD_MSISDN,                     /** msisdn                         */
+  EVEL_FIELD_NAME_VALUE_PAIRS,           /** nameValuePairs                 */
+  EVEL_FIELD_NF_NAMING_CODE,             /** nfNamingCode                   */
+  EVEL_FIELD_NF_SUBSCRIBED_OBJECT_NAME,  /** nfSubscribedObjectName         */
+  EVEL_FIELD_NF_SUBSCRIPTION_ID,         /** nfSubscriptionId               */
+  EVEL_FIELD_NFC_NAMING_CODE,            /** nfcNamingCode                  */
+  EVEL_FIELD_NUM_GTP_ECHO_FAILURES,      /** numGtpEchoFailures             */
+  EVEL_FIELD_NUM_GTP_TUNNEL_ERRORS,      /** numGtpTunnelErrors             */
+  EVEL_FIELD_NUM_HTTP_ERRORS,            /** numHttpErrors                  */
+  EVEL_FIELD_NUMBER_OF_MEDIA_PORTS_IN_USE,/** numberOfMediaPortsInUse       */
+  EVEL_FIELD_OBJECT_INSTANCES,           /** objectInstances                */
+  EVEL_FIELD_OBJECT_KEYS,                /** objectKeys                     */
+  EVEL_FIELD_OBJECT_SCHEMA,              /** objectSchema                   */
+  EVEL_FIELD_OBJECT_SCHEMA_URL,          /** objectSchemaUrl                */
+  EVEL_FIELD_OTHER_FUNCTIONAL_ROLE,      /** otherFunctionalRole            */
+  EVEL_FIELD_PACKET_LOSS_PERCENT,        /** packetLossPercent              */
+  EVEL_FIELD_PACKETS_LOST,               /** packetsLost                    */
+  EVEL_FIELD_PHONE_NUMBER,               /** phoneNumber                    */
+  EVEL_FIELD_R_FACTOR,                   /** rFactor                        */
+  EVEL_FIELD_RAC,                        /** rac                            */
+  EVEL_FIELD_RADIO_ACCESS_TECHNOLOGY,    /** radioAccessTechnology          */
+  EVEL_FIELD_REMOTE_IP_ADDRESS,          /** remoteIpAddress                */
+  EVEL_FIELD_REMOTE_PORT,                /** remotePort                     */
+  EVEL_FIELD_REPORTING_ENTITY_ID,        /** reportingEntityId              */
+  EVEL_FIELD_REQUEST_RATE,               /** requestRate                    */
+  EVEL_FIELD_ROUND_TRIP_DELAY,           /** roundTripDelay                 */
+  EVEL_FIELD_SAC,                        /** sac                            */
+  EVEL_FIELD_SAMPLING_ALGORITHM,         /** samplingAlgorithm              */
+  EVEL_FIELD_SOURCE_ID,                  /** sourceId                       */
+  EVEL_FIELD_SUMMARY_SIP,                /** summarySip                     */
+  EVEL_FIELD_SYSLOG_FACILITY,            /** syslogFacility                 */
+  EVEL_FIELD_SYSLOG_PRI,                 /** syslogPri                      */
+  EVEL_FIELD_SYSLOG_PROC,                /** syslogProc                     */
+  EVEL_FIELD_SYSLOG_PROC_ID,             /** syslogProcId                   */
+  EVEL_FIELD_SYSLOG_S_DATA,              /** syslogSData                    */
+  EVEL_FIELD_SYSLOG_SD_ID,               /** syslogSdId                     */
+  EVEL_FIELD_SYSLOG_SEV,                 /** syslogSev                      */
+  EVEL_FIELD_SYSLOG_VER,                 /** syslogVer                      */
+  EVEL_FIELD_TAC,                        /** tac                            */
+  EVEL_FIELD_TUNNEL_ID,                  /** tunnelId                       */
+  EVEL_FIELD_V_NIC_PERFORMANCE_ARRAY,    /** vNicPerformanceArray           */
+  EVEL_FIELD_V_NIC_USAGE_ARRAY,          /** vNicUsageArray                 */
+  EVEL_FIELD_VERSION,                    /** version                        */
+  EVEL_FIELD_VF_MODULE_NAME,             /** vfModuleName                   */
+  EVEL_FIELD_VLAN_ID,                    /** vlanId                         */
+  EVEL_FIELD_VNF_NAME,                   /** vnfName                        */
+  EVEL_FIELD_VNFC_SCALING_METRIC,        /** vnfcScalingMetric              */
+  EVEL_MAX_THROTTLE_FIELDS               /** Maximum number of known fields. */
+} EVEL_THROTTLE_FIELDS;
+
 /**************************************************************************//**
  * Event priorities.
  * JSON equivalent field: priority
@@ -428,7 +613,9 @@ typedef struct event_header {
   int minor_version;
 
   /***************************************************************************/
-  /* Mandatory fields                                                        */
+  /* Mandatory fields.  The source name and reporting entity name are NULL   */
+  /* while they have their default, the VM name from the metadata, and the   */
+  /* event id is NULL while it is the sequence number.                       */
   /***************************************************************************/
   EVEL_EVENT_DOMAINS event_domain;
   char * event_id;
@@ -441,7 +628,8 @@ typedef struct event_header {
   int sequence;
 
   /***************************************************************************/
-  /* Optional fields                                                         */
+  /* Optional fields.  The source id and reporting entity id are unset while */
+  /* they have their default, the VM UUID from the metadata.                 */
   /***************************************************************************/
   EVEL_OPTION_STRING event_type;
   EVEL_OPTION_STRING source_id;
@@ -450,6 +638,24 @@ typedef struct event_header {
   EVEL_OPTION_STRING nfcnaming_code;
   EVEL_OPTION_STRING nfnaming_code;
 
+  /***************************************************************************/
+  /* The arena the event and everything it owns is allocated from, or NULL   */
+  /* if each part is allocated separately.                                   */
+  /***************************************************************************/
+  ARENA * arena;
+
+  /***************************************************************************/
+  /* While the event is queued, the entry through which a newer event from   */
+  /* the same source may replace it, or NULL.                                */
+  /***************************************************************************/
+  struct evel_coalesce_entry * coalesce;
+
+  /***************************************************************************/
+  /* Bytes of memory the event owns, counted against the memory budget of    */
+  /* the queues while it is queued.                                          */
+  /***************************************************************************/
+  size_t size;
+
 } EVENT_HEADER;
 
 /*****************************************************************************/
@@ -1167,7 +1373,7 @@ typedef struct event_other {
   int major_version;
   int minor_version;
 
-  HASHTABLE_T *namedarrays; /* HASHTABLE_T */
+  HASH_MAP namedarrays; /* HASH_MAP of DLIST of OTHER_FIELD */
   DLIST jsonobjects; /* DLIST of EVEL_JSON_OBJECT */
   DLIST namedvalues;
 } EVENT_OTHER;
@@ -1385,6 +1591,57 @@ EVEL_ERR_CODES evel_initialize(const char * const fqdn,
                                int verbosity
                                );
 
+/**************************************************************************//**
+ * Further options to ::evel_initialize_ext.
+ *****************************************************************************/
+typedef struct evel_init_options {
+  int queue_depth;                  /** Events each priority queue holds.   */
+  size_t queue_max_bytes;           /** Memory the queued events may use.   */
+} EVEL_INIT_OPTIONS;
+
+/**************************************************************************//**
+ * Library initialization, with further options.
+ *
+ * As ::evel_initialize, but also sets the limits on the events waiting to be
+ * sent.  Each priority has a queue holding up to the queue depth in events,
+ * rounded up to a power of two, which is ::EVEL_EVENT_BUFFER_DEPTH unless
+ * set.  With a memory budget, an event is also only queued if the memory
+ * owned by the events already queued, of every priority, leaves room for
+ * it, so that a few huge events can't use up all the memory while a burst
+ * of small ones still fits.  An event which doesn't fit in its queue or the
+ * budget is handled according to the overflow policy of its domain.
+ *
+ * @param   fqdn    The API's FQDN or IP address.
+ * @param   port    The API's port.
+ * @param   path    The optional path (may be NULL).
+ * @param   topic   The optional topic part of the URL (may be NULL).
+ * @param   secure  Whether to use HTTPS (0=HTTP, 1=HTTPS).
+ * @param   username  Username for Basic Authentication of requests.
+ * @param   password  Password for Basic Authentication of requests.
+ * @param   source_type The kind of node we represent.
+ * @param   role    The role this node undertakes.
+ * @param   verbosity  0 for normal operation, positive values for chattier
+ *                     logs.
+ * @param   options    The further options, or NULL for the defaults.  A
+ *                     queue_depth of 0 leaves the default, and a
+ *                     queue_max_bytes of 0 means no memory budget.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      On success
+ * @retval  ::EVEL_ERR_CODES  On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_initialize_ext(const char * const fqdn,
+                                   int port,
+                                   const char * const path,
+                                   const char * const topic,
+                                   int secure,
+                                   const char * const username,
+                                   const char * const password,
+                                   EVEL_SOURCE_TYPES source_type,
+                                   const char * const role,
+                                   int verbosity,
+                                   const EVEL_INIT_OPTIONS * const options);
+
 /**************************************************************************//**
  * Clean up the EVEL library.
  *
@@ -1396,9 +1653,44 @@ EVEL_ERR_CODES evel_initialize(const char * const fqdn,
  *****************************************************************************/
 EVEL_ERR_CODES evel_terminate(void);
 
+/**************************************************************************//**
+ * Set how long ::evel_terminate keeps sending the events still queued.
+ *
+ * By default ::evel_terminate only waits for the posts already in flight,
+ * and drops the events still queued.  Given a timeout, it keeps sending
+ * until the queues are empty, as ::evel_flush does, and returns within the
+ * timeout regardless: posts still in flight when the time is up are
+ * abandoned, and they and any posts waiting to be retried are spooled, if
+ * there's a spool (see ::evel_set_spool), or dropped.
+ *
+ * @param timeout_ms  The longest time to keep sending, in milliseconds, or 0
+ *                    to drop the events.  Must be >= 0.
+ *****************************************************************************/
+void evel_set_terminate_timeout(const int timeout_ms);
+
 EVEL_ERR_CODES evel_post_event(EVENT_HEADER * event);
 const char * evel_error_string(void);
 
+/**************************************************************************//**
+ * Wait for the events already posted to be sent.
+ *
+ * Returns once the queues are empty and the posts of the events taken from
+ * them have completed, including any retries, or the timeout passes.  Events
+ * posted by other threads while waiting also have to be sent, so if they
+ * keep coming the flush may time out.  A post which fails for good counts
+ * as completed, so success means that nothing is left to send rather than
+ * that every event was delivered.
+ *
+ * @param timeout_ms  How long to wait, in milliseconds, or 0 not to wait, or
+ *                    -1 to wait indefinitely.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_FLUSH_TIMEOUT Events were still being sent at the timeout.
+ * @retval  EVEL_EVENT_HANDLER_INACTIVE The event handler isn't running.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_flush(const int timeout_ms);
+
 
 /**************************************************************************//**
  * Free an event.
@@ -1409,6 +1701,60 @@ const char * evel_error_string(void);
  *****************************************************************************/
 void evel_free_event(void * event);
 
+/**************************************************************************//**
+ * Set the size of the arena each new event is built in.
+ *
+ * With a size of 0, the default, every part of an event is allocated with
+ * its own malloc() and freed one by one by ::evel_free_event.  Otherwise
+ * each new event gets an arena whose first chunk is @p size bytes, the event
+ * and everything it owns are taken from the arena, and freeing the event
+ * releases the arena in one go.  Later chunks double in size, so @p size
+ * only needs to cover a typical event.
+ *
+ * The size applies to events created after the call.
+ *
+ * @param size      Size of the first chunk of each event's arena in bytes,
+ *                  or 0 to allocate events without arenas.
+ *****************************************************************************/
+void evel_set_event_arena_size(const int size);
+
+/**************************************************************************//**
+ * Set how many freed event structures are kept for reuse.
+ *
+ * ::evel_free_event keeps the structure of a freed event (or its arena, if
+ * the event was built in one) in a pool for its domain, and the next event
+ * created in that domain reuses it instead of allocating.  Each thread has
+ * its own pools of up to @p thread_limit structures per domain, so that the
+ * common case takes no lock; beyond that, up to @p shared_limit structures
+ * per domain are kept in a pool shared by all threads, which is how events
+ * freed by the library after posting get back to the threads raising them.
+ * Structures beyond both limits are freed.
+ *
+ * The defaults are 16 per thread and 64 shared.  A @p thread_limit of 0
+ * stops structures from being pooled.
+ *
+ * @param thread_limit  Structures kept per domain by each thread.
+ * @param shared_limit  Structures kept per domain in the shared pool.
+ *****************************************************************************/
+void evel_set_event_pool_limits(const int thread_limit, const int shared_limit);
+
+/**************************************************************************//**
+ * Set how many event sequence numbers each thread reserves at a time.
+ *
+ * Every event takes the next number from a sequence shared by all threads,
+ * which is also its eventId.  Where many threads raise events at a high rate
+ * they contend on the shared counter; with a block size of @p size, each
+ * thread instead reserves @p size numbers at once and hands them out to its
+ * own events.  Numbers remain unique, but events from different threads are
+ * no longer numbered in the order they were created, and numbers left in a
+ * thread's block when it stops raising events are never used.
+ *
+ * The default is 0, taking every number from the shared counter.
+ *
+ * @param size          Numbers reserved by each thread at a time, or 0.
+ *****************************************************************************/
+void evel_set_event_sequence_block(const int size);
+
 /**************************************************************************//**
  * Encode the event as a JSON event object according to AT&T's schema.
  *
@@ -1434,6 +1780,487 @@ size_t evel_write_callback(void *contents,
                            size_t nmemb,
                            void *userp);
 
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   EVENT POSTING                                                           */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Default batching limits.  A limit of one event per post disables batching */
+/* so that each event is posted on its own, as it always has been.           */
+/*****************************************************************************/
+#define EVEL_BATCH_DEFAULT_MAX_EVENTS   1
+#define EVEL_BATCH_DEFAULT_MAX_BYTES    EVEL_MAX_JSON_BODY
+#define EVEL_BATCH_DEFAULT_MAX_WAIT_MS  0
+
+/*****************************************************************************/
+/* Number of buckets in the batch size histogram.                            */
+/*****************************************************************************/
+#define EVEL_BATCH_SIZE_BUCKETS 8
+
+/**************************************************************************//**
+ * Batch statistics.
+ *
+ * Bucket n of the size histogram counts the batches which held between 2^n
+ * and 2^(n+1) - 1 events.  The last bucket also counts all larger batches.
+ *****************************************************************************/
+typedef struct evel_batch_stats {
+  unsigned long long batches;     /** Number of eventList posts made.        */
+  unsigned long long events;      /** Number of events in those posts.       */
+  unsigned long long bytes;       /** Number of body bytes in those posts.   */
+  int largest_batch;              /** Most events seen in a single post.     */
+  unsigned long long size_histogram[EVEL_BATCH_SIZE_BUCKETS];
+} EVEL_BATCH_STATS;
+
+/**************************************************************************//**
+ * Set the limits used to batch events into a single eventList post.
+ *
+ * The event handler collects queued events into one post to the batch API
+ * until it holds @p max_events events, adding the next event would take the
+ * body beyond @p max_bytes, or @p max_wait_ms milliseconds have passed since
+ * the first event of the batch was taken from the queue.  A single event
+ * which is larger than @p max_bytes is still posted, on its own.
+ *
+ * Setting @p max_events to 1 disables batching, so that every event is
+ * posted singly to the event API.  This is the default.
+ *
+ * The limits may be changed at any time and apply from the next batch.
+ *
+ * @param max_events    Maximum number of events in a post.  Must be >= 1.
+ * @param max_bytes     Maximum size of a post body in bytes.  Must be > 0.
+ * @param max_wait_ms   Maximum time to wait for a batch to fill, in
+ *                      milliseconds.  0 means only take events which are
+ *                      already queued.
+ *****************************************************************************/
+void evel_set_batch_limits(const int max_events,
+                           const int max_bytes,
+                           const int max_wait_ms);
+
+/*****************************************************************************/
+/* Number of posts the event handler keeps in flight at once.  The default   */
+/* of one post at a time keeps events in the order they were raised.         */
+/*****************************************************************************/
+#define EVEL_POST_DEFAULT_WINDOW 1
+#define EVEL_POST_MAX_WINDOW     64
+
+/**************************************************************************//**
+ * Set the number of posts the event handler keeps in flight at once.
+ *
+ * Posts run concurrently over connections which libcurl keeps open between
+ * posts, so raising the window lets throughput follow the listener's
+ * parallelism rather than being limited by the round trip time.  With more
+ * than one post in flight the listener may receive events out of order.
+ *
+ * The window may be changed at any time.
+ *
+ * @param window    Number of posts.  Must be between 1 and
+ *                  ::EVEL_POST_MAX_WINDOW.
+ *****************************************************************************/
+void evel_set_post_window(const int window);
+
+/**************************************************************************//**
+ * Get the batch statistics.
+ *
+ * @param stats     Pointer to the ::EVEL_BATCH_STATS to fill in.
+ *****************************************************************************/
+void evel_get_batch_stats(EVEL_BATCH_STATS * const stats);
+
+/*****************************************************************************/
+/* Default limits on retrying posts which fail.  A post is retried up to the */
+/* maximum number of attempts, with a delay which starts at the base delay   */
+/* and doubles with each attempt up to the maximum delay.                    */
+/*****************************************************************************/
+#define EVEL_RETRY_DEFAULT_MAX_ATTEMPTS   8
+#define EVEL_RETRY_DEFAULT_MAX_BYTES      (4 * 1024 * 1024)
+#define EVEL_RETRY_DEFAULT_BASE_DELAY_MS  500
+#define EVEL_RETRY_DEFAULT_MAX_DELAY_MS   30000
+
+/**************************************************************************//**
+ * Retry statistics.
+ *
+ * A post which is retried more than once is counted each time.  Dropped
+ * posts include those which were never retried, because the listener
+ * rejected them outright or there was no room to queue them.
+ *****************************************************************************/
+typedef struct evel_retry_stats {
+  unsigned long long retried_posts;   /** Number of posts retried.          */
+  unsigned long long retried_events;  /** Number of events in those posts.  */
+  unsigned long long dropped_posts;   /** Number of posts given up on.      */
+  unsigned long long dropped_events;  /** Number of events in those posts.  */
+  int queued_posts;                   /** Posts waiting to be retried.      */
+  int queued_bytes;                   /** Size of the posts waiting.        */
+} EVEL_RETRY_STATS;
+
+/**************************************************************************//**
+ * Set the limits on retrying posts which fail.
+ *
+ * A post which fails to reach the listener, or which the listener answers
+ * with a 408, 429 or 5XX response code, is kept, already encoded, and posted
+ * again after a delay.  The delay doubles with each attempt, from
+ * @p base_delay_ms up to @p max_delay_ms, and a random half of it is
+ * jittered so that clients don't retry in step.  If the listener sends a
+ * Retry-After header with a 429 or 503 response, the post isn't retried any
+ * sooner than it asks.  Posts due for retry are sent before new events.
+ *
+ * A post is dropped once it has been retried @p max_attempts times, or if
+ * queueing it would take the posts waiting to be retried beyond
+ * @p max_bytes.  Setting @p max_attempts to 0 disables retries, so that
+ * failed posts are dropped straight away.  Posts still waiting to be
+ * retried when the library is terminated are dropped.
+ *
+ * The limits may be changed at any time and apply to the next post which
+ * fails.
+ *
+ * @param max_attempts  Maximum number of times to retry a post.  Must be
+ *                      >= 0.
+ * @param max_bytes     Maximum size of the posts waiting to be retried, in
+ *                      bytes.  Must be >= 0.
+ * @param base_delay_ms Delay before the first retry of a post, in
+ *                      milliseconds.  Must be > 0.
+ * @param max_delay_ms  Maximum delay between retries, in milliseconds.  Must
+ *                      be >= @p base_delay_ms.
+ *****************************************************************************/
+void evel_set_retry_limits(const int max_attempts,
+                           const int max_bytes,
+                           const int base_delay_ms,
+                           const int max_delay_ms);
+
+/**************************************************************************//**
+ * Get the retry statistics.
+ *
+ * @param stats     Pointer to the ::EVEL_RETRY_STATS to fill in.
+ *****************************************************************************/
+void evel_get_retry_stats(EVEL_RETRY_STATS * const stats);
+
+/*****************************************************************************/
+/* Default limits on the spool.                                              */
+/*****************************************************************************/
+#define EVEL_SPOOL_DEFAULT_MAX_BYTES      (64 * 1024 * 1024)
+#define EVEL_SPOOL_DEFAULT_MAX_AGE_S      (24 * 60 * 60)
+#define EVEL_SPOOL_DEFAULT_REPLAY_RATE    20
+#define EVEL_SPOOL_MAX_REPLAY_RATE        1000
+
+/**************************************************************************//**
+ * Spool statistics.
+ *
+ * Dropped posts are those which were in the spool for too long, were pushed
+ * out of a full spool, or were rejected by the listener when replayed.
+ *****************************************************************************/
+typedef struct evel_spool_stats {
+  unsigned long long spooled_posts;   /** Number of posts spooled.          */
+  unsigned long long spooled_events;  /** Number of events in those posts.  */
+  unsigned long long replayed_posts;  /** Number of posts replayed.         */
+  unsigned long long replayed_events; /** Number of events in those posts.  */
+  unsigned long long dropped_posts;   /** Number of posts dropped.          */
+  unsigned long long dropped_events;  /** Number of events in those posts.  */
+  int segments;                       /** Segment files in the spool.       */
+  long long bytes;                    /** Size of those files.              */
+} EVEL_SPOOL_STATS;
+
+/**************************************************************************//**
+ * Set up a spool on disk for posts which can't be delivered.
+ *
+ * Without a spool, a post which can't be delivered once it has been retried
+ * as set by ::evel_set_retry_limits is dropped.  With a spool, it is added to
+ * segment files in @p directory, which are mapped into memory, and is replayed
+ * once posts are getting through again.  Posts which are still waiting to be
+ * retried when the library is terminated are spooled too.
+ *
+ * Replay is limited to @p replay_rate posts a second so that the listener
+ * isn't swamped as it recovers.  When events are batched, as set by
+ * ::evel_set_batch_limits, each replayed post gathers as many spooled posts
+ * as fit in one batch.  If a replayed post fails, replay backs off in the
+ * same way as retries, and resumes straight away once any other post gets
+ * through.
+ *
+ * The spool holds at most @p max_bytes of segment files, dropping its oldest
+ * segment when it needs room for a new one, and drops segments once they are
+ * older than @p max_age_s.  The segment files are written so that if the
+ * process stops, the next process to use the same directory replays whatever
+ * was not yet delivered.  Only one process may use a directory at a time.
+ *
+ * This must be called before ::evel_initialize, and the spool is closed by
+ * ::evel_terminate.  Passing a NULL @p directory means no spool, which is the
+ * default.
+ *
+ * @param directory     The directory for the spool, which must exist, or
+ *                      NULL.
+ * @param max_bytes     Maximum size of the spool in bytes.  Must be > 0.
+ *                      A spool smaller than 4 MiB uses segments of a quarter
+ *                      of its size, and a post larger than the whole spool
+ *                      is never spooled.
+ * @param max_age_s     Maximum time a post is kept, in seconds.  Must be > 0.
+ * @param replay_rate   Maximum number of posts replayed each second.  Must
+ *                      be > 0.  Rates above ::EVEL_SPOOL_MAX_REPLAY_RATE
+ *                      are treated as that rate.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_SPOOL_FAIL The directory couldn't be read.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_set_spool(const char * const directory,
+                              const long long max_bytes,
+                              const int max_age_s,
+                              const int replay_rate);
+
+/**************************************************************************//**
+ * Get the spool statistics.
+ *
+ * @param stats     Pointer to the ::EVEL_SPOOL_STATS to fill in.
+ *****************************************************************************/
+void evel_get_spool_stats(EVEL_SPOOL_STATS * const stats);
+
+/*****************************************************************************/
+/* Maximum number of listener endpoints, including the one given to          */
+/* ::evel_initialize.                                                        */
+/*****************************************************************************/
+#define EVEL_MAX_ENDPOINTS                8
+
+/**************************************************************************//**
+ * How posts are spread across the listener endpoints.
+ * JSON equivalent field: n/a
+ *****************************************************************************/
+typedef enum {
+  EVEL_ENDPOINT_PRIMARY_BACKUP,     /** First healthy endpoint in order.    */
+  EVEL_ENDPOINT_ROUND_ROBIN,        /** Each healthy endpoint in turn.      */
+  EVEL_ENDPOINT_LEAST_OUTSTANDING,  /** Healthy endpoint with fewest posts. */
+  EVEL_MAX_ENDPOINT_POLICIES
+} EVEL_ENDPOINT_POLICIES;
+
+/*****************************************************************************/
+/* Default endpoint selection.  An endpoint is taken out of use for the      */
+/* hold down time once the threshold of posts to it have failed in a row.    */
+/*****************************************************************************/
+#define EVEL_ENDPOINT_DEFAULT_POLICY      EVEL_ENDPOINT_PRIMARY_BACKUP
+#define EVEL_ENDPOINT_DEFAULT_THRESHOLD   1
+#define EVEL_ENDPOINT_DEFAULT_HOLD_DOWN_MS 5000
+
+/**************************************************************************//**
+ * Endpoint statistics.
+ *****************************************************************************/
+typedef struct evel_endpoint_stats {
+  unsigned long long posts;           /** Number of posts to the endpoint.  */
+  unsigned long long failures;        /** Number of those which failed.     */
+  unsigned long long hold_downs;      /** Times taken out of use.           */
+  int outstanding;                    /** Posts in flight to the endpoint.  */
+  bool healthy;                       /** Whether the endpoint is in use.   */
+} EVEL_ENDPOINT_STATS;
+
+/**************************************************************************//**
+ * Add a listener endpoint.
+ *
+ * Posts normally go to the endpoint given to ::evel_initialize, which is
+ * endpoint 0.  Endpoints added here are numbered from 1 in the order they
+ * are added and share the path, topic, transport and credentials given to
+ * ::evel_initialize.  How posts are spread across the endpoints is set by
+ * ::evel_set_endpoint_policy.
+ *
+ * This must be called before ::evel_initialize.  The endpoints are forgotten
+ * by ::evel_terminate.
+ *
+ * @param fqdn      The endpoint's FQDN or IP address.
+ * @param port      The endpoint's port.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL There are already ::EVEL_MAX_ENDPOINTS.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_add_endpoint(const char * const fqdn, const int port);
+
+/**************************************************************************//**
+ * Set how posts are spread across the listener endpoints.
+ *
+ * Endpoint health is tracked from the posts themselves: once
+ * @p failure_threshold posts to an endpoint have failed in a row, with the
+ * failures which are worth retrying as set out for ::evel_set_retry_limits,
+ * the endpoint is taken out of use for @p hold_down_ms.  A post which fails
+ * on an endpoint which is then taken out of use is retried straight away on
+ * another endpoint.  After the hold down the next post tests the endpoint
+ * again, and it is taken straight back out of use if that post fails too.
+ * If every endpoint is out of use, posts go to the one which has been out
+ * of use longest.
+ *
+ * The policy may be changed at any time and applies to the next post.
+ *
+ * @param policy            How to pick an endpoint for each post.
+ * @param failure_threshold Number of failures in a row which take an
+ *                          endpoint out of use.  Must be > 0.
+ * @param hold_down_ms      How long an endpoint is kept out of use, in
+ *                          milliseconds.  Must be > 0.
+ *****************************************************************************/
+void evel_set_endpoint_policy(const EVEL_ENDPOINT_POLICIES policy,
+                              const int failure_threshold,
+                              const int hold_down_ms);
+
+/**************************************************************************//**
+ * Get the statistics of a listener endpoint.
+ *
+ * @param endpoint  The number of the endpoint.
+ * @param stats     Pointer to the ::EVEL_ENDPOINT_STATS to fill in.
+ * @returns Whether there is such an endpoint.
+ *****************************************************************************/
+bool evel_get_endpoint_stats(const int endpoint,
+                             EVEL_ENDPOINT_STATS * const stats);
+
+/*****************************************************************************/
+/* Default compression of post bodies: off, and bodies smaller than the      */
+/* minimum size aren't worth compressing when it is on.                      */
+/*****************************************************************************/
+#define EVEL_COMPRESS_DEFAULT_LEVEL       0
+#define EVEL_COMPRESS_DEFAULT_MIN_BYTES   1024
+
+/**************************************************************************//**
+ * Compression statistics.
+ *****************************************************************************/
+typedef struct evel_compress_stats {
+  unsigned long long compressed_posts;  /** Number of posts compressed.     */
+  unsigned long long skipped_posts;     /** Number of posts left as is.     */
+  unsigned long long raw_bytes;         /** Their size before compression.  */
+  unsigned long long compressed_bytes;  /** Their size after compression.   */
+} EVEL_COMPRESS_STATS;
+
+/**************************************************************************//**
+ * Set the compression of post bodies.
+ *
+ * With compression on, post bodies of at least @p min_bytes are compressed
+ * with gzip and sent with Content-Encoding: gzip, which the listener must
+ * accept.  Smaller bodies, and any which don't get smaller, are sent as
+ * they are.  The compression state is kept from one post to the next rather
+ * than set up for each.
+ *
+ * The compression may be changed at any time and applies to the next post.
+ *
+ * @param level     The zlib compression level, from 1 (fastest) to 9
+ *                  (smallest), or 0 for no compression, which is the default.
+ * @param min_bytes Size below which bodies aren't compressed.  Must be >= 0.
+ *****************************************************************************/
+void evel_set_compression(const int level, const int min_bytes);
+
+/**************************************************************************//**
+ * Get the compression statistics.
+ *
+ * @param stats     Pointer to the ::EVEL_COMPRESS_STATS to fill in.
+ *****************************************************************************/
+void evel_get_compress_stats(EVEL_COMPRESS_STATS * const stats);
+
+/**************************************************************************//**
+ * Set whether events are encoded by the threads which post them.
+ *
+ * By default the event handler thread encodes each event as it sends it, so
+ * encoding and network I/O share a single thread.  With producer encoding,
+ * ::evel_post_event encodes the event in the calling thread instead, frees
+ * it straight away, and queues only the JSON, so that encoding is spread
+ * across the threads generating events.  The event is throttled according
+ * to the specification in force when it is posted rather than when it is
+ * sent.
+ *
+ * The setting may be changed at any time and applies to the next post.
+ *
+ * @param enabled   Whether ::evel_post_event encodes the event.  The default
+ *                  is false.
+ *****************************************************************************/
+void evel_set_producer_encoding(const bool enabled);
+
+/**************************************************************************//**
+ * Statistics of the queue of events of one priority.
+ *****************************************************************************/
+typedef struct evel_lane_stats {
+  unsigned long long queued;            /** Number of events queued.        */
+  unsigned long long dropped;           /** Number dropped as it was full.  */
+} EVEL_LANE_STATS;
+
+/**************************************************************************//**
+ * Set how events of each priority are shared out.
+ *
+ * Events wait to be sent in a separate queue for each
+ * ::EVEL_EVENT_PRIORITIES, so that a backlog of events of one priority
+ * doesn't hold up those of a higher one, and only drops events of its own
+ * priority once its queue is full.  By default events are taken strictly
+ * in priority order.  With weights, the queues instead take turns, highest
+ * priority first, with each taking up to its weight of events per turn so
+ * that lower priorities aren't starved.
+ *
+ * The weights may be changed at any time.
+ *
+ * @param weights   Array of ::EVEL_MAX_PRIORITIES weights, indexed by
+ *                  priority, each of which must be >= 1, or NULL for strict
+ *                  priority order.
+ *****************************************************************************/
+void evel_set_priority_weights(const int * const weights);
+
+/**************************************************************************//**
+ * Get the statistics of the queue of events of one priority.
+ *
+ * @param priority  The priority of the events.
+ * @param stats     Pointer to the ::EVEL_LANE_STATS to fill in.
+ *****************************************************************************/
+void evel_get_lane_stats(const EVEL_EVENT_PRIORITIES priority,
+                         EVEL_LANE_STATS * const stats);
+
+/**************************************************************************//**
+ * What happens to an event posted while its queue is full.
+ * JSON equivalent field: n/a
+ *****************************************************************************/
+typedef enum {
+  EVEL_OVERFLOW_DROP_NEWEST,        /** Drop the event being posted.        */
+  EVEL_OVERFLOW_DROP_OLDEST,        /** Drop the oldest queued event.       */
+  EVEL_OVERFLOW_BLOCK,              /** Wait for room, up to a timeout.     */
+  EVEL_OVERFLOW_COALESCE,           /** Replace a queued one from source.   */
+  EVEL_MAX_OVERFLOW_POLICIES
+} EVEL_OVERFLOW_POLICIES;
+
+/**************************************************************************//**
+ * Statistics of one overflow policy.
+ *****************************************************************************/
+typedef struct evel_overflow_stats {
+  unsigned long long overflows;         /** Events posted to a full queue.  */
+  unsigned long long dropped;           /** Of which were dropped.          */
+  unsigned long long replaced;          /** Queued events dropped/replaced. */
+  unsigned long long waited_ms;         /** Time spent waiting for room.    */
+} EVEL_OVERFLOW_STATS;
+
+/**************************************************************************//**
+ * Set what happens to events of a domain posted while their queue is full.
+ *
+ * By default the event being posted is dropped, and ::evel_post_event
+ * returns ::EVEL_EVENT_BUFFER_FULL.  The other policies are:
+ *
+ * - ::EVEL_OVERFLOW_DROP_OLDEST drops the oldest event in the queue to make
+ *   room instead.  Since each priority has its own queue, that is the oldest
+ *   event of the same priority, so more important events are never dropped
+ *   to make room for less important ones.
+ * - ::EVEL_OVERFLOW_BLOCK makes ::evel_post_event wait for room, for up to
+ *   the timeout, before dropping the event.  It should only be used by
+ *   threads which can afford to wait.
+ * - ::EVEL_OVERFLOW_COALESCE replaces an event of the same domain and
+ *   source name which is still queued, so that the newer event is sent in
+ *   its place, or drops the event if there is none.
+ *
+ * The policy may be changed at any time and applies to the next post.
+ *
+ * @param domain      The domain of the events.  Must not be
+ *                    ::EVEL_DOMAIN_INTERNAL.
+ * @param policy      What happens to an event posted while its queue is
+ *                    full.
+ * @param timeout_ms  For ::EVEL_OVERFLOW_BLOCK, the longest time to wait for
+ *                    room, in milliseconds.  Must be >= 0.
+ *****************************************************************************/
+void evel_set_overflow_policy(const EVEL_EVENT_DOMAINS domain,
+                              const EVEL_OVERFLOW_POLICIES policy,
+                              const int timeout_ms);
+
+/**************************************************************************//**
+ * Get the statistics of an overflow policy.
+ *
+ * @param policy    The overflow policy.
+ * @param stats     Pointer to the ::EVEL_OVERFLOW_STATS to fill in.
+ *****************************************************************************/
+void evel_get_overflow_stats(const EVEL_OVERFLOW_POLICIES policy,
+                             EVEL_OVERFLOW_STATS * const stats);
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
@@ -3849,6 +4676,34 @@ void evel_other_field_add(EVENT_OTHER * other,
                           char * name,
                           char * value);
 
+/**************************************************************************//**
+ * Set the number of named arrays expected in the Other.
+ *
+ * The table of named arrays grows as arrays are added, so this is only a
+ * hint which saves it being resized.
+ *
+ * @param other     Pointer to the Other.
+ * @param size      Number of named arrays expected.
+ *****************************************************************************/
+void evel_other_field_set_namedarraysize(EVENT_OTHER * other, const int size);
+
+/**************************************************************************//**
+ * Add a name/value pair to a named array in the Other, creating the array if
+ * this is its first pair.  Arrays are encoded in the order they were created.
+ *
+ * The library takes a copy of the strings so the caller does not have to
+ * preserve values after the function returns.
+ *
+ * @param other     Pointer to the Other.
+ * @param hashname  ASCIIZ string with the array's name.
+ * @param name      ASCIIZ string with the attribute's name.
+ * @param value     ASCIIZ string with the attribute's value.
+ *****************************************************************************/
+void evel_other_field_add_namedarray(EVENT_OTHER * other,
+                                     const char * hashname,
+                                     char * name,
+                                     char * value);
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
@@ -3866,6 +4721,48 @@ void evel_other_field_add(EVENT_OTHER * other,
  *****************************************************************************/
 int evel_get_measurement_interval();
 
+/**************************************************************************//**
+ * Determine whether throttling currently suppresses a field.
+ *
+ * Lets the application skip gathering and setting values which would not be
+ * sent.  This never waits, and may be called from any thread.
+ *
+ * @param domain        The domain of the event being built.
+ * @param field         The field.
+ * @returns true if the field is suppressed, false otherwise.
+ *****************************************************************************/
+bool evel_is_field_suppressed(const EVEL_EVENT_DOMAINS domain,
+                              const EVEL_THROTTLE_FIELDS field);
+
+/**************************************************************************//**
+ * Determine whether throttling currently suppresses a name-value pair.
+ *
+ * Lets the application skip gathering and adding an entry, such as the usage
+ * of one CPU in cpuUsageArray, which would not be sent.  This never waits,
+ * and may be called from any thread.
+ *
+ * @param domain        The domain of the event being built.
+ * @param field         The field holding the name-value pairs.
+ * @param name          The name of the name-value pair.
+ * @returns true if the name-value pair is suppressed, false otherwise.
+ *****************************************************************************/
+bool evel_is_nv_pair_suppressed(const EVEL_EVENT_DOMAINS domain,
+                                const EVEL_THROTTLE_FIELDS field,
+                                const char * const name);
+
+/**************************************************************************//**
+ * Return the throttling generation for a domain.
+ *
+ * The generation changes whenever the Event Listener changes throttling for
+ * the domain, so an application can remember the answers from
+ * ::evel_is_field_suppressed and ::evel_is_nv_pair_suppressed for as long as
+ * the generation it read before asking stays the same.
+ *
+ * @param domain        The domain.
+ * @returns The current generation.
+ *****************************************************************************/
+unsigned long evel_throttle_generation(const EVEL_EVENT_DOMAINS domain);
+
 /*****************************************************************************/
 /* Supported Report version.                                                 */
 /*****************************************************************************/
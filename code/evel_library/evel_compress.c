@@ -0,0 +1,166 @@
+/**************************************************************************//**
+ * @file
+ * Gzip compression of post bodies.
+ *
+ * @note  No thread protection so you will need to use appropriate
+ * synchronization if use spans multiple threads.
+ *
+ * License
+ * -------
+ *
+ * Copyright(c) <2016>, AT&T Intellectual Property.  All other rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:  This product includes
+ *    software developed by the AT&T.
+ * 4. Neither the name of AT&T nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY AT&T INTELLECTUAL PROPERTY ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL AT&T INTELLECTUAL PROPERTY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "evel_compress.h"
+
+/*****************************************************************************/
+/* zlib window bits for the largest window, plus 16 to ask for a gzip        */
+/* wrapper rather than a zlib one.                                           */
+/*****************************************************************************/
+#define EVEL_COMPRESS_GZIP_WINDOW_BITS (15 + 16)
+#define EVEL_COMPRESS_MEM_LEVEL 8
+
+/**************************************************************************//**
+ * Initialize a compressor.
+ *
+ * The zlib stream is set up by the first call to ::evel_compress.
+ *
+ * @param   compressor  Pointer to the compressor to initialize.
+ *****************************************************************************/
+void evel_compressor_initialize(EVEL_COMPRESSOR * const compressor)
+{
+  assert(compressor != NULL);
+
+  memset(&compressor->stream, 0, sizeof(compressor->stream));
+  compressor->level = 0;
+}
+
+/**************************************************************************//**
+ * Compress a body with gzip.
+ *
+ * The compressor's stream is reset rather than set up afresh, unless the
+ * level has changed.  The output buffer is grown, if need be, to the most
+ * that the body can compress to.
+ *
+ * @param   compressor      Pointer to the compressor.
+ * @param   level           The zlib compression level, 1 to 9.
+ * @param   body            The body to compress.
+ * @param   body_size       The size of the body in bytes.
+ * @param   output          Pointer to the output buffer, which may be NULL.
+ * @param   output_capacity Pointer to the size of the output buffer.
+ * @returns The size of the compressed body, or -1 if it couldn't be
+ *          compressed.
+ *****************************************************************************/
+int evel_compress(EVEL_COMPRESSOR * const compressor,
+                  const int level,
+                  const char * const body,
+                  const int body_size,
+                  char ** const output,
+                  int * const output_capacity)
+{
+  char * grown = NULL;
+  uLong bound = 0;
+  int size = -1;
+
+  assert(compressor != NULL);
+  assert((level >= 1) && (level <= 9));
+  assert(body != NULL);
+  assert(body_size >= 0);
+  assert(output != NULL);
+  assert(output_capacity != NULL);
+
+  /***************************************************************************/
+  /* Set up the stream if the level has changed, otherwise reuse it.         */
+  /***************************************************************************/
+  if (compressor->level != level)
+  {
+    evel_compressor_free(compressor);
+    if (deflateInit2(&compressor->stream,
+                     level,
+                     Z_DEFLATED,
+                     EVEL_COMPRESS_GZIP_WINDOW_BITS,
+                     EVEL_COMPRESS_MEM_LEVEL,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      goto exit_label;
+    }
+    compressor->level = level;
+  }
+  else if (deflateReset(&compressor->stream) != Z_OK)
+  {
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Make sure the whole body can be compressed in one go.                   */
+  /***************************************************************************/
+  bound = deflateBound(&compressor->stream, (uLong) body_size);
+  if ((uLong) *output_capacity < bound)
+  {
+    grown = realloc(*output, bound);
+    if (grown == NULL)
+    {
+      goto exit_label;
+    }
+    *output = grown;
+    *output_capacity = (int) bound;
+  }
+
+  compressor->stream.next_in = (Bytef *) body;
+  compressor->stream.avail_in = (uInt) body_size;
+  compressor->stream.next_out = (Bytef *) *output;
+  compressor->stream.avail_out = (uInt) *output_capacity;
+  if (deflate(&compressor->stream, Z_FINISH) == Z_STREAM_END)
+  {
+    size = *output_capacity - (int) compressor->stream.avail_out;
+  }
+
+exit_label:
+  return size;
+}
+
+/**************************************************************************//**
+ * Free the resources held by a compressor, leaving it initialized.
+ *
+ * @param   compressor  Pointer to the compressor.
+ *****************************************************************************/
+void evel_compressor_free(EVEL_COMPRESSOR * const compressor)
+{
+  assert(compressor != NULL);
+
+  if (compressor->level != 0)
+  {
+    deflateEnd(&compressor->stream);
+  }
+  evel_compressor_initialize(compressor);
+}
@@ -1,9 +1,13 @@
-#ifndef HASHTABLE_INCLUDED
-#define HASHTABLE_INCLUDED
+#ifndef EVEL_COMPRESS_INCLUDED
+#define EVEL_COMPRESS_INCLUDED
 
 /**************************************************************************//**
  * @file
- * A simple hashtable.
+ * Gzip compression of post bodies.
+ *
+ * A compressor keeps its zlib stream from one body to the next and only
+ * resets it, so that compressing a body doesn't allocate memory once the
+ * output buffer has grown to fit.
  *
  * @note  No thread protection so you will need to use appropriate
  * synchronization if use spans multiple threads.
@@ -40,19 +44,26 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *****************************************************************************/
 
-typedef struct entry_s {
-	char *key;
-	void *value;
-	struct entry_s *next;
-} ENTRY_T;
+#include <stdbool.h>
+#include <zlib.h>
 
 /**************************************************************************//**
- * Hashtable structure
+ * Compressor structure.  The level is that the stream was set up for, or 0
+ * if it hasn't been set up.
  *****************************************************************************/
+typedef struct evel_compressor
+{
+  z_stream stream;
+  int level;
+} EVEL_COMPRESSOR;
 
-typedef struct hashtable_s {
-	size_t size;
-	struct entry_s **table;	
-} HASHTABLE_T;
+void evel_compressor_initialize(EVEL_COMPRESSOR * const compressor);
+int evel_compress(EVEL_COMPRESSOR * const compressor,
+                  const int level,
+                  const char * const body,
+                  const int body_size,
+                  char ** const output,
+                  int * const output_capacity);
+void evel_compressor_free(EVEL_COMPRESSOR * const compressor);
 
 #endif
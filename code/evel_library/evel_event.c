@@ -40,6 +40,7 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <sys/time.h>
+#include <pthread.h>
 
 #include "evel.h"
 #include "evel_internal.h"
@@ -47,25 +48,422 @@
 #include "metadata.h"
 
 /**************************************************************************//**
- * Unique sequence number for events from this VNF.
+ * Unique sequence number for events from this VNF.  The generation changes
+ * whenever the sequence is reset, so that threads discard their blocks.
  *****************************************************************************/
 static int event_sequence = 1;
+static unsigned int event_sequence_generation = 0;
+
+/**************************************************************************//**
+ * Number of sequence numbers each thread reserves at a time, or 0 to take
+ * each one from ::event_sequence.
+ *****************************************************************************/
+static int event_sequence_block_size = 0;
+
+/**************************************************************************//**
+ * A thread's block of reserved sequence numbers.
+ *****************************************************************************/
+typedef struct evel_sequence_block
+{
+  int next;
+  int end;
+  unsigned int generation;
+} EVEL_SEQUENCE_BLOCK;
+
+static pthread_key_t evel_sequence_key;
+static pthread_once_t evel_sequence_once = PTHREAD_ONCE_INIT;
+
+/**************************************************************************//**
+ * Size of the first chunk of each new event's arena, or 0 for no arenas.
+ *****************************************************************************/
+static int event_arena_size = 0;
+
+/**************************************************************************//**
+ * The commonEventHeader fields whose defaults are the same for every event
+ * from this process.
+ *****************************************************************************/
+typedef enum {
+  EVEL_HEADER_REPORTING_ENTITY_NAME,
+  EVEL_HEADER_SOURCE_NAME,
+  EVEL_HEADER_VERSION,
+  EVEL_HEADER_REPORTING_ENTITY_ID,
+  EVEL_HEADER_SOURCE_ID,
+  EVEL_HEADER_MAX_FRAGMENTS
+} EVEL_HEADER_FRAGMENTS;
+
+/**************************************************************************//**
+ * The header defaults, encoded once per load of the metadata.
+ *
+ * A cache is never changed once published.  When the metadata changes a new
+ * one replaces it, and the old one is kept until termination since an
+ * encoding thread may still be using it.
+ *****************************************************************************/
+typedef struct evel_header_cache
+{
+  unsigned long generation;
+  char * fragments[EVEL_HEADER_MAX_FRAGMENTS];
+  int lengths[EVEL_HEADER_MAX_FRAGMENTS];
+  struct evel_header_cache * retired;
+} EVEL_HEADER_CACHE;
+
+/*****************************************************************************/
+/* Room to encode one header default: the metadata strings are short.        */
+/*****************************************************************************/
+#define EVEL_HEADER_FRAGMENT_SIZE 1024
+
+static EVEL_HEADER_CACHE * evel_header_cache = NULL;
+static pthread_mutex_t evel_header_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static EVEL_HEADER_CACHE * evel_header_cache_get(void);
+static EVEL_HEADER_CACHE * evel_header_cache_build(
+  const unsigned long generation);
+static void evel_header_cache_free(EVEL_HEADER_CACHE * cache);
+static int evel_next_event_sequence(void);
+static void evel_sequence_key_create(void);
+static void evel_json_encode_header_default(
+  EVEL_JSON_BUFFER * jbuf,
+  const EVEL_HEADER_CACHE * const cache,
+  const EVEL_HEADER_FRAGMENTS fragment,
+  const EVEL_THROTTLE_FIELDS field,
+  const char * const key,
+  const char * const value,
+  const bool optional);
 
 /**************************************************************************//**
  * Set the next event_sequence to use.
  *
+ * Any blocks of sequence numbers which threads have reserved are discarded.
+ *
  * @param sequence      The next sequence number to use.
  *****************************************************************************/
 void evel_set_next_event_sequence(const int sequence)
 {
   EVEL_ENTER();
 
-  EVEL_INFO("Setting event sequence to %d, was %d ", sequence, event_sequence);
-  event_sequence = sequence;
+  EVEL_INFO("Setting event sequence to %d, was %d ",
+            sequence,
+            __atomic_load_n(&event_sequence, __ATOMIC_RELAXED));
+  __atomic_store_n(&event_sequence, sequence, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&event_sequence_generation, 1, __ATOMIC_RELEASE);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set how many sequence numbers each thread reserves at a time.
+ *
+ * @param size          Size of each thread's block, or 0 to take every number
+ *                      from the shared counter.
+ *****************************************************************************/
+void evel_set_event_sequence_block(const int size)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(size >= 0);
+
+  __atomic_store_n(&event_sequence_block_size, size, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&event_sequence_generation, 1, __ATOMIC_RELEASE);
+  EVEL_DEBUG("Event sequence block size set to %d", size);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the sequence number for a new event.
+ *
+ * Numbers come straight from the shared counter, or from the calling thread's
+ * block of reserved numbers if blocks are enabled, taking a new block from
+ * the counter when the last is used up or the sequence has been reset.
+ *
+ * @returns The sequence number.
+ *****************************************************************************/
+static int evel_next_event_sequence(void)
+{
+  const int block_size =
+    __atomic_load_n(&event_sequence_block_size, __ATOMIC_RELAXED);
+  unsigned int generation;
+  EVEL_SEQUENCE_BLOCK * block = NULL;
+
+  if (block_size > 1)
+  {
+    pthread_once(&evel_sequence_once, evel_sequence_key_create);
+    block = pthread_getspecific(evel_sequence_key);
+    if (block == NULL)
+    {
+      block = calloc(1, sizeof(EVEL_SEQUENCE_BLOCK));
+      if (block != NULL)
+      {
+        pthread_setspecific(evel_sequence_key, block);
+      }
+    }
+  }
+  if (block == NULL)
+  {
+    return __atomic_fetch_add(&event_sequence, 1, __ATOMIC_RELAXED);
+  }
+
+  generation = __atomic_load_n(&event_sequence_generation, __ATOMIC_ACQUIRE);
+  if ((block->next == block->end) || (block->generation != generation))
+  {
+    block->next = __atomic_fetch_add(&event_sequence,
+                                     block_size,
+                                     __ATOMIC_RELAXED);
+    block->end = block->next + block_size;
+    block->generation = generation;
+  }
+
+  return block->next++;
+}
+
+/**************************************************************************//**
+ * Create the key to each thread's block of sequence numbers.
+ *****************************************************************************/
+static void evel_sequence_key_create(void)
+{
+  pthread_key_create(&evel_sequence_key, free);
+}
+
+/**************************************************************************//**
+ * Set the size of the arena each new event is built in.
+ *
+ * @param size      Size of the first chunk of each event's arena in bytes,
+ *                  or 0 to allocate events without arenas.
+ *****************************************************************************/
+void evel_set_event_arena_size(const int size)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(size >= 0);
+
+  __atomic_store_n(&event_arena_size, size, __ATOMIC_RELAXED);
+  EVEL_DEBUG("Event arena size set to %d", size);
 
   EVEL_EXIT();
 }
 
+/**************************************************************************//**
+ * Allocate a new event structure, in its own arena if arenas are enabled.
+ *
+ * The structure is taken from the domain's pool of freed events if it has
+ * one, and otherwise allocated.
+ *
+ * @param domain        The domain of the event.
+ * @param size          Size of the event structure, which must start with
+ *                      its ::EVENT_HEADER.
+ * @returns Pointer to the zeroed structure, or NULL on failure.
+ *****************************************************************************/
+void * evel_alloc_event(const EVEL_EVENT_DOMAINS domain, const size_t size)
+{
+  const int arena_size = __atomic_load_n(&event_arena_size, __ATOMIC_RELAXED);
+  const size_t first_size = ((size_t) arena_size > size) ?
+                            (size_t) arena_size : size;
+  ARENA * arena = NULL;
+  EVENT_HEADER * header = NULL;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(size >= sizeof(EVENT_HEADER));
+
+  header = evel_event_pool_get(domain, arena_size > 0);
+  if (arena_size > 0)
+  {
+    /*************************************************************************/
+    /* The event itself comes first in its arena.  A pooled arena which is  */
+    /* smaller than the arenas now wanted is discarded.                      */
+    /*************************************************************************/
+    if (header != NULL)
+    {
+      arena = header->arena;
+      if (arena->size < first_size)
+      {
+        arena_destroy(arena);
+        arena = NULL;
+      }
+    }
+    if (arena == NULL)
+    {
+      arena = arena_create(first_size);
+      if (arena == NULL)
+      {
+        header = NULL;
+        goto exit_label;
+      }
+    }
+    header = arena_alloc(arena, size);
+    assert(header != NULL);
+  }
+  else if (header == NULL)
+  {
+    header = malloc(size);
+    if (header == NULL)
+    {
+      goto exit_label;
+    }
+  }
+  memset(header, 0, size);
+  header->arena = arena;
+  header->size = size;
+
+exit_label:
+  EVEL_EXIT();
+  return header;
+}
+
+/**************************************************************************//**
+ * Release the structure of a freed event, returning it to the pools if they
+ * have room.
+ *
+ * An event built in an arena is released along with everything it owns by
+ * resetting the arena.
+ *
+ * @param header        Pointer to the event's ::EVENT_HEADER.
+ * @param domain        The domain of the event.
+ *****************************************************************************/
+void evel_release_event(EVENT_HEADER * const header,
+                        const EVEL_EVENT_DOMAINS domain)
+{
+  ARENA * const arena = header->arena;
+
+  EVEL_ENTER();
+
+  if (arena != NULL)
+  {
+    arena_reset(arena);
+  }
+  if (!evel_event_pool_put(domain, arena != NULL, header))
+  {
+    if (arena != NULL)
+    {
+      arena_destroy(arena);
+    }
+    else
+    {
+      free(header);
+    }
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Allocate memory owned by an event, which counts towards its size.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param size          Number of bytes required.
+ * @returns Pointer to the memory, which is not initialized, or NULL.
+ *****************************************************************************/
+void * evel_event_malloc(EVENT_HEADER * const header, const size_t size)
+{
+  assert(header != NULL);
+
+  header->size += size;
+  return (header->arena != NULL) ? arena_alloc(header->arena, size) :
+                                   malloc(size);
+}
+
+/**************************************************************************//**
+ * Copy a string into memory owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param value         The string to copy.
+ * @returns Pointer to the copy, or NULL.
+ *****************************************************************************/
+char * evel_event_strdup(EVENT_HEADER * const header,
+                         const char * const value)
+{
+  assert(header != NULL);
+
+  header->size += strlen(value) + 1;
+  return (header->arena != NULL) ? arena_strdup(header->arena, value) :
+                                   strdup(value);
+}
+
+/**************************************************************************//**
+ * Free memory owned by an event.  Memory in an event's arena is left to be
+ * released with the arena.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param memory        The memory to free.
+ *****************************************************************************/
+void evel_event_free(EVENT_HEADER * const header, void * const memory)
+{
+  assert(header != NULL);
+
+  if (header->arena == NULL)
+  {
+    free(memory);
+  }
+}
+
+/**************************************************************************//**
+ * Make an event responsible for an object which was allocated before it was
+ * attached to the event, so that the object is released with the event.
+ * Events without arenas release their objects explicitly, so this does
+ * nothing for them.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param destroy       Function which releases the object.
+ * @param object        The object.
+ *****************************************************************************/
+void evel_event_adopt(EVENT_HEADER * const header,
+                      void (*destroy)(void * object),
+                      void * const object)
+{
+  assert(header != NULL);
+
+  if ((header->arena != NULL) &&
+      (!arena_adopt(header->arena, destroy, object)))
+  {
+    log_error_state("Out of memory");
+  }
+}
+
+/**************************************************************************//**
+ * Add an item to the end of a list owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param list          Pointer to the list.
+ * @param item          The item to add.
+ *****************************************************************************/
+void evel_event_list_push(EVENT_HEADER * const header,
+                          DLIST * const list,
+                          void * const item)
+{
+  DLIST_ITEM * element = NULL;
+
+  assert(header != NULL);
+
+  header->size += sizeof(DLIST_ITEM);
+  if (header->arena != NULL)
+  {
+    element = arena_alloc(header->arena, sizeof(DLIST_ITEM));
+    if (element != NULL)
+    {
+      dlist_push_last_element(list, element, item);
+    }
+    else
+    {
+      log_error_state("Out of memory");
+    }
+  }
+  else
+  {
+    dlist_push_last(list, item);
+  }
+}
+
 /**************************************************************************//**
  * Create a new heartbeat event.
  *
@@ -83,13 +481,12 @@ EVENT_HEADER * evel_new_heartbeat()
   /***************************************************************************/
   /* Allocate the header.                                                    */
   /***************************************************************************/
-  heartbeat = malloc(sizeof(EVENT_HEADER));
+  heartbeat = evel_alloc_event(EVEL_DOMAIN_HEARTBEAT, sizeof(EVENT_HEADER));
   if (heartbeat == NULL)
   {
     log_error_state("Out of memory");
     goto exit_label;
   }
-  memset(heartbeat, 0, sizeof(EVENT_HEADER));
 
   /***************************************************************************/
   /* Initialize the header.  Get a new event sequence number.  Note that if  */
@@ -97,7 +494,9 @@ EVENT_HEADER * evel_new_heartbeat()
   /* everything downstream can cope with NULLs.                              */
   /***************************************************************************/
   evel_init_header(heartbeat,"Heartbeat");
-  evel_force_option_string(&heartbeat->event_type, "Autonomous heartbeat");
+  evel_event_force_option_string(heartbeat,
+                                 &heartbeat->event_type,
+                                 "Autonomous heartbeat");
 
 exit_label:
   EVEL_EXIT();
@@ -111,7 +510,6 @@ exit_label:
  *****************************************************************************/
 void evel_init_header(EVENT_HEADER * const header,const char *const eventname)
 {
-  char scratchpad[EVEL_MAX_STRING_LEN + 1] = {0};
   struct timeval tv;
 
   EVEL_ENTER();
@@ -123,33 +521,34 @@ void evel_init_header(EVENT_HEADER * const header,const char *const eventname)
   /***************************************************************************/
   /* Initialize the header.  Get a new event sequence number.  Note that if  */
   /* any memory allocation fails in here we will fail gracefully because     */
-  /* everything downstream can cope with NULLs.                              */
+  /* everything downstream can cope with NULLs.  The event ID is the         */
+  /* sequence number, which is formatted when the event is encoded.          */
   /***************************************************************************/
   header->event_domain = EVEL_DOMAIN_HEARTBEAT;
-  snprintf(scratchpad, EVEL_MAX_STRING_LEN, "%d", event_sequence);
-  header->event_id = strdup(scratchpad);
+  header->event_id = NULL;
   if( eventname == NULL )
-     header->event_name = strdup(functional_role);
+     header->event_name = evel_event_strdup(header, functional_role);
   else
-     header->event_name = strdup(eventname);
+     header->event_name = evel_event_strdup(header, eventname);
   header->last_epoch_microsec = tv.tv_usec + 1000000 * tv.tv_sec;
   header->priority = EVEL_PRIORITY_NORMAL;
-  header->reporting_entity_name = strdup(openstack_vm_name());
-  header->source_name = strdup(openstack_vm_name());
-  header->sequence = event_sequence;
+  header->reporting_entity_name = NULL;
+  header->source_name = NULL;
+  header->coalesce = NULL;
+  header->sequence = evel_next_event_sequence();
   header->start_epoch_microsec = header->last_epoch_microsec;
   header->major_version = EVEL_HEADER_MAJOR_VERSION;
   header->minor_version = EVEL_HEADER_MINOR_VERSION;
-  event_sequence++;
 
   /***************************************************************************/
-  /* Optional parameters.                                                    */
+  /* Optional parameters.  The reporting entity and source are left unset    */
+  /* so that they are encoded from the cached VM name and UUID.              */
   /***************************************************************************/
   evel_init_option_string(&header->event_type);
   evel_init_option_string(&header->nfcnaming_code);
   evel_init_option_string(&header->nfnaming_code);
-  evel_force_option_string(&header->reporting_entity_id, openstack_vm_uuid());
-  evel_force_option_string(&header->source_id, openstack_vm_uuid());
+  evel_init_option_string(&header->reporting_entity_id);
+  evel_init_option_string(&header->source_id);
   evel_init_option_intheader(&header->internal_field);
 
   EVEL_EXIT();
@@ -178,7 +577,7 @@ void evel_header_type_set(EVENT_HEADER * const header,
   assert(header != NULL);
   assert(type != NULL);
 
-  evel_set_option_string(&header->event_type, type, "Event Type");
+  evel_event_set_option_string(header, &header->event_type, type, "Event Type");
 
   EVEL_EXIT();
 }
@@ -245,7 +644,10 @@ void evel_nfcnamingcode_set(EVENT_HEADER * const header,
   /***************************************************************************/
   assert(header != NULL);
   assert(nfcnam != NULL);
-  evel_set_option_string(&header->nfcnaming_code, nfcnam, "NFC Naming Code");
+  evel_event_set_option_string(header,
+                               &header->nfcnaming_code,
+                               nfcnam,
+                               "NFC Naming Code");
 
   EVEL_EXIT();
 }
@@ -266,7 +668,10 @@ void evel_nfnamingcode_set(EVENT_HEADER * const header,
   /***************************************************************************/
   assert(header != NULL);
   assert(nfnam != NULL);
-  evel_set_option_string(&header->nfnaming_code, nfnam, "NF Naming Code");
+  evel_event_set_option_string(header,
+                               &header->nfnaming_code,
+                               nfnam,
+                               "NF Naming Code");
 
   EVEL_EXIT();
 }
@@ -290,14 +695,13 @@ void evel_reporting_entity_name_set(EVENT_HEADER * const header,
   /***************************************************************************/
   assert(header != NULL);
   assert(entity_name != NULL);
-  assert(header->reporting_entity_name != NULL);
 
   /***************************************************************************/
-  /* Free the previously allocated memory and replace it with a copy of the  */
+  /* Free any previously allocated memory and replace it with a copy of the  */
   /* provided one.                                                           */
   /***************************************************************************/
-  free(header->reporting_entity_name);
-  header->reporting_entity_name = strdup(entity_name);
+  evel_event_free(header, header->reporting_entity_name);
+  header->reporting_entity_name = evel_event_strdup(header, entity_name);
 
   EVEL_EXIT();
 }
@@ -323,10 +727,13 @@ void evel_reporting_entity_id_set(EVENT_HEADER * const header,
 
   /***************************************************************************/
   /* Free the previously allocated memory and replace it with a copy of the  */
-  /* provided one.  Note that evel_force_option_string strdups entity_id.    */
+  /* provided one.  Note that evel_event_force_option_string copies         */
+  /* entity_id.                                                              */
   /***************************************************************************/
-  evel_free_option_string(&header->reporting_entity_id);
-  evel_force_option_string(&header->reporting_entity_id, entity_id);
+  evel_event_free_option_string(header, &header->reporting_entity_id);
+  evel_event_force_option_string(header,
+                                 &header->reporting_entity_id,
+                                 entity_id);
 
   EVEL_EXIT();
 }
@@ -342,6 +749,7 @@ void evel_json_encode_header(EVEL_JSON_BUFFER * jbuf,
 {
   char * domain;
   char * priority;
+  EVEL_HEADER_CACHE * cache;
 
   EVEL_ENTER();
 
@@ -355,39 +763,339 @@ void evel_json_encode_header(EVEL_JSON_BUFFER * jbuf,
 
   domain = evel_event_domain(event->event_domain);
   priority = evel_event_priority(event->priority);
+  cache = evel_header_cache_get();
   evel_json_open_named_object(jbuf, "commonEventHeader");
 
   /***************************************************************************/
   /* Mandatory fields.                                                       */
   /***************************************************************************/
   evel_enc_kv_string(jbuf, "domain", domain);
-  evel_enc_kv_string(jbuf, "eventId", event->event_id);
+  if (event->event_id != NULL)
+  {
+    evel_enc_kv_string(jbuf, "eventId", event->event_id);
+  }
+  else
+  {
+    evel_enc_kv_int_string(jbuf, "eventId", event->sequence);
+  }
   evel_enc_kv_string(jbuf, "eventName", event->event_name);
   evel_enc_kv_ull(jbuf, "lastEpochMicrosec", event->last_epoch_microsec);
   evel_enc_kv_string(jbuf, "priority", priority);
-  evel_enc_kv_string(
-    jbuf, "reportingEntityName", event->reporting_entity_name);
+  if (event->reporting_entity_name != NULL)
+  {
+    evel_enc_kv_string(
+      jbuf, "reportingEntityName", event->reporting_entity_name);
+  }
+  else
+  {
+    evel_json_encode_header_default(jbuf,
+                                    cache,
+                                    EVEL_HEADER_REPORTING_ENTITY_NAME,
+                                    EVEL_MAX_THROTTLE_FIELDS,
+                                    "reportingEntityName",
+                                    openstack_vm_name(),
+                                    false);
+  }
   evel_enc_kv_int(jbuf, "sequence", event->sequence);
-  evel_enc_kv_string(jbuf, "sourceName", event->source_name);
+  if (event->source_name != NULL)
+  {
+    evel_enc_kv_string(jbuf, "sourceName", event->source_name);
+  }
+  else
+  {
+    evel_json_encode_header_default(jbuf,
+                                    cache,
+                                    EVEL_HEADER_SOURCE_NAME,
+                                    EVEL_MAX_THROTTLE_FIELDS,
+                                    "sourceName",
+                                    openstack_vm_name(),
+                                    false);
+  }
   evel_enc_kv_ull(jbuf, "startEpochMicrosec", event->start_epoch_microsec);
-  evel_enc_version(
-    jbuf, "version", event->major_version, event->minor_version);
+  if ((cache != NULL) &&
+      (event->major_version == EVEL_HEADER_MAJOR_VERSION) &&
+      (event->minor_version == EVEL_HEADER_MINOR_VERSION))
+  {
+    evel_enc_kv_fragment(jbuf,
+                         EVEL_FIELD_VERSION,
+                         "version",
+                         cache->fragments[EVEL_HEADER_VERSION],
+                         cache->lengths[EVEL_HEADER_VERSION],
+                         false);
+  }
+  else
+  {
+    evel_enc_version(
+      jbuf, "version", event->major_version, event->minor_version);
+  }
 
   /***************************************************************************/
   /* Optional fields.                                                        */
   /***************************************************************************/
-  evel_enc_kv_opt_string(jbuf, "eventType", &event->event_type);
-  evel_enc_kv_opt_string(
-    jbuf, "reportingEntityId", &event->reporting_entity_id);
-  evel_enc_kv_opt_string(jbuf, "sourceId", &event->source_id);
-  evel_enc_kv_opt_string(jbuf, "nfcNamingCode", &event->nfcnaming_code);
-  evel_enc_kv_opt_string(jbuf, "nfNamingCode", &event->nfnaming_code);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_EVENT_TYPE,
+                         "eventType",
+                         &event->event_type);
+  if (event->reporting_entity_id.is_set)
+  {
+    evel_enc_kv_opt_string(jbuf,
+                           EVEL_FIELD_REPORTING_ENTITY_ID,
+                           "reportingEntityId",
+                           &event->reporting_entity_id);
+  }
+  else
+  {
+    evel_json_encode_header_default(jbuf,
+                                    cache,
+                                    EVEL_HEADER_REPORTING_ENTITY_ID,
+                                    EVEL_FIELD_REPORTING_ENTITY_ID,
+                                    "reportingEntityId",
+                                    openstack_vm_uuid(),
+                                    true);
+  }
+  if (event->source_id.is_set)
+  {
+    evel_enc_kv_opt_string(jbuf,
+                           EVEL_FIELD_SOURCE_ID,
+                           "sourceId",
+                           &event->source_id);
+  }
+  else
+  {
+    evel_json_encode_header_default(jbuf,
+                                    cache,
+                                    EVEL_HEADER_SOURCE_ID,
+                                    EVEL_FIELD_SOURCE_ID,
+                                    "sourceId",
+                                    openstack_vm_uuid(),
+                                    true);
+  }
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_NFC_NAMING_CODE,
+                         "nfcNamingCode",
+                         &event->nfcnaming_code);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_NF_NAMING_CODE,
+                         "nfNamingCode",
+                         &event->nfnaming_code);
 
   evel_json_close_object(jbuf);
 
   EVEL_EXIT();
 }
 
+/**************************************************************************//**
+ * Encode a commonEventHeader field which has its default value.
+ *
+ * The cached encoding is used if there is one, otherwise the value is
+ * encoded as normal.
+ *
+ * @param jbuf          Pointer to the ::EVEL_JSON_BUFFER to encode into.
+ * @param cache         Pointer to the ::EVEL_HEADER_CACHE, or NULL.
+ * @param fragment      The field's entry in the cache.
+ * @param field         The field's ::EVEL_THROTTLE_FIELDS, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it can't be suppressed.
+ * @param key           The field's key.
+ * @param value         The field's default value.
+ * @param optional      Whether the field may be suppressed by throttling.
+ *****************************************************************************/
+static void evel_json_encode_header_default(
+  EVEL_JSON_BUFFER * jbuf,
+  const EVEL_HEADER_CACHE * const cache,
+  const EVEL_HEADER_FRAGMENTS fragment,
+  const EVEL_THROTTLE_FIELDS field,
+  const char * const key,
+  const char * const value,
+  const bool optional)
+{
+  EVEL_OPTION_STRING option;
+
+  EVEL_ENTER();
+
+  if (cache != NULL)
+  {
+    evel_enc_kv_fragment(jbuf,
+                         field,
+                         key,
+                         cache->fragments[fragment],
+                         cache->lengths[fragment],
+                         optional);
+  }
+  else if (optional)
+  {
+    option.value = (char *) value;
+    option.is_set = EVEL_TRUE;
+    evel_enc_kv_opt_string(jbuf, field, key, &option);
+  }
+  else
+  {
+    evel_enc_kv_string(jbuf, key, value);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the encodings of the commonEventHeader defaults.
+ *
+ * The encodings are built on first use, and again whenever the metadata has
+ * changed since they were built.
+ *
+ * @returns Pointer to the ::EVEL_HEADER_CACHE, or NULL if it could not be
+ *          built.
+ *****************************************************************************/
+static EVEL_HEADER_CACHE * evel_header_cache_get(void)
+{
+  const unsigned long generation = openstack_metadata_generation();
+  EVEL_HEADER_CACHE * cache;
+  EVEL_HEADER_CACHE * fresh;
+
+  EVEL_ENTER();
+
+  cache = __atomic_load_n(&evel_header_cache, __ATOMIC_ACQUIRE);
+  if ((cache == NULL) || (cache->generation != generation))
+  {
+    /*************************************************************************/
+    /* Only one thread rebuilds the cache; any others wait and then use it.  */
+    /*************************************************************************/
+    pthread_mutex_lock(&evel_header_cache_mutex);
+    cache = evel_header_cache;
+    if ((cache == NULL) || (cache->generation != generation))
+    {
+      fresh = evel_header_cache_build(generation);
+      if (fresh != NULL)
+      {
+        fresh->retired = cache;
+        __atomic_store_n(&evel_header_cache, fresh, __ATOMIC_RELEASE);
+      }
+      cache = fresh;
+    }
+    pthread_mutex_unlock(&evel_header_cache_mutex);
+  }
+
+  EVEL_EXIT();
+
+  return cache;
+}
+
+/**************************************************************************//**
+ * Encode the commonEventHeader defaults.
+ *
+ * @param generation    The metadata generation being encoded.
+ * @returns Pointer to the new ::EVEL_HEADER_CACHE, or NULL on failure.
+ *****************************************************************************/
+static EVEL_HEADER_CACHE * evel_header_cache_build(
+  const unsigned long generation)
+{
+  EVEL_HEADER_CACHE * cache = NULL;
+  EVEL_JSON_BUFFER jbuf;
+  char json[EVEL_HEADER_FRAGMENT_SIZE];
+  int fragment;
+
+  EVEL_ENTER();
+
+  cache = calloc(1, sizeof(EVEL_HEADER_CACHE));
+  if (cache == NULL)
+  {
+    log_error_state("Failed to allocate header cache");
+    goto exit_label;
+  }
+  cache->generation = generation;
+
+  for (fragment = 0; fragment < EVEL_HEADER_MAX_FRAGMENTS; fragment++)
+  {
+    evel_json_buffer_init(&jbuf, json, EVEL_HEADER_FRAGMENT_SIZE, NULL);
+    switch (fragment)
+    {
+      case EVEL_HEADER_REPORTING_ENTITY_NAME:
+        evel_enc_kv_string(&jbuf, "reportingEntityName", openstack_vm_name());
+        break;
+
+      case EVEL_HEADER_SOURCE_NAME:
+        evel_enc_kv_string(&jbuf, "sourceName", openstack_vm_name());
+        break;
+
+      case EVEL_HEADER_VERSION:
+        evel_enc_version(&jbuf,
+                         "version",
+                         EVEL_HEADER_MAJOR_VERSION,
+                         EVEL_HEADER_MINOR_VERSION);
+        break;
+
+      case EVEL_HEADER_REPORTING_ENTITY_ID:
+        evel_enc_kv_string(&jbuf, "reportingEntityId", openstack_vm_uuid());
+        break;
+
+      case EVEL_HEADER_SOURCE_ID:
+        evel_enc_kv_string(&jbuf, "sourceId", openstack_vm_uuid());
+        break;
+    }
+
+    cache->fragments[fragment] = strdup(json);
+    if (cache->fragments[fragment] == NULL)
+    {
+      log_error_state("Failed to allocate header cache fragment");
+      evel_header_cache_free(cache);
+      cache = NULL;
+      goto exit_label;
+    }
+    cache->lengths[fragment] = jbuf.offset;
+  }
+
+exit_label:
+  EVEL_EXIT();
+
+  return cache;
+}
+
+/**************************************************************************//**
+ * Free an ::EVEL_HEADER_CACHE.
+ *
+ * @param cache         Pointer to the ::EVEL_HEADER_CACHE to free.
+ *****************************************************************************/
+static void evel_header_cache_free(EVEL_HEADER_CACHE * cache)
+{
+  int fragment;
+
+  EVEL_ENTER();
+
+  for (fragment = 0; fragment < EVEL_HEADER_MAX_FRAGMENTS; fragment++)
+  {
+    free(cache->fragments[fragment]);
+  }
+  free(cache);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Free the cached encodings of the commonEventHeader defaults.
+ *
+ * Called once encoding has stopped, so that no thread can still be using
+ * them.
+ *****************************************************************************/
+void evel_header_cache_terminate(void)
+{
+  EVEL_HEADER_CACHE * cache;
+  EVEL_HEADER_CACHE * retired;
+
+  EVEL_ENTER();
+
+  pthread_mutex_lock(&evel_header_cache_mutex);
+  cache = evel_header_cache;
+  evel_header_cache = NULL;
+  pthread_mutex_unlock(&evel_header_cache_mutex);
+
+  while (cache != NULL)
+  {
+    retired = cache->retired;
+    evel_header_cache_free(cache);
+    cache = retired;
+  }
+
+  EVEL_EXIT();
+}
+
 /**************************************************************************//**
  * Free an event header.
  *
@@ -425,35 +1133,19 @@ void evel_free_header(EVENT_HEADER * const event)
 }
 
 /**************************************************************************//**
- * Encode the event as a JSON event object according to AT&T's schema.
+ * Encode the domain-specific content of an event into a JSON buffer.
  *
- * @param json      Pointer to where to store the JSON encoded data.
- * @param max_size  Size of storage available in json_body.
+ * This is the common part of encoding a single event and encoding an entry of
+ * an eventList.  The caller opens and closes the enclosing object.
+ *
+ * @param jbuf      Pointer to the ::EVEL_JSON_BUFFER to encode into.
  * @param event     Pointer to the ::EVENT_HEADER to encode.
- * @returns Number of bytes actually written.
  *****************************************************************************/
-int evel_json_encode_event(char * json,
-                           int max_size,
-                           EVENT_HEADER * event)
+static void evel_json_encode_event_fields(EVEL_JSON_BUFFER * jbuf,
+                                          EVENT_HEADER * event)
 {
-  EVEL_JSON_BUFFER json_buffer;
-  EVEL_JSON_BUFFER * jbuf = &json_buffer;
-  EVEL_THROTTLE_SPEC * throttle_spec;
-
   EVEL_ENTER();
 
-  /***************************************************************************/
-  /* Get the latest throttle specification for the domain.                   */
-  /***************************************************************************/
-  throttle_spec = evel_get_throttle_spec(event->event_domain);
-
-  /***************************************************************************/
-  /* Initialize the JSON_BUFFER and open the top-level objects.              */
-  /***************************************************************************/
-  evel_json_buffer_init(jbuf, json, max_size, throttle_spec);
-  evel_json_open_object(jbuf);
-  evel_json_open_named_object(jbuf, "event");
-
   switch (event->event_domain)
   {
     case EVEL_DOMAIN_HEARTBEAT:
@@ -506,6 +1198,36 @@ int evel_json_encode_event(char * json,
       assert(0);
   }
 
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Encode the event as a JSON event object according to AT&T's schema.
+ *
+ * @param jbuf      Pointer to the newly initialized ::EVEL_JSON_BUFFER to
+ *                  encode into.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ *****************************************************************************/
+static void evel_json_encode_event_buffer(EVEL_JSON_BUFFER * jbuf,
+                                          EVENT_HEADER * event)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Get the latest throttle specification for the domain, which stays valid */
+  /* until the read ends, even if it is replaced meanwhile.                  */
+  /***************************************************************************/
+  evel_throttle_read_begin();
+  jbuf->throttle_spec = evel_get_throttle_spec(event->event_domain);
+
+  /***************************************************************************/
+  /* Open the top-level objects.                                             */
+  /***************************************************************************/
+  evel_json_open_object(jbuf);
+  evel_json_open_named_object(jbuf, "event");
+
+  evel_json_encode_event_fields(jbuf, event);
+
   evel_json_close_object(jbuf);
   evel_json_close_object(jbuf);
 
@@ -514,21 +1236,165 @@ int evel_json_encode_event(char * json,
   /***************************************************************************/
   assert(jbuf->depth == 0);
 
+  jbuf->throttle_spec = NULL;
+  evel_throttle_read_end();
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Encode the event as one entry of a JSON eventList.
+ *
+ * The entry is the object that appears as the value of "event" in a single
+ * event post, so the result can be placed directly into the "eventList" array
+ * of a batch post.
+ *
+ * @param jbuf      Pointer to the newly initialized ::EVEL_JSON_BUFFER to
+ *                  encode into.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ *****************************************************************************/
+static void evel_json_encode_event_list_entry_buffer(EVEL_JSON_BUFFER * jbuf,
+                                                     EVENT_HEADER * event)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Get the latest throttle specification for the domain, which stays valid */
+  /* until the read ends, even if it is replaced meanwhile.                  */
+  /***************************************************************************/
+  evel_throttle_read_begin();
+  jbuf->throttle_spec = evel_get_throttle_spec(event->event_domain);
+
+  /***************************************************************************/
+  /* The entry sits one level below the top-level object, exactly where the  */
+  /* "event" object sits in a single post, so start one level down to keep   */
+  /* throttling at the same depth.                                           */
+  /***************************************************************************/
+  jbuf->depth = 1;
+  evel_json_open_object(jbuf);
+
+  evel_json_encode_event_fields(jbuf, event);
+
+  evel_json_close_object(jbuf);
+
+  /***************************************************************************/
+  /* Sanity check.                                                           */
+  /***************************************************************************/
+  assert(jbuf->depth == 1);
+
+  jbuf->throttle_spec = NULL;
+  evel_throttle_read_end();
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Encode the event as a JSON event object according to AT&T's schema.
+ *
+ * @param json      Pointer to where to store the JSON encoded data.
+ * @param max_size  Size of storage available in json_body.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ * @returns Number of bytes actually written.
+ *****************************************************************************/
+int evel_json_encode_event(char * json,
+                           int max_size,
+                           EVENT_HEADER * event)
+{
+  EVEL_JSON_BUFFER json_buffer;
+  EVEL_JSON_BUFFER * jbuf = &json_buffer;
+
+  EVEL_ENTER();
+
+  evel_json_buffer_init(jbuf, json, max_size, NULL);
+  evel_json_encode_event_buffer(jbuf, event);
+
+  EVEL_EXIT();
+
+  return jbuf->offset;
+}
+
+/**************************************************************************//**
+ * Encode the event as one entry of a JSON eventList.
+ *
+ * @param json      Pointer to where to store the JSON encoded data.
+ * @param max_size  Size of storage available in json.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ * @returns Number of bytes actually written.
+ *****************************************************************************/
+int evel_json_encode_event_list_entry(char * json,
+                                      int max_size,
+                                      EVENT_HEADER * event)
+{
+  EVEL_JSON_BUFFER json_buffer;
+  EVEL_JSON_BUFFER * jbuf = &json_buffer;
+
+  EVEL_ENTER();
+
+  evel_json_buffer_init(jbuf, json, max_size, NULL);
+  evel_json_encode_event_list_entry_buffer(jbuf, event);
+
+  EVEL_EXIT();
+
+  return jbuf->offset;
+}
+
+/**************************************************************************//**
+ * Encode the event as a JSON event object into an ::EVEL_JSON_ARENA.
+ *
+ * @param arena     Pointer to the arena to encode into.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ * @returns Number of bytes written to the start of the arena.
+ *****************************************************************************/
+int evel_json_encode_event_arena(EVEL_JSON_ARENA * const arena,
+                                 EVENT_HEADER * event)
+{
+  EVEL_JSON_BUFFER json_buffer;
+  EVEL_JSON_BUFFER * jbuf = &json_buffer;
+
+  EVEL_ENTER();
+
+  evel_json_buffer_init_arena(jbuf, arena, NULL);
+  evel_json_encode_event_buffer(jbuf, event);
+
   EVEL_EXIT();
 
   return jbuf->offset;
 }
 
+/**************************************************************************//**
+ * Encode the event as one entry of a JSON eventList into an ::EVEL_JSON_ARENA.
+ *
+ * @param arena     Pointer to the arena to encode into.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ * @returns Number of bytes written to the start of the arena.
+ *****************************************************************************/
+int evel_json_encode_event_list_entry_arena(EVEL_JSON_ARENA * const arena,
+                                            EVENT_HEADER * event)
+{
+  EVEL_JSON_BUFFER json_buffer;
+  EVEL_JSON_BUFFER * jbuf = &json_buffer;
+
+  EVEL_ENTER();
+
+  evel_json_buffer_init_arena(jbuf, arena, NULL);
+  evel_json_encode_event_list_entry_buffer(jbuf, event);
+
+  EVEL_EXIT();
+
+  return jbuf->offset;
+}
 
 /**************************************************************************//**
  * Initialize an event instance id.
  *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
  * @param vfield        Pointer to the event vnfname field being initialized.
  * @param vendor_id     The vendor id to encode in the event instance id.
  * @param event_id      The event id to encode in the event instance id.
  *****************************************************************************/
-void evel_init_vendor_field(VENDOR_VNFNAME_FIELD * const vfield,
-                                 const char * const vendor_name)
+void evel_init_vendor_field(EVENT_HEADER * const header,
+                            VENDOR_VNFNAME_FIELD * const vfield,
+                            const char * const vendor_name)
 {
   EVEL_ENTER();
 
@@ -541,7 +1407,7 @@ void evel_init_vendor_field(VENDOR_VNFNAME_FIELD * const vfield,
   /***************************************************************************/
   /* Store the mandatory parts.                                              */
   /***************************************************************************/
-  vfield->vendorname = strdup(vendor_name);
+  vfield->vendorname = evel_event_strdup(header, vendor_name);
   evel_init_option_string(&vfield->vfmodule);
   evel_init_option_string(&vfield->vnfname);
 
@@ -559,13 +1425,15 @@ void evel_init_vendor_field(VENDOR_VNFNAME_FIELD * const vfield,
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
  * @param vfield        Pointer to the Vendor field.
  * @param module_name   The module name to be set. ASCIIZ string. The caller
  *                      does not need to preserve the value once the function
  *                      returns.
  *****************************************************************************/
-void evel_vendor_field_module_set(VENDOR_VNFNAME_FIELD * const vfield,
-                                    const char * const module_name)
+void evel_vendor_field_module_set(EVENT_HEADER * const header,
+                                  VENDOR_VNFNAME_FIELD * const vfield,
+                                  const char * const module_name)
 {
   EVEL_ENTER();
 
@@ -575,7 +1443,10 @@ void evel_vendor_field_module_set(VENDOR_VNFNAME_FIELD * const vfield,
   assert(vfield != NULL);
   assert(module_name != NULL);
 
-  evel_set_option_string(&vfield->vfmodule, module_name, "Module name set");
+  evel_event_set_option_string(header,
+                               &vfield->vfmodule,
+                               module_name,
+                               "Module name set");
 
   EVEL_EXIT();
 }
@@ -587,13 +1458,15 @@ void evel_vendor_field_module_set(VENDOR_VNFNAME_FIELD * const vfield,
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
  * @param vfield        Pointer to the Vendor field.
  * @param module_name   The module name to be set. ASCIIZ string. The caller
  *                      does not need to preserve the value once the function
  *                      returns.
  *****************************************************************************/
-void evel_vendor_field_vnfname_set(VENDOR_VNFNAME_FIELD * const vfield,
-                                    const char * const vnfname)
+void evel_vendor_field_vnfname_set(EVENT_HEADER * const header,
+                                   VENDOR_VNFNAME_FIELD * const vfield,
+                                   const char * const vnfname)
 {
   EVEL_ENTER();
 
@@ -603,7 +1476,10 @@ void evel_vendor_field_vnfname_set(VENDOR_VNFNAME_FIELD * const vfield,
   assert(vfield != NULL);
   assert(vnfname != NULL);
 
-  evel_set_option_string(&vfield->vnfname, vnfname, "Virtual Network Function name set");
+  evel_event_set_option_string(header,
+                               &vfield->vnfname,
+                               vnfname,
+                               "Virtual Network Function name set");
 
   EVEL_EXIT();
 }
@@ -658,8 +1534,14 @@ void evel_json_encode_vendor_field(EVEL_JSON_BUFFER * jbuf,
   /* Mandatory fields.                                                       */
   /***************************************************************************/
   evel_enc_kv_string(jbuf, "vendorName", vfield->vendorname);
-  evel_enc_kv_opt_string(jbuf, "vfModuleName", &vfield->vfmodule);
-  evel_enc_kv_opt_string(jbuf, "vnfName", &vfield->vnfname);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_VF_MODULE_NAME,
+                         "vfModuleName",
+                         &vfield->vfmodule);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_VNF_NAME,
+                         "vnfName",
+                         &vfield->vnfname);
 
   /***************************************************************************/
   /* Optional fields.                                                        */
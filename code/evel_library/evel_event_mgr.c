@@ -41,6 +41,8 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <pthread.h>
+#include <time.h>
+#include <unistd.h>
 
 #include <curl/curl.h>
 
@@ -48,6 +50,9 @@
 #include "evel_internal.h"
 #include "ring_buffer.h"
 #include "evel_throttle.h"
+#include "evel_spool.h"
+#include "evel_compress.h"
+#include "hash_map.h"
 
 /**************************************************************************//**
  * How long we're prepared to wait for the API service to respond in
@@ -55,11 +60,155 @@
  *****************************************************************************/
 static const int EVEL_API_TIMEOUT = 5;
 
+/**************************************************************************//**
+ * How many spooled posts can be gathered into one replayed post.
+ *****************************************************************************/
+#define EVEL_REPLAY_MAX_POSTS 16
+
+/**************************************************************************//**
+ * The APIs on a listener endpoint.
+ *****************************************************************************/
+typedef enum {
+  EVEL_API_EVENT,
+  EVEL_API_BATCH,
+  EVEL_API_THROTTLE,
+  EVEL_MAX_APIS
+} EVEL_API;
+
+/**************************************************************************//**
+ * A listener endpoint, with the URLs of its APIs and the passively tracked
+ * state of its health.
+ *****************************************************************************/
+struct evel_endpoint {
+  char * urls[EVEL_MAX_APIS];
+  int consecutive_failures;
+  unsigned long long down_until_ms;
+  EVEL_ENDPOINT_STATS stats;
+};
+
+/**************************************************************************//**
+ * A post in flight on the multi handle.  Each transfer has its own easy
+ * handle and keeps its buffers from one post to the next.
+ *****************************************************************************/
+typedef struct evel_transfer {
+  CURL * handle;
+  char * body;
+  int body_size;
+  int body_capacity;
+  char * compressed;
+  int compressed_capacity;
+  MEMORY_CHUNK tx_chunk;
+  MEMORY_CHUNK rx_chunk;
+  EVEL_API api;
+  EVEL_ENDPOINT * endpoint;
+  int num_events;
+  int attempts;
+  bool spooled;
+  EVEL_SPOOL_REF spool_refs[EVEL_REPLAY_MAX_POSTS];
+  int num_spool_refs;
+  bool in_use;
+  char err_string[CURL_ERROR_SIZE];
+} EVEL_TRANSFER;
+
+/**************************************************************************//**
+ * A priority post waiting to be sent, and the endpoint which asked for it.
+ *****************************************************************************/
+typedef struct evel_priority_post {
+  MEMORY_CHUNK post;
+  EVEL_ENDPOINT * endpoint;
+} EVEL_PRIORITY_POST;
+
+/**************************************************************************//**
+ * A post waiting to be retried, holding a copy of the body that failed.
+ *****************************************************************************/
+typedef struct evel_retry {
+  struct evel_retry * next;
+  EVEL_API api;
+  int num_events;
+  int attempts;
+  unsigned long long due_ms;
+  int body_size;
+  char body[];
+} EVEL_RETRY;
+
+/**************************************************************************//**
+ * A source whose events coalesce when their queue is full: whether one of
+ * its events is queued, and the newer event to send in its place, if any.
+ * The queued flag is claimed atomically by the thread queueing the event,
+ * and is otherwise changed under the coalesce mutex, as is the replacement.
+ *****************************************************************************/
+typedef struct evel_coalesce_entry {
+  bool queued;
+  EVENT_HEADER * replacement;
+  char key[];
+} EVEL_COALESCE_ENTRY;
+
 /*****************************************************************************/
 /* Prototypes of locally scoped functions.                                   */
 /*****************************************************************************/
 static size_t read_callback(void *ptr, size_t size, size_t nmemb, void *userp);
 static void * event_handler(void *arg);
+static EVENT_HEADER * evel_build_batch(EVEL_TRANSFER * const xfer,
+                                       EVENT_HEADER * first,
+                                       EVEL_JSON_ARENA * const arena);
+static EVENT_HEADER * evel_batch_next_event(const struct timespec * deadline);
+static EVENT_HEADER * evel_event_read(const bool wait);
+static EVENT_HEADER * evel_event_try_read(void);
+static bool evel_events_queued(void);
+static bool evel_queues_empty(void);
+static EVT_HANDLER_COMMAND evel_event_command(const EVENT_HEADER * const msg);
+static bool evel_post_overflow(EVENT_HEADER * const event,
+                               const int lane,
+                               const EVEL_OVERFLOW_POLICIES policy,
+                               const int timeout_ms,
+                               EVEL_COALESCE_ENTRY * const entry);
+static bool evel_event_displace(EVENT_HEADER * const victim);
+static bool evel_event_enqueue(EVENT_HEADER * const event,
+                               const int lane,
+                               const int timeout_ms);
+static bool evel_budget_fits(const size_t size);
+static bool evel_budget_reserve(const size_t size);
+static void evel_budget_release(const EVENT_HEADER * const event);
+static EVEL_COALESCE_ENTRY * evel_coalesce_entry(
+                                             const EVENT_HEADER * const event);
+static bool evel_coalesce_claim(EVEL_COALESCE_ENTRY * const entry);
+static void evel_coalesce_unclaim(EVEL_COALESCE_ENTRY * const entry);
+static EVENT_HEADER * evel_coalesce_take(EVENT_HEADER * msg);
+static void evel_coalesce_free(void);
+static EVEL_TRANSFER * evel_transfer_get(void);
+static EVEL_ERR_CODES evel_transfer_init(EVEL_TRANSFER * const xfer);
+static void evel_transfer_reserve(EVEL_TRANSFER * const xfer,
+                                  const int size);
+static EVEL_ERR_CODES evel_transfer_start(EVEL_TRANSFER * const xfer,
+                                          const EVEL_API api,
+                                          EVEL_ENDPOINT * const endpoint);
+static void evel_transfer_complete(CURLMsg * const curl_msg);
+static void evel_transfers_run(const bool wake_for_events,
+                               const int max_wait_ms);
+static void evel_transfers_abort(void);
+static void evel_flush_signal(const bool flushed);
+static void evel_priority_post_start(void);
+static void evel_retry_post(EVEL_TRANSFER * const xfer,
+                            const long retry_after_ms,
+                            const bool failover);
+static void evel_retry_start(void);
+static int evel_retry_wait_ms(void);
+static void evel_post_dropped(const char * const body, const int num_events);
+static void evel_post_undeliverable(const char * const body,
+                                    const EVEL_API api,
+                                    const int num_events);
+static bool evel_replay_due(void);
+static void evel_replay_start(void);
+static bool evel_replay_entries(const char * const body,
+                                const int size,
+                                const bool batch,
+                                const char ** const entries,
+                                int * const entries_size);
+static void evel_replay_complete(EVEL_TRANSFER * const xfer,
+                                 const bool failed,
+                                 const bool retry);
+static int evel_replay_wait_ms(void);
+static unsigned long long evel_monotonic_ms(void);
 static bool evel_handle_response_tokens(const MEMORY_CHUNK * const chunk,
                                         const jsmntok_t * const json_tokens,
                                         const int num_tokens,
@@ -77,25 +226,117 @@ static bool evel_token_equals_string(const MEMORY_CHUNK * const chunk,
 static char curl_err_string[CURL_ERROR_SIZE] = "<NULL>";
 
 /**************************************************************************//**
- * Handle for the API into libcurl.
+ * Handle for the API into libcurl.  This is configured once and is the
+ * template from which the handle of each post in flight is duplicated.
  *****************************************************************************/
 static CURL * curl_handle = NULL;
 
+/**************************************************************************//**
+ * Multi handle which runs the posts in flight, and pools their connections.
+ *****************************************************************************/
+static CURLM * curl_multi = NULL;
+
 /**************************************************************************//**
  * Special headers that we send.
  *****************************************************************************/
 static struct curl_slist * hdr_chunk = NULL;
 
 /**************************************************************************//**
- * Message queue for sending events to the API.
+ * The same headers plus the one saying the body is compressed.
+ *****************************************************************************/
+static struct curl_slist * hdr_chunk_gzip = NULL;
+
+/**************************************************************************//**
+ * Message queues for sending events to the API, one for each priority, which
+ * all share the event handler as their reader.  Internal events go on the
+ * lowest priority queue.
+ *****************************************************************************/
+static ring_buffer event_buffers[EVEL_MAX_PRIORITIES];
+static EVEL_LANE_STATS evel_lane_stats[EVEL_MAX_PRIORITIES];
+
+/**************************************************************************//**
+ * How the event handler shares out the queues: the weight of each, or 0 for
+ * strict priority order, which is protected by the handler mutex, plus the
+ * event handler's copy of the weights, the number of events each queue may
+ * still supply this turn, and an internal event held back until the queues
+ * are empty, which are only used by the event handler thread.
  *****************************************************************************/
-static ring_buffer event_buffer;
+static int evel_lane_weights[EVEL_MAX_PRIORITIES];
+static int evel_lane_quota[EVEL_MAX_PRIORITIES];
+static int evel_lane_credits[EVEL_MAX_PRIORITIES];
+static EVENT_HEADER * evel_deferred_internal = NULL;
 
 /**************************************************************************//**
- * Single pending priority post, which can be generated as a result of a
+ * Whether events are encoded by the threads which post them rather than by
+ * the event handler.  Read on every post, so it is set and read atomically
+ * rather than under the handler mutex.
+ *****************************************************************************/
+static int evel_producer_encoding = 0;
+
+/**************************************************************************//**
+ * What happens to events of each domain posted while their queue is full,
+ * and how long they may wait for room.  Read on every post, so they are set
+ * and read atomically rather than under the handler mutex, as are the
+ * statistics of each policy.
+ *****************************************************************************/
+static int evel_overflow_policies[EVEL_MAX_DOMAINS];
+static int evel_overflow_timeouts_ms[EVEL_MAX_DOMAINS];
+static EVEL_OVERFLOW_STATS evel_overflow_stats[EVEL_MAX_OVERFLOW_POLICIES];
+
+/**************************************************************************//**
+ * The sources whose events coalesce, by domain: those with the default source
+ * name, which are looked up atomically since they are the common case, and
+ * the others keyed by source name.  Used by the threads posting events as
+ * well as the event handler, so protected by a mutex of its own.  Entries
+ * last until the event handler exits.
+ *****************************************************************************/
+static EVEL_COALESCE_ENTRY * evel_coalesce_defaults[EVEL_MAX_DOMAINS];
+static HASH_MAP evel_coalesce_maps[EVEL_MAX_DOMAINS];
+static pthread_mutex_t evel_coalesce_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**************************************************************************//**
+ * A command for the event handler taken out of a full queue to make room,
+ * which is set aside for the event handler rather than dropped.
+ *****************************************************************************/
+static EVENT_HEADER * evel_displaced_command = NULL;
+
+/**************************************************************************//**
+ * How much memory the queued events may use, or 0 for no limit, which is set
+ * when the event handler is initialized, and how much they do use, which is
+ * updated atomically.  Threads waiting for memory to be freed wait on the
+ * condition variable.
+ *****************************************************************************/
+static size_t evel_queue_max_bytes = 0;
+static size_t evel_queued_bytes = 0;
+static int evel_budget_waiters = 0;
+static pthread_mutex_t evel_budget_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t evel_budget_cv;
+
+/**************************************************************************//**
+ * Whether the event handler has sent every event it has taken from the
+ * queues, with no posts in flight or waiting to be retried.  Only changed by
+ * the event handler, under the mutex, and threads flushing wait on the
+ * condition variable for it to become true.
+ *****************************************************************************/
+static bool evel_handler_flushed = false;
+static pthread_mutex_t evel_flush_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t evel_flush_cv;
+
+/**************************************************************************//**
+ * How long ::evel_terminate keeps sending queued events, and the time on the
+ * monotonic clock by which the event handler must exit, or 0 for none.
+ *****************************************************************************/
+static int evel_terminate_timeout_ms = 0;
+static unsigned long long evel_exit_deadline_ms = 0;
+
+/**************************************************************************//**
+ * Queue of pending priority posts, which can be generated as a result of a
  * response to an event.  Currently only used to respond to a commandList.
+ * Only used by the event handler thread.
  *****************************************************************************/
-static MEMORY_CHUNK priority_post;
+static EVEL_PRIORITY_POST evel_priority_posts[EVEL_PRIORITY_QUEUE_SIZE];
+static int evel_priority_head = 0;
+static int evel_priority_count = 0;
 
 /**************************************************************************//**
  * The thread which is responsible for handling events off of the ring-buffer
@@ -110,10 +351,112 @@ static pthread_t evt_handler_thread;
 static EVT_HANDLER_STATE evt_handler_state = EVT_HANDLER_UNINITIALIZED;
 
 /**************************************************************************//**
- * The configured API URL for event and throttling.
+ * The listener endpoints, the first being the one the library was
+ * initialized with.  The endpoints are set up before the event handler
+ * thread starts, and the statistics and health of each are protected by the
+ * handler mutex so that they can be read from the foreground.
+ *****************************************************************************/
+static EVEL_ENDPOINT evel_endpoints[EVEL_MAX_ENDPOINTS];
+static int evel_num_endpoints = 0;
+
+/**************************************************************************//**
+ * How posts are spread across the endpoints, which is protected by the
+ * handler mutex, plus the next endpoint to try for round robin, which is only
+ * used by the event handler thread.
+ *****************************************************************************/
+static EVEL_ENDPOINT_POLICIES evel_endpoint_policy =
+                                                  EVEL_ENDPOINT_DEFAULT_POLICY;
+static int evel_endpoint_threshold = EVEL_ENDPOINT_DEFAULT_THRESHOLD;
+static int evel_endpoint_hold_down_ms = EVEL_ENDPOINT_DEFAULT_HOLD_DOWN_MS;
+static int evel_endpoint_next = 0;
+
+/**************************************************************************//**
+ * Tuning of the event handler: the limits used to batch events into
+ * eventList posts and the number of posts kept in flight, plus the
+ * statistics of the batches posted.  These are protected by the handler
+ * mutex since the tuning is set, and the statistics read, from the
+ * foreground.
+ *****************************************************************************/
+static int evel_batch_max_events = EVEL_BATCH_DEFAULT_MAX_EVENTS;
+static int evel_batch_max_bytes = EVEL_BATCH_DEFAULT_MAX_BYTES;
+static int evel_batch_max_wait_ms = EVEL_BATCH_DEFAULT_MAX_WAIT_MS;
+static int evel_post_window = EVEL_POST_DEFAULT_WINDOW;
+static EVEL_BATCH_STATS evel_batch_stats;
+static pthread_mutex_t evel_handler_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**************************************************************************//**
+ * The transfers used for events, of which up to the window are in flight at
+ * once, and the one used for priority posts.  The priority transfer has a
+ * connection cache of its own, so that control traffic neither waits for nor
+ * takes over the connections carrying events.  Only used by the event
+ * handler thread.
+ *****************************************************************************/
+static EVEL_TRANSFER evel_transfers[EVEL_POST_MAX_WINDOW];
+static EVEL_TRANSFER evel_priority_transfer;
+static CURLSH * curl_priority_share = NULL;
+static int evel_transfers_in_flight = 0;
+
+/**************************************************************************//**
+ * Set while the event handler is waiting on the multi handle and wants to be
+ * woken when an event is posted.
+ *****************************************************************************/
+static int evel_handler_polling = 0;
+
+/**************************************************************************//**
+ * How long the event handler waits on the multi handle at a time, in
+ * milliseconds.
+ *****************************************************************************/
+static const int EVEL_POLL_TIMEOUT_MS = 1000;
+
+/**************************************************************************//**
+ * Limits on retrying failed posts, and the statistics of the retries.  These
+ * are protected by the handler mutex.
+ *****************************************************************************/
+static int evel_retry_max_attempts = EVEL_RETRY_DEFAULT_MAX_ATTEMPTS;
+static int evel_retry_max_bytes = EVEL_RETRY_DEFAULT_MAX_BYTES;
+static int evel_retry_base_delay_ms = EVEL_RETRY_DEFAULT_BASE_DELAY_MS;
+static int evel_retry_max_delay_ms = EVEL_RETRY_DEFAULT_MAX_DELAY_MS;
+static EVEL_RETRY_STATS evel_retry_stats;
+
+/**************************************************************************//**
+ * Posts waiting to be retried, oldest first, and the seed for the jitter in
+ * their delays.  Only used by the event handler thread.
+ *****************************************************************************/
+static EVEL_RETRY * evel_retry_head = NULL;
+static EVEL_RETRY * evel_retry_tail = NULL;
+static unsigned int evel_retry_seed = 0;
+
+/**************************************************************************//**
+ * Pacing of the replay of spooled posts: the rate, which is protected by the
+ * handler mutex, when the next post may be replayed, and how long replay is
+ * backed off for after a failure.  The last two are only used by the event
+ * handler thread.
+ *****************************************************************************/
+static int evel_replay_rate = EVEL_SPOOL_DEFAULT_REPLAY_RATE;
+static unsigned long long evel_replay_next_ms = 0;
+static int evel_replay_backoff_ms = 0;
+
+/**************************************************************************//**
+ * Compression of post bodies: the level and minimum size, plus the
+ * statistics, which are protected by the handler mutex, and the compressor,
+ * which is only used by the event handler thread.
  *****************************************************************************/
-static char * evel_event_api_url;
-static char * evel_throt_api_url;
+static int evel_compress_level = EVEL_COMPRESS_DEFAULT_LEVEL;
+static int evel_compress_min_bytes = EVEL_COMPRESS_DEFAULT_MIN_BYTES;
+static EVEL_COMPRESS_STATS evel_compress_stats;
+static EVEL_COMPRESSOR evel_compressor;
+
+/**************************************************************************//**
+ * Room needed in the batch body over and above the events themselves, for
+ * the eventList framing.
+ *****************************************************************************/
+#define EVEL_BATCH_FRAMING_SIZE 32
+
+/**************************************************************************//**
+ * How many events are taken from a ring-buffer at a time when it is emptied
+ * on exit.
+ *****************************************************************************/
+#define EVEL_DRAIN_BATCH 32
 
 /**************************************************************************//**
  * Initialize the event handler.
@@ -123,21 +466,35 @@ static char * evel_throt_api_url;
  * @param[in] event_api_url
  *                      The URL where the Vendor Event Listener API is expected
  *                      to be.
+ * @param[in] batch_api_url
+ *                      The URL where the batch (eventList) API is expected to
+ *                      be.
  * @param[in] throt_api_url
  *                      The URL where the Throttling API is expected to be.
  * @param[in] username  The username for the Basic Authentication of requests.
  * @param[in] password  The password for the Basic Authentication of requests.
  * @param     verbosity 0 for normal operation, positive values for chattier
  *                        logs.
+ * @param     queue_depth How many events each priority queue holds.
+ * @param     queue_max_bytes
+ *                      How much memory the queued events may use, or 0 for
+ *                      no limit.
  *****************************************************************************/
 EVEL_ERR_CODES event_handler_initialize(const char * const event_api_url,
+                                        const char * const batch_api_url,
                                         const char * const throt_api_url,
                                         const char * const username,
                                         const char * const password,
-                                        int verbosity)
+                                        int verbosity,
+                                        const int queue_depth,
+                                        const size_t queue_max_bytes)
 {
   int rc = EVEL_SUCCESS;
   CURLcode curl_rc = CURLE_OK;
+  CURLMcode curl_mrc = CURLM_OK;
+  CURLSHcode curl_src = CURLSHE_OK;
+  pthread_condattr_t cond_attr;
+  int ii;
 
   EVEL_ENTER();
 
@@ -145,17 +502,16 @@ EVEL_ERR_CODES event_handler_initialize(const char * const event_api_url,
   /* Check assumptions.                                                      */
   /***************************************************************************/
   assert(event_api_url != NULL);
+  assert(batch_api_url != NULL);
   assert(throt_api_url != NULL);
   assert(username != NULL);
   assert(password != NULL);
+  assert(queue_depth > 0);
 
   /***************************************************************************/
-  /* Store the API URLs.                                                     */
+  /* Store the API URLs as the first endpoint.                               */
   /***************************************************************************/
-  evel_event_api_url = strdup(event_api_url);
-  assert(evel_event_api_url != NULL);
-  evel_throt_api_url = strdup(throt_api_url);
-  assert(evel_throt_api_url != NULL);
+  event_handler_add_endpoint(event_api_url, batch_api_url, throt_api_url);
 
   /***************************************************************************/
   /* Start the CURL library. Note that this initialization is not threadsafe */
@@ -285,6 +641,11 @@ EVEL_ERR_CODES event_handler_initialize(const char * const event_api_url,
   /***************************************************************************/
   hdr_chunk = curl_slist_append(hdr_chunk, "Content-type: application/json");
   hdr_chunk = curl_slist_append(hdr_chunk, "Expect:");
+  hdr_chunk_gzip = curl_slist_append(hdr_chunk_gzip,
+                                     "Content-type: application/json");
+  hdr_chunk_gzip = curl_slist_append(hdr_chunk_gzip, "Expect:");
+  hdr_chunk_gzip = curl_slist_append(hdr_chunk_gzip,
+                                     "Content-Encoding: gzip");
 
   /***************************************************************************/
   /* set our custom set of headers.                                         */
@@ -342,15 +703,86 @@ EVEL_ERR_CODES event_handler_initialize(const char * const event_api_url,
   }
 
   /***************************************************************************/
-  /* Initialize a message ring-buffer to be used between the foreground and  */
-  /* the thread which sends the messages.  This can't fail.                  */
+  /* Initialize the message ring-buffers to be used between the foreground   */
+  /* and the thread which sends the messages.  This can't fail.              */
+  /***************************************************************************/
+  for (ii = 0; ii < EVEL_MAX_PRIORITIES; ii++)
+  {
+    ring_buffer_initialize(&event_buffers[ii], queue_depth);
+    if (ii > 0)
+    {
+      ring_buffer_share_reader(&event_buffers[ii], &event_buffers[0]);
+    }
+  }
+  evel_deferred_internal = NULL;
+
+  /***************************************************************************/
+  /* Initialize the memory budget of the queues.  Threads waiting for memory */
+  /* or for a flush time out on the monotonic clock, as they do waiting for  */
+  /* the queues.                                                             */
+  /***************************************************************************/
+  evel_queue_max_bytes = queue_max_bytes;
+  evel_queued_bytes = 0;
+  pthread_condattr_init(&cond_attr);
+  pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&evel_budget_cv, &cond_attr);
+  pthread_cond_init(&evel_flush_cv, &cond_attr);
+  pthread_condattr_destroy(&cond_attr);
+  evel_handler_flushed = false;
+  evel_exit_deadline_ms = 0;
+
+  /***************************************************************************/
+  /* Get the multi handle which runs the posts.  It keeps a cache of open    */
+  /* connections, which we size to cover every post that can be in flight.   */
+  /***************************************************************************/
+  curl_multi = curl_multi_init();
+  if (curl_multi == NULL)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to get libCURL multi handle");
+    goto exit_label;
+  }
+  curl_mrc = curl_multi_setopt(curl_multi,
+                               CURLMOPT_MAXCONNECTS,
+                               (long) (EVEL_POST_MAX_WINDOW *
+                                       EVEL_MAX_ENDPOINTS));
+  if (curl_mrc != CURLM_OK)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to size libCURL connection cache. "
+                    "Error code=%d", curl_mrc);
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Priority posts share a connection cache of their own rather than the    */
+  /* multi handle's, although the multi handle still runs them.              */
   /***************************************************************************/
-  ring_buffer_initialize(&event_buffer, EVEL_EVENT_BUFFER_DEPTH);
+  curl_priority_share = curl_share_init();
+  if (curl_priority_share == NULL)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to get libCURL share handle");
+    goto exit_label;
+  }
+  curl_src = curl_share_setopt(curl_priority_share,
+                               CURLSHOPT_SHARE,
+                               CURL_LOCK_DATA_CONNECT);
+  if (curl_src != CURLSHE_OK)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to initialize libCURL share handle. "
+                    "Error code=%d (%s)", curl_src,
+                    curl_share_strerror(curl_src));
+    goto exit_label;
+  }
 
   /***************************************************************************/
-  /* Initialize the priority post buffer to empty.                           */
+  /* Initialize the priority post queue to empty.                            */
   /***************************************************************************/
-  priority_post.memory = NULL;
+  memset(evel_priority_posts, 0, sizeof(evel_priority_posts));
+  evel_priority_head = 0;
+  evel_priority_count = 0;
 
 exit_label:
   EVEL_EXIT();
@@ -358,6 +790,48 @@ exit_label:
   return(rc);
 }
 
+/**************************************************************************//**
+ * Add a listener endpoint to the event handler, after the one it was
+ * initialized with.
+ *
+ * @param[in] event_api_url
+ *                      The URL of the endpoint's Vendor Event Listener API.
+ * @param[in] batch_api_url
+ *                      The URL of the endpoint's batch (eventList) API.
+ * @param[in] throt_api_url
+ *                      The URL of the endpoint's Throttling API.
+ *****************************************************************************/
+void event_handler_add_endpoint(const char * const event_api_url,
+                                const char * const batch_api_url,
+                                const char * const throt_api_url)
+{
+  EVEL_ENDPOINT * endpoint = NULL;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(event_api_url != NULL);
+  assert(batch_api_url != NULL);
+  assert(throt_api_url != NULL);
+  assert(evel_num_endpoints < EVEL_MAX_ENDPOINTS);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  endpoint = &evel_endpoints[evel_num_endpoints];
+  memset(endpoint, 0, sizeof(EVEL_ENDPOINT));
+  endpoint->urls[EVEL_API_EVENT] = strdup(event_api_url);
+  assert(endpoint->urls[EVEL_API_EVENT] != NULL);
+  endpoint->urls[EVEL_API_BATCH] = strdup(batch_api_url);
+  assert(endpoint->urls[EVEL_API_BATCH] != NULL);
+  endpoint->urls[EVEL_API_THROTTLE] = strdup(throt_api_url);
+  assert(endpoint->urls[EVEL_API_THROTTLE] != NULL);
+  evel_num_endpoints++;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  EVEL_EXIT();
+}
+
 /**************************************************************************//**
  * Run the event handler.
  *
@@ -398,6 +872,9 @@ EVEL_ERR_CODES event_handler_run()
  * global exit flag and then signals the thread to interrupt it since it's
  * most likely waiting on the ring-buffer.
  *
+ * With a terminate timeout, the events still queued are sent first, and the
+ * event handler exits within the timeout regardless.
+ *
  * Having achieved an orderly shutdown of the event handler thread, clean up
  * the cURL library's resources cleanly.
  *
@@ -408,9 +885,12 @@ EVEL_ERR_CODES event_handler_run()
 EVEL_ERR_CODES event_handler_terminate()
 {
   EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_TRANSFER * xfer = NULL;
+  int ii;
 
   EVEL_ENTER();
   EVENT_INTERNAL *event = NULL;
+  int timeout_ms = 0;
 
   /***************************************************************************/
   /* Make sure that we were initialized before trying to terminate the       */
@@ -418,6 +898,23 @@ EVEL_ERR_CODES event_handler_terminate()
   /***************************************************************************/
   if (evt_handler_state != EVT_HANDLER_UNINITIALIZED)
   {
+    /*************************************************************************/
+    /* Given time, keep sending until everything queued has gone.  Posts     */
+    /* still in flight when the time is up are abandoned, so that the event  */
+    /* handler exits in time.                                                */
+    /*************************************************************************/
+    timeout_ms = __atomic_load_n(&evel_terminate_timeout_ms, __ATOMIC_RELAXED);
+    if (timeout_ms > 0)
+    {
+      __atomic_store_n(&evel_exit_deadline_ms,
+                       evel_monotonic_ms() + timeout_ms,
+                       __ATOMIC_RELAXED);
+      if (evel_flush(timeout_ms) != EVEL_SUCCESS)
+      {
+        EVEL_ERROR("Timed out sending queued events - dropping the rest");
+      }
+    }
+
     /*************************************************************************/
     /* Make sure that the event handler knows it's time to die.              */
     /*************************************************************************/
@@ -440,6 +937,10 @@ EVEL_ERR_CODES event_handler_terminate()
       EVEL_DEBUG("Sending event to Event Hander to request it to exit.");
       evt_handler_state = EVT_HANDLER_REQUEST_TERMINATE;
       evel_post_event((EVENT_HEADER *) event);
+      if (curl_multi != NULL)
+      {
+        curl_multi_wakeup(curl_multi);
+      }
       pthread_join(evt_handler_thread, NULL);
       EVEL_DEBUG("Event Handler thread has exited.");
     }
@@ -450,8 +951,41 @@ EVEL_ERR_CODES event_handler_terminate()
   }
 
   /***************************************************************************/
-  /* Clean-up the cURL library.                                              */
+  /* Clean-up the cURL library, starting with the handles of the transfers,  */
+  /* none of which are in flight now the event handler has exited.           */
   /***************************************************************************/
+  for (ii = 0; ii <= EVEL_POST_MAX_WINDOW; ii++)
+  {
+    xfer = (ii < EVEL_POST_MAX_WINDOW) ? &evel_transfers[ii] :
+                                         &evel_priority_transfer;
+    if (xfer->handle != NULL)
+    {
+      curl_easy_cleanup(xfer->handle);
+    }
+    free(xfer->body);
+    free(xfer->compressed);
+    free(xfer->rx_chunk.memory);
+    memset(xfer, 0, sizeof(EVEL_TRANSFER));
+  }
+  evel_transfers_in_flight = 0;
+  while (evel_priority_count > 0)
+  {
+    free(evel_priority_posts[evel_priority_head].post.memory);
+    evel_priority_posts[evel_priority_head].post.memory = NULL;
+    evel_priority_head = (evel_priority_head + 1) % EVEL_PRIORITY_QUEUE_SIZE;
+    evel_priority_count--;
+  }
+  evel_spool_close();
+  if (curl_priority_share != NULL)
+  {
+    curl_share_cleanup(curl_priority_share);
+    curl_priority_share = NULL;
+  }
+  if (curl_multi != NULL)
+  {
+    curl_multi_cleanup(curl_multi);
+    curl_multi = NULL;
+  }
   if (curl_handle != NULL)
   {
     curl_easy_cleanup(curl_handle);
@@ -462,20 +996,28 @@ EVEL_ERR_CODES event_handler_terminate()
     curl_slist_free_all(hdr_chunk);
     hdr_chunk = NULL;
   }
+  if (hdr_chunk_gzip != NULL)
+  {
+    curl_slist_free_all(hdr_chunk_gzip);
+    hdr_chunk_gzip = NULL;
+  }
+  evel_compressor_free(&evel_compressor);
 
   /***************************************************************************/
-  /* Free off the stored API URL strings.                                    */
+  /* Free off the stored API URL strings, and forget the endpoints.          */
   /***************************************************************************/
-  if (evel_event_api_url != NULL)
+  pthread_mutex_lock(&evel_handler_mutex);
+  while (evel_num_endpoints > 0)
   {
-    free(evel_event_api_url);
-    evel_event_api_url = NULL;
-  }
-  if (evel_throt_api_url != NULL)
-  {
-    free(evel_throt_api_url);
-    evel_throt_api_url = NULL;
+    evel_num_endpoints--;
+    for (ii = 0; ii < EVEL_MAX_APIS; ii++)
+    {
+      free(evel_endpoints[evel_num_endpoints].urls[ii]);
+    }
+    memset(&evel_endpoints[evel_num_endpoints], 0, sizeof(EVEL_ENDPOINT));
   }
+  pthread_mutex_unlock(&evel_handler_mutex);
+  evel_endpoint_next = 0;
 
   EVEL_EXIT();
   return rc;
@@ -497,6 +1039,12 @@ EVEL_ERR_CODES event_handler_terminate()
 EVEL_ERR_CODES evel_post_event(EVENT_HEADER * event)
 {
   int rc = EVEL_SUCCESS;
+  int lane = 0;
+  EVEL_OVERFLOW_POLICIES policy = EVEL_OVERFLOW_DROP_NEWEST;
+  int timeout_ms = 0;
+  bool queued = false;
+  EVENT_ENCODED * encoded = NULL;
+  EVEL_COALESCE_ENTRY * entry = NULL;
 
   EVEL_ENTER();
 
@@ -514,12 +1062,92 @@ EVEL_ERR_CODES evel_post_event(EVENT_HEADER * event)
       (evt_handler_state == EVT_HANDLER_INACTIVE) ||
       (evt_handler_state == EVT_HANDLER_REQUEST_TERMINATE))
   {
-    if (ring_buffer_write(&event_buffer, event) == 0)
+    /*************************************************************************/
+    /* Find out what happens if the queue is full while the domain and       */
+    /* source name are still to hand.                                        */
+    /*************************************************************************/
+    if (event->event_domain != EVEL_DOMAIN_INTERNAL)
+    {
+      policy = __atomic_load_n(&evel_overflow_policies[event->event_domain],
+                               __ATOMIC_RELAXED);
+      timeout_ms = __atomic_load_n(
+                              &evel_overflow_timeouts_ms[event->event_domain],
+                              __ATOMIC_RELAXED);
+      if (policy == EVEL_OVERFLOW_COALESCE)
+      {
+        entry = evel_coalesce_entry(event);
+      }
+    }
+
+    /*************************************************************************/
+    /* With producer encoding, the event is encoded here and only the JSON   */
+    /* is queued.  If that fails the event is queued as it is instead.       */
+    /*************************************************************************/
+    if ((event->event_domain != EVEL_DOMAIN_INTERNAL) &&
+        (__atomic_load_n(&evel_producer_encoding, __ATOMIC_RELAXED)))
+    {
+      encoded = evel_new_encoded_event(event);
+      if (encoded != NULL)
+      {
+        evel_free_event(event);
+        event = &encoded->internal.header;
+      }
+    }
+
+    /*************************************************************************/
+    /* Each priority has its own queue, so that when one is full only events */
+    /* of that priority are dropped.                                         */
+    /*************************************************************************/
+    lane = event->priority;
+    assert(lane < EVEL_MAX_PRIORITIES);
+
+    /*************************************************************************/
+    /* A coalescing event becomes the one from its source which a newer one  */
+    /* can replace, unless there already is one queued.  The lock is only    */
+    /* taken if the queue is full.                                           */
+    /*************************************************************************/
+    if ((entry != NULL) && (evel_coalesce_claim(entry)))
+    {
+      event->coalesce = entry;
+    }
+    queued = evel_event_enqueue(event, lane, 0);
+    if (!queued)
+    {
+      if (entry != NULL)
+      {
+        pthread_mutex_lock(&evel_coalesce_mutex);
+      }
+      if (event->coalesce != NULL)
+      {
+        event->coalesce = NULL;
+        evel_coalesce_unclaim(entry);
+      }
+      queued = evel_post_overflow(event, lane, policy, timeout_ms, entry);
+      if (entry != NULL)
+      {
+        pthread_mutex_unlock(&evel_coalesce_mutex);
+      }
+    }
+
+    if (!queued)
     {
       log_error_state("Failed to write event to buffer - event dropped!");
+      __atomic_add_fetch(&evel_lane_stats[lane].dropped, 1, __ATOMIC_RELAXED);
       rc = EVEL_EVENT_BUFFER_FULL;
       evel_free_event(event);
     }
+    else
+    {
+      __atomic_add_fetch(&evel_lane_stats[lane].queued, 1, __ATOMIC_RELAXED);
+      if (__atomic_load_n(&evel_handler_polling, __ATOMIC_SEQ_CST))
+      {
+        /*********************************************************************/
+        /* The event handler is waiting for posts to complete rather than    */
+        /* for events, so wake it up to take this one.                       */
+        /*********************************************************************/
+        curl_multi_wakeup(curl_multi);
+      }
+    }
   }
   else
   {
@@ -536,135 +1164,71 @@ EVEL_ERR_CODES evel_post_event(EVENT_HEADER * event)
 }
 
 /**************************************************************************//**
- * Post an event to the Vendor Event Listener API.
+ * Wait for the events already posted to be sent.
+ *
+ * @param timeout_ms  How long to wait, in milliseconds, or 0 not to wait, or
+ *                    -1 to wait indefinitely.
  *
  * @returns Status code
  * @retval  EVEL_SUCCESS On success
- * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ * @retval  EVEL_FLUSH_TIMEOUT Events were still being sent at the timeout.
+ * @retval  EVEL_EVENT_HANDLER_INACTIVE The event handler isn't running.
  *****************************************************************************/
-static EVEL_ERR_CODES evel_post_api(char * msg, size_t size)
+EVEL_ERR_CODES evel_flush(const int timeout_ms)
 {
-  int rc = EVEL_SUCCESS;
-  CURLcode curl_rc = CURLE_OK;
-  MEMORY_CHUNK rx_chunk;
-  MEMORY_CHUNK tx_chunk;
-  int http_response_code = 0;
+  const unsigned long long deadline_ms = evel_monotonic_ms() + timeout_ms;
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  struct timespec deadline;
 
   EVEL_ENTER();
 
   /***************************************************************************/
-  /* Create the memory chunk to be used for the response to the post.  The   */
-  /* will be realloced.                                                      */
-  /***************************************************************************/
-  rx_chunk.memory = malloc(1);
-  assert(rx_chunk.memory != NULL);
-  rx_chunk.size = 0;
-
-  /***************************************************************************/
-  /* Create the memory chunk to be sent as the body of the post.             */
+  /* Check preconditions.                                                    */
   /***************************************************************************/
-  tx_chunk.memory = msg;
-  tx_chunk.size = size;
-  EVEL_DEBUG("Sending chunk of size %d", tx_chunk.size);
+  assert(timeout_ms >= -1);
 
-  /***************************************************************************/
-  /* Point to the data to be received.                                       */
-  /***************************************************************************/
-  curl_rc = curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, &rx_chunk);
-  if (curl_rc != CURLE_OK)
-  {
-    rc = EVEL_CURL_LIBRARY_FAIL;
-    log_error_state("Failed to initialize libCURL to upload. "
-                    "Error code=%d (%s)", curl_rc, curl_err_string);
-    goto exit_label;
-  }
-  EVEL_DEBUG("Initialized data to receive");
+  deadline.tv_sec = deadline_ms / 1000;
+  deadline.tv_nsec = (deadline_ms % 1000) * 1000000L;
 
   /***************************************************************************/
-  /* Pointer to pass to our read function                                    */
+  /* We're done once the event handler has sent everything it took from the  */
+  /* queues and there is nothing left in them.  Events posted since we       */
+  /* started may keep us waiting, too.  The event handler only says it has   */
+  /* sent everything when it holds back no internal event, so we needn't     */
+  /* look at that, which only the event handler may.                         */
   /***************************************************************************/
-  curl_rc = curl_easy_setopt(curl_handle, CURLOPT_READDATA, &tx_chunk);
-  if (curl_rc != CURLE_OK)
+  pthread_mutex_lock(&evel_flush_mutex);
+  while (1)
   {
-    rc = EVEL_CURL_LIBRARY_FAIL;
-    log_error_state("Failed to set upload data for libCURL to upload. "
-                    "Error code=%d (%s)", curl_rc, curl_err_string);
-    goto exit_label;
+    if ((evt_handler_state != EVT_HANDLER_ACTIVE) &&
+        (evt_handler_state != EVT_HANDLER_INACTIVE))
+    {
+      rc = EVEL_EVENT_HANDLER_INACTIVE;
+      break;
+    }
+    if ((evel_handler_flushed) && (evel_queues_empty()))
+    {
+      break;
+    }
+    if ((timeout_ms >= 0) && (evel_monotonic_ms() >= deadline_ms))
+    {
+      rc = EVEL_FLUSH_TIMEOUT;
+      break;
+    }
+    if (timeout_ms < 0)
+    {
+      pthread_cond_wait(&evel_flush_cv, &evel_flush_mutex);
+    }
+    else
+    {
+      pthread_cond_timedwait(&evel_flush_cv, &evel_flush_mutex, &deadline);
+    }
   }
-  EVEL_DEBUG("Initialized data to send");
+  pthread_mutex_unlock(&evel_flush_mutex);
 
-  /***************************************************************************/
-  /* Size of the data to transmit.                                           */
-  /***************************************************************************/
-  curl_rc = curl_easy_setopt(curl_handle,
-                             CURLOPT_POSTFIELDSIZE,
-                             tx_chunk.size);
-  if (curl_rc != CURLE_OK)
-  {
-    rc = EVEL_CURL_LIBRARY_FAIL;
-    log_error_state("Failed to set length of upload data for libCURL to "
-                    "upload.  Error code=%d (%s)", curl_rc, curl_err_string);
-    goto exit_label;
-  }
-  EVEL_DEBUG("Initialized length of data to send");
-
-  /***************************************************************************/
-  /* Now run off and do what you've been told!                               */
-  /***************************************************************************/
-  curl_rc = curl_easy_perform(curl_handle);
-  if (curl_rc != CURLE_OK)
-  {
-    rc = EVEL_CURL_LIBRARY_FAIL;
-    log_error_state("Failed to transfer an event to Vendor Event Listener! "
-                    "Error code=%d (%s)", curl_rc, curl_err_string);
-    EVEL_ERROR("Dropped event: %s", msg);
-    goto exit_label;
-  }
-
-  /***************************************************************************/
-  /* See what response we got - any 2XX response is good.                    */
-  /***************************************************************************/
-  curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &http_response_code);
-  EVEL_DEBUG("HTTP response code: %d", http_response_code);
-  if ((http_response_code / 100) == 2)
-  {
-    /*************************************************************************/
-    /* If the server responded with data it may be interesting but not a     */
-    /* problem.                                                              */
-    /*************************************************************************/
-    if ((rx_chunk.size > 0) && (rx_chunk.memory != NULL))
-    {
-      EVEL_DEBUG("Server returned data = %d (%s)",
-                 rx_chunk.size,
-                 rx_chunk.memory);
-
-      /***********************************************************************/
-      /* If this is a response to priority post, then we're not interested.  */
-      /***********************************************************************/
-      if (priority_post.memory != NULL)
-      {
-        EVEL_ERROR("Ignoring priority post response");
-      }
-      else
-      {
-        evel_handle_event_response(&rx_chunk, &priority_post);
-      }
-    }
-  }
-  else
-  {
-    EVEL_ERROR("Unexpected HTTP response code: %d with data size %d (%s)",
-                http_response_code,
-                rx_chunk.size,
-                rx_chunk.size > 0 ? rx_chunk.memory : "NONE");
-    EVEL_ERROR("Potentially dropped event: %s", msg);
-  }
-
-exit_label:
-  free(rx_chunk.memory);
-  EVEL_EXIT();
-  return(rc);
-}
+  EVEL_EXIT();
+  return rc;
+}
 
 /**************************************************************************//**
  * Callback function to provide data to send.
@@ -687,7 +1251,7 @@ static size_t read_callback(void *ptr, size_t size, size_t nmemb, void *userp)
   if (bytes_to_write > 0)
   {
     EVEL_DEBUG("Going to try to write %d bytes", bytes_to_write);
-    strncpy((char *)ptr, tx_chunk->memory, bytes_to_write);
+    memcpy(ptr, tx_chunk->memory, bytes_to_write);
     tx_chunk->memory += bytes_to_write;
     tx_chunk->size -= bytes_to_write;
     rtn = bytes_to_write;
@@ -752,11 +1316,22 @@ static void * event_handler(void * arg __attribute__ ((unused)))
 {
   int old_type = 0;
   EVENT_HEADER * msg = NULL;
-  EVENT_INTERNAL * internal_msg = NULL;
+  EVENT_HEADER * pending_msg = NULL;
+  EVENT_ENCODED * encoded = NULL;
+  EVEL_TRANSFER * xfer = NULL;
+  EVEL_RETRY * retry = NULL;
+  EVEL_API api = EVEL_API_EVENT;
+  EVEL_JSON_ARENA * arena = NULL;
   int json_size = 0;
-  char json_body[EVEL_MAX_JSON_BODY];
   int rc = EVEL_SUCCESS;
-  CURLcode curl_rc;
+  int max_events = 0;
+  int window = 0;
+  void * msgs[EVEL_DRAIN_BATCH];
+  int num_msgs = 0;
+  unsigned long long deadline_ms = 0;
+  unsigned long long now_ms = 0;
+  int lane;
+  int ii;
 
   EVEL_INFO("Event handler thread started");
 
@@ -765,12 +1340,24 @@ static void * event_handler(void * arg __attribute__ ((unused)))
   /***************************************************************************/
   pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, &old_type);
 
+  /***************************************************************************/
+  /* Events are encoded in this thread's JSON arena, which grows to fit the  */
+  /* largest event and is then reused.                                       */
+  /***************************************************************************/
+  arena = evel_json_thread_arena();
+  evel_retry_seed = (unsigned int) (time(NULL) ^ (time_t) getpid());
+
   /***************************************************************************/
   /* Set the handler as active, defending against weird situations like      */
   /* immediately shutting down after initializing the library so the         */
   /* handler never gets started up properly.                                 */
   /***************************************************************************/
-  if (evt_handler_state == EVT_HANDLER_INACTIVE)
+  if (arena == NULL)
+  {
+    EVEL_ERROR("Event Handler has no JSON arena - "
+               "Handler will exit immediately!");
+  }
+  else if (evt_handler_state == EVT_HANDLER_INACTIVE)
   {
     evt_handler_state = EVT_HANDLER_ACTIVE;
   }
@@ -782,96 +1369,173 @@ static void * event_handler(void * arg __attribute__ ((unused)))
 
   while (evt_handler_state == EVT_HANDLER_ACTIVE)
   {
-    /*************************************************************************/
-    /* Wait for a message to be received.                                    */
-    /*************************************************************************/
-    EVEL_DEBUG("Event handler getting any messages");
-    msg = ring_buffer_read(&event_buffer);
+    pthread_mutex_lock(&evel_handler_mutex);
+    max_events = evel_batch_max_events;
+    window = evel_post_window;
+    memcpy(evel_lane_quota, evel_lane_weights, sizeof(evel_lane_quota));
+    pthread_mutex_unlock(&evel_handler_mutex);
 
     /*************************************************************************/
-    /* Internal events get special treatment while regular events get posted */
-    /* to the far side.                                                      */
+    /* Start posts until the window is full or we run out of events.         */
     /*************************************************************************/
-    if (msg->event_domain != EVEL_DOMAIN_INTERNAL)
+    while ((evt_handler_state == EVT_HANDLER_ACTIVE) &&
+           (evel_transfers_in_flight < window))
     {
-      EVEL_DEBUG("External event received");
-
       /***********************************************************************/
-      /* Encode the event in JSON.                                           */
+      /* Take any event left over from the last batch first, then any post   */
+      /* due to be retried or replayed from the spool.  Otherwise, if nothing*/
+      /* is in flight or waiting to be sent there's nothing to do but wait   */
+      /* for an event, else only take an event if one is waiting.            */
       /***********************************************************************/
-      json_size = evel_json_encode_event(json_body, EVEL_MAX_JSON_BODY, msg);
+      if (pending_msg != NULL)
+      {
+        msg = pending_msg;
+        pending_msg = NULL;
+      }
+      else if ((evel_retry_head != NULL) && (evel_retry_wait_ms() == 0))
+      {
+        /*********************************************************************/
+        /* Posts due to be retried go ahead of new events.                   */
+        /*********************************************************************/
+        evel_retry_start();
+        continue;
+      }
+      else if (evel_replay_due())
+      {
+        evel_replay_start();
+        continue;
+      }
+      else if ((evel_transfers_in_flight == 0) &&
+               (!evel_priority_transfer.in_use) &&
+               (evel_retry_head == NULL) &&
+               (!evel_spool_pending()))
+      {
+        EVEL_DEBUG("Event handler getting any messages");
+        msg = evel_event_read(true);
+      }
+      else if (evel_events_queued())
+      {
+        msg = evel_event_read(false);
+      }
+      else
+      {
+        /*********************************************************************/
+        /* Nothing is queued, so unless posts are in flight or waiting to be */
+        /* retried everything has been sent.                                 */
+        /*********************************************************************/
+        evel_flush_signal((evel_transfers_in_flight == 0) &&
+                          (!evel_priority_transfer.in_use) &&
+                          (evel_retry_head == NULL));
+        break;
+      }
 
       /***********************************************************************/
-      /* Send the JSON across the API.                                       */
+      /* Internal commands get special treatment while regular events, and   */
+      /* those already encoded, get posted to the far side.                  */
       /***********************************************************************/
-      EVEL_DEBUG("Sending JSON of size %d is: %s", json_size, json_body);
-      rc = evel_post_api(json_body, json_size);
-      if (rc != EVEL_SUCCESS)
+      if (evel_event_command(msg) == EVT_CMD_TERMINATE)
       {
-        EVEL_ERROR("Failed to transfer the data. Error code=%d", rc);
+        EVEL_DEBUG("Internal event received");
+        evt_handler_state = EVT_HANDLER_TERMINATING;
+        evel_free_event(msg);
+        msg = NULL;
+        break;
       }
-    }
-    else
-    {
-      EVEL_DEBUG("Internal event received");
-      internal_msg = (EVENT_INTERNAL *) msg;
-      assert(internal_msg->command == EVT_CMD_TERMINATE);
-      evt_handler_state = EVT_HANDLER_TERMINATING;
-    }
 
-    /*************************************************************************/
-    /* We are responsible for freeing the memory.                            */
-    /*************************************************************************/
-    evel_free_event(msg);
-    msg = NULL;
-
-    /*************************************************************************/
-    /* There may be a single priority post to be sent.                       */
-    /*************************************************************************/
-    if (priority_post.memory != NULL)
-    {
-      EVEL_DEBUG("Priority Post");
+      EVEL_DEBUG("External event received");
+      xfer = evel_transfer_get();
+      if (xfer == NULL)
+      {
+        EVEL_ERROR("No transfer available - event dropped!");
+        evel_free_event(msg);
+        msg = NULL;
+        continue;
+      }
 
-      /***********************************************************************/
-      /* Set the URL for the throttling API.                                 */
-      /***********************************************************************/
-      curl_rc = curl_easy_setopt(curl_handle, CURLOPT_URL, evel_throt_api_url);
-      if (curl_rc != CURLE_OK)
+      if (max_events > 1)
       {
         /*********************************************************************/
-        /* This is only likely to happen with CURLE_OUT_OF_MEMORY, in which  */
-        /* case we carry on regardless.                                      */
+        /* Batch this event up with any others that follow it.  The batch    */
+        /* takes responsibility for freeing the events it holds.             */
         /*********************************************************************/
-        EVEL_ERROR("Failed to set throttling URL. Error code=%d", rc);
+        pending_msg = evel_build_batch(xfer, msg, arena);
+        api = EVEL_API_BATCH;
       }
       else
       {
-        rc = evel_post_api(priority_post.memory, priority_post.size);
-        if (rc != EVEL_SUCCESS)
+        /*********************************************************************/
+        /* Encode the event in JSON and copy it into the body of the post.   */
+        /* An event which is already encoded just needs wrapping up.         */
+        /*********************************************************************/
+        if (evel_event_command(msg) == EVT_CMD_POST_ENCODED)
         {
-          EVEL_ERROR("Failed to transfer priority post. Error code=%d", rc);
+          encoded = (EVENT_ENCODED *) msg;
+          evel_transfer_reserve(xfer,
+                                encoded->json_size + EVEL_BATCH_FRAMING_SIZE);
+          json_size = sprintf(xfer->body, "{\"event\": ");
+          memcpy(xfer->body + json_size, encoded->json, encoded->json_size);
+          json_size += encoded->json_size;
+          json_size += sprintf(xfer->body + json_size, "}");
         }
-      }
+        else
+        {
+          json_size = evel_json_encode_event_arena(arena, msg);
+          evel_transfer_reserve(xfer, json_size + 1);
+          memcpy(xfer->body, arena->json, json_size + 1);
+        }
+        xfer->body_size = json_size;
+        xfer->num_events = 1;
+        api = EVEL_API_EVENT;
 
-      /***********************************************************************/
-      /* Reinstate the URL for the event API.                                */
-      /***********************************************************************/
-      curl_rc = curl_easy_setopt(curl_handle, CURLOPT_URL, evel_event_api_url);
-      if (curl_rc != CURLE_OK)
-      {
         /*********************************************************************/
-        /* This is only likely to happen with CURLE_OUT_OF_MEMORY, in which  */
-        /* case we carry on regardless.                                      */
+        /* We are responsible for freeing the memory.                        */
         /*********************************************************************/
-        EVEL_ERROR("Failed to reinstate events URL. Error code=%d", rc);
+        evel_free_event(msg);
       }
+      msg = NULL;
 
       /***********************************************************************/
-      /* We are responsible for freeing the memory.                          */
+      /* Send the JSON across the API.                                       */
       /***********************************************************************/
-      free(priority_post.memory);
-      priority_post.memory = NULL;
+      EVEL_DEBUG("Sending JSON of size %d is: %s", xfer->body_size, xfer->body);
+      xfer->attempts = 0;
+      xfer->spooled = false;
+      rc = evel_transfer_start(xfer, api, evel_endpoint_select());
+      if (rc != EVEL_SUCCESS)
+      {
+        EVEL_ERROR("Failed to transfer the data. Error code=%d", rc);
+        evel_retry_post(xfer, 0, false);
+      }
+    }
+
+    /*************************************************************************/
+    /* Make progress on the posts in flight, waking for new events only if   */
+    /* there's room in the window to send them.                              */
+    /*************************************************************************/
+    evel_transfers_run(evel_transfers_in_flight < window,
+                       EVEL_POLL_TIMEOUT_MS);
+  }
+
+  /***************************************************************************/
+  /* Let the posts already in flight complete, which they will do within the */
+  /* API timeout, unless we have to exit by a deadline before then.          */
+  /***************************************************************************/
+  deadline_ms = __atomic_load_n(&evel_exit_deadline_ms, __ATOMIC_RELAXED);
+  while ((evel_transfers_in_flight > 0) ||
+         (evel_priority_transfer.in_use) ||
+         (evel_priority_count > 0))
+  {
+    now_ms = evel_monotonic_ms();
+    if ((deadline_ms != 0) && (now_ms >= deadline_ms))
+    {
+      evel_transfers_abort();
+      break;
     }
+    evel_transfers_run(false,
+                       (deadline_ms != 0) ?
+                       (int) min(deadline_ms - now_ms,
+                                 (unsigned long long) EVEL_POLL_TIMEOUT_MS) :
+                       EVEL_POLL_TIMEOUT_MS);
   }
 
   /***************************************************************************/
@@ -881,18 +1545,2759 @@ static void * event_handler(void * arg __attribute__ ((unused)))
   /* sending events in so we know that this process will conclude!           */
   /***************************************************************************/
   evt_handler_state = EVT_HANDLER_TERMINATING;
-  while (!ring_buffer_is_empty(&event_buffer))
+  evel_free_event(pending_msg);
+  for (lane = 0; lane < EVEL_MAX_PRIORITIES; lane++)
   {
-    EVEL_DEBUG("Reading event from buffer");
-    msg = ring_buffer_read(&event_buffer);
-    evel_free_event(msg);
+    while ((num_msgs = ring_buffer_read_many(&event_buffers[lane],
+                                             msgs,
+                                             EVEL_DRAIN_BATCH,
+                                             0)) > 0)
+    {
+      EVEL_DEBUG("Read %d events from buffer", num_msgs);
+      for (ii = 0; ii < num_msgs; ii++)
+      {
+        evel_free_event(msgs[ii]);
+      }
+    }
+  }
+  evel_free_event(evel_deferred_internal);
+  evel_deferred_internal = NULL;
+  evel_free_event(__atomic_exchange_n(&evel_displaced_command,
+                                      NULL,
+                                      __ATOMIC_ACQUIRE));
+  evel_coalesce_free();
+  __atomic_store_n(&evel_queued_bytes, 0, __ATOMIC_RELAXED);
+
+  /***************************************************************************/
+  /* Posts still waiting to be retried are spooled, if there's a spool, or   */
+  /* dropped.                                                                */
+  /***************************************************************************/
+  while (evel_retry_head != NULL)
+  {
+    retry = evel_retry_head;
+    evel_retry_head = retry->next;
+    evel_post_undeliverable(retry->body, retry->api, retry->num_events);
+    free(retry);
   }
+  evel_retry_tail = NULL;
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_retry_stats.queued_posts = 0;
+  evel_retry_stats.queued_bytes = 0;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  /***************************************************************************/
+  /* Wake anyone still flushing, who will find that we have gone.            */
+  /***************************************************************************/
   evt_handler_state = EVT_HANDLER_TERMINATED;
+  evel_flush_signal(true);
   EVEL_INFO("Event handler thread stopped");
 
   return (NULL);
 }
 
+/**************************************************************************//**
+ * Collect a batch of events into the body of a post, as a single eventList.
+ *
+ * Starting with the supplied event, events are taken from the ring-buffer
+ * until one of the batch limits is reached.  Each event is encoded and freed
+ * as it is added to the batch.
+ *
+ * @param xfer        The transfer which will post the batch.
+ * @param first       The first event of the batch.
+ * @param arena       The JSON arena in which to encode each event.
+ * @returns An event taken from the ring-buffer which did not make it into the
+ *          batch, and which the caller must handle next, or NULL.
+ *****************************************************************************/
+static EVENT_HEADER * evel_build_batch(EVEL_TRANSFER * const xfer,
+                                       EVENT_HEADER * first,
+                                       EVEL_JSON_ARENA * const arena)
+{
+  EVENT_HEADER * msg = first;
+  EVENT_HEADER * next_msg = NULL;
+  int max_events = 0;
+  int max_bytes = 0;
+  int max_wait_ms = 0;
+  int offset = 0;
+  int json_size = 0;
+  int num_events = 0;
+  int bucket = 0;
+  struct timespec deadline;
+  char * body = NULL;
+  const char * json = NULL;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(xfer != NULL);
+  assert(first != NULL);
+  assert(evel_event_command(first) != EVT_CMD_TERMINATE);
+  assert(arena != NULL);
+
+  /***************************************************************************/
+  /* Take the current limits, which apply for the whole of this batch.       */
+  /***************************************************************************/
+  pthread_mutex_lock(&evel_handler_mutex);
+  max_events = evel_batch_max_events;
+  max_bytes = evel_batch_max_bytes;
+  max_wait_ms = evel_batch_max_wait_ms;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  /***************************************************************************/
+  /* Make sure the body can hold a full batch.  It only needs to grow beyond */
+  /* that for a single event which is larger than the batch limit.           */
+  /***************************************************************************/
+  evel_transfer_reserve(xfer, max_bytes + EVEL_BATCH_FRAMING_SIZE);
+
+  /***************************************************************************/
+  /* The wait for the batch to fill is measured from now.                    */
+  /***************************************************************************/
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += max_wait_ms / 1000;
+  deadline.tv_nsec += (max_wait_ms % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  offset = sprintf(xfer->body, "{\"eventList\": [");
+  while (msg != NULL)
+  {
+    /*************************************************************************/
+    /* Encode the event on its own, unless it is already encoded, then see   */
+    /* whether it fits in the batch.  The first event always goes in,        */
+    /* however big it is.                                                    */
+    /*************************************************************************/
+    if (evel_event_command(msg) == EVT_CMD_POST_ENCODED)
+    {
+      json = ((EVENT_ENCODED *) msg)->json;
+      json_size = ((EVENT_ENCODED *) msg)->json_size;
+    }
+    else
+    {
+      json_size = evel_json_encode_event_list_entry_arena(arena, msg);
+      json = arena->json;
+    }
+    if ((num_events > 0) &&
+        (offset + json_size + EVEL_BATCH_FRAMING_SIZE > max_bytes))
+    {
+      EVEL_DEBUG("Batch full at %d bytes", offset);
+      next_msg = msg;
+      break;
+    }
+
+    evel_transfer_reserve(xfer,
+                          offset + json_size + EVEL_BATCH_FRAMING_SIZE);
+    body = xfer->body;
+    if (num_events > 0)
+    {
+      memcpy(body + offset, ", ", 2);
+      offset += 2;
+    }
+    memcpy(body + offset, json, json_size);
+    offset += json_size;
+    num_events++;
+
+    /*************************************************************************/
+    /* A high priority event doesn't wait for the batch to fill, although it */
+    /* takes any events already queued with it.                              */
+    /*************************************************************************/
+    if (msg->priority == EVEL_PRIORITY_HIGH)
+    {
+      clock_gettime(CLOCK_MONOTONIC, &deadline);
+    }
+    evel_free_event(msg);
+    msg = NULL;
+
+    if (num_events >= max_events)
+    {
+      break;
+    }
+
+    /*************************************************************************/
+    /* Get the next event.  Internal commands are left for the caller.       */
+    /*************************************************************************/
+    msg = evel_batch_next_event(&deadline);
+    if ((msg != NULL) && (evel_event_command(msg) == EVT_CMD_TERMINATE))
+    {
+      next_msg = msg;
+      msg = NULL;
+    }
+  }
+  offset += sprintf(xfer->body + offset, "]}");
+  xfer->body_size = offset;
+  xfer->num_events = num_events;
+  EVEL_DEBUG("Built batch of %d events, size %d", num_events, offset);
+
+  /***************************************************************************/
+  /* Record the size of the batch.                                           */
+  /***************************************************************************/
+  while ((bucket < EVEL_BATCH_SIZE_BUCKETS - 1) &&
+         ((num_events >> (bucket + 1)) != 0))
+  {
+    bucket++;
+  }
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_batch_stats.batches++;
+  evel_batch_stats.events += num_events;
+  evel_batch_stats.bytes += offset;
+  evel_batch_stats.largest_batch = max(evel_batch_stats.largest_batch,
+                                       num_events);
+  evel_batch_stats.size_histogram[bucket]++;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  EVEL_EXIT();
+
+  return next_msg;
+}
+
+/**************************************************************************//**
+ * Get the next event for a batch, waiting until the deadline for one to be
+ * queued if there are none already.
+ *
+ * @param deadline    The time, on the monotonic clock, to stop waiting.
+ * @returns The next event, or NULL if the deadline passed with none queued.
+ *****************************************************************************/
+static EVENT_HEADER * evel_batch_next_event(const struct timespec * deadline)
+{
+  EVENT_HEADER * msg = NULL;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Wait on the ring-buffers until there is an event or the deadline.       */
+  /***************************************************************************/
+  while ((msg = evel_event_read(false)) == NULL)
+  {
+    if (!ring_buffer_wait(event_buffers, EVEL_MAX_PRIORITIES, deadline))
+    {
+      break;
+    }
+  }
+
+  EVEL_EXIT();
+
+  return msg;
+}
+
+/**************************************************************************//**
+ * Get the next event from the queues.
+ *
+ * An internal event is held back until the queues are otherwise empty, so
+ * that events queued before it are still sent.
+ *
+ * @param wait        Whether to wait for an event if there are none queued,
+ *                    which the caller only does once it has nothing else
+ *                    left to send.
+ * @returns The next event, or NULL if there are none and we're not waiting.
+ *****************************************************************************/
+static EVENT_HEADER * evel_event_read(const bool wait)
+{
+  EVENT_HEADER * msg = NULL;
+
+  EVEL_ENTER();
+
+  while (1)
+  {
+    msg = evel_event_try_read();
+    if ((msg != NULL) &&
+        (evel_event_command(msg) == EVT_CMD_TERMINATE) &&
+        (evel_deferred_internal == NULL) &&
+        (evel_events_queued()))
+    {
+      EVEL_DEBUG("Holding back internal event");
+      evel_deferred_internal = msg;
+      continue;
+    }
+    if ((msg == NULL) && (evel_deferred_internal != NULL))
+    {
+      msg = evel_deferred_internal;
+      evel_deferred_internal = NULL;
+    }
+    if ((msg != NULL) || (!wait))
+    {
+      break;
+    }
+    evel_flush_signal(true);
+    ring_buffer_wait(event_buffers, EVEL_MAX_PRIORITIES, NULL);
+  }
+
+  EVEL_EXIT();
+
+  return msg;
+}
+
+/**************************************************************************//**
+ * Take the next event from the queues without waiting.
+ *
+ * The queues are tried highest priority first.  With weights, each queue
+ * only supplies its weight of events before the lower priority queues get a
+ * turn, and once none of the queues with events has any turn left every
+ * queue gets a fresh turn.  An event which a newer one from the same source
+ * has replaced is freed, and the newer one returned in its place.
+ *
+ * @returns The next event, or NULL if the queues are empty.
+ *****************************************************************************/
+static EVENT_HEADER * evel_event_try_read(void)
+{
+  EVENT_HEADER * msg = NULL;
+  int turn;
+  int lane;
+
+  /***************************************************************************/
+  /* Any event taken has yet to be sent, which we say before taking it so    */
+  /* that a thread flushing sees either the event or that we're not done.    */
+  /***************************************************************************/
+  evel_flush_signal(false);
+
+  for (turn = 0; (turn < 2) && (msg == NULL); turn++)
+  {
+    for (lane = 0; (lane < EVEL_MAX_PRIORITIES) && (msg == NULL); lane++)
+    {
+      if ((evel_lane_quota[lane] == 0) || (evel_lane_credits[lane] > 0))
+      {
+        msg = ring_buffer_try_read(&event_buffers[lane]);
+        if ((msg != NULL) && (evel_lane_quota[lane] > 0))
+        {
+          evel_lane_credits[lane]--;
+        }
+      }
+    }
+    if (msg == NULL)
+    {
+      memcpy(evel_lane_credits, evel_lane_quota, sizeof(evel_lane_credits));
+    }
+  }
+
+  /***************************************************************************/
+  /* A command displaced from a full queue is taken once the queues are      */
+  /* empty, and a queued event may have been replaced by a newer one.        */
+  /***************************************************************************/
+  if (msg == NULL)
+  {
+    msg = __atomic_exchange_n(&evel_displaced_command, NULL, __ATOMIC_ACQUIRE);
+  }
+  if (msg != NULL)
+  {
+    evel_budget_release(msg);
+    if (msg->coalesce != NULL)
+    {
+      msg = evel_coalesce_take(msg);
+    }
+  }
+
+  return msg;
+}
+
+/**************************************************************************//**
+ * Check whether there are any events waiting to be taken from the queues,
+ * including an internal event held back.  Only called by the event handler.
+ *
+ * @returns true if there are events waiting, or false.
+ *****************************************************************************/
+static bool evel_events_queued(void)
+{
+  return (evel_deferred_internal != NULL) || (!evel_queues_empty());
+}
+
+/**************************************************************************//**
+ * Check whether the queues are empty, and no command has been set aside for
+ * the event handler.  May be called from any thread.
+ *
+ * @returns true if there are no events waiting in the queues, or false.
+ *****************************************************************************/
+static bool evel_queues_empty(void)
+{
+  bool empty = (__atomic_load_n(&evel_displaced_command,
+                                __ATOMIC_ACQUIRE) == NULL);
+  int lane;
+
+  for (lane = 0; (lane < EVEL_MAX_PRIORITIES) && (empty); lane++)
+  {
+    empty = ring_buffer_is_empty(&event_buffers[lane]);
+  }
+
+  return empty;
+}
+
+/**************************************************************************//**
+ * Record whether the event handler has sent everything it has taken from the
+ * queues, waking any threads flushing if it has.
+ *
+ * @param flushed     Whether everything has been sent.
+ *****************************************************************************/
+static void evel_flush_signal(const bool flushed)
+{
+  if (flushed != evel_handler_flushed)
+  {
+    pthread_mutex_lock(&evel_flush_mutex);
+    evel_handler_flushed = flushed;
+    if (flushed)
+    {
+      pthread_cond_broadcast(&evel_flush_cv);
+    }
+    pthread_mutex_unlock(&evel_flush_mutex);
+  }
+}
+
+/**************************************************************************//**
+ * Get the internal command an event carries.
+ *
+ * @param msg         The event.
+ * @returns The command, or ::EVT_CMD_MAX_COMMANDS for an external event.
+ *****************************************************************************/
+static EVT_HANDLER_COMMAND evel_event_command(const EVENT_HEADER * const msg)
+{
+  EVT_HANDLER_COMMAND command = EVT_CMD_MAX_COMMANDS;
+
+  if (msg->event_domain == EVEL_DOMAIN_INTERNAL)
+  {
+    command = ((const EVENT_INTERNAL *) msg)->command;
+  }
+
+  return command;
+}
+
+/**************************************************************************//**
+ * Handle an event posted while its queue is full, according to the overflow
+ * policy of its domain.
+ *
+ * For ::EVEL_OVERFLOW_COALESCE, the caller holds the coalesce mutex.
+ *
+ * @param event       The event being posted.
+ * @param lane        The queue of the event.
+ * @param policy      The overflow policy of the event's domain.
+ * @param timeout_ms  How long the event may wait for room, in milliseconds.
+ * @param entry       The source of a coalescing event, or NULL.
+ * @returns Whether the event was queued, or replaced a queued one, rather
+ *          than being left for the caller to drop.
+ *****************************************************************************/
+static bool evel_post_overflow(EVENT_HEADER * const event,
+                               const int lane,
+                               const EVEL_OVERFLOW_POLICIES policy,
+                               const int timeout_ms,
+                               EVEL_COALESCE_ENTRY * const entry)
+{
+  EVEL_OVERFLOW_STATS * const stats = &evel_overflow_stats[policy];
+  EVENT_HEADER * victim = NULL;
+  unsigned long long start_ms = 0;
+  bool queued = false;
+  int attempt;
+
+  EVEL_ENTER();
+
+  __atomic_add_fetch(&stats->overflows, 1, __ATOMIC_RELAXED);
+
+  switch (policy)
+  {
+    case EVEL_OVERFLOW_DROP_OLDEST:
+      /***********************************************************************/
+      /* Take the oldest event out of the queue and try again, which may     */
+      /* take a few goes if other threads posting take the room first.       */
+      /***********************************************************************/
+      for (attempt = 0;
+           (attempt < event_buffers[lane].size) && (!queued);
+           attempt++)
+      {
+        victim = ring_buffer_try_read(&event_buffers[lane]);
+        if (victim == NULL)
+        {
+          break;
+        }
+        if (evel_event_displace(victim))
+        {
+          __atomic_add_fetch(&stats->replaced, 1, __ATOMIC_RELAXED);
+        }
+        queued = evel_event_enqueue(event, lane, 0);
+      }
+      break;
+
+    case EVEL_OVERFLOW_BLOCK:
+      start_ms = evel_monotonic_ms();
+      queued = evel_event_enqueue(event, lane, timeout_ms);
+      __atomic_add_fetch(&stats->waited_ms,
+                         evel_monotonic_ms() - start_ms,
+                         __ATOMIC_RELAXED);
+      break;
+
+    case EVEL_OVERFLOW_COALESCE:
+      /***********************************************************************/
+      /* Take the place of the newer event waiting to replace the queued one */
+      /* from the same source, or become it.                                 */
+      /***********************************************************************/
+      if ((entry != NULL) && (__atomic_load_n(&entry->queued,
+                                              __ATOMIC_ACQUIRE)))
+      {
+        if (entry->replacement != NULL)
+        {
+          evel_budget_release(entry->replacement);
+          evel_free_event(entry->replacement);
+          entry->replacement = NULL;
+          __atomic_add_fetch(&stats->replaced, 1, __ATOMIC_RELAXED);
+        }
+        if (evel_budget_reserve(event->size))
+        {
+          entry->replacement = event;
+          queued = true;
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  if (!queued)
+  {
+    __atomic_add_fetch(&stats->dropped, 1, __ATOMIC_RELAXED);
+  }
+
+  EVEL_EXIT();
+
+  return queued;
+}
+
+/**************************************************************************//**
+ * Dispose of an event taken out of a full queue to make room.
+ *
+ * A command for the event handler is set aside for it rather than dropped.
+ * Any newer event waiting to replace the event is dropped along with it.
+ *
+ * @param victim      The event taken out of the queue.
+ * @returns Whether the event was dropped.
+ *****************************************************************************/
+static bool evel_event_displace(EVENT_HEADER * const victim)
+{
+  EVT_HANDLER_COMMAND command = evel_event_command(victim);
+  EVENT_HEADER * displaced = NULL;
+  bool dropped = false;
+
+  EVEL_ENTER();
+
+  if ((command != EVT_CMD_MAX_COMMANDS) && (command != EVT_CMD_POST_ENCODED))
+  {
+    EVEL_DEBUG("Setting aside displaced command %d", command);
+    displaced = __atomic_exchange_n(&evel_displaced_command,
+                                    victim,
+                                    __ATOMIC_RELEASE);
+    assert(displaced == NULL);
+  }
+  else
+  {
+    if (victim->coalesce != NULL)
+    {
+      pthread_mutex_lock(&evel_coalesce_mutex);
+      __atomic_store_n(&victim->coalesce->queued, false, __ATOMIC_RELEASE);
+      if (victim->coalesce->replacement != NULL)
+      {
+        evel_budget_release(victim->coalesce->replacement);
+        evel_free_event(victim->coalesce->replacement);
+        victim->coalesce->replacement = NULL;
+      }
+      pthread_mutex_unlock(&evel_coalesce_mutex);
+    }
+    evel_budget_release(victim);
+    __atomic_add_fetch(&evel_lane_stats[victim->priority].dropped,
+                       1,
+                       __ATOMIC_RELAXED);
+    evel_free_event(victim);
+    dropped = true;
+  }
+
+  EVEL_EXIT();
+
+  return dropped;
+}
+
+/**************************************************************************//**
+ * Queue an event, if there is room for it in its queue and in the memory
+ * budget, waiting up to a timeout for room.
+ *
+ * @param event       The event.
+ * @param lane        The queue of the event.
+ * @param timeout_ms  How long to wait for room, in milliseconds, or 0 not to
+ *                    wait.
+ * @returns Whether the event was queued.
+ *****************************************************************************/
+static bool evel_event_enqueue(EVENT_HEADER * const event,
+                               const int lane,
+                               const int timeout_ms)
+{
+  const unsigned long long deadline_ms = evel_monotonic_ms() + timeout_ms;
+  unsigned long long now_ms = 0;
+  struct timespec deadline;
+  bool queued = false;
+
+  while (1)
+  {
+    now_ms = evel_monotonic_ms();
+    if (evel_budget_reserve(event->size))
+    {
+      queued = ring_buffer_write_timed(&event_buffers[lane],
+                                       event,
+                                       (deadline_ms > now_ms) ?
+                                       (int) (deadline_ms - now_ms) : 0);
+      if (!queued)
+      {
+        evel_budget_release(event);
+      }
+      break;
+    }
+    if (now_ms >= deadline_ms)
+    {
+      break;
+    }
+
+    /*************************************************************************/
+    /* Say that we're waiting before checking again under the lock, so that  */
+    /* the event handler either sees us waiting or we see the memory it      */
+    /* freed.                                                                */
+    /*************************************************************************/
+    deadline.tv_sec = deadline_ms / 1000;
+    deadline.tv_nsec = (deadline_ms % 1000) * 1000000L;
+    pthread_mutex_lock(&evel_budget_mutex);
+    __atomic_add_fetch(&evel_budget_waiters, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!evel_budget_fits(event->size))
+    {
+      pthread_cond_timedwait(&evel_budget_cv, &evel_budget_mutex, &deadline);
+    }
+    __atomic_sub_fetch(&evel_budget_waiters, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&evel_budget_mutex);
+  }
+
+  return queued;
+}
+
+/**************************************************************************//**
+ * Check whether the memory budget has room for an event.
+ *
+ * An event bigger than the whole budget still fits once the queues are
+ * empty, so that it isn't dropped however long it waits.
+ *
+ * @param size        The size of the event.
+ * @returns Whether the event fits.
+ *****************************************************************************/
+static bool evel_budget_fits(const size_t size)
+{
+  const size_t queued = __atomic_load_n(&evel_queued_bytes, __ATOMIC_RELAXED);
+
+  return ((evel_queue_max_bytes == 0) ||
+          (size == 0) ||
+          (queued == 0) ||
+          (queued + size <= evel_queue_max_bytes));
+}
+
+/**************************************************************************//**
+ * Reserve memory for an event in the memory budget, if it fits.
+ *
+ * @param size        The size of the event.
+ * @returns Whether the memory was reserved.
+ *****************************************************************************/
+static bool evel_budget_reserve(const size_t size)
+{
+  size_t queued = __atomic_load_n(&evel_queued_bytes, __ATOMIC_RELAXED);
+  bool reserved = true;
+
+  if ((evel_queue_max_bytes > 0) && (size > 0))
+  {
+    do
+    {
+      if ((queued > 0) && (queued + size > evel_queue_max_bytes))
+      {
+        reserved = false;
+        break;
+      }
+    } while (!__atomic_compare_exchange_n(&evel_queued_bytes,
+                                          &queued,
+                                          queued + size,
+                                          1,
+                                          __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED));
+  }
+
+  return reserved;
+}
+
+/**************************************************************************//**
+ * Release the memory reserved for an event in the memory budget, waking any
+ * threads waiting for memory.
+ *
+ * @param event       The event.
+ *****************************************************************************/
+static void evel_budget_release(const EVENT_HEADER * const event)
+{
+  if ((evel_queue_max_bytes > 0) && (event->size > 0))
+  {
+    __atomic_sub_fetch(&evel_queued_bytes, event->size, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&evel_budget_waiters, __ATOMIC_RELAXED))
+    {
+      pthread_mutex_lock(&evel_budget_mutex);
+      pthread_cond_broadcast(&evel_budget_cv);
+      pthread_mutex_unlock(&evel_budget_mutex);
+    }
+  }
+}
+
+/**************************************************************************//**
+ * Get the entry for the source of a coalescing event, adding one if this is
+ * the first event from the source.
+ *
+ * @param event       The event.
+ * @returns The entry, or NULL if memory could not be allocated.
+ *****************************************************************************/
+static EVEL_COALESCE_ENTRY * evel_coalesce_entry(
+                                             const EVENT_HEADER * const event)
+{
+  EVEL_COALESCE_ENTRY * entry = NULL;
+  const char * source = (event->source_name != NULL) ? event->source_name : "";
+  int key_size;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* The source name is NULL while it is the default, whose entry is found   */
+  /* without taking the lock once it exists.                                 */
+  /***************************************************************************/
+  if (event->source_name == NULL)
+  {
+    entry = __atomic_load_n(&evel_coalesce_defaults[event->event_domain],
+                            __ATOMIC_ACQUIRE);
+  }
+
+  if (entry == NULL)
+  {
+    pthread_mutex_lock(&evel_coalesce_mutex);
+    if (event->source_name == NULL)
+    {
+      entry = evel_coalesce_defaults[event->event_domain];
+    }
+    else
+    {
+      entry = hash_map_get(&evel_coalesce_maps[event->event_domain], source);
+    }
+    if (entry == NULL)
+    {
+      /***********************************************************************/
+      /* The entry keeps its own copy of the source name as its key.         */
+      /***********************************************************************/
+      key_size = strlen(source) + 1;
+      entry = malloc(sizeof(EVEL_COALESCE_ENTRY) + key_size);
+      if (entry != NULL)
+      {
+        entry->queued = false;
+        entry->replacement = NULL;
+        memcpy(entry->key, source, key_size);
+        if (event->source_name == NULL)
+        {
+          __atomic_store_n(&evel_coalesce_defaults[event->event_domain],
+                           entry,
+                           __ATOMIC_RELEASE);
+        }
+        else if (!hash_map_set(&evel_coalesce_maps[event->event_domain],
+                               entry->key,
+                               entry))
+        {
+          free(entry);
+          entry = NULL;
+        }
+      }
+      if (entry == NULL)
+      {
+        log_error_state("Failed to allocate coalesce entry");
+      }
+    }
+    pthread_mutex_unlock(&evel_coalesce_mutex);
+  }
+
+  EVEL_EXIT();
+
+  return entry;
+}
+
+/**************************************************************************//**
+ * Claim a source of coalescing events for an event about to be queued, if
+ * none of its events is queued already.
+ *
+ * @param entry       The source.
+ * @returns Whether the event claimed the source.
+ *****************************************************************************/
+static bool evel_coalesce_claim(EVEL_COALESCE_ENTRY * const entry)
+{
+  bool unclaimed = false;
+
+  return __atomic_compare_exchange_n(&entry->queued,
+                                     &unclaimed,
+                                     true,
+                                     false,
+                                     __ATOMIC_ACQ_REL,
+                                     __ATOMIC_RELAXED);
+}
+
+/**************************************************************************//**
+ * Give up the claim on a source of coalescing events when the event which
+ * claimed it couldn't be queued.
+ *
+ * A newer event may have been set to replace the one which was never queued,
+ * and there is then nothing for it to replace, so it is dropped, as it would
+ * have been had it been posted after the failure.  The caller holds the
+ * coalesce mutex.
+ *
+ * @param entry       The source.
+ *****************************************************************************/
+static void evel_coalesce_unclaim(EVEL_COALESCE_ENTRY * const entry)
+{
+  EVEL_ENTER();
+
+  if (entry->replacement != NULL)
+  {
+    evel_budget_release(entry->replacement);
+    evel_free_event(entry->replacement);
+    entry->replacement = NULL;
+    __atomic_add_fetch(&evel_overflow_stats[EVEL_OVERFLOW_COALESCE].dropped,
+                       1,
+                       __ATOMIC_RELAXED);
+  }
+  __atomic_store_n(&entry->queued, false, __ATOMIC_RELEASE);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Take a queued coalescing event off its source, swapping it for the newer
+ * event which has replaced it, if any.
+ *
+ * @param msg         The event taken from the queue.
+ * @returns The event to send.
+ *****************************************************************************/
+static EVENT_HEADER * evel_coalesce_take(EVENT_HEADER * msg)
+{
+  EVEL_COALESCE_ENTRY * entry = msg->coalesce;
+  EVENT_HEADER * replacement = NULL;
+
+  EVEL_ENTER();
+
+  pthread_mutex_lock(&evel_coalesce_mutex);
+  msg->coalesce = NULL;
+  replacement = entry->replacement;
+  entry->replacement = NULL;
+  __atomic_store_n(&entry->queued, false, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&evel_coalesce_mutex);
+
+  if (replacement != NULL)
+  {
+    EVEL_DEBUG("Sending coalesced event in place of queued one");
+    evel_budget_release(replacement);
+    evel_free_event(msg);
+    msg = replacement;
+  }
+
+  EVEL_EXIT();
+
+  return msg;
+}
+
+/**************************************************************************//**
+ * Free the sources of coalescing events, and any newer events still waiting
+ * to replace queued ones.
+ *****************************************************************************/
+static void evel_coalesce_free(void)
+{
+  EVEL_COALESCE_ENTRY * entry = NULL;
+  int domain;
+  int ii;
+
+  EVEL_ENTER();
+
+  pthread_mutex_lock(&evel_coalesce_mutex);
+  for (domain = 0; domain < EVEL_MAX_DOMAINS; domain++)
+  {
+    for (ii = 0; ii < hash_map_count(&evel_coalesce_maps[domain]); ii++)
+    {
+      entry = hash_map_value(&evel_coalesce_maps[domain], ii);
+      evel_free_event(entry->replacement);
+      free(entry);
+    }
+    hash_map_free(&evel_coalesce_maps[domain]);
+    hash_map_initialize(&evel_coalesce_maps[domain]);
+
+    entry = evel_coalesce_defaults[domain];
+    if (entry != NULL)
+    {
+      evel_free_event(entry->replacement);
+      free(entry);
+      evel_coalesce_defaults[domain] = NULL;
+    }
+  }
+  pthread_mutex_unlock(&evel_coalesce_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set the limits used to batch events into a single eventList post.
+ *
+ * @param max_events    Maximum number of events in a post.  Must be >= 1.
+ * @param max_bytes     Maximum size of a post body in bytes.  Must be > 0.
+ * @param max_wait_ms   Maximum time to wait for a batch to fill, in
+ *                      milliseconds.
+ *****************************************************************************/
+void evel_set_batch_limits(const int max_events,
+                           const int max_bytes,
+                           const int max_wait_ms)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(max_events >= 1);
+  assert(max_bytes > 0);
+  assert(max_wait_ms >= 0);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_batch_max_events = max_events;
+  evel_batch_max_bytes = max_bytes;
+  evel_batch_max_wait_ms = max_wait_ms;
+  pthread_mutex_unlock(&evel_handler_mutex);
+  EVEL_DEBUG("Batch limits set to %d events, %d bytes, %d ms",
+             max_events, max_bytes, max_wait_ms);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the batch statistics.
+ *
+ * @param stats     Pointer to the ::EVEL_BATCH_STATS to fill in.
+ *****************************************************************************/
+void evel_get_batch_stats(EVEL_BATCH_STATS * const stats)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(stats != NULL);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  *stats = evel_batch_stats;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set the number of posts the event handler keeps in flight at once.
+ *
+ * @param window    Number of posts.  Must be between 1 and
+ *                  ::EVEL_POST_MAX_WINDOW.
+ *****************************************************************************/
+void evel_set_post_window(const int window)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(window >= 1);
+  assert(window <= EVEL_POST_MAX_WINDOW);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_post_window = window;
+  pthread_mutex_unlock(&evel_handler_mutex);
+  EVEL_DEBUG("Post window set to %d", window);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get a transfer which is not in flight, ready to be used for a post.
+ *
+ * @returns The transfer, or NULL if none could be made ready.
+ *****************************************************************************/
+static EVEL_TRANSFER * evel_transfer_get(void)
+{
+  EVEL_TRANSFER * xfer = NULL;
+  int ii;
+
+  EVEL_ENTER();
+
+  for (ii = 0; ii < EVEL_POST_MAX_WINDOW; ii++)
+  {
+    if (!evel_transfers[ii].in_use)
+    {
+      xfer = &evel_transfers[ii];
+      break;
+    }
+  }
+
+  /***************************************************************************/
+  /* The window is never bigger than the number of transfers, so there must  */
+  /* have been one free, but it might not have a handle yet.                 */
+  /***************************************************************************/
+  assert(xfer != NULL);
+  if ((xfer->handle == NULL) && (evel_transfer_init(xfer) != EVEL_SUCCESS))
+  {
+    xfer = NULL;
+  }
+
+  EVEL_EXIT();
+
+  return xfer;
+}
+
+/**************************************************************************//**
+ * Give a transfer its own handle, which has the same settings as the
+ * template handle.
+ *
+ * @param xfer      The transfer.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_transfer_init(EVEL_TRANSFER * const xfer)
+{
+  int rc = EVEL_SUCCESS;
+  CURLcode curl_rc = CURLE_OK;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(xfer != NULL);
+  assert(xfer->handle == NULL);
+
+  xfer->handle = curl_easy_duphandle(curl_handle);
+  if (xfer->handle == NULL)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to get libCURL handle for transfer");
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Each transfer needs its own error buffer, and a way back from the handle*/
+  /* to the transfer when the post completes.                                */
+  /***************************************************************************/
+  curl_rc = curl_easy_setopt(xfer->handle,
+                             CURLOPT_ERRORBUFFER,
+                             xfer->err_string);
+  if (curl_rc == CURLE_OK)
+  {
+    curl_rc = curl_easy_setopt(xfer->handle, CURLOPT_PRIVATE, xfer);
+  }
+  if (curl_rc != CURLE_OK)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to initialize libCURL handle for transfer. "
+                    "Error code=%d", curl_rc);
+    curl_easy_cleanup(xfer->handle);
+    xfer->handle = NULL;
+    goto exit_label;
+  }
+
+exit_label:
+  EVEL_EXIT();
+
+  return(rc);
+}
+
+/**************************************************************************//**
+ * Make sure that the body of a transfer can hold a post of the given size.
+ *
+ * The body keeps its contents if it has to grow.
+ *
+ * @param xfer      The transfer.
+ * @param size      The size needed in bytes.
+ *****************************************************************************/
+static void evel_transfer_reserve(EVEL_TRANSFER * const xfer, const int size)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(xfer != NULL);
+  assert(!xfer->in_use);
+
+  if (xfer->body_capacity < size)
+  {
+    xfer->body = realloc(xfer->body, size);
+    assert(xfer->body != NULL);
+    xfer->body_capacity = size;
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Start posting the body of a transfer.
+ *
+ * @param xfer      The transfer.
+ * @param api       The API to post to.
+ * @param endpoint  The endpoint to post to.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_transfer_start(EVEL_TRANSFER * const xfer,
+                                          const EVEL_API api,
+                                          EVEL_ENDPOINT * const endpoint)
+{
+  int rc = EVEL_SUCCESS;
+  CURLcode curl_rc = CURLE_OK;
+  CURLMcode curl_mrc = CURLM_OK;
+  int level = 0;
+  int min_bytes = 0;
+  int compressed_size = -1;
+  bool compressed = false;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(xfer != NULL);
+  assert(xfer->handle != NULL);
+  assert(!xfer->in_use);
+  assert(api < EVEL_MAX_APIS);
+  assert(endpoint != NULL);
+
+  /***************************************************************************/
+  /* The response is received into memory kept from the last post, and the   */
+  /* body is sent from the transfer's own buffer.                            */
+  /***************************************************************************/
+  xfer->api = api;
+  xfer->endpoint = endpoint;
+  xfer->rx_chunk.size = 0;
+  xfer->tx_chunk.memory = xfer->body;
+  xfer->tx_chunk.size = xfer->body_size;
+  xfer->err_string[0] = '\0';
+
+  /***************************************************************************/
+  /* Send a compressed copy of the body instead if compression is on, the    */
+  /* body is big enough and it gets smaller.                                 */
+  /***************************************************************************/
+  pthread_mutex_lock(&evel_handler_mutex);
+  level = evel_compress_level;
+  min_bytes = evel_compress_min_bytes;
+  pthread_mutex_unlock(&evel_handler_mutex);
+  if ((level > 0) && (xfer->body_size >= min_bytes))
+  {
+    compressed_size = evel_compress(&evel_compressor,
+                                    level,
+                                    xfer->body,
+                                    xfer->body_size,
+                                    &xfer->compressed,
+                                    &xfer->compressed_capacity);
+    if ((compressed_size >= 0) && (compressed_size < xfer->body_size))
+    {
+      xfer->tx_chunk.memory = xfer->compressed;
+      xfer->tx_chunk.size = compressed_size;
+      compressed = true;
+    }
+    else
+    {
+      EVEL_DEBUG("Body of size %d not compressed", xfer->body_size);
+    }
+  }
+  pthread_mutex_lock(&evel_handler_mutex);
+  if (compressed)
+  {
+    evel_compress_stats.compressed_posts++;
+    evel_compress_stats.raw_bytes += xfer->body_size;
+    evel_compress_stats.compressed_bytes += xfer->tx_chunk.size;
+  }
+  else if (level > 0)
+  {
+    evel_compress_stats.skipped_posts++;
+  }
+  pthread_mutex_unlock(&evel_handler_mutex);
+  EVEL_DEBUG("Sending chunk of size %d", xfer->tx_chunk.size);
+
+  /***************************************************************************/
+  /* Say whether the body is compressed.                                     */
+  /***************************************************************************/
+  curl_rc = curl_easy_setopt(xfer->handle,
+                             CURLOPT_HTTPHEADER,
+                             compressed ? hdr_chunk_gzip : hdr_chunk);
+  if (curl_rc != CURLE_OK)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to set the headers for libCURL to upload. "
+                    "Error code=%d (%s)", curl_rc, xfer->err_string);
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Set the URL, which depends on what we are posting.                      */
+  /***************************************************************************/
+  curl_rc = curl_easy_setopt(xfer->handle, CURLOPT_URL, endpoint->urls[api]);
+  if (curl_rc != CURLE_OK)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to set the URL for libCURL to upload. "
+                    "Error code=%d (%s)", curl_rc, xfer->err_string);
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Point to the data to be received.                                       */
+  /***************************************************************************/
+  curl_rc = curl_easy_setopt(xfer->handle, CURLOPT_WRITEDATA, &xfer->rx_chunk);
+  if (curl_rc != CURLE_OK)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to initialize libCURL to upload. "
+                    "Error code=%d (%s)", curl_rc, xfer->err_string);
+    goto exit_label;
+  }
+  EVEL_DEBUG("Initialized data to receive");
+
+  /***************************************************************************/
+  /* Pointer to pass to our read function                                    */
+  /***************************************************************************/
+  curl_rc = curl_easy_setopt(xfer->handle, CURLOPT_READDATA, &xfer->tx_chunk);
+  if (curl_rc != CURLE_OK)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to set upload data for libCURL to upload. "
+                    "Error code=%d (%s)", curl_rc, xfer->err_string);
+    goto exit_label;
+  }
+  EVEL_DEBUG("Initialized data to send");
+
+  /***************************************************************************/
+  /* Size of the data to transmit.                                           */
+  /***************************************************************************/
+  curl_rc = curl_easy_setopt(xfer->handle,
+                             CURLOPT_POSTFIELDSIZE,
+                             (long) xfer->tx_chunk.size);
+  if (curl_rc != CURLE_OK)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to set length of upload data for libCURL to "
+                    "upload.  Error code=%d (%s)", curl_rc, xfer->err_string);
+    goto exit_label;
+  }
+  EVEL_DEBUG("Initialized length of data to send");
+
+  /***************************************************************************/
+  /* Hand the transfer to the multi handle, which runs it from now on.       */
+  /***************************************************************************/
+  curl_mrc = curl_multi_add_handle(curl_multi, xfer->handle);
+  if (curl_mrc != CURLM_OK)
+  {
+    rc = EVEL_CURL_LIBRARY_FAIL;
+    log_error_state("Failed to start libCURL transfer. "
+                    "Error code=%d (%s)", curl_mrc,
+                    curl_multi_strerror(curl_mrc));
+    goto exit_label;
+  }
+  xfer->in_use = true;
+  if (xfer != &evel_priority_transfer)
+  {
+    evel_transfers_in_flight++;
+  }
+  evel_endpoint_posted(endpoint);
+
+exit_label:
+  EVEL_EXIT();
+
+  return(rc);
+}
+
+/**************************************************************************//**
+ * Handle the completion of a post.
+ *
+ * @param curl_msg  The message from the multi handle saying the post is done.
+ *****************************************************************************/
+static void evel_transfer_complete(CURLMsg * const curl_msg)
+{
+  EVEL_TRANSFER * xfer = NULL;
+  CURLcode curl_rc = CURLE_OK;
+  long http_response_code = 0;
+  curl_off_t retry_after = 0;
+  long retry_after_ms = 0;
+  bool failed = false;
+  bool retry = false;
+  bool failover = false;
+  MEMORY_CHUNK priority_post;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(curl_msg != NULL);
+  assert(curl_msg->msg == CURLMSG_DONE);
+
+  curl_easy_getinfo(curl_msg->easy_handle, CURLINFO_PRIVATE, (char **) &xfer);
+  assert(xfer != NULL);
+  assert(xfer->in_use);
+  curl_rc = curl_msg->data.result;
+  curl_multi_remove_handle(curl_multi, xfer->handle);
+
+  if (curl_rc != CURLE_OK)
+  {
+    log_error_state("Failed to transfer an event to Vendor Event Listener! "
+                    "Error code=%d (%s)", curl_rc,
+                    (xfer->err_string[0] != '\0') ?
+                    xfer->err_string : curl_easy_strerror(curl_rc));
+    failed = true;
+    retry = true;
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* See what response we got - any 2XX response is good.                    */
+  /***************************************************************************/
+  curl_easy_getinfo(xfer->handle,
+                    CURLINFO_RESPONSE_CODE,
+                    &http_response_code);
+  EVEL_DEBUG("HTTP response code: %ld", http_response_code);
+  if ((http_response_code / 100) == 2)
+  {
+    /*************************************************************************/
+    /* If the server responded with data it may be interesting but not a     */
+    /* problem.                                                              */
+    /*************************************************************************/
+    if ((xfer->rx_chunk.size > 0) && (xfer->rx_chunk.memory != NULL))
+    {
+      EVEL_DEBUG("Server returned data = %d (%s)",
+                 xfer->rx_chunk.size,
+                 xfer->rx_chunk.memory);
+
+      /***********************************************************************/
+      /* Any priority post the response asks for is queued, to go back to    */
+      /* the endpoint which asked for it.                                    */
+      /***********************************************************************/
+      priority_post.memory = NULL;
+      priority_post.size = 0;
+      evel_handle_event_response(&xfer->rx_chunk, &priority_post);
+      if (priority_post.memory != NULL)
+      {
+        evel_priority_post_queue(&priority_post, xfer->endpoint);
+      }
+    }
+  }
+  else
+  {
+    EVEL_ERROR("Unexpected HTTP response code: %ld with data size %d (%s)",
+                http_response_code,
+                xfer->rx_chunk.size,
+                xfer->rx_chunk.size > 0 ? xfer->rx_chunk.memory : "NONE");
+    failed = true;
+
+    /*************************************************************************/
+    /* Timeouts, throttling and server errors are worth retrying, after at   */
+    /* least as long as the listener asks us to wait for the last two.       */
+    /*************************************************************************/
+    if ((http_response_code == 408) ||
+        (http_response_code == 429) ||
+        ((http_response_code / 100) == 5))
+    {
+      retry = true;
+      if (((http_response_code == 429) || (http_response_code == 503)) &&
+          (curl_easy_getinfo(xfer->handle,
+                             CURLINFO_RETRY_AFTER,
+                             &retry_after) == CURLE_OK))
+      {
+        retry_after_ms = (long) retry_after * 1000;
+      }
+    }
+  }
+
+exit_label:
+  xfer->in_use = false;
+  if (xfer != &evel_priority_transfer)
+  {
+    evel_transfers_in_flight--;
+  }
+
+  /***************************************************************************/
+  /* Failures which are worth retrying count against the endpoint's health.  */
+  /* If that takes the endpoint out of use, the post fails over straight     */
+  /* away rather than waiting for the listener.                              */
+  /***************************************************************************/
+  failover = evel_endpoint_completed(xfer->endpoint, !(failed && retry));
+
+  /***************************************************************************/
+  /* Replayed posts go back to the spool if they fail.  Any other post which */
+  /* gets through means replay needn't hold back any longer.                 */
+  /***************************************************************************/
+  if (xfer->spooled)
+  {
+    evel_replay_complete(xfer, failed, retry);
+  }
+  else if (xfer != &evel_priority_transfer)
+  {
+    if (!failed)
+    {
+      evel_replay_backoff_ms = 0;
+      evel_replay_next_ms = 0;
+    }
+    if (retry)
+    {
+      evel_retry_post(xfer, retry_after_ms, failover);
+    }
+    else if (failed)
+    {
+      evel_post_dropped(xfer->body, xfer->num_events);
+    }
+  }
+  else if (failed)
+  {
+    EVEL_ERROR("Dropped priority post: %s", xfer->body);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Make progress on the posts in flight.
+ *
+ * Completed posts are handled, then if any posts are still in flight we wait
+ * for one of them to make progress.  If there are only posts waiting to be
+ * retried or replayed, we wait for the next of them to be due or for an
+ * event.
+ *
+ * @param wake_for_events   Whether to stop waiting if an event is posted.
+ * @param max_wait_ms       The longest time to wait, in milliseconds.
+ *****************************************************************************/
+static void evel_transfers_run(const bool wake_for_events,
+                               const int max_wait_ms)
+{
+  CURLMcode curl_mrc = CURLM_OK;
+  CURLMsg * curl_msg = NULL;
+  int running = 0;
+  int msgs_left = 0;
+
+  EVEL_ENTER();
+
+  curl_mrc = curl_multi_perform(curl_multi, &running);
+  if (curl_mrc != CURLM_OK)
+  {
+    EVEL_ERROR("Failed to run libCURL transfers. Error code=%d (%s)",
+               curl_mrc, curl_multi_strerror(curl_mrc));
+  }
+
+  while ((curl_msg = curl_multi_info_read(curl_multi, &msgs_left)) != NULL)
+  {
+    if (curl_msg->msg == CURLMSG_DONE)
+    {
+      evel_transfer_complete(curl_msg);
+    }
+  }
+
+  /***************************************************************************/
+  /* Priority posts asked for by the posts just completed go straight away,  */
+  /* whatever the state of the window.  If one is started, the multi handle  */
+  /* times out at once so we don't wait before running it.                   */
+  /***************************************************************************/
+  evel_priority_post_start();
+
+  if ((running > 0) ||
+      (wake_for_events && ((evel_retry_head != NULL) ||
+                           (evel_spool_pending()))))
+  {
+    /*************************************************************************/
+    /* Say that we want waking before checking for events, so that an event  */
+    /* posted between the check and the wait still wakes us.  We wait no     */
+    /* longer than until the next retry or replay is due.                    */
+    /*************************************************************************/
+    if (wake_for_events)
+    {
+      __atomic_store_n(&evel_handler_polling, 1, __ATOMIC_SEQ_CST);
+    }
+    if ((!wake_for_events) || (!evel_events_queued()))
+    {
+      curl_mrc = curl_multi_poll(curl_multi,
+                                 NULL,
+                                 0,
+                                 min(min(evel_retry_wait_ms(),
+                                         evel_replay_wait_ms()),
+                                     max_wait_ms),
+                                 NULL);
+      if (curl_mrc != CURLM_OK)
+      {
+        EVEL_ERROR("Failed to wait for libCURL transfers. "
+                   "Error code=%d (%s)",
+                   curl_mrc, curl_multi_strerror(curl_mrc));
+      }
+    }
+    __atomic_store_n(&evel_handler_polling, 0, __ATOMIC_SEQ_CST);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Abandon the posts in flight so that the event handler can exit in time.
+ *
+ * The posts are spooled, if there's a spool, or dropped.  Posts replayed
+ * from the spool are left there.
+ *****************************************************************************/
+static void evel_transfers_abort(void)
+{
+  EVEL_TRANSFER * xfer = NULL;
+  int ii;
+  int jj;
+
+  EVEL_ENTER();
+
+  for (ii = 0; ii <= EVEL_POST_MAX_WINDOW; ii++)
+  {
+    xfer = (ii < EVEL_POST_MAX_WINDOW) ? &evel_transfers[ii] :
+                                         &evel_priority_transfer;
+    if (!xfer->in_use)
+    {
+      continue;
+    }
+
+    EVEL_ERROR("Abandoning post of %d events in flight", xfer->num_events);
+    curl_multi_remove_handle(curl_multi, xfer->handle);
+    xfer->in_use = false;
+    pthread_mutex_lock(&evel_handler_mutex);
+    xfer->endpoint->stats.outstanding--;
+    pthread_mutex_unlock(&evel_handler_mutex);
+    if (xfer != &evel_priority_transfer)
+    {
+      evel_transfers_in_flight--;
+    }
+
+    if (xfer->spooled)
+    {
+      for (jj = 0; jj < xfer->num_spool_refs; jj++)
+      {
+        evel_spool_rewind(&xfer->spool_refs[jj]);
+      }
+      xfer->spooled = false;
+    }
+    else if (xfer != &evel_priority_transfer)
+    {
+      evel_post_undeliverable(xfer->body, xfer->api, xfer->num_events);
+    }
+    else
+    {
+      EVEL_ERROR("Dropped priority post: %s", xfer->body);
+    }
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Queue a priority post to be sent back to the endpoint which asked for it.
+ *
+ * If the queue is full the oldest post is dropped to make room.
+ *
+ * @param post      The post, whose memory the queue takes over.
+ * @param endpoint  The endpoint which asked for the post.
+ *****************************************************************************/
+void evel_priority_post_queue(MEMORY_CHUNK * const post,
+                              EVEL_ENDPOINT * const endpoint)
+{
+  EVEL_PRIORITY_POST * entry = NULL;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(post != NULL);
+  assert(post->memory != NULL);
+
+  if (evel_priority_count == EVEL_PRIORITY_QUEUE_SIZE)
+  {
+    entry = &evel_priority_posts[evel_priority_head];
+    EVEL_ERROR("Dropped stale priority post: %s", entry->post.memory);
+    free(entry->post.memory);
+    entry->post.memory = NULL;
+    evel_priority_head = (evel_priority_head + 1) % EVEL_PRIORITY_QUEUE_SIZE;
+    evel_priority_count--;
+  }
+
+  entry = &evel_priority_posts[(evel_priority_head + evel_priority_count) %
+                               EVEL_PRIORITY_QUEUE_SIZE];
+  entry->post = *post;
+  entry->endpoint = endpoint;
+  evel_priority_count++;
+  post->memory = NULL;
+  post->size = 0;
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Take the oldest pending priority post off the queue, unless the priority
+ * transfer is still busy with the one before it.
+ *
+ * @param transfer_busy  Whether the priority transfer is in flight.
+ * @param post           Set to the post, whose memory the caller takes over.
+ * @param endpoint       Set to the endpoint which asked for the post.
+ * @returns Whether a post was taken.
+ *****************************************************************************/
+bool evel_priority_post_take(const bool transfer_busy,
+                             MEMORY_CHUNK * const post,
+                             EVEL_ENDPOINT ** const endpoint)
+{
+  bool taken = false;
+  EVEL_PRIORITY_POST * entry = NULL;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(post != NULL);
+  assert(endpoint != NULL);
+
+  if ((evel_priority_count > 0) && (!transfer_busy))
+  {
+    entry = &evel_priority_posts[evel_priority_head];
+    *post = entry->post;
+    *endpoint = entry->endpoint;
+    entry->post.memory = NULL;
+    entry->post.size = 0;
+    evel_priority_head = (evel_priority_head + 1) % EVEL_PRIORITY_QUEUE_SIZE;
+    evel_priority_count--;
+    taken = true;
+  }
+
+  EVEL_EXIT();
+
+  return(taken);
+}
+
+/**************************************************************************//**
+ * Start the oldest pending priority post, if there is one and the priority
+ * transfer is free.
+ *****************************************************************************/
+static void evel_priority_post_start(void)
+{
+  int rc = EVEL_SUCCESS;
+  CURLcode curl_rc = CURLE_OK;
+  MEMORY_CHUNK post;
+  EVEL_ENDPOINT * endpoint = NULL;
+
+  EVEL_ENTER();
+
+  if (evel_priority_post_take(evel_priority_transfer.in_use,
+                              &post,
+                              &endpoint))
+  {
+    EVEL_DEBUG("Priority Post");
+
+    /*************************************************************************/
+    /* The priority transfer gets its handle the first time it is used, and  */
+    /* keeps its connections apart from those used for events.               */
+    /*************************************************************************/
+    if (evel_priority_transfer.handle == NULL)
+    {
+      rc = evel_transfer_init(&evel_priority_transfer);
+      if (rc == EVEL_SUCCESS)
+      {
+        curl_rc = curl_easy_setopt(evel_priority_transfer.handle,
+                                   CURLOPT_SHARE,
+                                   curl_priority_share);
+        if (curl_rc != CURLE_OK)
+        {
+          rc = EVEL_CURL_LIBRARY_FAIL;
+          log_error_state("Failed to share libCURL handle for priority "
+                          "posts. Error code=%d", curl_rc);
+          curl_easy_cleanup(evel_priority_transfer.handle);
+          evel_priority_transfer.handle = NULL;
+        }
+      }
+    }
+
+    if (rc == EVEL_SUCCESS)
+    {
+      evel_transfer_reserve(&evel_priority_transfer, post.size + 1);
+      memcpy(evel_priority_transfer.body, post.memory, post.size);
+      evel_priority_transfer.body[post.size] = '\0';
+      evel_priority_transfer.body_size = post.size;
+
+      rc = evel_transfer_start(&evel_priority_transfer,
+                               EVEL_API_THROTTLE,
+                               (endpoint != NULL) ?
+                               endpoint :
+                               evel_endpoint_select());
+      if (rc != EVEL_SUCCESS)
+      {
+        EVEL_ERROR("Failed to transfer priority post. Error code=%d", rc);
+      }
+    }
+
+    /*************************************************************************/
+    /* We are responsible for freeing the memory.                            */
+    /*************************************************************************/
+    free(post.memory);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Queue the body of a post which failed to be retried, or drop it if it has
+ * been retried enough times already or there's no room for it.
+ *
+ * @param xfer            The transfer whose post failed.
+ * @param retry_after_ms  The minimum delay before the retry asked for by the
+ *                        listener, in milliseconds, or 0.
+ * @param failover        Whether to retry straight away, on another
+ *                        endpoint.
+ *****************************************************************************/
+static void evel_retry_post(EVEL_TRANSFER * const xfer,
+                            const long retry_after_ms,
+                            const bool failover)
+{
+  EVEL_RETRY * retry = NULL;
+  long delay_ms = 0;
+  bool queued = false;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(xfer != NULL);
+  assert(!xfer->in_use);
+
+  /***************************************************************************/
+  /* Posts which fail once we're terminating are not retried.                */
+  /***************************************************************************/
+  pthread_mutex_lock(&evel_handler_mutex);
+  if ((evt_handler_state == EVT_HANDLER_ACTIVE) &&
+      (xfer->attempts < evel_retry_max_attempts) &&
+      (evel_retry_stats.queued_bytes + xfer->body_size <=
+       evel_retry_max_bytes))
+  {
+    delay_ms = failover ? 0 :
+               evel_retry_delay_ms(xfer->attempts,
+                                   evel_retry_base_delay_ms,
+                                   evel_retry_max_delay_ms,
+                                   rand_r(&evel_retry_seed),
+                                   retry_after_ms);
+
+    retry = malloc(sizeof(EVEL_RETRY) + xfer->body_size + 1);
+    if (retry != NULL)
+    {
+      retry->next = NULL;
+      retry->api = xfer->api;
+      retry->num_events = xfer->num_events;
+      retry->attempts = xfer->attempts + 1;
+      retry->due_ms = evel_monotonic_ms() + delay_ms;
+      retry->body_size = xfer->body_size;
+      memcpy(retry->body, xfer->body, xfer->body_size);
+      retry->body[xfer->body_size] = '\0';
+      evel_retry_stats.queued_posts++;
+      evel_retry_stats.queued_bytes += xfer->body_size;
+      queued = true;
+    }
+  }
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  if (queued)
+  {
+    EVEL_INFO("Retrying post of %d events in %ld ms, attempt %d",
+              retry->num_events, delay_ms, retry->attempts);
+    if (evel_retry_tail != NULL)
+    {
+      evel_retry_tail->next = retry;
+    }
+    else
+    {
+      evel_retry_head = retry;
+    }
+    evel_retry_tail = retry;
+  }
+  else
+  {
+    evel_post_undeliverable(xfer->body, xfer->api, xfer->num_events);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Work out how long to wait before retrying a post.
+ *
+ * The delay doubles with each attempt up to the maximum, and up to half of it
+ * is taken off at random so that clients don't retry in step.  It is never
+ * less than the delay the listener asked for.
+ *
+ * @param attempts        How many times the post has been retried already.
+ * @param base_delay_ms   The delay before the first retry, in milliseconds.
+ * @param max_delay_ms    The maximum delay, in milliseconds.
+ * @param jitter          A random number, which picks how much is taken off.
+ * @param retry_after_ms  The minimum delay asked for by the listener, in
+ *                        milliseconds, or 0.
+ * @returns The delay, in milliseconds.
+ *****************************************************************************/
+long evel_retry_delay_ms(const int attempts,
+                         const long base_delay_ms,
+                         const long max_delay_ms,
+                         const unsigned int jitter,
+                         const long retry_after_ms)
+{
+  long delay_ms = base_delay_ms;
+  int ii;
+
+  for (ii = 0; (ii < attempts) && (delay_ms < max_delay_ms); ii++)
+  {
+    delay_ms *= 2;
+  }
+  delay_ms = min(delay_ms, max_delay_ms);
+  delay_ms -= (long) (jitter % (delay_ms / 2 + 1));
+
+  return max(delay_ms, retry_after_ms);
+}
+
+/**************************************************************************//**
+ * Start retrying the oldest post which is due to be retried.
+ *
+ * The post is taken off the queue; if it fails again it is queued afresh.
+ *****************************************************************************/
+static void evel_retry_start(void)
+{
+  EVEL_RETRY * retry = NULL;
+  EVEL_RETRY * prev = NULL;
+  EVEL_TRANSFER * xfer = NULL;
+  unsigned long long now_ms = 0;
+  int rc = EVEL_SUCCESS;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Find the oldest post which is due, and take it off the queue.           */
+  /***************************************************************************/
+  now_ms = evel_monotonic_ms();
+  for (retry = evel_retry_head; retry != NULL; retry = retry->next)
+  {
+    if (retry->due_ms <= now_ms)
+    {
+      break;
+    }
+    prev = retry;
+  }
+  if (retry == NULL)
+  {
+    goto exit_label;
+  }
+  if (prev != NULL)
+  {
+    prev->next = retry->next;
+  }
+  else
+  {
+    evel_retry_head = retry->next;
+  }
+  if (evel_retry_tail == retry)
+  {
+    evel_retry_tail = prev;
+  }
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_retry_stats.queued_posts--;
+  evel_retry_stats.queued_bytes -= retry->body_size;
+  evel_retry_stats.retried_posts++;
+  evel_retry_stats.retried_events += retry->num_events;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  /***************************************************************************/
+  /* Copy the body back into a transfer and post it again.                   */
+  /***************************************************************************/
+  xfer = evel_transfer_get();
+  if (xfer == NULL)
+  {
+    EVEL_ERROR("No transfer available - post not retried!");
+    evel_post_dropped(retry->body, retry->num_events);
+    free(retry);
+    goto exit_label;
+  }
+  evel_transfer_reserve(xfer, retry->body_size + 1);
+  memcpy(xfer->body, retry->body, retry->body_size + 1);
+  xfer->body_size = retry->body_size;
+  xfer->num_events = retry->num_events;
+  xfer->attempts = retry->attempts;
+  xfer->spooled = false;
+  EVEL_DEBUG("Retrying JSON of size %d, attempt %d",
+             xfer->body_size, xfer->attempts);
+  rc = evel_transfer_start(xfer, retry->api, evel_endpoint_select());
+  free(retry);
+  if (rc != EVEL_SUCCESS)
+  {
+    EVEL_ERROR("Failed to transfer the data. Error code=%d", rc);
+    evel_retry_post(xfer, 0, false);
+  }
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get how long the event handler can wait before a post is due to be
+ * retried.
+ *
+ * @returns The time in milliseconds, which is 0 if a post is due now and is
+ *          no more than the usual time the handler waits for.
+ *****************************************************************************/
+static int evel_retry_wait_ms(void)
+{
+  EVEL_RETRY * retry = NULL;
+  unsigned long long now_ms = 0;
+  int wait_ms = EVEL_POLL_TIMEOUT_MS;
+
+  if (evel_retry_head != NULL)
+  {
+    now_ms = evel_monotonic_ms();
+    for (retry = evel_retry_head; retry != NULL; retry = retry->next)
+    {
+      if (retry->due_ms <= now_ms)
+      {
+        wait_ms = 0;
+        break;
+      }
+      wait_ms = min(wait_ms, (int) (retry->due_ms - now_ms));
+    }
+  }
+
+  return wait_ms;
+}
+
+/**************************************************************************//**
+ * Give up on a post.
+ *
+ * @param body        The body of the post.
+ * @param num_events  The number of events in the post.
+ *****************************************************************************/
+static void evel_post_dropped(const char * const body, const int num_events)
+{
+  EVEL_ERROR("Dropped event: %s", body);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_retry_stats.dropped_posts++;
+  evel_retry_stats.dropped_events += num_events;
+  pthread_mutex_unlock(&evel_handler_mutex);
+}
+
+/**************************************************************************//**
+ * Handle a post which can't be delivered, by spooling it if there's a spool
+ * and otherwise dropping it.
+ *
+ * @param body        The body of the post.
+ * @param api         The API the post was to.
+ * @param num_events  The number of events in the post.
+ *****************************************************************************/
+static void evel_post_undeliverable(const char * const body,
+                                    const EVEL_API api,
+                                    const int num_events)
+{
+  if (!evel_spool_append(body,
+                         strlen(body),
+                         (api == EVEL_API_BATCH),
+                         num_events))
+  {
+    evel_post_dropped(body, num_events);
+  }
+}
+
+/**************************************************************************//**
+ * Say whether a post should be replayed from the spool now.
+ *
+ * @returns Whether to call ::evel_replay_start.
+ *****************************************************************************/
+static bool evel_replay_due(void)
+{
+  return evel_spool_pending() && (evel_replay_wait_ms() == 0);
+}
+
+/**************************************************************************//**
+ * Start replaying the next post in the spool.
+ *
+ * When events are batched, the post gathers as many of the spooled posts as
+ * fit in one batch, as a single eventList.
+ *****************************************************************************/
+static void evel_replay_start(void)
+{
+  EVEL_TRANSFER * xfer = NULL;
+  EVEL_SPOOL_REF ref;
+  const char * body = NULL;
+  const char * entries = NULL;
+  int size = 0;
+  int entries_size = 0;
+  bool batch = false;
+  int num_events = 0;
+  int rate = 0;
+  int max_events = 0;
+  int max_bytes = 0;
+  int offset = 0;
+  EVEL_API api = EVEL_API_EVENT;
+  int rc = EVEL_SUCCESS;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Pace the replay, whether or not there turns out to be a post to replay. */
+  /***************************************************************************/
+  pthread_mutex_lock(&evel_handler_mutex);
+  rate = evel_replay_rate;
+  max_events = evel_batch_max_events;
+  max_bytes = evel_batch_max_bytes;
+  pthread_mutex_unlock(&evel_handler_mutex);
+  evel_replay_next_ms = max(evel_replay_next_ms, evel_monotonic_ms()) +
+                        1000 / rate;
+
+  xfer = evel_transfer_get();
+  if ((xfer == NULL) ||
+      (!evel_spool_next(&ref, &body, &size, &batch, &num_events)))
+  {
+    goto exit_label;
+  }
+  xfer->spool_refs[0] = ref;
+  xfer->num_spool_refs = 1;
+  xfer->num_events = num_events;
+
+  if ((max_events <= 1) ||
+      (!evel_replay_entries(body, size, batch, &entries, &entries_size)))
+  {
+    /*************************************************************************/
+    /* Copy the body out of the spool and post it as it is.                  */
+    /*************************************************************************/
+    evel_transfer_reserve(xfer, size + 1);
+    memcpy(xfer->body, body, size + 1);
+    xfer->body_size = size;
+    api = batch ? EVEL_API_BATCH : EVEL_API_EVENT;
+  }
+  else
+  {
+    /*************************************************************************/
+    /* Copy the events out of the spooled posts into one eventList, until    */
+    /* the batch limits are reached.  The body from the spool is only valid  */
+    /* until the next record is read, so each is copied straight away.  A    */
+    /* post which doesn't fit is left in the spool for next time.            */
+    /*************************************************************************/
+    evel_transfer_reserve(xfer, max_bytes + EVEL_BATCH_FRAMING_SIZE);
+    offset = sprintf(xfer->body, "{\"eventList\": [");
+    while (true)
+    {
+      evel_transfer_reserve(xfer,
+                            offset + entries_size + EVEL_BATCH_FRAMING_SIZE);
+      if (xfer->num_spool_refs > 1)
+      {
+        memcpy(xfer->body + offset, ", ", 2);
+        offset += 2;
+      }
+      memcpy(xfer->body + offset, entries, entries_size);
+      offset += entries_size;
+
+      if ((xfer->num_spool_refs == EVEL_REPLAY_MAX_POSTS) ||
+          (xfer->num_events >= max_events) ||
+          (!evel_spool_next(&ref, &body, &size, &batch, &num_events)))
+      {
+        break;
+      }
+      if ((xfer->num_events + num_events > max_events) ||
+          (!evel_replay_entries(body, size, batch, &entries, &entries_size)) ||
+          (offset + entries_size + EVEL_BATCH_FRAMING_SIZE > max_bytes))
+      {
+        evel_spool_rewind(&ref);
+        break;
+      }
+      xfer->spool_refs[xfer->num_spool_refs++] = ref;
+      xfer->num_events += num_events;
+    }
+    offset += sprintf(xfer->body + offset, "]}");
+    xfer->body_size = offset;
+    api = EVEL_API_BATCH;
+  }
+
+  /***************************************************************************/
+  /* Post the body.                                                          */
+  /***************************************************************************/
+  xfer->attempts = 0;
+  xfer->spooled = true;
+  EVEL_DEBUG("Replaying %d spooled posts as JSON of size %d",
+             xfer->num_spool_refs, xfer->body_size);
+  rc = evel_transfer_start(xfer, api, evel_endpoint_select());
+  if (rc != EVEL_SUCCESS)
+  {
+    EVEL_ERROR("Failed to transfer the data. Error code=%d", rc);
+    evel_replay_complete(xfer, true, true);
+  }
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Find the eventList entries in the body of a spooled post.
+ *
+ * @param body          The body of the post.
+ * @param size          The size of the body in bytes.
+ * @param batch         Whether the post is to the batch API.
+ * @param entries       Filled in with the start of the entries.
+ * @param entries_size  Filled in with the size of the entries in bytes.
+ * @returns Whether the body has the framing the library posts with.
+ *****************************************************************************/
+static bool evel_replay_entries(const char * const body,
+                                const int size,
+                                const bool batch,
+                                const char ** const entries,
+                                int * const entries_size)
+{
+  const char * prefix = batch ? "{\"eventList\": [" : "{\"event\": ";
+  const char * suffix = batch ? "]}" : "}";
+  const int prefix_size = strlen(prefix);
+  const int suffix_size = strlen(suffix);
+  bool found = false;
+
+  if ((size > prefix_size + suffix_size) &&
+      (strncmp(body, prefix, prefix_size) == 0) &&
+      (strncmp(body + size - suffix_size, suffix, suffix_size) == 0))
+  {
+    *entries = body + prefix_size;
+    *entries_size = size - prefix_size - suffix_size;
+    found = true;
+  }
+
+  return found;
+}
+
+/**************************************************************************//**
+ * Handle the completion of a post replayed from the spool.
+ *
+ * @param xfer      The transfer which replayed the post.
+ * @param failed    Whether the post failed.
+ * @param retry     Whether the post is worth retrying, if it failed.
+ *****************************************************************************/
+static void evel_replay_complete(EVEL_TRANSFER * const xfer,
+                                 const bool failed,
+                                 const bool retry)
+{
+  int base_delay_ms = 0;
+  int max_delay_ms = 0;
+  int ii;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(xfer != NULL);
+  assert(xfer->spooled);
+
+  if (!failed)
+  {
+    for (ii = 0; ii < xfer->num_spool_refs; ii++)
+    {
+      evel_spool_release(&xfer->spool_refs[ii], true);
+    }
+    evel_replay_backoff_ms = 0;
+  }
+  else if (!retry)
+  {
+    EVEL_ERROR("Dropped event: %s", xfer->body);
+    for (ii = 0; ii < xfer->num_spool_refs; ii++)
+    {
+      evel_spool_release(&xfer->spool_refs[ii], false);
+    }
+  }
+  else
+  {
+    /*************************************************************************/
+    /* Leave the post in the spool, and back off before replaying again.     */
+    /*************************************************************************/
+    pthread_mutex_lock(&evel_handler_mutex);
+    base_delay_ms = evel_retry_base_delay_ms;
+    max_delay_ms = evel_retry_max_delay_ms;
+    pthread_mutex_unlock(&evel_handler_mutex);
+    evel_replay_backoff_ms = (evel_replay_backoff_ms == 0) ?
+                             base_delay_ms :
+                             min(evel_replay_backoff_ms * 2, max_delay_ms);
+    evel_replay_next_ms = evel_monotonic_ms() + evel_replay_backoff_ms;
+    for (ii = 0; ii < xfer->num_spool_refs; ii++)
+    {
+      evel_spool_rewind(&xfer->spool_refs[ii]);
+    }
+    EVEL_INFO("Replay failed, backing off for %d ms", evel_replay_backoff_ms);
+  }
+  xfer->spooled = false;
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get how long the event handler can wait before a post is due to be
+ * replayed from the spool.
+ *
+ * @returns The time in milliseconds, which is 0 if a post is due now and is
+ *          no more than the usual time the handler waits for.
+ *****************************************************************************/
+static int evel_replay_wait_ms(void)
+{
+  unsigned long long now_ms = 0;
+  int wait_ms = EVEL_POLL_TIMEOUT_MS;
+
+  if (evel_spool_pending())
+  {
+    now_ms = evel_monotonic_ms();
+    wait_ms = (evel_replay_next_ms <= now_ms) ? 0 :
+              (int) min(evel_replay_next_ms - now_ms,
+                        (unsigned long long) EVEL_POLL_TIMEOUT_MS);
+  }
+
+  return wait_ms;
+}
+
+/**************************************************************************//**
+ * Set up a spool on disk for posts which can't be delivered.
+ *
+ * @param directory     The directory for the spool, which must exist, or
+ *                      NULL.
+ * @param max_bytes     Maximum size of the spool in bytes.  Must be > 0.
+ * @param max_age_s     Maximum time a post is kept, in seconds.  Must be > 0.
+ * @param replay_rate   Maximum number of posts replayed each second.  Must
+ *                      be > 0.  Rates above ::EVEL_SPOOL_MAX_REPLAY_RATE
+ *                      are treated as that rate.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_SPOOL_FAIL The directory couldn't be read.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_set_spool(const char * const directory,
+                              const long long max_bytes,
+                              const int max_age_s,
+                              const int replay_rate)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(max_bytes > 0);
+  assert(max_age_s > 0);
+  assert(replay_rate > 0);
+  assert((evt_handler_state == EVT_HANDLER_UNINITIALIZED) ||
+         (evt_handler_state == EVT_HANDLER_TERMINATED));
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_replay_rate = min(replay_rate, EVEL_SPOOL_MAX_REPLAY_RATE);
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  evel_spool_close();
+  if (directory != NULL)
+  {
+    rc = evel_spool_open(directory, max_bytes, max_age_s);
+  }
+
+  EVEL_EXIT();
+
+  return rc;
+}
+
+/**************************************************************************//**
+ * Pick the endpoint for the next post.
+ *
+ * Endpoints which are out of use are skipped, unless they all are, in which
+ * case the one which has been out of use longest is picked.
+ *
+ * @returns The endpoint.
+ *****************************************************************************/
+EVEL_ENDPOINT * evel_endpoint_select(void)
+{
+  EVEL_ENDPOINT * endpoint = NULL;
+  EVEL_ENDPOINT * best = NULL;
+  EVEL_ENDPOINT * fallback = NULL;
+  EVEL_ENDPOINT_POLICIES policy;
+  unsigned long long now_ms = 0;
+  int ii;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(evel_num_endpoints > 0);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  policy = evel_endpoint_policy;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  /***************************************************************************/
+  /* Round robin starts looking after the endpoint used last, the other      */
+  /* policies look through the endpoints in order.                           */
+  /***************************************************************************/
+  now_ms = evel_monotonic_ms();
+  for (ii = 0; ii < evel_num_endpoints; ii++)
+  {
+    endpoint = &evel_endpoints[(policy == EVEL_ENDPOINT_ROUND_ROBIN) ?
+                               (evel_endpoint_next + ii) % evel_num_endpoints :
+                               ii];
+    if (endpoint->down_until_ms > now_ms)
+    {
+      if ((fallback == NULL) ||
+          (endpoint->down_until_ms < fallback->down_until_ms))
+      {
+        fallback = endpoint;
+      }
+    }
+    else if (policy == EVEL_ENDPOINT_LEAST_OUTSTANDING)
+    {
+      if ((best == NULL) ||
+          (endpoint->stats.outstanding < best->stats.outstanding))
+      {
+        best = endpoint;
+      }
+    }
+    else
+    {
+      best = endpoint;
+      break;
+    }
+  }
+
+  if (best == NULL)
+  {
+    best = fallback;
+  }
+  evel_endpoint_next = (best - evel_endpoints + 1) % evel_num_endpoints;
+
+  EVEL_EXIT();
+
+  return best;
+}
+
+/**************************************************************************//**
+ * Record that a post has been started on an endpoint.
+ *
+ * @param endpoint  The endpoint.
+ *****************************************************************************/
+void evel_endpoint_posted(EVEL_ENDPOINT * const endpoint)
+{
+  assert(endpoint != NULL);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  endpoint->stats.posts++;
+  endpoint->stats.outstanding++;
+  pthread_mutex_unlock(&evel_handler_mutex);
+}
+
+/**************************************************************************//**
+ * Record that a post to an endpoint has completed, and track the endpoint's
+ * health.
+ *
+ * @param endpoint  The endpoint.
+ * @param healthy   Whether the post showed the endpoint to be healthy.
+ * @returns Whether the post took the endpoint out of use while another
+ *          endpoint is still in use, so that the post should fail over.
+ *****************************************************************************/
+bool evel_endpoint_completed(EVEL_ENDPOINT * const endpoint,
+                             const bool healthy)
+{
+  unsigned long long now_ms = 0;
+  bool taken_out = false;
+  bool failover = false;
+  int ii;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(endpoint != NULL);
+
+  now_ms = evel_monotonic_ms();
+  pthread_mutex_lock(&evel_handler_mutex);
+  endpoint->stats.outstanding--;
+  if (healthy)
+  {
+    endpoint->consecutive_failures = 0;
+    endpoint->down_until_ms = 0;
+  }
+  else
+  {
+    /*************************************************************************/
+    /* Once enough posts have failed in a row, take the endpoint out of use  */
+    /* unless it already is.  Its failure count isn't reset, so if the first */
+    /* post to it after the hold down fails it's taken straight back out.    */
+    /*************************************************************************/
+    endpoint->stats.failures++;
+    endpoint->consecutive_failures++;
+    if ((endpoint->consecutive_failures >= evel_endpoint_threshold) &&
+        (endpoint->down_until_ms <= now_ms))
+    {
+      endpoint->down_until_ms = now_ms + evel_endpoint_hold_down_ms;
+      endpoint->stats.hold_downs++;
+      taken_out = true;
+    }
+  }
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  if (taken_out)
+  {
+    EVEL_ERROR("Listener endpoint %d taken out of use after %d failures",
+               (int) (endpoint - evel_endpoints),
+               endpoint->consecutive_failures);
+    for (ii = 0; ii < evel_num_endpoints; ii++)
+    {
+      if (evel_endpoints[ii].down_until_ms <= now_ms)
+      {
+        failover = true;
+      }
+    }
+  }
+
+  EVEL_EXIT();
+
+  return failover;
+}
+
+/**************************************************************************//**
+ * Set how posts are spread across the listener endpoints.
+ *
+ * @param policy            How to pick an endpoint for each post.
+ * @param failure_threshold Number of failures in a row which take an
+ *                          endpoint out of use.  Must be > 0.
+ * @param hold_down_ms      How long an endpoint is kept out of use, in
+ *                          milliseconds.  Must be > 0.
+ *****************************************************************************/
+void evel_set_endpoint_policy(const EVEL_ENDPOINT_POLICIES policy,
+                              const int failure_threshold,
+                              const int hold_down_ms)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(policy < EVEL_MAX_ENDPOINT_POLICIES);
+  assert(failure_threshold > 0);
+  assert(hold_down_ms > 0);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_endpoint_policy = policy;
+  evel_endpoint_threshold = failure_threshold;
+  evel_endpoint_hold_down_ms = hold_down_ms;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the statistics of a listener endpoint.
+ *
+ * @param endpoint  The number of the endpoint.
+ * @param stats     Pointer to the ::EVEL_ENDPOINT_STATS to fill in.
+ * @returns Whether there is such an endpoint.
+ *****************************************************************************/
+bool evel_get_endpoint_stats(const int endpoint,
+                             EVEL_ENDPOINT_STATS * const stats)
+{
+  unsigned long long now_ms = 0;
+  bool found = false;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(endpoint >= 0);
+  assert(stats != NULL);
+
+  now_ms = evel_monotonic_ms();
+  pthread_mutex_lock(&evel_handler_mutex);
+  if (endpoint < evel_num_endpoints)
+  {
+    *stats = evel_endpoints[endpoint].stats;
+    stats->healthy = (evel_endpoints[endpoint].down_until_ms <= now_ms);
+    found = true;
+  }
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  EVEL_EXIT();
+
+  return found;
+}
+
+/**************************************************************************//**
+ * Set the compression of post bodies.
+ *
+ * @param level     The zlib compression level, from 1 (fastest) to 9
+ *                  (smallest), or 0 for no compression.
+ * @param min_bytes Size below which bodies aren't compressed.  Must be >= 0.
+ *****************************************************************************/
+void evel_set_compression(const int level, const int min_bytes)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert((level >= 0) && (level <= 9));
+  assert(min_bytes >= 0);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_compress_level = level;
+  evel_compress_min_bytes = min_bytes;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the compression statistics.
+ *
+ * @param stats     Pointer to the ::EVEL_COMPRESS_STATS to fill in.
+ *****************************************************************************/
+void evel_get_compress_stats(EVEL_COMPRESS_STATS * const stats)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(stats != NULL);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  *stats = evel_compress_stats;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set whether events are encoded by the threads which post them.
+ *
+ * @param enabled   Whether ::evel_post_event encodes the event.
+ *****************************************************************************/
+void evel_set_producer_encoding(const bool enabled)
+{
+  EVEL_ENTER();
+
+  __atomic_store_n(&evel_producer_encoding, enabled ? 1 : 0, __ATOMIC_RELAXED);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set how events of each priority are shared out.
+ *
+ * @param weights   Array of ::EVEL_MAX_PRIORITIES weights, indexed by
+ *                  priority, each of which must be >= 1, or NULL for strict
+ *                  priority order.
+ *****************************************************************************/
+void evel_set_priority_weights(const int * const weights)
+{
+  int ii;
+
+  EVEL_ENTER();
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  for (ii = 0; ii < EVEL_MAX_PRIORITIES; ii++)
+  {
+    assert((weights == NULL) || (weights[ii] >= 1));
+    evel_lane_weights[ii] = (weights != NULL) ? weights[ii] : 0;
+  }
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the statistics of the queue of events of one priority.
+ *
+ * @param priority  The priority of the events.
+ * @param stats     Pointer to the ::EVEL_LANE_STATS to fill in.
+ *****************************************************************************/
+void evel_get_lane_stats(const EVEL_EVENT_PRIORITIES priority,
+                         EVEL_LANE_STATS * const stats)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(priority < EVEL_MAX_PRIORITIES);
+  assert(stats != NULL);
+
+  stats->queued = __atomic_load_n(&evel_lane_stats[priority].queued,
+                                  __ATOMIC_RELAXED);
+  stats->dropped = __atomic_load_n(&evel_lane_stats[priority].dropped,
+                                   __ATOMIC_RELAXED);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set what happens to events of a domain posted while their queue is full.
+ *
+ * @param domain      The domain of the events.  Must not be
+ *                    ::EVEL_DOMAIN_INTERNAL.
+ * @param policy      What happens to an event posted while its queue is
+ *                    full.
+ * @param timeout_ms  For ::EVEL_OVERFLOW_BLOCK, the longest time to wait for
+ *                    room, in milliseconds.  Must be >= 0.
+ *****************************************************************************/
+void evel_set_overflow_policy(const EVEL_EVENT_DOMAINS domain,
+                              const EVEL_OVERFLOW_POLICIES policy,
+                              const int timeout_ms)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(domain > EVEL_DOMAIN_INTERNAL);
+  assert(domain < EVEL_MAX_DOMAINS);
+  assert(policy < EVEL_MAX_OVERFLOW_POLICIES);
+  assert(timeout_ms >= 0);
+
+  __atomic_store_n(&evel_overflow_timeouts_ms[domain],
+                   timeout_ms,
+                   __ATOMIC_RELAXED);
+  __atomic_store_n(&evel_overflow_policies[domain], policy, __ATOMIC_RELAXED);
+  EVEL_DEBUG("Overflow policy of domain %d set to %d, timeout %d ms",
+             domain, policy, timeout_ms);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the statistics of an overflow policy.
+ *
+ * @param policy    The overflow policy.
+ * @param stats     Pointer to the ::EVEL_OVERFLOW_STATS to fill in.
+ *****************************************************************************/
+void evel_get_overflow_stats(const EVEL_OVERFLOW_POLICIES policy,
+                             EVEL_OVERFLOW_STATS * const stats)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(policy < EVEL_MAX_OVERFLOW_POLICIES);
+  assert(stats != NULL);
+
+  stats->overflows = __atomic_load_n(&evel_overflow_stats[policy].overflows,
+                                     __ATOMIC_RELAXED);
+  stats->dropped = __atomic_load_n(&evel_overflow_stats[policy].dropped,
+                                   __ATOMIC_RELAXED);
+  stats->replaced = __atomic_load_n(&evel_overflow_stats[policy].replaced,
+                                    __ATOMIC_RELAXED);
+  stats->waited_ms = __atomic_load_n(&evel_overflow_stats[policy].waited_ms,
+                                     __ATOMIC_RELAXED);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set how long ::evel_terminate keeps sending the events still queued.
+ *
+ * @param timeout_ms  The longest time to keep sending, in milliseconds, or 0
+ *                    to drop the events.  Must be >= 0.
+ *****************************************************************************/
+void evel_set_terminate_timeout(const int timeout_ms)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(timeout_ms >= 0);
+
+  __atomic_store_n(&evel_terminate_timeout_ms, timeout_ms, __ATOMIC_RELAXED);
+  EVEL_DEBUG("Terminate timeout set to %d ms", timeout_ms);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set the limits on retrying posts which fail.
+ *
+ * @param max_attempts  Maximum number of times to retry a post.  Must be
+ *                      >= 0.
+ * @param max_bytes     Maximum size of the posts waiting to be retried, in
+ *                      bytes.  Must be >= 0.
+ * @param base_delay_ms Delay before the first retry of a post, in
+ *                      milliseconds.  Must be > 0.
+ * @param max_delay_ms  Maximum delay between retries, in milliseconds.  Must
+ *                      be >= @p base_delay_ms.
+ *****************************************************************************/
+void evel_set_retry_limits(const int max_attempts,
+                           const int max_bytes,
+                           const int base_delay_ms,
+                           const int max_delay_ms)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(max_attempts >= 0);
+  assert(max_bytes >= 0);
+  assert(base_delay_ms > 0);
+  assert(max_delay_ms >= base_delay_ms);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  evel_retry_max_attempts = max_attempts;
+  evel_retry_max_bytes = max_bytes;
+  evel_retry_base_delay_ms = base_delay_ms;
+  evel_retry_max_delay_ms = max_delay_ms;
+  pthread_mutex_unlock(&evel_handler_mutex);
+  EVEL_DEBUG("Retry limits set to %d attempts, %d bytes, %d-%d ms",
+             max_attempts, max_bytes, base_delay_ms, max_delay_ms);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the retry statistics.
+ *
+ * @param stats     Pointer to the ::EVEL_RETRY_STATS to fill in.
+ *****************************************************************************/
+void evel_get_retry_stats(EVEL_RETRY_STATS * const stats)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(stats != NULL);
+
+  pthread_mutex_lock(&evel_handler_mutex);
+  *stats = evel_retry_stats;
+  pthread_mutex_unlock(&evel_handler_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the time on the monotonic clock.
+ *
+ * @returns The time in milliseconds.
+ *****************************************************************************/
+static unsigned long long evel_monotonic_ms(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return ((unsigned long long) now.tv_sec * 1000) + (now.tv_nsec / 1000000);
+}
+
 /**************************************************************************//**
  * Handle a JSON response from the listener, contained in a ::MEMORY_CHUNK.
  *
@@ -914,7 +4319,8 @@ void evel_handle_event_response(const MEMORY_CHUNK * const chunk,
   /* Check preconditions.                                                    */
   /***************************************************************************/
   assert(chunk != NULL);
-  assert(priority_post.memory == NULL);
+  assert(post != NULL);
+  assert(post->memory == NULL);
 
   EVEL_DEBUG("Response size = %d", chunk->size);
   EVEL_DEBUG("Response = %s", chunk->memory);
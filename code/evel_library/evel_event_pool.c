@@ -0,0 +1,414 @@
+/**************************************************************************//**
+ * @file
+ * Pools of event structures for reuse.
+ *
+ * Each thread keeps a short free list of structures for each event domain,
+ * backed by a shared pool so that events freed on one thread (typically the
+ * event handler, once an event is posted) can be reused by the threads which
+ * raise them.
+ *
+ * License
+ * -------
+ *
+ * Copyright(c) <2016>, AT&T Intellectual Property.  All other rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:  This product includes
+ *    software developed by the AT&T.
+ * 4. Neither the name of AT&T nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY AT&T INTELLECTUAL PROPERTY ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL AT&T INTELLECTUAL PROPERTY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "evel.h"
+#include "evel_internal.h"
+
+/*****************************************************************************/
+/* Default number of structures kept for each domain by each thread, and in  */
+/* the shared pool.                                                          */
+/*****************************************************************************/
+#define EVEL_POOL_DEFAULT_THREAD_LIMIT 16
+#define EVEL_POOL_DEFAULT_SHARED_LIMIT 64
+
+/*****************************************************************************/
+/* The kinds of pooled memory: plain event structures, and event structures  */
+/* at the start of an arena which has been reset.                            */
+/*****************************************************************************/
+#define EVEL_POOL_KINDS 2
+
+/**************************************************************************//**
+ * A pooled structure.  The link overlays the start of the free event, which
+ * leaves the event's arena pointer intact.
+ *****************************************************************************/
+typedef struct evel_pool_block
+{
+  struct evel_pool_block * next;
+} EVEL_POOL_BLOCK;
+
+/**************************************************************************//**
+ * A free list of pooled structures.
+ *****************************************************************************/
+typedef struct evel_pool_list
+{
+  EVEL_POOL_BLOCK * head;
+  int count;
+} EVEL_POOL_LIST;
+
+/**************************************************************************//**
+ * A thread's pools, one free list for each domain and kind of memory.
+ *****************************************************************************/
+typedef struct evel_thread_pools
+{
+  EVEL_POOL_LIST lists[EVEL_MAX_DOMAINS][EVEL_POOL_KINDS];
+} EVEL_THREAD_POOLS;
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static void evel_pool_key_create(void);
+static void evel_pool_thread_exit(void * pools);
+static EVEL_THREAD_POOLS * evel_pool_thread_pools(void);
+static void evel_pool_block_free(const bool in_arena, EVEL_POOL_BLOCK * block);
+
+/*****************************************************************************/
+/* Limits on the number of structures pooled for each domain.                */
+/*****************************************************************************/
+static int evel_pool_thread_limit = EVEL_POOL_DEFAULT_THREAD_LIMIT;
+static int evel_pool_shared_limit = EVEL_POOL_DEFAULT_SHARED_LIMIT;
+
+/*****************************************************************************/
+/* The shared pool, and the key to each thread's pools.                      */
+/*****************************************************************************/
+static EVEL_POOL_LIST evel_pool_shared[EVEL_MAX_DOMAINS][EVEL_POOL_KINDS];
+static pthread_mutex_t evel_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t evel_pool_key;
+static pthread_once_t evel_pool_once = PTHREAD_ONCE_INIT;
+
+/**************************************************************************//**
+ * Set the number of freed event structures kept for reuse.
+ *
+ * @param thread_limit  Number kept for each domain by each thread.
+ * @param shared_limit  Number kept for each domain in the shared pool.
+ *****************************************************************************/
+void evel_set_event_pool_limits(const int thread_limit, const int shared_limit)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(thread_limit >= 0);
+  assert(shared_limit >= 0);
+
+  __atomic_store_n(&evel_pool_thread_limit, thread_limit, __ATOMIC_RELAXED);
+  __atomic_store_n(&evel_pool_shared_limit, shared_limit, __ATOMIC_RELAXED);
+  EVEL_DEBUG("Event pool limits set to %d per thread, %d shared",
+             thread_limit,
+             shared_limit);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Take a structure for a new event from the pools.
+ *
+ * Each domain always uses structures of the same size, so a structure taken
+ * from a domain's pool is big enough for the new event.
+ *
+ * @param domain        The domain of the new event.
+ * @param in_arena      true to take a structure at the start of an arena,
+ *                      false for a plain structure.
+ * @returns Pointer to the structure, which is not initialized, or NULL if the
+ *          pools are empty.
+ *****************************************************************************/
+void * evel_event_pool_get(const EVEL_EVENT_DOMAINS domain,
+                           const bool in_arena)
+{
+  const int thread_limit =
+    __atomic_load_n(&evel_pool_thread_limit, __ATOMIC_RELAXED);
+  EVEL_THREAD_POOLS * pools = NULL;
+  EVEL_POOL_LIST * local = NULL;
+  EVEL_POOL_LIST * shared = NULL;
+  EVEL_POOL_BLOCK * block = NULL;
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(domain < EVEL_MAX_DOMAINS);
+
+  pools = evel_pool_thread_pools();
+  if (pools == NULL)
+  {
+    goto exit_label;
+  }
+  local = &pools->lists[domain][in_arena];
+
+  /***************************************************************************/
+  /* If this thread has none, refill it with up to half its limit from the   */
+  /* shared pool, so that the lock is only taken once for several events.    */
+  /***************************************************************************/
+  if (local->head == NULL)
+  {
+    shared = &evel_pool_shared[domain][in_arena];
+    pthread_mutex_lock(&evel_pool_mutex);
+    while ((shared->head != NULL) &&
+           (local->count == 0 || local->count < thread_limit / 2))
+    {
+      block = shared->head;
+      shared->head = block->next;
+      shared->count--;
+      block->next = local->head;
+      local->head = block;
+      local->count++;
+    }
+    pthread_mutex_unlock(&evel_pool_mutex);
+  }
+
+  block = local->head;
+  if (block != NULL)
+  {
+    local->head = block->next;
+    local->count--;
+  }
+
+exit_label:
+  return block;
+}
+
+/**************************************************************************//**
+ * Return the structure of a freed event to the pools.
+ *
+ * @param domain        The domain of the freed event.
+ * @param in_arena      true if the structure is at the start of its arena,
+ *                      which must have been reset, or false otherwise.
+ * @param memory        The structure.
+ * @returns true if the structure was pooled, false if the pools are full and
+ *          the caller must release it.
+ *****************************************************************************/
+bool evel_event_pool_put(const EVEL_EVENT_DOMAINS domain,
+                         const bool in_arena,
+                         void * const memory)
+{
+  const int thread_limit =
+    __atomic_load_n(&evel_pool_thread_limit, __ATOMIC_RELAXED);
+  const int shared_limit =
+    __atomic_load_n(&evel_pool_shared_limit, __ATOMIC_RELAXED);
+  EVEL_THREAD_POOLS * pools = NULL;
+  EVEL_POOL_LIST * local = NULL;
+  EVEL_POOL_LIST * shared = NULL;
+  EVEL_POOL_BLOCK * block = NULL;
+  EVEL_POOL_BLOCK * spill = NULL;
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(domain < EVEL_MAX_DOMAINS);
+  assert(memory != NULL);
+
+  if (thread_limit == 0)
+  {
+    return false;
+  }
+  pools = evel_pool_thread_pools();
+  if (pools == NULL)
+  {
+    return false;
+  }
+  local = &pools->lists[domain][in_arena];
+
+  /***************************************************************************/
+  /* If this thread is at its limit, move half its list to the shared pool,  */
+  /* releasing any the shared pool has no room for once the lock is dropped. */
+  /***************************************************************************/
+  if (local->count >= thread_limit)
+  {
+    shared = &evel_pool_shared[domain][in_arena];
+    pthread_mutex_lock(&evel_pool_mutex);
+    while (local->count > thread_limit / 2)
+    {
+      block = local->head;
+      local->head = block->next;
+      local->count--;
+      if (shared->count < shared_limit)
+      {
+        block->next = shared->head;
+        shared->head = block;
+        shared->count++;
+      }
+      else
+      {
+        block->next = spill;
+        spill = block;
+      }
+    }
+    pthread_mutex_unlock(&evel_pool_mutex);
+
+    while (spill != NULL)
+    {
+      block = spill;
+      spill = block->next;
+      evel_pool_block_free(in_arena, block);
+    }
+  }
+
+  block = memory;
+  block->next = local->head;
+  local->head = block;
+  local->count++;
+
+  return true;
+}
+
+/**************************************************************************//**
+ * Free everything in the shared pool.
+ *****************************************************************************/
+void evel_event_pool_terminate(void)
+{
+  EVEL_POOL_BLOCK * block = NULL;
+  int domain;
+  int kind;
+
+  EVEL_ENTER();
+
+  pthread_mutex_lock(&evel_pool_mutex);
+  for (domain = 0; domain < EVEL_MAX_DOMAINS; domain++)
+  {
+    for (kind = 0; kind < EVEL_POOL_KINDS; kind++)
+    {
+      while (evel_pool_shared[domain][kind].head != NULL)
+      {
+        block = evel_pool_shared[domain][kind].head;
+        evel_pool_shared[domain][kind].head = block->next;
+        evel_pool_block_free(kind, block);
+      }
+      evel_pool_shared[domain][kind].count = 0;
+    }
+  }
+  pthread_mutex_unlock(&evel_pool_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the calling thread's pools, creating them on first use.
+ *
+ * @returns Pointer to the pools, or NULL if they could not be created.
+ *****************************************************************************/
+static EVEL_THREAD_POOLS * evel_pool_thread_pools(void)
+{
+  EVEL_THREAD_POOLS * pools = NULL;
+
+  pthread_once(&evel_pool_once, evel_pool_key_create);
+  pools = pthread_getspecific(evel_pool_key);
+  if (pools == NULL)
+  {
+    pools = calloc(1, sizeof(EVEL_THREAD_POOLS));
+    if (pools == NULL)
+    {
+      log_error_state("Failed to allocate event pools");
+      goto exit_label;
+    }
+    pthread_setspecific(evel_pool_key, pools);
+  }
+
+exit_label:
+  return pools;
+}
+
+/**************************************************************************//**
+ * Create the key to each thread's pools.
+ *****************************************************************************/
+static void evel_pool_key_create(void)
+{
+  pthread_key_create(&evel_pool_key, evel_pool_thread_exit);
+}
+
+/**************************************************************************//**
+ * Hand a thread's pooled structures to the shared pool as the thread exits.
+ *
+ * @param pools         Pointer to the thread's ::EVEL_THREAD_POOLS.
+ *****************************************************************************/
+static void evel_pool_thread_exit(void * pools)
+{
+  EVEL_THREAD_POOLS * thread_pools = pools;
+  EVEL_POOL_LIST * local = NULL;
+  EVEL_POOL_LIST * shared = NULL;
+  EVEL_POOL_BLOCK * block = NULL;
+  int domain;
+  int kind;
+
+  if (thread_pools == NULL)
+  {
+    return;
+  }
+
+  pthread_mutex_lock(&evel_pool_mutex);
+  for (domain = 0; domain < EVEL_MAX_DOMAINS; domain++)
+  {
+    for (kind = 0; kind < EVEL_POOL_KINDS; kind++)
+    {
+      local = &thread_pools->lists[domain][kind];
+      shared = &evel_pool_shared[domain][kind];
+      while (local->head != NULL)
+      {
+        block = local->head;
+        local->head = block->next;
+        if (shared->count <
+            __atomic_load_n(&evel_pool_shared_limit, __ATOMIC_RELAXED))
+        {
+          block->next = shared->head;
+          shared->head = block;
+          shared->count++;
+        }
+        else
+        {
+          evel_pool_block_free(kind, block);
+        }
+      }
+    }
+  }
+  pthread_mutex_unlock(&evel_pool_mutex);
+
+  free(thread_pools);
+}
+
+/**************************************************************************//**
+ * Release a pooled structure.
+ *
+ * @param in_arena      true if the structure is at the start of its arena.
+ * @param block         The structure.
+ *****************************************************************************/
+static void evel_pool_block_free(const bool in_arena, EVEL_POOL_BLOCK * block)
+{
+  if (in_arena)
+  {
+    arena_destroy(((EVENT_HEADER *) block)->arena);
+  }
+  else
+  {
+    free(block);
+  }
+}
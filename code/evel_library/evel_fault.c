@@ -81,13 +81,12 @@ EVENT_FAULT * evel_new_fault(const char * const condition,
   /***************************************************************************/
   /* Allocate the fault.                                                     */
   /***************************************************************************/
-  fault = malloc(sizeof(EVENT_FAULT));
+  fault = evel_alloc_event(EVEL_DOMAIN_FAULT, sizeof(EVENT_FAULT));
   if (fault == NULL)
   {
     log_error_state("Out of memory");
     goto exit_label;
   }
-  memset(fault, 0, sizeof(EVENT_FAULT));
   EVEL_DEBUG("New fault is at %lp", fault);
 
   /***************************************************************************/
@@ -102,8 +101,9 @@ EVENT_FAULT * evel_new_fault(const char * const condition,
   fault->event_severity = severity;
   fault->event_source_type = ev_source_type;
   fault->vf_status = status;
-  fault->alarm_condition = strdup(condition);
-  fault->specific_problem = strdup(specific_problem);
+  fault->alarm_condition = evel_event_strdup(&fault->header, condition);
+  fault->specific_problem = evel_event_strdup(&fault->header,
+                                              specific_problem);
   evel_init_option_string(&fault->category);
   evel_init_option_string(&fault->alarm_interface_a);
   dlist_initialize(&fault->additional_info);
@@ -142,15 +142,15 @@ void evel_fault_addl_info_add(EVENT_FAULT * fault, char * name, char * value)
   assert(value != NULL);
 
   EVEL_DEBUG("Adding name=%s value=%s", name, value);
-  addl_info = malloc(sizeof(FAULT_ADDL_INFO));
+  addl_info = evel_event_malloc(&fault->header, sizeof(FAULT_ADDL_INFO));
   assert(addl_info != NULL);
   memset(addl_info, 0, sizeof(FAULT_ADDL_INFO));
-  addl_info->name = strdup(name);
-  addl_info->value = strdup(value);
+  addl_info->name = evel_event_strdup(&fault->header, name);
+  addl_info->value = evel_event_strdup(&fault->header, value);
   assert(addl_info->name != NULL);
   assert(addl_info->value != NULL);
 
-  dlist_push_last(&fault->additional_info, addl_info);
+  evel_event_list_push(&fault->header, &fault->additional_info, addl_info);
 
   EVEL_EXIT();
 }
@@ -180,9 +180,10 @@ void evel_fault_category_set(EVENT_FAULT * fault,
   assert(fault->header.event_domain == EVEL_DOMAIN_FAULT);
   assert(category != NULL);
 
-  evel_set_option_string(&fault->category,
-                         category,
-                         "Fault Category set");
+  evel_event_set_option_string(&fault->header,
+                               &fault->category,
+                               category,
+                               "Fault Category set");
   EVEL_EXIT();
 }
 
@@ -210,9 +211,10 @@ void evel_fault_interface_set(EVENT_FAULT * fault,
   assert(fault->header.event_domain == EVEL_DOMAIN_FAULT);
   assert(interface != NULL);
 
-  evel_set_option_string(&fault->alarm_interface_a,
-                         interface,
-                         "Alarm Interface A");
+  evel_event_set_option_string(&fault->header,
+                               &fault->alarm_interface_a,
+                               interface,
+                               "Alarm Interface A");
   EVEL_EXIT();
 }
 
@@ -276,7 +278,10 @@ void evel_json_encode_fault(EVEL_JSON_BUFFER * jbuf,
   /* Mandatory fields.                                                       */
   /***************************************************************************/
   evel_enc_kv_string(jbuf, "alarmCondition", event->alarm_condition);
-  evel_enc_kv_opt_string(jbuf, "eventCategory", &event->category);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_EVENT_CATEGORY,
+                         "eventCategory",
+                         &event->category);
   evel_enc_kv_string(jbuf, "eventSeverity", fault_severity);
   evel_enc_kv_string(jbuf, "eventSourceType", fault_source_type);
   evel_enc_kv_string(jbuf, "specificProblem", event->specific_problem);
@@ -292,7 +297,9 @@ void evel_json_encode_fault(EVEL_JSON_BUFFER * jbuf,
   /* Checkpoint, so that we can wind back if all fields are suppressed.      */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "alarmAdditionalInformation"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_ALARM_ADDITIONAL_INFORMATION,
+                                    "alarmAdditionalInformation"))
   {
     bool item_added = false;
 
@@ -302,9 +309,11 @@ void evel_json_encode_fault(EVEL_JSON_BUFFER * jbuf,
       addl_info = (FAULT_ADDL_INFO*) addl_info_item->item;
       assert(addl_info != NULL);
 
-      if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
-                                          "alarmAdditionalInformation",
-                                          addl_info->name))
+      if (!evel_throttle_suppress_nv_pair(
+             jbuf->throttle_spec,
+             EVEL_FIELD_ALARM_ADDITIONAL_INFORMATION,
+             "alarmAdditionalInformation",
+             addl_info->name))
       {
         evel_json_open_object(jbuf);
         evel_enc_kv_string(jbuf, "name", addl_info->name);
@@ -324,7 +333,10 @@ void evel_json_encode_fault(EVEL_JSON_BUFFER * jbuf,
       evel_json_rewind(jbuf);
     }
   }
-  evel_enc_kv_opt_string(jbuf, "alarmInterfaceA", &event->alarm_interface_a);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_ALARM_INTERFACE_A,
+                         "alarmInterfaceA",
+                         &event->alarm_interface_a);
 
   evel_json_close_object(jbuf);
 
@@ -67,13 +67,13 @@ EVENT_HEARTBEAT_FIELD * evel_new_heartbeat_field(int interval)
   /***************************************************************************/
   /* Allocate the Heartbeat fields event.                                           */
   /***************************************************************************/
-  event = malloc(sizeof(EVENT_HEARTBEAT_FIELD));
+  event = evel_alloc_event(EVEL_DOMAIN_HEARTBEAT_FIELD,
+                           sizeof(EVENT_HEARTBEAT_FIELD));
   if (event == NULL)
   {
     log_error_state("Out of memory");
     goto exit_label;
   }
-  memset(event, 0, sizeof(EVENT_HEARTBEAT_FIELD));
   EVEL_DEBUG("New Heartbeat fields event is at %lp", event);
 
   /***************************************************************************/
@@ -123,14 +123,14 @@ void evel_hrtbt_field_addl_field_add(EVENT_HEARTBEAT_FIELD * const event,
   assert(value != NULL);
 
   EVEL_DEBUG("Adding name=%s value=%s", name, value);
-  nv_pair = malloc(sizeof(OTHER_FIELD));
+  nv_pair = evel_event_malloc(&event->header, sizeof(OTHER_FIELD));
   assert(nv_pair != NULL);
-  nv_pair->name = strdup(name);
-  nv_pair->value = strdup(value);
+  nv_pair->name = evel_event_strdup(&event->header, name);
+  nv_pair->value = evel_event_strdup(&event->header, value);
   assert(nv_pair->name != NULL);
   assert(nv_pair->value != NULL);
 
-  dlist_push_last(&event->additional_info, nv_pair);
+  evel_event_list_push(&event->header, &event->additional_info, nv_pair);
 
   EVEL_EXIT();
 }
@@ -202,7 +202,9 @@ void evel_json_encode_hrtbt_field(EVEL_JSON_BUFFER * const jbuf,
   /* Checkpoint, so that we can wind back if all fields are suppressed.      */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "additionalFields"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_ADDITIONAL_FIELDS,
+                                    "additionalFields"))
   {
     bool added = false;
 
@@ -213,6 +215,7 @@ void evel_json_encode_hrtbt_field(EVEL_JSON_BUFFER * const jbuf,
       assert(nv_pair != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_ADDITIONAL_FIELDS,
                                           "additionalFields",
                                           nv_pair->name))
       {
@@ -84,6 +84,7 @@ typedef struct memory_chunk {
  *****************************************************************************/
 typedef enum {
   EVT_CMD_TERMINATE,
+  EVT_CMD_POST_ENCODED,
   EVT_CMD_MAX_COMMANDS
 } EVT_HANDLER_COMMAND;
 
@@ -109,6 +110,18 @@ typedef struct event_internal {
   EVT_HANDLER_COMMAND command;
 } EVENT_INTERNAL;
 
+/**************************************************************************//**
+ * Encoded event.
+ * Internal event carrying an event which the thread that posted it has
+ * already encoded, as one entry of a JSON eventList.  The header only has its
+ * domain and priority set.
+ *****************************************************************************/
+typedef struct event_encoded {
+  EVENT_INTERNAL internal;
+  int json_size;
+  char json[];
+} EVENT_ENCODED;
+
 /**************************************************************************//**
  * Suppressed NV pairs list entry.
  * JSON equivalent field: suppressedNvPairs
@@ -131,10 +144,18 @@ typedef struct evel_suppressed_nv_pairs {
   /***************************************************************************/
   /* Hash table containing suppressed_nv_pair_names as keys.                 */
   /***************************************************************************/
-  struct hsearch_data * hash_nv_pair_names;
+  HASH_MAP hash_nv_pair_names;
 
 } EVEL_SUPPRESSED_NV_PAIRS;
 
+/*****************************************************************************/
+/* Words in a bitmask with a bit per ::EVEL_THROTTLE_FIELDS.                 */
+/*****************************************************************************/
+#define EVEL_THROTTLE_FIELD_WORD_BITS (sizeof(unsigned long) * 8)
+#define EVEL_THROTTLE_FIELD_WORDS                                             \
+  ((EVEL_MAX_THROTTLE_FIELDS + EVEL_THROTTLE_FIELD_WORD_BITS - 1) /           \
+   EVEL_THROTTLE_FIELD_WORD_BITS)
+
 /**************************************************************************//**
  * Event Throttling Specification for a domain which is in a throttled state.
  * JSON equivalent object: eventThrottlingState
@@ -158,13 +179,31 @@ typedef struct evel_throttle_spec {
   /***************************************************************************/
   /* Hash table containing suppressed_nv_pair_names as keys.                 */
   /***************************************************************************/
-  struct hsearch_data * hash_field_names;
+  HASH_MAP hash_field_names;
 
   /***************************************************************************/
   /* Hash table containing nv_pair_field_name as keys, and                   */
   /* suppressed_nv_pairs_list as values.                                     */
   /***************************************************************************/
-  struct hsearch_data * hash_nv_pairs_list;
+  HASH_MAP hash_nv_pairs_list;
+
+  /***************************************************************************/
+  /* Bit per ::EVEL_THROTTLE_FIELDS, set if the field is suppressed.         */
+  /***************************************************************************/
+  unsigned long suppressed_fields[EVEL_THROTTLE_FIELD_WORDS];
+
+  /***************************************************************************/
+  /* The suppressed_nv_pairs_list entry for each ::EVEL_THROTTLE_FIELDS, or  */
+  /* NULL.                                                                   */
+  /***************************************************************************/
+  EVEL_SUPPRESSED_NV_PAIRS * field_nv_pairs[EVEL_MAX_THROTTLE_FIELDS];
+
+  /***************************************************************************/
+  /* Whether any suppressed field names, or fields holding name-value pairs, */
+  /* are not ::EVEL_THROTTLE_FIELDS, and so must be looked up by name.       */
+  /***************************************************************************/
+  bool unknown_field_names;
+  bool unknown_nv_pair_fields;
 
 } EVEL_THROTTLE_SPEC;
 
@@ -173,6 +212,11 @@ typedef struct evel_throttle_spec {
 /*****************************************************************************/
 #define EVEL_RFC2822_STRFTIME_FORMAT "%a, %d %b %Y %T %z"
 
+/*****************************************************************************/
+/* Room to leave for a time formatted with EVEL_RFC2822_STRFTIME_FORMAT.     */
+/*****************************************************************************/
+#define EVEL_MAX_TIME_STRING_LEN 64
+
 /*****************************************************************************/
 /* EVEL_JSON_BUFFER depth at which we throttle fields.                       */
 /*****************************************************************************/
@@ -186,18 +230,129 @@ typedef struct evel_throttle_spec {
  * @param[in] event_api_url
  *                      The URL where the Vendor Event Listener API is expected
  *                      to be.
+ * @param[in] batch_api_url
+ *                      The URL where the batch (eventList) API is expected to
+ *                      be.
  * @param[in] throt_api_url
  *                      The URL where the Throttling API is expected to be.
  * @param[in] username  The username for the Basic Authentication of requests.
  * @param[in] password  The password for the Basic Authentication of requests.
  * @param     verbosity 0 for normal operation, positive values for chattier
  *                        logs.
+ * @param     queue_depth How many events each priority queue holds.
+ * @param     queue_max_bytes
+ *                      How much memory the queued events may use, or 0 for
+ *                      no limit.
  *****************************************************************************/
 EVEL_ERR_CODES event_handler_initialize(const char * const event_api_url,
+                                        const char * const batch_api_url,
                                         const char * const throt_api_url,
                                         const char * const username,
                                         const char * const password,
-                                        int verbosity);
+                                        int verbosity,
+                                        const int queue_depth,
+                                        const size_t queue_max_bytes);
+
+/**************************************************************************//**
+ * Add a listener endpoint to the event handler, after the one it was
+ * initialized with.
+ *
+ * @param[in] event_api_url
+ *                      The URL of the endpoint's Vendor Event Listener API.
+ * @param[in] batch_api_url
+ *                      The URL of the endpoint's batch (eventList) API.
+ * @param[in] throt_api_url
+ *                      The URL of the endpoint's Throttling API.
+ *****************************************************************************/
+void event_handler_add_endpoint(const char * const event_api_url,
+                                const char * const batch_api_url,
+                                const char * const throt_api_url);
+
+/**************************************************************************//**
+ * Work out how long to wait before retrying a post.
+ *
+ * The delay doubles with each attempt up to the maximum, and up to half of it
+ * is taken off at random so that clients don't retry in step.  It is never
+ * less than the delay the listener asked for.
+ *
+ * @param attempts        How many times the post has been retried already.
+ * @param base_delay_ms   The delay before the first retry, in milliseconds.
+ * @param max_delay_ms    The maximum delay, in milliseconds.
+ * @param jitter          A random number, which picks how much is taken off.
+ * @param retry_after_ms  The minimum delay asked for by the listener, in
+ *                        milliseconds, or 0.
+ * @returns The delay, in milliseconds.
+ *****************************************************************************/
+long evel_retry_delay_ms(const int attempts,
+                         const long base_delay_ms,
+                         const long max_delay_ms,
+                         const unsigned int jitter,
+                         const long retry_after_ms);
+
+/**************************************************************************//**
+ * A listener endpoint, with the URLs of its APIs and the passively tracked
+ * state of its health.
+ *****************************************************************************/
+typedef struct evel_endpoint EVEL_ENDPOINT;
+
+/**************************************************************************//**
+ * Pick the endpoint for the next post.
+ *
+ * Endpoints which are out of use are skipped, unless they all are, in which
+ * case the one which has been out of use longest is picked.
+ *
+ * @returns The endpoint.
+ *****************************************************************************/
+EVEL_ENDPOINT * evel_endpoint_select(void);
+
+/**************************************************************************//**
+ * Record that a post has been started on an endpoint.
+ *
+ * @param endpoint  The endpoint.
+ *****************************************************************************/
+void evel_endpoint_posted(EVEL_ENDPOINT * const endpoint);
+
+/**************************************************************************//**
+ * Record that a post to an endpoint has completed, and track the endpoint's
+ * health.
+ *
+ * @param endpoint  The endpoint.
+ * @param healthy   Whether the post showed the endpoint to be healthy.
+ * @returns Whether the post took the endpoint out of use while another
+ *          endpoint is still in use, so that the post should fail over.
+ *****************************************************************************/
+bool evel_endpoint_completed(EVEL_ENDPOINT * const endpoint,
+                             const bool healthy);
+
+/**************************************************************************//**
+ * How many priority posts can be waiting to be sent at once.  Once full, the
+ * oldest is dropped since a later one carries more recent state.
+ *****************************************************************************/
+#define EVEL_PRIORITY_QUEUE_SIZE 4
+
+/**************************************************************************//**
+ * Queue a priority post to be sent back to the endpoint which asked for it.
+ *
+ * If the queue is full the oldest post is dropped to make room.
+ *
+ * @param post      The post, whose memory the queue takes over.
+ * @param endpoint  The endpoint which asked for the post.
+ *****************************************************************************/
+void evel_priority_post_queue(MEMORY_CHUNK * const post,
+                              EVEL_ENDPOINT * const endpoint);
+
+/**************************************************************************//**
+ * Take the oldest pending priority post off the queue, unless the priority
+ * transfer is still busy with the one before it.
+ *
+ * @param transfer_busy  Whether the priority transfer is in flight.
+ * @param post           Set to the post, whose memory the caller takes over.
+ * @param endpoint       Set to the endpoint which asked for the post.
+ * @returns Whether a post was taken.
+ *****************************************************************************/
+bool evel_priority_post_take(const bool transfer_busy,
+                             MEMORY_CHUNK * const post,
+                             EVEL_ENDPOINT ** const endpoint);
 
 /**************************************************************************//**
  * Terminate the event handler.
@@ -252,6 +407,30 @@ EVENT_INTERNAL * evel_new_internal_event(EVT_HANDLER_COMMAND command);
  *****************************************************************************/
 void evel_free_internal_event(EVENT_INTERNAL * event);
 
+/**************************************************************************//**
+ * Create a new encoded event.
+ *
+ * The event is encoded in the calling thread's ::EVEL_JSON_ARENA, applying
+ * the current throttle specification, and the result copied into the new
+ * ::EVENT_ENCODED.  The event itself is left for the caller to free.
+ *
+ * @param   event   Pointer to the ::EVENT_HEADER to encode.
+ * @returns pointer to the newly manufactured ::EVENT_ENCODED.  If the event
+ *          is not used (i.e. posted) it must be released using
+ *          ::evel_free_event.
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_ENCODED * evel_new_encoded_event(EVENT_HEADER * const event);
+
+/*****************************************************************************/
+/* Growable storage for encoding JSON, which keeps its memory between uses.  */
+/*****************************************************************************/
+typedef struct evel_json_arena
+{
+  char * json;
+  int size;
+} EVEL_JSON_ARENA;
+
 /*****************************************************************************/
 /* Structure to hold JSON buffer and associated tracking, as it is written.  */
 /*****************************************************************************/
@@ -261,6 +440,13 @@ typedef struct evel_json_buffer
   int offset;
   int max_size;
 
+  /***************************************************************************/
+  /* The arena which the buffer grows into, or NULL if the buffer is a fixed */
+  /* size.  A fixed size buffer which fills up is marked as truncated.       */
+  /***************************************************************************/
+  EVEL_JSON_ARENA * arena;
+  bool truncated;
+
   /***************************************************************************/
   /* The working throttle specification, which can be NULL.                  */
   /***************************************************************************/
@@ -287,6 +473,180 @@ typedef struct evel_json_buffer
 void evel_json_encode_header(EVEL_JSON_BUFFER * jbuf,
                              EVENT_HEADER * event);
 
+/**************************************************************************//**
+ * Free the cached encodings of the commonEventHeader defaults.
+ *****************************************************************************/
+void evel_header_cache_terminate(void);
+
+/**************************************************************************//**
+ * Allocate a new event structure, in its own arena if arenas are enabled.
+ *
+ * @param domain        The domain of the event.
+ * @param size          Size of the event structure, which must start with
+ *                      its ::EVENT_HEADER.
+ * @returns Pointer to the zeroed structure, or NULL on failure.
+ *****************************************************************************/
+void * evel_alloc_event(const EVEL_EVENT_DOMAINS domain, const size_t size);
+
+/**************************************************************************//**
+ * Release the structure of a freed event, returning it to the pools if they
+ * have room.
+ *
+ * @param header        Pointer to the event's ::EVENT_HEADER.
+ * @param domain        The domain of the event.
+ *****************************************************************************/
+void evel_release_event(EVENT_HEADER * const header,
+                        const EVEL_EVENT_DOMAINS domain);
+
+/**************************************************************************//**
+ * Take a structure for a new event from the pools.
+ *
+ * @param domain        The domain of the new event.
+ * @param in_arena      true to take a structure at the start of an arena,
+ *                      false for a plain structure.
+ * @returns Pointer to the structure, which is not initialized, or NULL if the
+ *          pools are empty.
+ *****************************************************************************/
+void * evel_event_pool_get(const EVEL_EVENT_DOMAINS domain,
+                           const bool in_arena);
+
+/**************************************************************************//**
+ * Return the structure of a freed event to the pools.
+ *
+ * @param domain        The domain of the freed event.
+ * @param in_arena      true if the structure is at the start of its arena,
+ *                      which must have been reset, or false otherwise.
+ * @param memory        The structure.
+ * @returns true if the structure was pooled, false if the pools are full and
+ *          the caller must release it.
+ *****************************************************************************/
+bool evel_event_pool_put(const EVEL_EVENT_DOMAINS domain,
+                         const bool in_arena,
+                         void * const memory);
+
+/**************************************************************************//**
+ * Free everything in the shared event pool.
+ *****************************************************************************/
+void evel_event_pool_terminate(void);
+
+/**************************************************************************//**
+ * Allocate memory owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param size          Number of bytes required.
+ * @returns Pointer to the memory, which is not initialized, or NULL.
+ *****************************************************************************/
+void * evel_event_malloc(EVENT_HEADER * const header, const size_t size);
+
+/**************************************************************************//**
+ * Copy a string into memory owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param value         The string to copy.
+ * @returns Pointer to the copy, or NULL.
+ *****************************************************************************/
+char * evel_event_strdup(EVENT_HEADER * const header,
+                         const char * const value);
+
+/**************************************************************************//**
+ * Free memory owned by an event.  Memory in an event's arena is left to be
+ * released with the arena.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param memory        The memory to free.
+ *****************************************************************************/
+void evel_event_free(EVENT_HEADER * const header, void * const memory);
+
+/**************************************************************************//**
+ * Make an event responsible for an object which was allocated before it was
+ * attached to the event, so that the object is released with the event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param destroy       Function which releases the object.
+ * @param object        The object.
+ *****************************************************************************/
+void evel_event_adopt(EVENT_HEADER * const header,
+                      void (*destroy)(void * object),
+                      void * const object);
+
+/**************************************************************************//**
+ * Add an item to the end of a list owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param list          Pointer to the list.
+ * @param item          The item to add.
+ *****************************************************************************/
+void evel_event_list_push(EVENT_HEADER * const header,
+                          DLIST * const list,
+                          void * const item);
+
+/**************************************************************************//**
+ * Set the value of an ::EVEL_OPTION_STRING owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param option        Pointer to the ::EVEL_OPTION_STRING.
+ * @param value         The value to set.
+ * @param description   Description to be used in logging.
+ *****************************************************************************/
+void evel_event_set_option_string(EVENT_HEADER * const header,
+                                  EVEL_OPTION_STRING * const option,
+                                  const char * const value,
+                                  const char * const description);
+
+/**************************************************************************//**
+ * Force the value of an ::EVEL_OPTION_STRING owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param option        Pointer to the ::EVEL_OPTION_STRING.
+ * @param value         The value to set.
+ *****************************************************************************/
+void evel_event_force_option_string(EVENT_HEADER * const header,
+                                    EVEL_OPTION_STRING * const option,
+                                    const char * const value);
+
+/**************************************************************************//**
+ * Free the underlying resources of an ::EVEL_OPTION_STRING owned by an
+ * event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param option        Pointer to the ::EVEL_OPTION_STRING.
+ *****************************************************************************/
+void evel_event_free_option_string(EVENT_HEADER * const header,
+                                   EVEL_OPTION_STRING * const option);
+
+/**************************************************************************//**
+ * Initialize a Vendor field owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param vfield        Pointer to the ::VENDOR_VNFNAME_FIELD.
+ * @param vendor_name   The vendor name.
+ *****************************************************************************/
+void evel_init_vendor_field(EVENT_HEADER * const header,
+                            VENDOR_VNFNAME_FIELD * const vfield,
+                            const char * const vendor_name);
+
+/**************************************************************************//**
+ * Set the Vendor module property of a Vendor field owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param vfield        Pointer to the ::VENDOR_VNFNAME_FIELD.
+ * @param module_name   The module name to be set.
+ *****************************************************************************/
+void evel_vendor_field_module_set(EVENT_HEADER * const header,
+                                  VENDOR_VNFNAME_FIELD * const vfield,
+                                  const char * const module_name);
+
+/**************************************************************************//**
+ * Set the VNF name property of a Vendor field owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param vfield        Pointer to the ::VENDOR_VNFNAME_FIELD.
+ * @param vnfname       The VNF name to be set.
+ *****************************************************************************/
+void evel_vendor_field_vnfname_set(EVENT_HEADER * const header,
+                                   VENDOR_VNFNAME_FIELD * const vfield,
+                                   const char * const vnfname);
+
 /**************************************************************************//**
  * Encode the fault in JSON according to AT&T's schema for the fault type.
  *
@@ -377,6 +737,38 @@ void evel_json_encode_other(EVEL_JSON_BUFFER * jbuf,
  *****************************************************************************/
 void evel_set_next_event_sequence(const int sequence);
 
+/**************************************************************************//**
+ * Encode the event as one entry of a JSON eventList.
+ *
+ * @param json      Pointer to where to store the JSON encoded data.
+ * @param max_size  Size of storage available in json.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ * @returns Number of bytes actually written.
+ *****************************************************************************/
+int evel_json_encode_event_list_entry(char * json,
+                                      int max_size,
+                                      EVENT_HEADER * event);
+
+/**************************************************************************//**
+ * Encode the event as a JSON event object into an ::EVEL_JSON_ARENA.
+ *
+ * @param arena     Pointer to the arena to encode into.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ * @returns Number of bytes written to the start of the arena.
+ *****************************************************************************/
+int evel_json_encode_event_arena(EVEL_JSON_ARENA * const arena,
+                                 EVENT_HEADER * event);
+
+/**************************************************************************//**
+ * Encode the event as one entry of a JSON eventList into an ::EVEL_JSON_ARENA.
+ *
+ * @param arena     Pointer to the arena to encode into.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ * @returns Number of bytes written to the start of the arena.
+ *****************************************************************************/
+int evel_json_encode_event_list_entry_arena(EVEL_JSON_ARENA * const arena,
+                                            EVENT_HEADER * event);
+
 /**************************************************************************//**
  * Handle a JSON response from the listener, contained in a ::MEMORY_CHUNK.
  *
@@ -401,15 +793,43 @@ void evel_json_buffer_init(EVEL_JSON_BUFFER * jbuf,
                            const int max_size,
                            EVEL_THROTTLE_SPEC * throttle_spec);
 
+/**************************************************************************//**
+ * Initialize a ::EVEL_JSON_BUFFER which grows into an ::EVEL_JSON_ARENA.
+ *
+ * The buffer is written from the start of the arena, growing it as required,
+ * so the encoding is never truncated.
+ *
+ * @param jbuf          Pointer to the ::EVEL_JSON_BUFFER to initialise.
+ * @param arena         Pointer to the arena to use.
+ * @param throttle_spec Pointer to throttle specification. Can be NULL.
+ *****************************************************************************/
+void evel_json_buffer_init_arena(EVEL_JSON_BUFFER * jbuf,
+                                 EVEL_JSON_ARENA * const arena,
+                                 EVEL_THROTTLE_SPEC * throttle_spec);
+
+/**************************************************************************//**
+ * Get the calling thread's ::EVEL_JSON_ARENA.
+ *
+ * The arena is created on first use and keeps the largest size it has grown
+ * to, so that once a thread has encoded its largest event, encoding needs no
+ * further memory allocation.  It is freed when the thread exits.
+ *
+ * @returns Pointer to the arena, or NULL if it could not be created.
+ *****************************************************************************/
+EVEL_JSON_ARENA * evel_json_thread_arena(void);
+
 /**************************************************************************//**
  * Encode a string key and string value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_string(EVEL_JSON_BUFFER * jbuf,
+                            const EVEL_THROTTLE_FIELDS field,
                             const char * const key,
                             const EVEL_OPTION_STRING * const option);
 
@@ -424,15 +844,37 @@ void evel_enc_kv_string(EVEL_JSON_BUFFER * jbuf,
                         const char * const key,
                         const char * const value);
 
+/**************************************************************************//**
+ * Add a key and value which were encoded earlier to a ::EVEL_JSON_BUFFER.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
+ * @param key           Pointer to the key, used to check for suppression.
+ * @param fragment      The encoded key and value, without a leading comma.
+ * @param length        The length of the fragment.
+ * @param optional      Whether the field may be suppressed by throttling.
+ * @return true if the key, value was added, false if it was suppressed.
+ *****************************************************************************/
+bool evel_enc_kv_fragment(EVEL_JSON_BUFFER * jbuf,
+                          const EVEL_THROTTLE_FIELDS field,
+                          const char * const key,
+                          const char * const fragment,
+                          const int length,
+                          const bool optional);
+
 /**************************************************************************//**
  * Encode a string key and integer value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_int(EVEL_JSON_BUFFER * jbuf,
+                         const EVEL_THROTTLE_FIELDS field,
                          const char * const key,
                          const EVEL_OPTION_INT * const option);
 
@@ -447,15 +889,30 @@ void evel_enc_kv_int(EVEL_JSON_BUFFER * jbuf,
                      const char * const key,
                      const int value);
 
+/**************************************************************************//**
+ * Encode a string key and an integer value, as a string, to a
+ * ::EVEL_JSON_BUFFER.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param key           Pointer to the key to encode.
+ * @param value         The corresponding value to encode.
+ *****************************************************************************/
+void evel_enc_kv_int_string(EVEL_JSON_BUFFER * jbuf,
+                            const char * const key,
+                            const int value);
+
 /**************************************************************************//**
  * Encode a string key and double value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_double(EVEL_JSON_BUFFER * jbuf,
+                            const EVEL_THROTTLE_FIELDS field,
                             const char * const key,
                             const EVEL_OPTION_DOUBLE * const option);
 
@@ -474,11 +931,14 @@ void evel_enc_kv_double(EVEL_JSON_BUFFER * jbuf,
  * Encode a string key and unsigned long long value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_ull(EVEL_JSON_BUFFER * jbuf,
+                         const EVEL_THROTTLE_FIELDS field,
                          const char * const key,
                          const EVEL_OPTION_ULL * const option);
 
@@ -497,11 +957,14 @@ void evel_enc_kv_ull(EVEL_JSON_BUFFER * jbuf,
  * Encode a string key and time value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_time(EVEL_JSON_BUFFER * jbuf,
+                          const EVEL_THROTTLE_FIELDS field,
                           const char * const key,
                           const EVEL_OPTION_TIME * const option);
 
@@ -533,10 +996,13 @@ void evel_enc_version(EVEL_JSON_BUFFER * jbuf,
  * Add the key and opening bracket of an optional named list to a JSON buffer.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @return true if the list was opened, false if it was suppressed.
  *****************************************************************************/
 bool evel_json_open_opt_named_list(EVEL_JSON_BUFFER * jbuf,
+                                   const EVEL_THROTTLE_FIELDS field,
                                    const char * const key);
 
 /**************************************************************************//**
@@ -570,9 +1036,12 @@ void evel_enc_list_item(EVEL_JSON_BUFFER * jbuf,
  * Add the opening bracket of an optional named object to a JSON buffer.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  *****************************************************************************/
 bool evel_json_open_opt_named_object(EVEL_JSON_BUFFER * jbuf,
+                                     const EVEL_THROTTLE_FIELDS field,
                                      const char * const key);
 
 /**************************************************************************//**
@@ -620,6 +1089,14 @@ void evel_json_rewind(EVEL_JSON_BUFFER * jbuf);
  *****************************************************************************/
 void evel_free_option_string(EVEL_OPTION_STRING * const option);
 
+/**************************************************************************//**
+ * Return the memory allocated for the value of an ::EVEL_OPTION_STRING.
+ *
+ * @param option        Pointer to the ::EVEL_OPTION_STRING.
+ * @returns Number of bytes allocated, or 0 if the option is not set.
+ *****************************************************************************/
+size_t evel_option_string_size(const EVEL_OPTION_STRING * const option);
+
 /**************************************************************************//**
  * Initialize an ::EVEL_OPTION_STRING to a not-set state.
  *
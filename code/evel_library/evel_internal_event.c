@@ -90,11 +90,78 @@ EVENT_INTERNAL * evel_new_internal_event(EVT_HANDLER_COMMAND command)
   event->header.event_domain = EVEL_DOMAIN_INTERNAL;
   event->command = command;
 
+  /***************************************************************************/
+  /* Internal commands go behind any events already queued.                  */
+  /***************************************************************************/
+  event->header.priority = EVEL_PRIORITY_LOW;
+
 exit_label:
   EVEL_EXIT();
   return event;
 }
 
+/**************************************************************************//**
+ * Create a new encoded event.
+ *
+ * The event is encoded in the calling thread's ::EVEL_JSON_ARENA, applying
+ * the current throttle specification, and the result copied into the new
+ * ::EVENT_ENCODED.  The event itself is left for the caller to free.
+ *
+ * @param   event   Pointer to the ::EVENT_HEADER to encode.
+ * @returns pointer to the newly manufactured ::EVENT_ENCODED.  If the event
+ *          is not used (i.e. posted) it must be released using
+ *          ::evel_free_event.
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_ENCODED * evel_new_encoded_event(EVENT_HEADER * const event)
+{
+  EVENT_ENCODED * encoded = NULL;
+  EVEL_JSON_ARENA * arena = NULL;
+  int json_size = 0;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(event != NULL);
+  assert(event->event_domain != EVEL_DOMAIN_INTERNAL);
+
+  arena = evel_json_thread_arena();
+  if (arena == NULL)
+  {
+    log_error_state("Out of memory");
+    goto exit_label;
+  }
+  json_size = evel_json_encode_event_list_entry_arena(arena, event);
+
+  /***************************************************************************/
+  /* Allocate the event with room for the encoding, which is kept            */
+  /* printf-able for debug.  Only the domain and priority of the header are  */
+  /* needed, so it doesn't take an event sequence number as a full header    */
+  /* would.                                                                  */
+  /***************************************************************************/
+  encoded = malloc(sizeof(EVENT_ENCODED) + json_size + 1);
+  if (encoded == NULL)
+  {
+    log_error_state("Out of memory");
+    goto exit_label;
+  }
+  memset(encoded, 0, sizeof(EVENT_ENCODED));
+  encoded->internal.header.event_domain = EVEL_DOMAIN_INTERNAL;
+  encoded->internal.header.priority = event->priority;
+  encoded->internal.header.size = sizeof(EVENT_ENCODED) + json_size + 1;
+  encoded->internal.command = EVT_CMD_POST_ENCODED;
+  encoded->json_size = json_size;
+  memcpy(encoded->json, arena->json, json_size);
+  encoded->json[json_size] = '\0';
+  EVEL_DEBUG("New encoded event is at %lp", encoded);
+
+exit_label:
+  EVEL_EXIT();
+  return encoded;
+}
+
 /**************************************************************************//**
  * Free an internal event.
  *
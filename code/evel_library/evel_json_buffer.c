@@ -36,6 +36,15 @@
 
 #include <assert.h>
 #include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EVEL_JSON_ESCAPE_X86
+#endif
 
 #include "evel_throttle.h"
 
@@ -43,6 +52,105 @@
 /* Local prototypes.                                                         */
 /*****************************************************************************/
 static char * evel_json_kv_comma(EVEL_JSON_BUFFER * jbuf);
+static bool evel_json_reserve(EVEL_JSON_BUFFER * jbuf, const int size);
+static void evel_json_vprintf(EVEL_JSON_BUFFER * jbuf,
+                              const char * const format,
+                              va_list largs);
+static void evel_json_printf(EVEL_JSON_BUFFER * jbuf,
+                             const char * const format,
+                             ...) __attribute__ ((format (printf, 2, 3)));
+static void evel_json_arena_free(void * arena);
+static void evel_json_arena_key_create(void);
+static void evel_json_kv_key(EVEL_JSON_BUFFER * jbuf, const char * const key);
+static int evel_json_format_ull(char * out, unsigned long long value);
+static int evel_json_format_int(char * out, const long long value);
+static int evel_json_format_double(char * out, const double value);
+static void evel_json_add_ull(EVEL_JSON_BUFFER * jbuf,
+                              const unsigned long long value);
+static void evel_json_add_int(EVEL_JSON_BUFFER * jbuf, const long long value);
+static void evel_json_add_double(EVEL_JSON_BUFFER * jbuf, const double value);
+static void evel_json_add_string(EVEL_JSON_BUFFER * jbuf,
+                                 const char * const value);
+static void evel_json_add_escape(EVEL_JSON_BUFFER * jbuf,
+                                 const unsigned char character);
+static int evel_json_clean_run_scalar(const char * const value,
+                                      const int length);
+static void evel_json_escape_select(void);
+#ifdef EVEL_JSON_ESCAPE_X86
+static int evel_json_clean_run_sse2(const char * const value,
+                                    const int length);
+static int evel_json_clean_run_avx2(const char * const value,
+                                    const int length)
+                                    __attribute__ ((target ("avx2")));
+#endif
+
+/*****************************************************************************/
+/* Room to leave for a formatted number, which is at most 25 characters.     */
+/*****************************************************************************/
+#define EVEL_JSON_NUMBER_SIZE 32
+
+/*****************************************************************************/
+/* Doubles below this magnitude have every integer exactly representable.    */
+/*****************************************************************************/
+#define EVEL_JSON_EXACT_INTEGER_LIMIT 9007199254740992.0
+#define EVEL_JSON_MANTISSA_DIGITS 16
+
+/*****************************************************************************/
+/* The most decimal places tried when formatting a double in fixed notation. */
+/*****************************************************************************/
+#define EVEL_JSON_MAX_DECIMALS 22
+
+/*****************************************************************************/
+/* The decimal digit pairs "00" to "99", for formatting two digits at once.  */
+/*****************************************************************************/
+static const char evel_json_digit_pairs[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+/*****************************************************************************/
+/* The characters which must be escaped in a JSON string: quotation mark,    */
+/* reverse solidus and the control characters.                               */
+/*****************************************************************************/
+static const bool evel_json_needs_escape[256] = {
+  [0x00 ... 0x1f] = true,
+  ['"'] = true,
+  ['\\'] = true
+};
+
+/*****************************************************************************/
+/* The function finding runs of characters which need no escaping, picked   */
+/* once for the best instruction set the CPU supports.                       */
+/*****************************************************************************/
+static int (*evel_json_clean_run)(const char * const value,
+                                  const int length);
+static pthread_once_t evel_json_escape_once = PTHREAD_ONCE_INIT;
+
+/*****************************************************************************/
+/* Hex digits for \u escapes.                                                */
+/*****************************************************************************/
+static const char evel_json_hex_digits[] = "0123456789abcdef";
+
+/*****************************************************************************/
+/* Powers of ten, all of which are exactly representable as doubles.         */
+/*****************************************************************************/
+static const double evel_json_powers_of_ten[EVEL_JSON_MAX_DECIMALS + 1] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*****************************************************************************/
+/* The key to each thread's JSON arena.                                      */
+/*****************************************************************************/
+static pthread_key_t evel_json_arena_key;
+static pthread_once_t evel_json_arena_once = PTHREAD_ONCE_INIT;
 
 /**************************************************************************//**
  * Initialize a ::EVEL_JSON_BUFFER.
@@ -64,6 +172,8 @@ void evel_json_buffer_init(EVEL_JSON_BUFFER * jbuf,
   jbuf->json = json;
   jbuf->max_size = max_size;
   jbuf->offset = 0;
+  jbuf->arena = NULL;
+  jbuf->truncated = false;
   jbuf->throttle_spec = throttle_spec;
   jbuf->depth = 0;
   jbuf->checkpoint = -1;
@@ -71,6 +181,714 @@ void evel_json_buffer_init(EVEL_JSON_BUFFER * jbuf,
   EVEL_EXIT();
 }
 
+/**************************************************************************//**
+ * Initialize a ::EVEL_JSON_BUFFER which grows into an ::EVEL_JSON_ARENA.
+ *
+ * The buffer is written from the start of the arena, growing it as required,
+ * so the encoding is never truncated.
+ *
+ * @param jbuf          Pointer to the ::EVEL_JSON_BUFFER to initialise.
+ * @param arena         Pointer to the arena to use.
+ * @param throttle_spec Pointer to throttle specification. Can be NULL.
+ *****************************************************************************/
+void evel_json_buffer_init_arena(EVEL_JSON_BUFFER * jbuf,
+                                 EVEL_JSON_ARENA * const arena,
+                                 EVEL_THROTTLE_SPEC * throttle_spec)
+{
+  EVEL_ENTER();
+
+  assert(jbuf != NULL);
+  assert(arena != NULL);
+  jbuf->json = arena->json;
+  jbuf->max_size = arena->size;
+  jbuf->offset = 0;
+  jbuf->arena = arena;
+  jbuf->truncated = false;
+  jbuf->throttle_spec = throttle_spec;
+  jbuf->depth = 0;
+  jbuf->checkpoint = -1;
+
+  /***************************************************************************/
+  /* Make sure that even an empty encoding is terminated.                    */
+  /***************************************************************************/
+  if (evel_json_reserve(jbuf, 0))
+  {
+    jbuf->json[0] = '\0';
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the calling thread's ::EVEL_JSON_ARENA.
+ *
+ * The arena is created on first use and keeps the largest size it has grown
+ * to, so that once a thread has encoded its largest event, encoding needs no
+ * further memory allocation.  It is freed when the thread exits.
+ *
+ * @returns Pointer to the arena, or NULL if it could not be created.
+ *****************************************************************************/
+EVEL_JSON_ARENA * evel_json_thread_arena(void)
+{
+  EVEL_JSON_ARENA * arena = NULL;
+
+  EVEL_ENTER();
+
+  pthread_once(&evel_json_arena_once, evel_json_arena_key_create);
+  arena = pthread_getspecific(evel_json_arena_key);
+  if (arena == NULL)
+  {
+    arena = malloc(sizeof(EVEL_JSON_ARENA));
+    if (arena == NULL)
+    {
+      log_error_state("Failed to allocate JSON arena");
+      goto exit_label;
+    }
+    arena->json = malloc(EVEL_MAX_JSON_BODY);
+    arena->size = (arena->json != NULL) ? EVEL_MAX_JSON_BODY : 0;
+    pthread_setspecific(evel_json_arena_key, arena);
+  }
+
+exit_label:
+  EVEL_EXIT();
+
+  return arena;
+}
+
+/**************************************************************************//**
+ * Create the key to each thread's JSON arena.
+ *****************************************************************************/
+static void evel_json_arena_key_create(void)
+{
+  pthread_key_create(&evel_json_arena_key, evel_json_arena_free);
+}
+
+/**************************************************************************//**
+ * Free a thread's JSON arena as the thread exits.
+ *
+ * @param arena         Pointer to the ::EVEL_JSON_ARENA to free.
+ *****************************************************************************/
+static void evel_json_arena_free(void * arena)
+{
+  if (arena != NULL)
+  {
+    free(((EVEL_JSON_ARENA *) arena)->json);
+    free(arena);
+  }
+}
+
+/**************************************************************************//**
+ * Make room to add to a ::EVEL_JSON_BUFFER.
+ *
+ * Makes sure that there is room for the given number of bytes plus a
+ * terminating NUL at the current offset, growing the arena if the buffer has
+ * one.  The arena at least doubles in size each time, so its memory is
+ * reallocated only a few times before reaching its working size.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param size          Number of bytes about to be added.
+ * @returns true if there is room, false if the buffer is full, in which case
+ *          it is marked as truncated.
+ *****************************************************************************/
+static bool evel_json_reserve(EVEL_JSON_BUFFER * jbuf, const int size)
+{
+  EVEL_JSON_ARENA * arena = jbuf->arena;
+  int needed = jbuf->offset + size + 1;
+  int new_size = 0;
+  char * new_json = NULL;
+
+  if (jbuf->truncated)
+  {
+    return false;
+  }
+
+  if (needed <= jbuf->max_size)
+  {
+    return true;
+  }
+
+  if (arena != NULL)
+  {
+    new_size = (arena->size > 0) ? arena->size : EVEL_MAX_JSON_BODY;
+    while (new_size < needed)
+    {
+      new_size *= 2;
+    }
+    new_json = realloc(arena->json, new_size);
+    if (new_json != NULL)
+    {
+      EVEL_DEBUG("JSON arena grown from %d to %d bytes", arena->size, new_size);
+      arena->json = new_json;
+      arena->size = new_size;
+      jbuf->json = new_json;
+      jbuf->max_size = new_size;
+      return true;
+    }
+  }
+
+  log_error_state("JSON buffer of %d bytes full - encoding truncated",
+                  jbuf->max_size);
+  jbuf->truncated = true;
+  return false;
+}
+
+/**************************************************************************//**
+ * Add formatted text to a ::EVEL_JSON_BUFFER.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param format        Format string in standard printf format.
+ * @param largs         Variable parameters for format string.
+ *****************************************************************************/
+static void evel_json_vprintf(EVEL_JSON_BUFFER * jbuf,
+                              const char * const format,
+                              va_list largs)
+{
+  va_list retry_args;
+  int length;
+
+  if (jbuf->truncated)
+  {
+    return;
+  }
+
+  /***************************************************************************/
+  /* Almost everything fits first time.  If it doesn't, make room and try    */
+  /* again, or keep what fitted if there's no more room to be had.           */
+  /***************************************************************************/
+  va_copy(retry_args, largs);
+  length = vsnprintf(jbuf->json + jbuf->offset,
+                     jbuf->max_size - jbuf->offset,
+                     format,
+                     largs);
+  if (length >= jbuf->max_size - jbuf->offset)
+  {
+    if (evel_json_reserve(jbuf, length))
+    {
+      vsnprintf(jbuf->json + jbuf->offset,
+                jbuf->max_size - jbuf->offset,
+                format,
+                retry_args);
+    }
+    else
+    {
+      length = jbuf->max_size - jbuf->offset - 1;
+    }
+  }
+  va_end(retry_args);
+  jbuf->offset += length;
+}
+
+/**************************************************************************//**
+ * Add formatted text to a ::EVEL_JSON_BUFFER.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param format        Format string in standard printf format.
+ * @param ...           Variable parameters for format string.
+ *****************************************************************************/
+static void evel_json_printf(EVEL_JSON_BUFFER * jbuf,
+                             const char * const format,
+                             ...)
+{
+  va_list largs;
+
+  va_start(largs, format);
+  evel_json_vprintf(jbuf, format, largs);
+  va_end(largs);
+}
+
+/**************************************************************************//**
+ * Add the comma if required, and the quoted key, of a key-value pair to a
+ * ::EVEL_JSON_BUFFER.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param key           Pointer to the key to encode.
+ *****************************************************************************/
+static void evel_json_kv_key(EVEL_JSON_BUFFER * jbuf, const char * const key)
+{
+  const char * comma = evel_json_kv_comma(jbuf);
+  int comma_length = strlen(comma);
+  int key_length = strlen(key);
+  char * json;
+
+  if (!evel_json_reserve(jbuf, comma_length + key_length + 4))
+  {
+    return;
+  }
+
+  json = jbuf->json + jbuf->offset;
+  memcpy(json, comma, comma_length);
+  json += comma_length;
+  *json++ = '"';
+  memcpy(json, key, key_length);
+  json += key_length;
+  memcpy(json, "\": ", 4);
+  jbuf->offset += comma_length + key_length + 4;
+  jbuf->json[jbuf->offset] = '\0';
+}
+
+/**************************************************************************//**
+ * Format an unsigned integer in decimal.
+ *
+ * Digits are produced two at a time, from the least significant end.
+ *
+ * @param out           Where to write the digits, which is not terminated.
+ *                      There must be room for ::EVEL_JSON_NUMBER_SIZE bytes.
+ * @param value         The value to format.
+ * @returns Number of characters written.
+ *****************************************************************************/
+static int evel_json_format_ull(char * out, unsigned long long value)
+{
+  char digits[EVEL_JSON_NUMBER_SIZE];
+  char * digit = digits + EVEL_JSON_NUMBER_SIZE;
+  int pair;
+  int length;
+
+  while (value >= 100)
+  {
+    pair = (value % 100) * 2;
+    value /= 100;
+    *--digit = evel_json_digit_pairs[pair + 1];
+    *--digit = evel_json_digit_pairs[pair];
+  }
+  if (value >= 10)
+  {
+    pair = value * 2;
+    *--digit = evel_json_digit_pairs[pair + 1];
+    *--digit = evel_json_digit_pairs[pair];
+  }
+  else
+  {
+    *--digit = '0' + value;
+  }
+
+  length = digits + EVEL_JSON_NUMBER_SIZE - digit;
+  memcpy(out, digit, length);
+
+  return length;
+}
+
+/**************************************************************************//**
+ * Format a signed integer in decimal.
+ *
+ * @param out           Where to write the digits, which is not terminated.
+ *                      There must be room for ::EVEL_JSON_NUMBER_SIZE bytes.
+ * @param value         The value to format.
+ * @returns Number of characters written.
+ *****************************************************************************/
+static int evel_json_format_int(char * out, const long long value)
+{
+  int length;
+
+  if (value < 0)
+  {
+    out[0] = '-';
+    length = 1 + evel_json_format_ull(out + 1,
+                                      0ULL - (unsigned long long) value);
+  }
+  else
+  {
+    length = evel_json_format_ull(out, value);
+  }
+
+  return length;
+}
+
+/**************************************************************************//**
+ * Format a double as the shortest decimal which reads back as the same value.
+ *
+ * Values of the sort found in measurements, like 11.11, are written in fixed
+ * notation with the fewest decimal places which give back exactly the same
+ * double.  The test is exact: the candidate's digits and the power of ten
+ * are both exactly representable, so the division rounds correctly, just as
+ * reading the decimal back does.  Anything else, which is mostly values
+ * needing 16 or 17 significant digits, falls back to the fewest significant
+ * digits which read back correctly.
+ *
+ * @param out           Where to write the number, which is terminated.
+ *                      There must be room for ::EVEL_JSON_NUMBER_SIZE bytes.
+ * @param value         The value to format.
+ * @returns Number of characters written, excluding the terminator.
+ *****************************************************************************/
+static int evel_json_format_double(char * out, const double value)
+{
+  double magnitude = (value < 0) ? -value : value;
+  double scaled;
+  unsigned long long mantissa;
+  unsigned long long divisor;
+  unsigned long long integer_part;
+  unsigned long long fraction;
+  int decimals;
+  int precision;
+  int length = 0;
+  int fraction_length;
+
+  /***************************************************************************/
+  /* Non-finite values have always been written as printf writes them.       */
+  /***************************************************************************/
+  if (!isfinite(value))
+  {
+    return snprintf(out, EVEL_JSON_NUMBER_SIZE, "%f", value);
+  }
+
+  /***************************************************************************/
+  /* Look for the fewest decimal places which represent the value exactly.   */
+  /***************************************************************************/
+  for (decimals = 0; decimals <= EVEL_JSON_MAX_DECIMALS; decimals++)
+  {
+    scaled = magnitude * evel_json_powers_of_ten[decimals];
+    if (scaled >= EVEL_JSON_EXACT_INTEGER_LIMIT)
+    {
+      break;
+    }
+    mantissa = (unsigned long long) (scaled + 0.5);
+    if ((double) mantissa / evel_json_powers_of_ten[decimals] == magnitude)
+    {
+      if (signbit(value))
+      {
+        out[length++] = '-';
+      }
+
+      /***********************************************************************/
+      /* The mantissa has at most 16 digits, so with more decimal places     */
+      /* than that it's all fraction.                                        */
+      /***********************************************************************/
+      if (decimals < EVEL_JSON_MANTISSA_DIGITS)
+      {
+        divisor = (unsigned long long) evel_json_powers_of_ten[decimals];
+        integer_part = mantissa / divisor;
+        fraction = mantissa % divisor;
+      }
+      else
+      {
+        integer_part = 0;
+        fraction = mantissa;
+      }
+      length += evel_json_format_ull(out + length, integer_part);
+      if (decimals > 0)
+      {
+        /*********************************************************************/
+        /* Format the fraction, then add the leading zeros it needs.         */
+        /*********************************************************************/
+        out[length++] = '.';
+        fraction_length = evel_json_format_ull(out + length, fraction);
+        memmove(out + length + decimals - fraction_length,
+                out + length,
+                fraction_length);
+        memset(out + length, '0', decimals - fraction_length);
+        length += decimals;
+      }
+      out[length] = '\0';
+      return length;
+    }
+  }
+
+  /***************************************************************************/
+  /* Otherwise use the fewest significant digits which read back correctly.  */
+  /* Any normal double which has a representation that short is written     */
+  /* that way with 15 significant digits, but subnormal values have too few  */
+  /* bits for that to hold.  If we ran out of exact integers after trying    */
+  /* some decimal places, we've already ruled out anything up to 15 digits.  */
+  /***************************************************************************/
+  if ((decimals > 0) && (decimals <= EVEL_JSON_MAX_DECIMALS))
+  {
+    precision = DBL_DIG + 1;
+  }
+  else if (magnitude < DBL_MIN)
+  {
+    precision = 1;
+  }
+  else
+  {
+    precision = DBL_DIG;
+  }
+  for (; precision <= 17; precision++)
+  {
+    length = snprintf(out, EVEL_JSON_NUMBER_SIZE, "%.*g", precision, value);
+    if (strtod(out, NULL) == value)
+    {
+      break;
+    }
+  }
+
+  return length;
+}
+
+/**************************************************************************//**
+ * Add an unsigned integer to a ::EVEL_JSON_BUFFER.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param value         The value to add.
+ *****************************************************************************/
+static void evel_json_add_ull(EVEL_JSON_BUFFER * jbuf,
+                              const unsigned long long value)
+{
+  if (evel_json_reserve(jbuf, EVEL_JSON_NUMBER_SIZE))
+  {
+    jbuf->offset += evel_json_format_ull(jbuf->json + jbuf->offset, value);
+    jbuf->json[jbuf->offset] = '\0';
+  }
+}
+
+/**************************************************************************//**
+ * Add a signed integer to a ::EVEL_JSON_BUFFER.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param value         The value to add.
+ *****************************************************************************/
+static void evel_json_add_int(EVEL_JSON_BUFFER * jbuf, const long long value)
+{
+  if (evel_json_reserve(jbuf, EVEL_JSON_NUMBER_SIZE))
+  {
+    jbuf->offset += evel_json_format_int(jbuf->json + jbuf->offset, value);
+    jbuf->json[jbuf->offset] = '\0';
+  }
+}
+
+/**************************************************************************//**
+ * Add a double to a ::EVEL_JSON_BUFFER.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param value         The value to add.
+ *****************************************************************************/
+static void evel_json_add_double(EVEL_JSON_BUFFER * jbuf, const double value)
+{
+  if (evel_json_reserve(jbuf, EVEL_JSON_NUMBER_SIZE))
+  {
+    jbuf->offset += evel_json_format_double(jbuf->json + jbuf->offset, value);
+  }
+}
+
+/**************************************************************************//**
+ * Add a string to a ::EVEL_JSON_BUFFER as a quoted, escaped JSON string.
+ *
+ * Runs of characters which need no escaping are found a vector at a time
+ * where the CPU allows, and copied in bulk.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param value         The string to add.
+ *****************************************************************************/
+static void evel_json_add_string(EVEL_JSON_BUFFER * jbuf,
+                                 const char * const value)
+{
+  const int length = strlen(value);
+  int index = 0;
+  int run;
+
+  pthread_once(&evel_json_escape_once, evel_json_escape_select);
+
+  /***************************************************************************/
+  /* Most strings need no escaping, so make room for them in one go.         */
+  /***************************************************************************/
+  if (!evel_json_reserve(jbuf, length + 2))
+  {
+    return;
+  }
+  jbuf->json[jbuf->offset++] = '"';
+
+  while (index < length)
+  {
+    run = evel_json_clean_run(value + index, length - index);
+
+    /*************************************************************************/
+    /* Leave room for the longest escape and the closing quote after the     */
+    /* run.                                                                  */
+    /*************************************************************************/
+    if (!evel_json_reserve(jbuf, run + 7))
+    {
+      return;
+    }
+    memcpy(jbuf->json + jbuf->offset, value + index, run);
+    jbuf->offset += run;
+    index += run;
+
+    if (index < length)
+    {
+      evel_json_add_escape(jbuf, value[index]);
+      index++;
+    }
+  }
+
+  jbuf->json[jbuf->offset++] = '"';
+  jbuf->json[jbuf->offset] = '\0';
+}
+
+/**************************************************************************//**
+ * Add the escape sequence for a character to a ::EVEL_JSON_BUFFER.
+ *
+ * The caller must have made room for the longest escape sequence.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param character     The character to escape.
+ *****************************************************************************/
+static void evel_json_add_escape(EVEL_JSON_BUFFER * jbuf,
+                                 const unsigned char character)
+{
+  char * json = jbuf->json + jbuf->offset;
+
+  json[0] = '\\';
+  switch (character)
+  {
+    case '"':
+    case '\\':
+      json[1] = character;
+      break;
+
+    case '\b':
+      json[1] = 'b';
+      break;
+
+    case '\f':
+      json[1] = 'f';
+      break;
+
+    case '\n':
+      json[1] = 'n';
+      break;
+
+    case '\r':
+      json[1] = 'r';
+      break;
+
+    case '\t':
+      json[1] = 't';
+      break;
+
+    default:
+      json[1] = 'u';
+      json[2] = '0';
+      json[3] = '0';
+      json[4] = evel_json_hex_digits[character >> 4];
+      json[5] = evel_json_hex_digits[character & 0xf];
+      jbuf->offset += 6;
+      return;
+  }
+  jbuf->offset += 2;
+}
+
+/**************************************************************************//**
+ * Pick the function to find runs of characters which need no escaping.
+ *****************************************************************************/
+static void evel_json_escape_select(void)
+{
+  evel_json_clean_run = evel_json_clean_run_scalar;
+
+#ifdef EVEL_JSON_ESCAPE_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  {
+    evel_json_clean_run = evel_json_clean_run_avx2;
+  }
+  else if (__builtin_cpu_supports("sse2"))
+  {
+    evel_json_clean_run = evel_json_clean_run_sse2;
+  }
+#endif
+}
+
+/**************************************************************************//**
+ * Find the length of the run of characters which need no escaping, a byte
+ * at a time.
+ *
+ * @param value         The characters to check.
+ * @param length        The number of characters to check.
+ * @returns The number of characters before the first which needs escaping,
+ *          or length if none does.
+ *****************************************************************************/
+static int evel_json_clean_run_scalar(const char * const value,
+                                      const int length)
+{
+  int index = 0;
+
+  while ((index < length) &&
+         (!evel_json_needs_escape[(unsigned char) value[index]]))
+  {
+    index++;
+  }
+
+  return index;
+}
+
+#ifdef EVEL_JSON_ESCAPE_X86
+/**************************************************************************//**
+ * Find the length of the run of characters which need no escaping, 16 bytes
+ * at a time.
+ *
+ * A byte needs escaping if it is a quote or backslash, or no greater than
+ * 0x1f, which is tested unsigned so that UTF-8 bytes pass.
+ *
+ * @param value         The characters to check.
+ * @param length        The number of characters to check.
+ * @returns The number of characters before the first which needs escaping,
+ *          or length if none does.
+ *****************************************************************************/
+static int evel_json_clean_run_sse2(const char * const value,
+                                    const int length)
+{
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control = _mm_set1_epi8(0x1f);
+  __m128i chunk;
+  __m128i dirty;
+  int mask;
+  int index = 0;
+
+  while (index + 16 <= length)
+  {
+    chunk = _mm_loadu_si128((const __m128i *) (value + index));
+    dirty = _mm_or_si128(
+              _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                           _mm_cmpeq_epi8(chunk, backslash)),
+              _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+    mask = _mm_movemask_epi8(dirty);
+    if (mask != 0)
+    {
+      return index + __builtin_ctz(mask);
+    }
+    index += 16;
+  }
+
+  return index + evel_json_clean_run_scalar(value + index, length - index);
+}
+
+/**************************************************************************//**
+ * Find the length of the run of characters which need no escaping, 32 bytes
+ * at a time.
+ *
+ * @param value         The characters to check.
+ * @param length        The number of characters to check.
+ * @returns The number of characters before the first which needs escaping,
+ *          or length if none does.
+ *****************************************************************************/
+static int evel_json_clean_run_avx2(const char * const value,
+                                    const int length)
+{
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i control = _mm256_set1_epi8(0x1f);
+  __m256i chunk;
+  __m256i dirty;
+  unsigned int mask;
+  int index = 0;
+
+  while (index + 32 <= length)
+  {
+    chunk = _mm256_loadu_si256((const __m256i *) (value + index));
+    dirty = _mm256_or_si256(
+              _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                              _mm256_cmpeq_epi8(chunk, backslash)),
+              _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+    mask = _mm256_movemask_epi8(dirty);
+    if (mask != 0)
+    {
+      return index + __builtin_ctz(mask);
+    }
+    index += 32;
+  }
+
+  return index + evel_json_clean_run_sse2(value + index, length - index);
+}
+#endif
+
 /**************************************************************************//**
  * Encode an integer value to a JSON buffer.
  *
@@ -87,9 +905,7 @@ void evel_enc_int(EVEL_JSON_BUFFER * jbuf,
   /***************************************************************************/
   assert(jbuf != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%d", value);
+  evel_json_add_int(jbuf, value);
 
   EVEL_EXIT();
 }
@@ -98,11 +914,14 @@ void evel_enc_int(EVEL_JSON_BUFFER * jbuf,
  * Encode a string key and string value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_string(EVEL_JSON_BUFFER * jbuf,
+                            const EVEL_THROTTLE_FIELDS field,
                             const char * const key,
                             const EVEL_OPTION_STRING * const option)
 {
@@ -119,7 +938,7 @@ bool evel_enc_kv_opt_string(EVEL_JSON_BUFFER * jbuf,
   {
     if ((jbuf->depth == EVEL_THROTTLE_FIELD_DEPTH) &&
         (jbuf->throttle_spec != NULL) &&
-        evel_throttle_suppress_field(jbuf->throttle_spec, key))
+        evel_throttle_suppress_field(jbuf->throttle_spec, field, key))
     {
       EVEL_INFO("Suppressed: %s, %s", key, option->value);
     }
@@ -147,9 +966,6 @@ void evel_enc_kv_string(EVEL_JSON_BUFFER * jbuf,
                         const char * const key,
                         const char * const value)
 {
-  int index;
-  int length;
-
   EVEL_ENTER();
 
   /***************************************************************************/
@@ -158,46 +974,75 @@ void evel_enc_kv_string(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%s\"%s\": \"",
-                           evel_json_kv_comma(jbuf),
-                           key);
+  /***************************************************************************/
+  /* We need to escape quotation marks, backslashes and control characters   */
+  /* in the value.                                                           */
+  /***************************************************************************/
+  evel_json_kv_key(jbuf, key);
+  evel_json_add_string(jbuf, value);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add a key and value which were encoded earlier to a ::EVEL_JSON_BUFFER.
+ *
+ * This is used for fields whose value is the same for many events, so that
+ * they are encoded once rather than once per event.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
+ * @param key           Pointer to the key, used to check for suppression.
+ * @param fragment      The encoded key and value, without a leading comma.
+ * @param length        The length of the fragment.
+ * @param optional      Whether the field may be suppressed by throttling.
+ * @return true if the key, value was added, false if it was suppressed.
+ *****************************************************************************/
+bool evel_enc_kv_fragment(EVEL_JSON_BUFFER * jbuf,
+                          const EVEL_THROTTLE_FIELDS field,
+                          const char * const key,
+                          const char * const fragment,
+                          const int length,
+                          const bool optional)
+{
+  const char * comma;
+  int comma_length;
+  bool added = false;
+
+  EVEL_ENTER();
 
   /***************************************************************************/
-  /* We need to escape quotation marks and backslashes in the value.         */
+  /* Check preconditions.                                                    */
   /***************************************************************************/
-  length = strlen(value);
+  assert(jbuf != NULL);
+  assert(key != NULL);
+  assert(fragment != NULL);
 
-  for (index = 0; index < length; index++)
+  if (optional &&
+      (jbuf->depth == EVEL_THROTTLE_FIELD_DEPTH) &&
+      (jbuf->throttle_spec != NULL) &&
+      evel_throttle_suppress_field(jbuf->throttle_spec, field, key))
   {
-    /*************************************************************************/
-    /* Drop out if no more space.                                            */
-    /*************************************************************************/
-    if (jbuf->max_size - jbuf->offset < 2)
-    {
-      break;
-    }
-
-    /*************************************************************************/
-    /* Add an escape character if necessary, then write the character        */
-    /* itself.                                                               */
-    /*************************************************************************/
-    if ((value[index] == '\"') || (value[index] == '\\'))
+    EVEL_INFO("Suppressed: %s", key);
+  }
+  else
+  {
+    comma = evel_json_kv_comma(jbuf);
+    comma_length = strlen(comma);
+    if (evel_json_reserve(jbuf, comma_length + length))
     {
-      jbuf->json[jbuf->offset] = '\\';
-      jbuf->offset++;
+      memcpy(jbuf->json + jbuf->offset, comma, comma_length);
+      memcpy(jbuf->json + jbuf->offset + comma_length, fragment, length);
+      jbuf->offset += comma_length + length;
+      jbuf->json[jbuf->offset] = '\0';
     }
-
-    jbuf->json[jbuf->offset] = value[index];
-    jbuf->offset++;
+    added = true;
   }
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "\"");
-
   EVEL_EXIT();
+
+  return added;
 }
 
 
@@ -205,11 +1050,14 @@ void evel_enc_kv_string(EVEL_JSON_BUFFER * jbuf,
  * Encode a string key and integer value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_int(EVEL_JSON_BUFFER * jbuf,
+                         const EVEL_THROTTLE_FIELDS field,
                          const char * const key,
                          const EVEL_OPTION_INT * const option)
 {
@@ -226,7 +1074,7 @@ bool evel_enc_kv_opt_int(EVEL_JSON_BUFFER * jbuf,
   {
     if ((jbuf->depth == EVEL_THROTTLE_FIELD_DEPTH) &&
         (jbuf->throttle_spec != NULL) &&
-        evel_throttle_suppress_field(jbuf->throttle_spec, key))
+        evel_throttle_suppress_field(jbuf->throttle_spec, field, key))
     {
       EVEL_INFO("Suppressed: %s, %d", key, option->value);
     }
@@ -262,12 +1110,40 @@ void evel_enc_kv_int(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%s\"%s\": %d",
-                           evel_json_kv_comma(jbuf),
-                           key,
-                           value);
+  evel_json_kv_key(jbuf, key);
+  evel_json_add_int(jbuf, value);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Encode a string key and an integer value, as a string, to a
+ * ::EVEL_JSON_BUFFER.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param key           Pointer to the key to encode.
+ * @param value         The corresponding value to encode.
+ *****************************************************************************/
+void evel_enc_kv_int_string(EVEL_JSON_BUFFER * jbuf,
+                            const char * const key,
+                            const int value)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+  assert(key != NULL);
+
+  evel_json_kv_key(jbuf, key);
+  if (evel_json_reserve(jbuf, EVEL_JSON_NUMBER_SIZE + 2))
+  {
+    jbuf->json[jbuf->offset++] = '"';
+    jbuf->offset += evel_json_format_int(jbuf->json + jbuf->offset, value);
+    jbuf->json[jbuf->offset++] = '"';
+    jbuf->json[jbuf->offset] = '\0';
+  }
 
   EVEL_EXIT();
 }
@@ -291,12 +1167,11 @@ void evel_enc_kv_object(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%s\"%s\": %s",
-                           evel_json_kv_comma(jbuf),
-                           key,
-                           value);
+  evel_json_printf(jbuf,
+                   "%s\"%s\": %s",
+                   evel_json_kv_comma(jbuf),
+                   key,
+                   value);
 
   EVEL_EXIT();
 }
@@ -305,11 +1180,14 @@ void evel_enc_kv_object(EVEL_JSON_BUFFER * jbuf,
  * Encode a string key and double value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_double(EVEL_JSON_BUFFER * jbuf,
+                            const EVEL_THROTTLE_FIELDS field,
                             const char * const key,
                             const EVEL_OPTION_DOUBLE * const option)
 {
@@ -326,7 +1204,7 @@ bool evel_enc_kv_opt_double(EVEL_JSON_BUFFER * jbuf,
   {
     if ((jbuf->depth == EVEL_THROTTLE_FIELD_DEPTH) &&
         (jbuf->throttle_spec != NULL) &&
-        evel_throttle_suppress_field(jbuf->throttle_spec, key))
+        evel_throttle_suppress_field(jbuf->throttle_spec, field, key))
     {
       EVEL_INFO("Suppressed: %s, %1f", key, option->value);
     }
@@ -362,12 +1240,8 @@ void evel_enc_kv_double(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%s\"%s\": %1f",
-                           evel_json_kv_comma(jbuf),
-                           key,
-                           value);
+  evel_json_kv_key(jbuf, key);
+  evel_json_add_double(jbuf, value);
 
   EVEL_EXIT();
 }
@@ -376,11 +1250,14 @@ void evel_enc_kv_double(EVEL_JSON_BUFFER * jbuf,
  * Encode a string key and unsigned long long value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_ull(EVEL_JSON_BUFFER * jbuf,
+                         const EVEL_THROTTLE_FIELDS field,
                          const char * const key,
                          const EVEL_OPTION_ULL * const option)
 {
@@ -397,7 +1274,7 @@ bool evel_enc_kv_opt_ull(EVEL_JSON_BUFFER * jbuf,
   {
     if ((jbuf->depth == EVEL_THROTTLE_FIELD_DEPTH) &&
         (jbuf->throttle_spec != NULL) &&
-        evel_throttle_suppress_field(jbuf->throttle_spec, key))
+        evel_throttle_suppress_field(jbuf->throttle_spec, field, key))
     {
       EVEL_INFO("Suppressed: %s, %1lu", key, option->value);
     }
@@ -433,12 +1310,8 @@ void evel_enc_kv_ull(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%s\"%s\": %llu",
-                           evel_json_kv_comma(jbuf),
-                           key,
-                           value);
+  evel_json_kv_key(jbuf, key);
+  evel_json_add_ull(jbuf, value);
 
   EVEL_EXIT();
 }
@@ -447,11 +1320,14 @@ void evel_enc_kv_ull(EVEL_JSON_BUFFER * jbuf,
  * Encode a string key and time value to a ::EVEL_JSON_BUFFER.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @param option        Pointer to holder of the corresponding value to encode.
  * @return true if the key, value was added, false if it was suppressed.
  *****************************************************************************/
 bool evel_enc_kv_opt_time(EVEL_JSON_BUFFER * jbuf,
+                          const EVEL_THROTTLE_FIELDS field,
                           const char * const key,
                           const EVEL_OPTION_TIME * const option)
 {
@@ -468,7 +1344,7 @@ bool evel_enc_kv_opt_time(EVEL_JSON_BUFFER * jbuf,
   {
     if ((jbuf->depth == EVEL_THROTTLE_FIELD_DEPTH) &&
         (jbuf->throttle_spec != NULL) &&
-        evel_throttle_suppress_field(jbuf->throttle_spec, key))
+        evel_throttle_suppress_field(jbuf->throttle_spec, field, key))
     {
       EVEL_INFO("Suppressed time: %s", key);
     }
@@ -505,18 +1381,18 @@ void evel_enc_kv_time(EVEL_JSON_BUFFER * jbuf,
   assert(key != NULL);
   assert(time != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%s\"%s\": \"",
-                           evel_json_kv_comma(jbuf),
-                           key);
-  jbuf->offset += strftime(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           EVEL_RFC2822_STRFTIME_FORMAT,
-                           localtime(time));
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "\"");
+  evel_json_printf(jbuf,
+                   "%s\"%s\": \"",
+                   evel_json_kv_comma(jbuf),
+                   key);
+  if (evel_json_reserve(jbuf, EVEL_MAX_TIME_STRING_LEN))
+  {
+    jbuf->offset += strftime(jbuf->json + jbuf->offset,
+                             jbuf->max_size - jbuf->offset,
+                             EVEL_RFC2822_STRFTIME_FORMAT,
+                             localtime(time));
+  }
+  evel_json_printf(jbuf, "\"");
   EVEL_EXIT();
 }
 
@@ -544,10 +1420,8 @@ void evel_enc_version(EVEL_JSON_BUFFER * jbuf,
   evel_enc_kv_int(jbuf, key, major_version);
   if (minor_version != 0)
   {
-    jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                             jbuf->max_size - jbuf->offset,
-                             ".%d",
-                             minor_version);
+    evel_json_printf(jbuf, ".");
+    evel_json_add_int(jbuf, minor_version);
   }
 
   EVEL_EXIT();
@@ -557,10 +1431,13 @@ void evel_enc_version(EVEL_JSON_BUFFER * jbuf,
  * Add the key and opening bracket of an optional named list to a JSON buffer.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  * @return true if the list was opened, false if it was suppressed.
  *****************************************************************************/
 bool evel_json_open_opt_named_list(EVEL_JSON_BUFFER * jbuf,
+                                   const EVEL_THROTTLE_FIELDS field,
                                    const char * const key)
 {
   bool opened = false;
@@ -575,7 +1452,7 @@ bool evel_json_open_opt_named_list(EVEL_JSON_BUFFER * jbuf,
 
   if ((jbuf->depth == EVEL_THROTTLE_FIELD_DEPTH) &&
       (jbuf->throttle_spec != NULL) &&
-      evel_throttle_suppress_field(jbuf->throttle_spec, key))
+      evel_throttle_suppress_field(jbuf->throttle_spec, field, key))
   {
     EVEL_INFO("Suppressed: %s", key);
     opened = false;
@@ -608,11 +1485,10 @@ void evel_json_open_named_list(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%s\"%s\": [",
-                           evel_json_kv_comma(jbuf),
-                           key);
+  evel_json_printf(jbuf,
+                   "%s\"%s\": [",
+                   evel_json_kv_comma(jbuf),
+                   key);
   jbuf->depth++;
 
   EVEL_EXIT();
@@ -632,9 +1508,7 @@ void evel_json_close_list(EVEL_JSON_BUFFER * jbuf)
   /***************************************************************************/
   assert(jbuf != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "]");
+  evel_json_printf(jbuf, "]");
   jbuf->depth--;
 
   EVEL_EXIT();
@@ -666,16 +1540,11 @@ void evel_enc_list_item(EVEL_JSON_BUFFER * jbuf,
   /***************************************************************************/
   if (jbuf->json[jbuf->offset - 1] != '[')
   {
-    jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                             jbuf->max_size - jbuf->offset,
-                             ", ");
+    evel_json_printf(jbuf, ", ");
   }
 
   va_start(largs, format);
-  jbuf->offset += vsnprintf(jbuf->json + jbuf->offset,
-                            jbuf->max_size - jbuf->offset,
-                            format,
-                            largs);
+  evel_json_vprintf(jbuf, format, largs);
   va_end(largs);
 
   EVEL_EXIT();
@@ -685,9 +1554,12 @@ void evel_enc_list_item(EVEL_JSON_BUFFER * jbuf,
  * Add the opening bracket of an optional named object to a JSON buffer.
  *
  * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The ::EVEL_THROTTLE_FIELDS for the key, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param key           Pointer to the key to encode.
  *****************************************************************************/
 bool evel_json_open_opt_named_object(EVEL_JSON_BUFFER * jbuf,
+                                     const EVEL_THROTTLE_FIELDS field,
                                      const char * const key)
 {
   bool opened = false;
@@ -702,7 +1574,7 @@ bool evel_json_open_opt_named_object(EVEL_JSON_BUFFER * jbuf,
 
   if ((jbuf->depth == EVEL_THROTTLE_FIELD_DEPTH) &&
       (jbuf->throttle_spec != NULL) &&
-      evel_throttle_suppress_field(jbuf->throttle_spec, key))
+      evel_throttle_suppress_field(jbuf->throttle_spec, field, key))
   {
     EVEL_INFO("Suppressed: %s", key);
     opened = false;
@@ -736,11 +1608,10 @@ void evel_json_open_named_object(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%s\"%s\": {",
-                           evel_json_kv_comma(jbuf),
-                           key);
+  evel_json_printf(jbuf,
+                   "%s\"%s\": {",
+                   evel_json_kv_comma(jbuf),
+                   key);
   jbuf->depth++;
 
   EVEL_EXIT();
@@ -771,10 +1642,7 @@ void evel_json_open_object(EVEL_JSON_BUFFER * jbuf)
     comma = "";
   }
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "%s{",
-                           comma);
+  evel_json_printf(jbuf, "%s{", comma);
   jbuf->depth++;
 
   EVEL_EXIT();
@@ -794,9 +1662,7 @@ void evel_json_close_object(EVEL_JSON_BUFFER * jbuf)
   /***************************************************************************/
   assert(jbuf != NULL);
 
-  jbuf->offset += snprintf(jbuf->json + jbuf->offset,
-                           jbuf->max_size - jbuf->offset,
-                           "}");
+  evel_json_printf(jbuf, "}");
   jbuf->depth--;
 
   EVEL_EXIT();
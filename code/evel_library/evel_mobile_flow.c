@@ -39,6 +39,7 @@
 
 #include "evel.h"
 #include "evel_internal.h"
+#include "evel_throttle.h"
 
 /*****************************************************************************/
 /* Array of strings to use when encoding TCP flags.                          */
@@ -84,6 +85,9 @@ static char * evel_qci_cos_strings[EVEL_MAX_QCI_COS_TYPES] = {
 void evel_json_encode_mobile_flow_gtp_flow_metrics(
                                         EVEL_JSON_BUFFER * jbuf,
                                         MOBILE_GTP_PER_FLOW_METRICS * metrics);
+static void evel_destroy_mobile_gtp_flow_metrics(void * metrics);
+static size_t evel_mobile_gtp_flow_metrics_size(
+                                  const MOBILE_GTP_PER_FLOW_METRICS * metrics);
 
 /**************************************************************************//**
  * Create a new Mobile Flow event.
@@ -133,13 +137,13 @@ EVENT_MOBILE_FLOW * evel_new_mobile_flow(
   /***************************************************************************/
   /* Allocate the Mobile Flow.                                               */
   /***************************************************************************/
-  mobile_flow = malloc(sizeof(EVENT_MOBILE_FLOW));
+  mobile_flow = evel_alloc_event(EVEL_DOMAIN_MOBILE_FLOW,
+                                 sizeof(EVENT_MOBILE_FLOW));
   if (mobile_flow == NULL)
   {
     log_error_state("Out of memory");
     goto exit_label;
   }
-  memset(mobile_flow, 0, sizeof(EVENT_MOBILE_FLOW));
   EVEL_DEBUG("New Mobile Flow is at %lp", mobile_flow);
 
   /***************************************************************************/
@@ -150,13 +154,25 @@ EVENT_MOBILE_FLOW * evel_new_mobile_flow(
   mobile_flow->header.event_domain = EVEL_DOMAIN_MOBILE_FLOW;
   mobile_flow->major_version = EVEL_MOBILE_FLOW_MAJOR_VERSION;
   mobile_flow->minor_version = EVEL_MOBILE_FLOW_MINOR_VERSION;
-  mobile_flow->flow_direction = strdup(flow_direction);
+  mobile_flow->flow_direction = evel_event_strdup(&mobile_flow->header,
+                                                  flow_direction);
   mobile_flow->gtp_per_flow_metrics = gtp_per_flow_metrics;
-  mobile_flow->ip_protocol_type = strdup(ip_protocol_type);
-  mobile_flow->ip_version = strdup(ip_version);
-  mobile_flow->other_endpoint_ip_address = strdup(other_endpoint_ip_address);
+  mobile_flow->header.size +=
+                      evel_mobile_gtp_flow_metrics_size(gtp_per_flow_metrics);
+  evel_event_adopt(&mobile_flow->header,
+                   evel_destroy_mobile_gtp_flow_metrics,
+                   gtp_per_flow_metrics);
+  mobile_flow->ip_protocol_type = evel_event_strdup(&mobile_flow->header,
+                                                    ip_protocol_type);
+  mobile_flow->ip_version = evel_event_strdup(&mobile_flow->header,
+                                              ip_version);
+  mobile_flow->other_endpoint_ip_address = evel_event_strdup(
+    &mobile_flow->header,
+    other_endpoint_ip_address);
   mobile_flow->other_endpoint_port = other_endpoint_port;
-  mobile_flow->reporting_endpoint_ip_addr = strdup(reporting_endpoint_ip_addr);
+  mobile_flow->reporting_endpoint_ip_addr = evel_event_strdup(
+    &mobile_flow->header,
+    reporting_endpoint_ip_addr);
   mobile_flow->reporting_endpoint_port = reporting_endpoint_port;
   evel_init_option_string(&mobile_flow->application_type);
   evel_init_option_string(&mobile_flow->app_protocol_type);
@@ -218,14 +234,14 @@ void evel_mobile_flow_addl_field_add(EVENT_MOBILE_FLOW * const event, char * nam
   assert(value != NULL);
 
   EVEL_DEBUG("Adding name=%s value=%s", name, value);
-  nv_pair = malloc(sizeof(OTHER_FIELD));
+  nv_pair = evel_event_malloc(&event->header, sizeof(OTHER_FIELD));
   assert(nv_pair != NULL);
-  nv_pair->name = strdup(name);
-  nv_pair->value = strdup(value);
+  nv_pair->name = evel_event_strdup(&event->header, name);
+  nv_pair->value = evel_event_strdup(&event->header, value);
   assert(nv_pair->name != NULL);
   assert(nv_pair->value != NULL);
 
-  dlist_push_last(&event->additional_info, nv_pair);
+  evel_event_list_push(&event->header, &event->additional_info, nv_pair);
 
   EVEL_EXIT();
 }
@@ -282,9 +298,10 @@ void evel_mobile_flow_app_type_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(type != NULL);
 
-  evel_set_option_string(&mobile_flow->application_type,
-                         type,
-                         "Application Type");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->application_type,
+                               type,
+                               "Application Type");
   EVEL_EXIT();
 }
 
@@ -312,9 +329,10 @@ void evel_mobile_flow_app_prot_type_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(type != NULL);
 
-  evel_set_option_string(&mobile_flow->app_protocol_type,
-                         type,
-                         "Application Protocol Type");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->app_protocol_type,
+                               type,
+                               "Application Protocol Type");
   EVEL_EXIT();
 }
 
@@ -342,9 +360,10 @@ void evel_mobile_flow_app_prot_ver_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(version != NULL);
 
-  evel_set_option_string(&mobile_flow->app_protocol_version,
-                         version,
-                         "Application Protocol Version");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->app_protocol_version,
+                               version,
+                               "Application Protocol Version");
   EVEL_EXIT();
 }
 
@@ -371,9 +390,10 @@ void evel_mobile_flow_cid_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(cid != NULL);
 
-  evel_set_option_string(&mobile_flow->cid,
-                         cid,
-                         "CID");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->cid,
+                               cid,
+                               "CID");
   EVEL_EXIT();
 }
 
@@ -401,9 +421,10 @@ void evel_mobile_flow_con_type_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(type != NULL);
 
-  evel_set_option_string(&mobile_flow->connection_type,
-                         type,
-                         "Connection Type");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->connection_type,
+                               type,
+                               "Connection Type");
   EVEL_EXIT();
 }
 
@@ -430,9 +451,10 @@ void evel_mobile_flow_ecgi_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(ecgi != NULL);
 
-  evel_set_option_string(&mobile_flow->ecgi,
-                         ecgi,
-                         "ECGI");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->ecgi,
+                               ecgi,
+                               "ECGI");
   EVEL_EXIT();
 }
 
@@ -460,9 +482,10 @@ void evel_mobile_flow_gtp_prot_type_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(type != NULL);
 
-  evel_set_option_string(&mobile_flow->gtp_protocol_type,
-                         type,
-                         "GTP Protocol Type");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->gtp_protocol_type,
+                               type,
+                               "GTP Protocol Type");
   EVEL_EXIT();
 }
 
@@ -490,9 +513,10 @@ void evel_mobile_flow_gtp_prot_ver_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(version != NULL);
 
-  evel_set_option_string(&mobile_flow->gtp_version,
-                         version,
-                         "GTP Protocol Version");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->gtp_version,
+                               version,
+                               "GTP Protocol Version");
   EVEL_EXIT();
 }
 
@@ -519,9 +543,10 @@ void evel_mobile_flow_http_header_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(header != NULL);
 
-  evel_set_option_string(&mobile_flow->http_header,
-                         header,
-                         "HTTP Header");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->http_header,
+                               header,
+                               "HTTP Header");
   EVEL_EXIT();
 }
 
@@ -548,9 +573,10 @@ void evel_mobile_flow_imei_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(imei != NULL);
 
-  evel_set_option_string(&mobile_flow->imei,
-                         imei,
-                         "IMEI");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->imei,
+                               imei,
+                               "IMEI");
   EVEL_EXIT();
 }
 
@@ -577,9 +603,10 @@ void evel_mobile_flow_imsi_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(imsi != NULL);
 
-  evel_set_option_string(&mobile_flow->imsi,
-                         imsi,
-                         "IMSI");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->imsi,
+                               imsi,
+                               "IMSI");
   EVEL_EXIT();
 }
 
@@ -606,9 +633,10 @@ void evel_mobile_flow_lac_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(lac != NULL);
 
-  evel_set_option_string(&mobile_flow->lac,
-                         lac,
-                         "LAC");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->lac,
+                               lac,
+                               "LAC");
   EVEL_EXIT();
 }
 
@@ -635,9 +663,10 @@ void evel_mobile_flow_mcc_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(mcc != NULL);
 
-  evel_set_option_string(&mobile_flow->mcc,
-                         mcc,
-                         "MCC");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->mcc,
+                               mcc,
+                               "MCC");
   EVEL_EXIT();
 }
 
@@ -664,9 +693,10 @@ void evel_mobile_flow_mnc_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(mnc != NULL);
 
-  evel_set_option_string(&mobile_flow->mnc,
-                         mnc,
-                         "MNC");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->mnc,
+                               mnc,
+                               "MNC");
   EVEL_EXIT();
 }
 
@@ -693,9 +723,10 @@ void evel_mobile_flow_msisdn_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(msisdn != NULL);
 
-  evel_set_option_string(&mobile_flow->msisdn,
-                         msisdn,
-                         "MSISDN");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->msisdn,
+                               msisdn,
+                               "MSISDN");
   EVEL_EXIT();
 }
 
@@ -723,9 +754,10 @@ void evel_mobile_flow_other_func_role_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(role != NULL);
 
-  evel_set_option_string(&mobile_flow->other_functional_role,
-                         role,
-                         "Other Functional Role");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->other_functional_role,
+                               role,
+                               "Other Functional Role");
   EVEL_EXIT();
 }
 
@@ -752,9 +784,10 @@ void evel_mobile_flow_rac_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(rac != NULL);
 
-  evel_set_option_string(&mobile_flow->rac,
-                         rac,
-                         "RAC");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->rac,
+                               rac,
+                               "RAC");
   EVEL_EXIT();
 }
 
@@ -782,9 +815,10 @@ void evel_mobile_flow_radio_acc_tech_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(tech != NULL);
 
-  evel_set_option_string(&mobile_flow->radio_access_technology,
-                         tech,
-                         "Radio Access Technology");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->radio_access_technology,
+                               tech,
+                               "Radio Access Technology");
   EVEL_EXIT();
 }
 
@@ -811,9 +845,10 @@ void evel_mobile_flow_sac_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(sac != NULL);
 
-  evel_set_option_string(&mobile_flow->sac,
-                         sac,
-                         "SAC");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->sac,
+                               sac,
+                               "SAC");
   EVEL_EXIT();
 }
 
@@ -868,9 +903,10 @@ void evel_mobile_flow_tac_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(tac != NULL);
 
-  evel_set_option_string(&mobile_flow->tac,
-                         tac,
-                         "TAC");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->tac,
+                               tac,
+                               "TAC");
   EVEL_EXIT();
 }
 
@@ -897,9 +933,10 @@ void evel_mobile_flow_tunnel_id_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(tunnel_id != NULL);
 
-  evel_set_option_string(&mobile_flow->tunnel_id,
-                         tunnel_id,
-                         "Tunnel ID");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->tunnel_id,
+                               tunnel_id,
+                               "Tunnel ID");
   EVEL_EXIT();
 }
 
@@ -926,9 +963,10 @@ void evel_mobile_flow_vlan_id_set(EVENT_MOBILE_FLOW * mobile_flow,
   assert(mobile_flow->header.event_domain == EVEL_DOMAIN_MOBILE_FLOW);
   assert(vlan_id != NULL);
 
-  evel_set_option_string(&mobile_flow->vlan_id,
-                         vlan_id,
-                         "VLAN ID");
+  evel_event_set_option_string(&mobile_flow->header,
+                               &mobile_flow->vlan_id,
+                               vlan_id,
+                               "VLAN ID");
   EVEL_EXIT();
 }
 
@@ -961,7 +999,9 @@ void evel_json_encode_mobile_flow(EVEL_JSON_BUFFER * jbuf,
   /* Checkpoint, so that we can wind back if all fields are suppressed.      */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "additionalFields"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_ADDITIONAL_FIELDS,
+                                    "additionalFields"))
   {
     bool added = false;
 
@@ -972,6 +1012,7 @@ void evel_json_encode_mobile_flow(EVEL_JSON_BUFFER * jbuf,
       assert(nv_pair != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_ADDITIONAL_FIELDS,
                                           "additionalFields",
                                           nv_pair->name))
       {
@@ -1014,32 +1055,62 @@ void evel_json_encode_mobile_flow(EVEL_JSON_BUFFER * jbuf,
   /***************************************************************************/
   /* Optional parameters.                                                    */
   /***************************************************************************/
-  evel_enc_kv_opt_string(jbuf, "applicationType", &event->application_type);
-  evel_enc_kv_opt_string(jbuf, "appProtocolType", &event->app_protocol_type);
-  evel_enc_kv_opt_string(
-    jbuf, "appProtocolVersion", &event->app_protocol_version);
-  evel_enc_kv_opt_string(jbuf, "cid", &event->cid);
-  evel_enc_kv_opt_string(jbuf, "connectionType", &event->connection_type);
-  evel_enc_kv_opt_string(jbuf, "ecgi", &event->ecgi);
-  evel_enc_kv_opt_string(jbuf, "gtpProtocolType", &event->gtp_protocol_type);
-  evel_enc_kv_opt_string(jbuf, "gtpVersion", &event->gtp_version);
-  evel_enc_kv_opt_string(jbuf, "httpHeader", &event->http_header);
-  evel_enc_kv_opt_string(jbuf, "imei", &event->imei);
-  evel_enc_kv_opt_string(jbuf, "imsi", &event->imsi);
-  evel_enc_kv_opt_string(jbuf, "lac", &event->lac);
-  evel_enc_kv_opt_string(jbuf, "mcc", &event->mcc);
-  evel_enc_kv_opt_string(jbuf, "mnc", &event->mnc);
-  evel_enc_kv_opt_string(jbuf, "msisdn", &event->msisdn);
-  evel_enc_kv_opt_string(
-    jbuf, "otherFunctionalRole", &event->other_functional_role);
-  evel_enc_kv_opt_string(jbuf, "rac", &event->rac);
-  evel_enc_kv_opt_string(
-    jbuf, "radioAccessTechnology", &event->radio_access_technology);
-  evel_enc_kv_opt_string(jbuf, "sac", &event->sac);
-  evel_enc_kv_opt_int(jbuf, "samplingAlgorithm", &event->sampling_algorithm);
-  evel_enc_kv_opt_string(jbuf, "tac", &event->tac);
-  evel_enc_kv_opt_string(jbuf, "tunnelId", &event->tunnel_id);
-  evel_enc_kv_opt_string(jbuf, "vlanId", &event->vlan_id);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_APPLICATION_TYPE,
+                         "applicationType",
+                         &event->application_type);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_APP_PROTOCOL_TYPE,
+                         "appProtocolType",
+                         &event->app_protocol_type);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_APP_PROTOCOL_VERSION,
+                         "appProtocolVersion",
+                         &event->app_protocol_version);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_CID, "cid", &event->cid);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_CONNECTION_TYPE,
+                         "connectionType",
+                         &event->connection_type);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_ECGI, "ecgi", &event->ecgi);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_GTP_PROTOCOL_TYPE,
+                         "gtpProtocolType",
+                         &event->gtp_protocol_type);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_GTP_VERSION,
+                         "gtpVersion",
+                         &event->gtp_version);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_HTTP_HEADER,
+                         "httpHeader",
+                         &event->http_header);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_IMEI, "imei", &event->imei);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_IMSI, "imsi", &event->imsi);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_LAC, "lac", &event->lac);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_MCC, "mcc", &event->mcc);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_MNC, "mnc", &event->mnc);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_MSISDN, "msisdn", &event->msisdn);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_OTHER_FUNCTIONAL_ROLE,
+                         "otherFunctionalRole",
+                         &event->other_functional_role);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_RAC, "rac", &event->rac);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_RADIO_ACCESS_TECHNOLOGY,
+                         "radioAccessTechnology",
+                         &event->radio_access_technology);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_SAC, "sac", &event->sac);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_SAMPLING_ALGORITHM,
+                      "samplingAlgorithm",
+                      &event->sampling_algorithm);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_TAC, "tac", &event->tac);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_TUNNEL_ID,
+                         "tunnelId",
+                         &event->tunnel_id);
+  evel_enc_kv_opt_string(jbuf, EVEL_FIELD_VLAN_ID, "vlanId", &event->vlan_id);
   evel_enc_version(jbuf,
                    "mobileFlowFieldsVersion",
                    event->major_version,
@@ -2070,30 +2141,62 @@ void evel_json_encode_mobile_flow_gtp_flow_metrics(
     evel_json_close_list(jbuf);
   }
 
-  evel_enc_kv_opt_int(
-    jbuf, "durConnectionFailedStatus", &metrics->dur_connection_failed_status);
-  evel_enc_kv_opt_int(
-    jbuf, "durTunnelFailedStatus", &metrics->dur_tunnel_failed_status);
-  evel_enc_kv_opt_string(jbuf, "flowActivatedBy", &metrics->flow_activated_by);
-  evel_enc_kv_opt_time(
-    jbuf, "flowActivationTime", &metrics->flow_activation_time);
-  evel_enc_kv_opt_string(
-    jbuf, "flowDeactivatedBy", &metrics->flow_deactivated_by);
-  evel_enc_kv_opt_string(
-    jbuf, "gtpConnectionStatus", &metrics->gtp_connection_status);
-  evel_enc_kv_opt_string(jbuf, "gtpTunnelStatus", &metrics->gtp_tunnel_status);
-  evel_enc_kv_opt_int(jbuf, "largePacketRtt", &metrics->large_packet_rtt);
-  evel_enc_kv_opt_double(
-    jbuf, "largePacketThreshold", &metrics->large_packet_threshold);
-  evel_enc_kv_opt_int(
-    jbuf, "maxReceiveBitRate", &metrics->max_receive_bit_rate);
-  evel_enc_kv_opt_int(
-    jbuf, "maxTransmitBitRate", &metrics->max_transmit_bit_rate);
-  evel_enc_kv_opt_int(
-    jbuf, "numGtpEchoFailures", &metrics->num_gtp_echo_failures);
-  evel_enc_kv_opt_int(
-    jbuf, "numGtpTunnelErrors", &metrics->num_gtp_tunnel_errors);
-  evel_enc_kv_opt_int(jbuf, "numHttpErrors", &metrics->num_http_errors);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_DUR_CONNECTION_FAILED_STATUS,
+                      "durConnectionFailedStatus",
+                      &metrics->dur_connection_failed_status);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_DUR_TUNNEL_FAILED_STATUS,
+                      "durTunnelFailedStatus",
+                      &metrics->dur_tunnel_failed_status);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_FLOW_ACTIVATED_BY,
+                         "flowActivatedBy",
+                         &metrics->flow_activated_by);
+  evel_enc_kv_opt_time(jbuf,
+                       EVEL_FIELD_FLOW_ACTIVATION_TIME,
+                       "flowActivationTime",
+                       &metrics->flow_activation_time);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_FLOW_DEACTIVATED_BY,
+                         "flowDeactivatedBy",
+                         &metrics->flow_deactivated_by);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_GTP_CONNECTION_STATUS,
+                         "gtpConnectionStatus",
+                         &metrics->gtp_connection_status);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_GTP_TUNNEL_STATUS,
+                         "gtpTunnelStatus",
+                         &metrics->gtp_tunnel_status);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_LARGE_PACKET_RTT,
+                      "largePacketRtt",
+                      &metrics->large_packet_rtt);
+  evel_enc_kv_opt_double(jbuf,
+                         EVEL_FIELD_LARGE_PACKET_THRESHOLD,
+                         "largePacketThreshold",
+                         &metrics->large_packet_threshold);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_MAX_RECEIVE_BIT_RATE,
+                      "maxReceiveBitRate",
+                      &metrics->max_receive_bit_rate);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_MAX_TRANSMIT_BIT_RATE,
+                      "maxTransmitBitRate",
+                      &metrics->max_transmit_bit_rate);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_NUM_GTP_ECHO_FAILURES,
+                      "numGtpEchoFailures",
+                      &metrics->num_gtp_echo_failures);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_NUM_GTP_TUNNEL_ERRORS,
+                      "numGtpTunnelErrors",
+                      &metrics->num_gtp_tunnel_errors);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_NUM_HTTP_ERRORS,
+                      "numHttpErrors",
+                      &metrics->num_http_errors);
 
   evel_json_close_object(jbuf);
 
@@ -2130,3 +2233,40 @@ void evel_free_mobile_gtp_flow_metrics(MOBILE_GTP_PER_FLOW_METRICS * metrics)
 
   EVEL_EXIT();
 }
+
+/**************************************************************************//**
+ * Free a GTP Per Flow Metrics block along with its allocated memory, for an
+ * event built in an arena.
+ *
+ * @param metrics   Pointer to the ::MOBILE_GTP_PER_FLOW_METRICS.
+ *****************************************************************************/
+static void evel_destroy_mobile_gtp_flow_metrics(void * metrics)
+{
+  EVEL_ENTER();
+
+  evel_free_mobile_gtp_flow_metrics(metrics);
+  free(metrics);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Return the memory used by a GTP Per Flow Metrics block, which is allocated
+ * before the event which owns it and so is charged to the event when it is
+ * attached.
+ *
+ * @param metrics   Pointer to the ::MOBILE_GTP_PER_FLOW_METRICS.
+ * @returns Number of bytes allocated for the block and its strings.
+ *****************************************************************************/
+static size_t evel_mobile_gtp_flow_metrics_size(
+                                   const MOBILE_GTP_PER_FLOW_METRICS * metrics)
+{
+  assert(metrics != NULL);
+
+  return sizeof(MOBILE_GTP_PER_FLOW_METRICS) +
+         strlen(metrics->flow_status) + 1 +
+         evel_option_string_size(&metrics->flow_activated_by) +
+         evel_option_string_size(&metrics->flow_deactivated_by) +
+         evel_option_string_size(&metrics->gtp_connection_status) +
+         evel_option_string_size(&metrics->gtp_tunnel_status);
+}
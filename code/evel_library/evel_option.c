@@ -64,6 +64,19 @@ void evel_free_option_string(EVEL_OPTION_STRING * const option)
   EVEL_EXIT();
 }
 
+/**************************************************************************//**
+ * Return the memory allocated for the value of an ::EVEL_OPTION_STRING.
+ *
+ * @param option        Pointer to the ::EVEL_OPTION_STRING.
+ * @returns Number of bytes allocated, or 0 if the option is not set.
+ *****************************************************************************/
+size_t evel_option_string_size(const EVEL_OPTION_STRING * const option)
+{
+  assert(option != NULL);
+
+  return (option->is_set) ? strlen(option->value) + 1 : 0;
+}
+
 /**************************************************************************//**
  * Initialize an ::EVEL_OPTION_STRING to a not-set state.
  *
@@ -143,6 +156,99 @@ void evel_force_option_string(EVEL_OPTION_STRING * const option,
   EVEL_EXIT();
 }
 
+/**************************************************************************//**
+ * Free the underlying resources of an ::EVEL_OPTION_STRING owned by an
+ * event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param option        Pointer to the ::EVEL_OPTION_STRING.
+ *****************************************************************************/
+void evel_event_free_option_string(EVENT_HEADER * const header,
+                                   EVEL_OPTION_STRING * const option)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(header != NULL);
+  assert(option != NULL);
+
+  if (option->is_set)
+  {
+    evel_event_free(header, option->value);
+    option->value = NULL;
+    option->is_set = EVEL_FALSE;
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set the value of an ::EVEL_OPTION_STRING owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param option        Pointer to the ::EVEL_OPTION_STRING.
+ * @param value         The value to set.
+ * @param description   Description to be used in logging.
+ *****************************************************************************/
+void evel_event_set_option_string(EVENT_HEADER * const header,
+                                  EVEL_OPTION_STRING * const option,
+                                  const char * const value,
+                                  const char * const description)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(header != NULL);
+  assert(option != NULL);
+  assert(value != NULL);
+  assert(description != NULL);
+
+  if (option->is_set)
+  {
+    EVEL_ERROR("Ignoring attempt to update %s to %s. %s already set to %s",
+               description, value, description, option->value);
+  }
+  else
+  {
+    EVEL_DEBUG("Setting %s to %s", description, value);
+    option->value = evel_event_strdup(header, value);
+    option->is_set = EVEL_TRUE;
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Force the value of an ::EVEL_OPTION_STRING owned by an event.
+ *
+ * @param header        Pointer to the owning event's ::EVENT_HEADER.
+ * @param option        Pointer to the ::EVEL_OPTION_STRING.
+ * @param value         The value to set.
+ *****************************************************************************/
+void evel_event_force_option_string(EVENT_HEADER * const header,
+                                    EVEL_OPTION_STRING * const option,
+                                    const char * const value)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(header != NULL);
+  assert(option != NULL);
+  assert(option->is_set == EVEL_FALSE);
+  assert(option->value == NULL);
+
+  option->value = evel_event_strdup(header, value);
+  option->is_set = EVEL_TRUE;
+
+  EVEL_EXIT();
+}
+
 /**************************************************************************//**
  * Initialize an ::EVEL_OPTION_INT to a not-set state.
  *
@@ -39,6 +39,8 @@
 #include "evel.h"
 #include "evel_internal.h"
 
+static void evel_other_destroy_namedarrays(void * namedarrays);
+
 /**************************************************************************//**
  * Create a new Other event.
  *
@@ -62,13 +64,12 @@ EVENT_OTHER * evel_new_other()
   /***************************************************************************/
   /* Allocate the Other.                                                     */
   /***************************************************************************/
-  other = malloc(sizeof(EVENT_OTHER));
+  other = evel_alloc_event(EVEL_DOMAIN_OTHER, sizeof(EVENT_OTHER));
   if (other == NULL)
   {
     log_error_state("Out of memory");
     goto exit_label;
   }
-  memset(other, 0, sizeof(EVENT_OTHER));
   EVEL_DEBUG("New Other is at %lp", other);
 
   /***************************************************************************/
@@ -80,10 +81,18 @@ EVENT_OTHER * evel_new_other()
   other->major_version = EVEL_OTHER_EVENT_MAJOR_VERSION;
   other->minor_version = EVEL_OTHER_EVENT_MINOR_VERSION;
 
-  other->namedarrays = NULL;
+  hash_map_initialize(&other->namedarrays);
   dlist_initialize(&other->jsonobjects);
   dlist_initialize(&other->namedvalues);
 
+  /***************************************************************************/
+  /* The named arrays' table is allocated separately, so an event in an      */
+  /* arena releases it when the arena is reset.                              */
+  /***************************************************************************/
+  evel_event_adopt(&other->header,
+                   evel_other_destroy_namedarrays,
+                   &other->namedarrays);
+
 exit_label:
   EVEL_EXIT();
   return other;
@@ -117,18 +126,16 @@ void evel_other_type_set(EVENT_OTHER * other,
 }
 
 /**************************************************************************//**
- * Add a json object to jsonObject list.
+ * Set the number of named arrays expected in the Other.
  *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * The table of named arrays grows as arrays are added, so this is only a
+ * hint which saves it being resized.
  *
  * @param other         Pointer to the Other.
- * @param size          size of hashtable
+ * @param size          Number of named arrays expected.
  *****************************************************************************/
 void evel_other_field_set_namedarraysize(EVENT_OTHER * other, const int size)
 {
-  OTHER_FIELD * other_field = NULL;
   EVEL_ENTER();
 
   /***************************************************************************/
@@ -136,26 +143,30 @@ void evel_other_field_set_namedarraysize(EVENT_OTHER * other, const int size)
   /***************************************************************************/
   assert(other != NULL);
   assert(other->header.event_domain == EVEL_DOMAIN_OTHER);
-  assert(other->namedarrays == NULL);
   assert(size > 0);
 
   EVEL_DEBUG("Adding Named array");
 
-  other->namedarrays =  ht_create(size);
+  if (!hash_map_reserve(&other->namedarrays, size))
+  {
+    EVEL_ERROR("Failed to size named arrays table for %d arrays", size);
+  }
 
   EVEL_EXIT();
 }
 
 
 /**************************************************************************//**
- * Add a json object to jsonObject list.
+ * Add a name/value pair to a named array in the Other, creating the array if
+ * this is its first pair.  Arrays are encoded in the order they were created.
  *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * The library takes a copy of the strings so the caller does not have to
+ * preserve values after the function returns.
  *
  * @param other         Pointer to the Other.
- * @param size          size of hashtable
+ * @param hashname      ASCIIZ string with the array's name.
+ * @param name          ASCIIZ string with the attribute's name.
+ * @param value         ASCIIZ string with the attribute's value.
  *****************************************************************************/
 void evel_other_field_add_namedarray(EVENT_OTHER * other, const char *hashname,  char * name, char *value)
 {
@@ -168,32 +179,38 @@ void evel_other_field_add_namedarray(EVENT_OTHER * other, const char *hashname,
   /***************************************************************************/
   assert(other != NULL);
   assert(other->header.event_domain == EVEL_DOMAIN_OTHER);
-  assert(other->namedarrays != NULL);
+  assert(hashname != NULL);
 
   EVEL_DEBUG("Adding values to Named array");
       
   EVEL_DEBUG("Adding name=%s value=%s", name, value);
-  other_field = malloc(sizeof(OTHER_FIELD));
+  other_field = evel_event_malloc(&other->header, sizeof(OTHER_FIELD));
   assert(other_field != NULL);
   memset(other_field, 0, sizeof(OTHER_FIELD));
-  other_field->name = strdup(name);
-  other_field->value = strdup(value);
+  other_field->name = evel_event_strdup(&other->header, name);
+  other_field->value = evel_event_strdup(&other->header, value);
   assert(other_field->name != NULL);
   assert(other_field->value != NULL);
 
 
-  list = ht_get(other->namedarrays, hashname);
+  list = hash_map_get(&other->namedarrays, hashname);
   if( list == NULL )
   {
-     DLIST * nlist = malloc(sizeof(DLIST));
+     DLIST * nlist = evel_event_malloc(&other->header, sizeof(DLIST));
+     assert(nlist != NULL);
      dlist_initialize(nlist);
-     dlist_push_last(nlist, other_field);
-     ht_set(other->namedarrays, hashname, nlist);
+     evel_event_list_push(&other->header, nlist, other_field);
+     if (!hash_map_set(&other->namedarrays,
+                       evel_event_strdup(&other->header, hashname),
+                       nlist))
+     {
+       EVEL_ERROR("Failed to add named array %s", hashname);
+     }
      EVEL_DEBUG("Created to new table table");
   }
   else
   {
-     dlist_push_last(list, other_field);
+     evel_event_list_push(&other->header, list, other_field);
      EVEL_DEBUG("Adding to existing table");
   }
 
@@ -225,7 +242,7 @@ void evel_other_field_add_jsonobj(EVENT_OTHER * other, EVEL_JSON_OBJECT *jsonobj
 
   EVEL_DEBUG("Adding jsonObject");
 
-  dlist_push_last(&other->jsonobjects, jsonobj);
+  evel_event_list_push(&other->header, &other->jsonobjects, jsonobj);
 
   EVEL_EXIT();
 }
@@ -257,15 +274,15 @@ void evel_other_field_add(EVENT_OTHER * other, char * name, char * value)
   assert(value != NULL);
 
   EVEL_DEBUG("Adding name=%s value=%s", name, value);
-  other_field = malloc(sizeof(OTHER_FIELD));
+  other_field = evel_event_malloc(&other->header, sizeof(OTHER_FIELD));
   assert(other_field != NULL);
   memset(other_field, 0, sizeof(OTHER_FIELD));
-  other_field->name = strdup(name);
-  other_field->value = strdup(value);
+  other_field->name = evel_event_strdup(&other->header, name);
+  other_field->value = evel_event_strdup(&other->header, value);
   assert(other_field->name != NULL);
   assert(other_field->value != NULL);
 
-  dlist_push_last(&other->namedvalues, other_field);
+  evel_event_list_push(&other->header, &other->namedvalues, other_field);
 
   EVEL_EXIT();
 }
@@ -286,9 +303,7 @@ void evel_json_encode_other(EVEL_JSON_BUFFER * jbuf,
   DLIST_ITEM * jsobj_field_item = NULL;
   EVEL_INTERNAL_KEY * keyinst = NULL;
   DLIST_ITEM * keyinst_field_item = NULL;
-  HASHTABLE_T *ht = NULL;
   int i;
-  bool itm_added = false;
   DLIST *itm_list = NULL;
 
   EVEL_ENTER();
@@ -302,59 +317,44 @@ void evel_json_encode_other(EVEL_JSON_BUFFER * jbuf,
   evel_json_encode_header(jbuf, &event->header);
   evel_json_open_named_object(jbuf, "otherFields");
 
-// iterate through hashtable and print DLIST for each entry
-
-   ht = event->namedarrays;
-   if( ht != NULL )
-   {
-     if( ht->size > 0)
-     {
-        for( i = 0; i < ht->size; i++ ) {
-             if( ht->table[i] != NULL)
-	     {
-		itm_added = true;
-	     }
-        }
-        if( itm_added == true)
-        {
-
-  if (evel_json_open_opt_named_list(jbuf, "hashOfNameValuePairArrays"))
-  {
-       for( i = 0; i < ht->size; i++ ) {
-             if( ht->table[i] != NULL)
-	     {
-		itm_list = ht->table[i];
-
-  if(evel_json_open_opt_named_list(jbuf, ht->table[i]->key))
+  /***************************************************************************/
+  /* Encode the named arrays in the order they were added.                   */
+  /***************************************************************************/
+  if ((hash_map_count(&event->namedarrays) > 0) &&
+      evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_HASH_OF_NAME_VALUE_PAIR_ARRAYS,
+                                    "hashOfNameValuePairArrays"))
   {
-    other_field_item = dlist_get_first(&itm_list);
-    while (other_field_item != NULL)
+    for (i = 0; i < hash_map_count(&event->namedarrays); i++)
     {
-     other_field = (OTHER_FIELD *) other_field_item->item;
-     if(other_field != NULL){
-       evel_json_open_object(jbuf);
-       evel_enc_kv_string(jbuf, "name", other_field->name);
-       evel_enc_kv_string(jbuf, "value", other_field->value);
-       evel_json_close_object(jbuf);
-       other_field_item = dlist_get_next(other_field_item);
-     }
+      itm_list = hash_map_value(&event->namedarrays, i);
+      assert(itm_list != NULL);
+
+      evel_json_open_object(jbuf);
+      evel_enc_kv_string(jbuf, "name", hash_map_key(&event->namedarrays, i));
+      evel_json_open_named_list(jbuf, "arrayOfFields");
+      other_field_item = dlist_get_first(itm_list);
+      while (other_field_item != NULL)
+      {
+        other_field = (OTHER_FIELD *) other_field_item->item;
+        assert(other_field != NULL);
+
+        evel_json_open_object(jbuf);
+        evel_enc_kv_string(jbuf, "name", other_field->name);
+        evel_enc_kv_string(jbuf, "value", other_field->value);
+        evel_json_close_object(jbuf);
+        other_field_item = dlist_get_next(other_field_item);
+      }
+      evel_json_close_list(jbuf);
+      evel_json_close_object(jbuf);
     }
     evel_json_close_list(jbuf);
   }
 
-	     }
-       }
-
-       evel_json_close_list(jbuf);
-  }
-
-
-        }
-     }
-   }
-
   evel_json_checkpoint(jbuf);
-  if(evel_json_open_opt_named_list(jbuf, "jsonObjects"))
+  if(evel_json_open_opt_named_list(jbuf,
+                                   EVEL_FIELD_JSON_OBJECTS,
+                                   "jsonObjects"))
   {
   bool item_added = false;
   other_field_item = dlist_get_first(&event->jsonobjects);
@@ -365,7 +365,9 @@ void evel_json_encode_other(EVEL_JSON_BUFFER * jbuf,
     {
      evel_json_open_object(jbuf);
 
-       if( evel_json_open_opt_named_list(jbuf, "objectInstances"))
+       if( evel_json_open_opt_named_list(jbuf,
+                                         EVEL_FIELD_OBJECT_INSTANCES,
+                                         "objectInstances"))
        {
 	bool item_added2 = false;
         jsobj_field_item = dlist_get_first(&jsonobjp->jsonobjectinstances);
@@ -378,7 +380,9 @@ void evel_json_encode_other(EVEL_JSON_BUFFER * jbuf,
               evel_enc_kv_object(jbuf, "objectInstance", jsonobjinst->jsonstring);
               evel_enc_kv_ull(jbuf, "objectInstanceEpochMicrosec", jsonobjinst->objinst_epoch_microsec);
   //evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "objectKeys"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_OBJECT_KEYS,
+                                    "objectKeys"))
   {
     bool item_added3 = false;
 
@@ -390,8 +394,14 @@ void evel_json_encode_other(EVEL_JSON_BUFFER * jbuf,
       {
         evel_json_open_object(jbuf);
         evel_enc_kv_string(jbuf, "keyName", keyinst->keyname);
-        evel_enc_kv_opt_int(jbuf, "keyOrder", &keyinst->keyorder);
-        evel_enc_kv_opt_string(jbuf, "keyValue", &keyinst->keyvalue);
+        evel_enc_kv_opt_int(jbuf,
+                            EVEL_FIELD_KEY_ORDER,
+                            "keyOrder",
+                            &keyinst->keyorder);
+        evel_enc_kv_opt_string(jbuf,
+                               EVEL_FIELD_KEY_VALUE,
+                               "keyValue",
+                               &keyinst->keyvalue);
         evel_json_close_object(jbuf);
 	item_added3 = false;
       }
@@ -420,10 +430,22 @@ void evel_json_encode_other(EVEL_JSON_BUFFER * jbuf,
        }
 
     evel_enc_kv_string(jbuf, "objectName", jsonobjp->object_name);
-    evel_enc_kv_opt_string(jbuf, "objectSchema", &jsonobjp->objectschema);
-    evel_enc_kv_opt_string(jbuf, "objectSchemaUrl", &jsonobjp->objectschemaurl);
-    evel_enc_kv_opt_string(jbuf, "nfSubscribedObjectName", &jsonobjp->nfsubscribedobjname);
-    evel_enc_kv_opt_string(jbuf, "nfSubscriptionId", &jsonobjp->nfsubscriptionid);
+    evel_enc_kv_opt_string(jbuf,
+                           EVEL_FIELD_OBJECT_SCHEMA,
+                           "objectSchema",
+                           &jsonobjp->objectschema);
+    evel_enc_kv_opt_string(jbuf,
+                           EVEL_FIELD_OBJECT_SCHEMA_URL,
+                           "objectSchemaUrl",
+                           &jsonobjp->objectschemaurl);
+    evel_enc_kv_opt_string(jbuf,
+                           EVEL_FIELD_NF_SUBSCRIBED_OBJECT_NAME,
+                           "nfSubscribedObjectName",
+                           &jsonobjp->nfsubscribedobjname);
+    evel_enc_kv_opt_string(jbuf,
+                           EVEL_FIELD_NF_SUBSCRIPTION_ID,
+                           "nfSubscriptionId",
+                           &jsonobjp->nfsubscriptionid);
     evel_json_close_object(jbuf);
     item_added = true;
   }
@@ -438,7 +460,9 @@ void evel_json_encode_other(EVEL_JSON_BUFFER * jbuf,
 
   }
 
-  if( evel_json_open_opt_named_list(jbuf, "nameValuePairs"))
+  if( evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_NAME_VALUE_PAIRS,
+                                    "nameValuePairs"))
   {
   other_field_item = dlist_get_first(&event->namedvalues);
   while (other_field_item != NULL)
@@ -473,6 +497,8 @@ void evel_json_encode_other(EVEL_JSON_BUFFER * jbuf,
 void evel_free_other(EVENT_OTHER * event)
 {
   OTHER_FIELD * other_field = NULL;
+  DLIST * list = NULL;
+  int i;
 
   EVEL_ENTER();
 
@@ -484,7 +510,7 @@ void evel_free_other(EVENT_OTHER * event)
   assert(event->header.event_domain == EVEL_DOMAIN_OTHER);
 
   /***************************************************************************/
-  /* Free all internal strings then the header itself.                       */
+  /* Free all internal strings and named arrays then the header itself.      */
   /***************************************************************************/
   other_field = dlist_pop_last(&event->namedvalues);
   while (other_field != NULL)
@@ -497,7 +523,37 @@ void evel_free_other(EVENT_OTHER * event)
     free(other_field);
     other_field = dlist_pop_last(&event->namedvalues);
   }
+  for (i = 0; i < hash_map_count(&event->namedarrays); i++)
+  {
+    list = hash_map_value(&event->namedarrays, i);
+    other_field = dlist_pop_last(list);
+    while (other_field != NULL)
+    {
+      free(other_field->name);
+      free(other_field->value);
+      free(other_field);
+      other_field = dlist_pop_last(list);
+    }
+    free(list);
+    free((char *) hash_map_key(&event->namedarrays, i));
+  }
+  hash_map_free(&event->namedarrays);
   evel_free_header(&event->header);
 
   EVEL_EXIT();
 }
+
+/**************************************************************************//**
+ * Free the table of named arrays of an Other, for an event built in an arena.
+ * The arrays themselves are in the arena.
+ *
+ * @param namedarrays   Pointer to the Other's ::HASH_MAP of named arrays.
+ *****************************************************************************/
+static void evel_other_destroy_namedarrays(void * namedarrays)
+{
+  EVEL_ENTER();
+
+  hash_map_free(namedarrays);
+
+  EVEL_EXIT();
+}
@@ -77,13 +77,12 @@ EVENT_REPORT * evel_new_report(double measurement_interval)
   /***************************************************************************/
   /* Allocate the report.                                                    */
   /***************************************************************************/
-  report = malloc(sizeof(EVENT_REPORT));
+  report = evel_alloc_event(EVEL_DOMAIN_REPORT, sizeof(EVENT_REPORT));
   if (report == NULL)
   {
     log_error_state("Out of memory for Report");
     goto exit_label;
   }
-  memset(report, 0, sizeof(EVENT_REPORT));
   EVEL_DEBUG("New report is at %lp", report);
 
   /***************************************************************************/
@@ -160,14 +159,15 @@ void evel_report_feature_use_add(EVENT_REPORT * report,
   /* Allocate a container for the value and push onto the list.              */
   /***************************************************************************/
   EVEL_DEBUG("Adding Feature=%s Use=%d", feature, utilization);
-  feature_use = malloc(sizeof(MEASUREMENT_FEATURE_USE));
+  feature_use = evel_event_malloc(&report->header,
+                                  sizeof(MEASUREMENT_FEATURE_USE));
   assert(feature_use != NULL);
   memset(feature_use, 0, sizeof(MEASUREMENT_FEATURE_USE));
-  feature_use->feature_id = strdup(feature);
+  feature_use->feature_id = evel_event_strdup(&report->header, feature);
   assert(feature_use->feature_id != NULL);
   feature_use->feature_utilization = utilization;
 
-  dlist_push_last(&report->feature_usage, feature_use);
+  evel_event_list_push(&report->header, &report->feature_usage, feature_use);
 
   EVEL_EXIT();
 }
@@ -208,12 +208,12 @@ void evel_report_custom_measurement_add(EVENT_REPORT * report,
   /***************************************************************************/
   EVEL_DEBUG("Adding Measurement Group=%s Name=%s Value=%s",
               group, name, value);
-  measurement = malloc(sizeof(CUSTOM_MEASUREMENT));
+  measurement = evel_event_malloc(&report->header, sizeof(CUSTOM_MEASUREMENT));
   assert(measurement != NULL);
   memset(measurement, 0, sizeof(CUSTOM_MEASUREMENT));
-  measurement->name = strdup(name);
+  measurement->name = evel_event_strdup(&report->header, name);
   assert(measurement->name != NULL);
-  measurement->value = strdup(value);
+  measurement->value = evel_event_strdup(&report->header, value);
   assert(measurement->value != NULL);
 
   /***************************************************************************/
@@ -240,19 +240,24 @@ void evel_report_custom_measurement_add(EVENT_REPORT * report,
   if (item == NULL)
   {
     EVEL_DEBUG("Creating new Measurement Group");
-    measurement_group = malloc(sizeof(MEASUREMENT_GROUP));
+    measurement_group = evel_event_malloc(&report->header,
+                                          sizeof(MEASUREMENT_GROUP));
     assert(measurement_group != NULL);
     memset(measurement_group, 0, sizeof(MEASUREMENT_GROUP));
-    measurement_group->name = strdup(group);
+    measurement_group->name = evel_event_strdup(&report->header, group);
     assert(measurement_group->name != NULL);
     dlist_initialize(&measurement_group->measurements);
-    dlist_push_last(&report->measurement_groups, measurement_group);
+    evel_event_list_push(&report->header,
+                         &report->measurement_groups,
+                         measurement_group);
   }
 
   /***************************************************************************/
   /* If we didn't have the group already, create it.                         */
   /***************************************************************************/
-  dlist_push_last(&measurement_group->measurements, measurement);
+  evel_event_list_push(&report->header,
+                       &measurement_group->measurements,
+                       measurement);
 
   EVEL_EXIT();
 }
@@ -288,7 +293,9 @@ void evel_json_encode_report(EVEL_JSON_BUFFER * jbuf,
   /* Feature Utilization list.                                               */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "featureUsageArray"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_FEATURE_USAGE_ARRAY,
+                                    "featureUsageArray"))
   {
     bool item_added = false;
 
@@ -299,6 +306,7 @@ void evel_json_encode_report(EVEL_JSON_BUFFER * jbuf,
       assert(feature_use != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_FEATURE_USAGE_ARRAY,
                                           "featureUsageArray",
                                           feature_use->feature_id))
       {
@@ -326,7 +334,9 @@ void evel_json_encode_report(EVEL_JSON_BUFFER * jbuf,
   /* Additional Measurement Groups list.                                     */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "additionalMeasurements"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_ADDITIONAL_MEASUREMENTS,
+                                    "additionalMeasurements"))
   {
     bool item_added = false;
 
@@ -337,6 +347,7 @@ void evel_json_encode_report(EVEL_JSON_BUFFER * jbuf,
       assert(measurement_group != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_ADDITIONAL_MEASUREMENTS,
                                           "additionalMeasurements",
                                           measurement_group->name))
       {
@@ -71,13 +71,13 @@ EVENT_MEASUREMENT * evel_new_measurement(double measurement_interval)
   /***************************************************************************/
   /* Allocate the measurement.                                               */
   /***************************************************************************/
-  measurement = malloc(sizeof(EVENT_MEASUREMENT));
+  measurement = evel_alloc_event(EVEL_DOMAIN_MEASUREMENT,
+                                 sizeof(EVENT_MEASUREMENT));
   if (measurement == NULL)
   {
     log_error_state("Out of memory for Measurement");
     goto exit_label;
   }
-  memset(measurement, 0, sizeof(EVENT_MEASUREMENT));
   EVEL_DEBUG("New measurement is at %lp", measurement);
 
   /***************************************************************************/
@@ -167,15 +167,17 @@ void evel_measurement_addl_info_add(EVENT_MEASUREMENT * measurement, char * name
   assert(value != NULL);
   
   EVEL_DEBUG("Adding name=%s value=%s", name, value);
-  addl_info = malloc(sizeof(OTHER_FIELD));
+  addl_info = evel_event_malloc(&measurement->header, sizeof(OTHER_FIELD));
   assert(addl_info != NULL);
   memset(addl_info, 0, sizeof(OTHER_FIELD));
-  addl_info->name = strdup(name);
-  addl_info->value = strdup(value);
+  addl_info->name = evel_event_strdup(&measurement->header, name);
+  addl_info->value = evel_event_strdup(&measurement->header, value);
   assert(addl_info->name != NULL);
   assert(addl_info->value != NULL);
 
-  dlist_push_last(&measurement->additional_info, addl_info);
+  evel_event_list_push(&measurement->header,
+                       &measurement->additional_info,
+                       addl_info);
 
   EVEL_EXIT();
 }
@@ -275,7 +277,8 @@ void evel_measurement_errors_set(EVENT_MEASUREMENT * measurement,
                receive_errors,
                transmit_discards,
                transmit_errors);
-    errors = malloc(sizeof(MEASUREMENT_ERRORS));
+    errors = evel_event_malloc(&measurement->header,
+                               sizeof(MEASUREMENT_ERRORS));
     assert(errors != NULL);
     memset(errors, 0, sizeof(MEASUREMENT_ERRORS));
     errors->receive_discards = receive_discards;
@@ -388,10 +391,11 @@ MEASUREMENT_CPU_USE *evel_measurement_new_cpu_use_add(EVENT_MEASUREMENT * measur
   /* Allocate a container for the value and push onto the list.              */
   /***************************************************************************/
   EVEL_DEBUG("Adding id=%s usage=%lf", id, usage);
-  cpu_use = malloc(sizeof(MEASUREMENT_CPU_USE));
+  cpu_use = evel_event_malloc(&measurement->header,
+                              sizeof(MEASUREMENT_CPU_USE));
   assert(cpu_use != NULL);
   memset(cpu_use, 0, sizeof(MEASUREMENT_CPU_USE));
-  cpu_use->id    = strdup(id);
+  cpu_use->id    = evel_event_strdup(&measurement->header, id);
   cpu_use->usage = usage;
   evel_init_option_double(&cpu_use->idle);
   evel_init_option_double(&cpu_use->intrpt);
@@ -402,7 +406,7 @@ MEASUREMENT_CPU_USE *evel_measurement_new_cpu_use_add(EVENT_MEASUREMENT * measur
   evel_init_option_double(&cpu_use->user);
   evel_init_option_double(&cpu_use->wait);
 
-  dlist_push_last(&measurement->cpu_usage, cpu_use);
+  evel_event_list_push(&measurement->header, &measurement->cpu_usage, cpu_use);
 
   EVEL_EXIT();
   return cpu_use;
@@ -589,11 +593,12 @@ MEASUREMENT_MEM_USE * evel_measurement_new_mem_use_add(EVENT_MEASUREMENT * measu
   /* Allocate a container for the value and push onto the list.              */
   /***************************************************************************/
   EVEL_DEBUG("Adding id=%s buffer size=%lf", id, membuffsz);
-  mem_use = malloc(sizeof(MEASUREMENT_MEM_USE));
+  mem_use = evel_event_malloc(&measurement->header,
+                              sizeof(MEASUREMENT_MEM_USE));
   assert(mem_use != NULL);
   memset(mem_use, 0, sizeof(MEASUREMENT_MEM_USE));
-  mem_use->id    = strdup(id);
-  mem_use->vmid  = strdup(vmidentifier);
+  mem_use->id    = evel_event_strdup(&measurement->header, id);
+  mem_use->vmid  = evel_event_strdup(&measurement->header, vmidentifier);
   mem_use->membuffsz = membuffsz;
   evel_init_option_double(&mem_use->memcache);
   evel_init_option_double(&mem_use->memconfig);
@@ -604,7 +609,7 @@ MEASUREMENT_MEM_USE * evel_measurement_new_mem_use_add(EVENT_MEASUREMENT * measu
 
   assert(mem_use->id != NULL);
 
-  dlist_push_last(&measurement->mem_usage, mem_use);
+  evel_event_list_push(&measurement->header, &measurement->mem_usage, mem_use);
 
   EVEL_EXIT();
   return mem_use;
@@ -745,12 +750,15 @@ MEASUREMENT_DISK_USE * evel_measurement_new_disk_use_add(EVENT_MEASUREMENT * mea
   /* Allocate a container for the value and push onto the list.              */
   /***************************************************************************/
   EVEL_DEBUG("Adding id=%s disk usage", id);
-  disk_use = malloc(sizeof(MEASUREMENT_DISK_USE));
+  disk_use = evel_event_malloc(&measurement->header,
+                               sizeof(MEASUREMENT_DISK_USE));
   assert(disk_use != NULL);
   memset(disk_use, 0, sizeof(MEASUREMENT_DISK_USE));
-  disk_use->id    = strdup(id);
+  disk_use->id    = evel_event_strdup(&measurement->header, id);
   assert(disk_use->id != NULL);
-  dlist_push_last(&measurement->disk_usage, disk_use);
+  evel_event_list_push(&measurement->header,
+                       &measurement->disk_usage,
+                       disk_use);
 
   evel_init_option_double(&disk_use->iotimeavg );
   evel_init_option_double(&disk_use->iotimelast );
@@ -1570,10 +1578,12 @@ void evel_measurement_fsys_use_add(EVENT_MEASUREMENT * measurement,
   /* Allocate a container for the value and push onto the list.              */
   /***************************************************************************/
   EVEL_DEBUG("Adding filesystem_name=%s", filesystem_name);
-  fsys_use = malloc(sizeof(MEASUREMENT_FSYS_USE));
+  fsys_use = evel_event_malloc(&measurement->header,
+                               sizeof(MEASUREMENT_FSYS_USE));
   assert(fsys_use != NULL);
   memset(fsys_use, 0, sizeof(MEASUREMENT_FSYS_USE));
-  fsys_use->filesystem_name = strdup(filesystem_name);
+  fsys_use->filesystem_name = evel_event_strdup(&measurement->header,
+                                                filesystem_name);
   fsys_use->block_configured = block_configured;
   fsys_use->block_used = block_used;
   fsys_use->block_iops = block_iops;
@@ -1581,7 +1591,9 @@ void evel_measurement_fsys_use_add(EVENT_MEASUREMENT * measurement,
   fsys_use->ephemeral_used = ephemeral_used;
   fsys_use->ephemeral_iops = ephemeral_iops;
 
-  dlist_push_last(&measurement->filesystem_usage, fsys_use);
+  evel_event_list_push(&measurement->header,
+                       &measurement->filesystem_usage,
+                       fsys_use);
 
   EVEL_EXIT();
 }
@@ -1616,14 +1628,17 @@ void evel_measurement_feature_use_add(EVENT_MEASUREMENT * measurement,
   /* Allocate a container for the value and push onto the list.              */
   /***************************************************************************/
   EVEL_DEBUG("Adding Feature=%s Use=%d", feature, utilization);
-  feature_use = malloc(sizeof(MEASUREMENT_FEATURE_USE));
+  feature_use = evel_event_malloc(&measurement->header,
+                                  sizeof(MEASUREMENT_FEATURE_USE));
   assert(feature_use != NULL);
   memset(feature_use, 0, sizeof(MEASUREMENT_FEATURE_USE));
-  feature_use->feature_id = strdup(feature);
+  feature_use->feature_id = evel_event_strdup(&measurement->header, feature);
   assert(feature_use->feature_id != NULL);
   feature_use->feature_utilization = utilization;
 
-  dlist_push_last(&measurement->feature_usage, feature_use);
+  evel_event_list_push(&measurement->header,
+                       &measurement->feature_usage,
+                       feature_use);
 
   EVEL_EXIT();
 }
@@ -1664,12 +1679,13 @@ void evel_measurement_custom_measurement_add(EVENT_MEASUREMENT * measurement,
   /***************************************************************************/
   EVEL_DEBUG("Adding Measurement Group=%s Name=%s Value=%s",
               group, name, value);
-  custom_measurement = malloc(sizeof(CUSTOM_MEASUREMENT));
+  custom_measurement = evel_event_malloc(&measurement->header,
+                                         sizeof(CUSTOM_MEASUREMENT));
   assert(custom_measurement != NULL);
   memset(custom_measurement, 0, sizeof(CUSTOM_MEASUREMENT));
-  custom_measurement->name = strdup(name);
+  custom_measurement->name = evel_event_strdup(&measurement->header, name);
   assert(custom_measurement->name != NULL);
-  custom_measurement->value = strdup(value);
+  custom_measurement->value = evel_event_strdup(&measurement->header, value);
   assert(custom_measurement->value != NULL);
 
   /***************************************************************************/
@@ -1696,19 +1712,24 @@ void evel_measurement_custom_measurement_add(EVENT_MEASUREMENT * measurement,
   if (item == NULL)
   {
     EVEL_DEBUG("Creating new Measurement Group");
-    measurement_group = malloc(sizeof(MEASUREMENT_GROUP));
+    measurement_group = evel_event_malloc(&measurement->header,
+                                          sizeof(MEASUREMENT_GROUP));
     assert(measurement_group != NULL);
     memset(measurement_group, 0, sizeof(MEASUREMENT_GROUP));
-    measurement_group->name = strdup(group);
+    measurement_group->name = evel_event_strdup(&measurement->header, group);
     assert(measurement_group->name != NULL);
     dlist_initialize(&measurement_group->measurements);
-    dlist_push_last(&measurement->additional_measurements, measurement_group);
+    evel_event_list_push(&measurement->header,
+                         &measurement->additional_measurements,
+                         measurement_group);
   }
 
   /***************************************************************************/
   /* If we didn't have the group already, create it.                         */
   /***************************************************************************/
-  dlist_push_last(&measurement_group->measurements, custom_measurement);
+  evel_event_list_push(&measurement->header,
+                       &measurement_group->measurements,
+                       custom_measurement);
 
   EVEL_EXIT();
 }
@@ -1743,14 +1764,17 @@ void evel_measurement_codec_use_add(EVENT_MEASUREMENT * measurement,
   /* Allocate a container for the value and push onto the list.              */
   /***************************************************************************/
   EVEL_DEBUG("Adding Codec=%s Use=%d", codec, utilization);
-  codec_use = malloc(sizeof(MEASUREMENT_CODEC_USE));
+  codec_use = evel_event_malloc(&measurement->header,
+                                sizeof(MEASUREMENT_CODEC_USE));
   assert(codec_use != NULL);
   memset(codec_use, 0, sizeof(MEASUREMENT_CODEC_USE));
-  codec_use->codec_id = strdup(codec);
+  codec_use->codec_id = evel_event_strdup(&measurement->header, codec);
   assert(codec_use->codec_id != NULL);
   codec_use->number_in_use = utilization;
 
-  dlist_push_last(&measurement->codec_usage, codec_use);
+  evel_event_list_push(&measurement->header,
+                       &measurement->codec_usage,
+                       codec_use);
 
   EVEL_EXIT();
 }
@@ -1927,7 +1951,10 @@ void evel_meas_latency_bucket_add(EVENT_MEASUREMENT * const measurement,
   assert(measurement != NULL);
   assert(measurement->header.event_domain == EVEL_DOMAIN_MEASUREMENT);
   assert(bucket != NULL);
-  dlist_push_last(&measurement->latency_distribution, bucket);
+  evel_event_list_push(&measurement->header,
+                       &measurement->latency_distribution,
+                       bucket);
+  evel_event_adopt(&measurement->header, free, bucket);
 
   EVEL_EXIT();
 }
@@ -2068,6 +2095,22 @@ void evel_measurement_free_vnic_performance(MEASUREMENT_VNIC_PERFORMANCE * const
   EVEL_EXIT();
 }
 
+/**************************************************************************//**
+ * Free a vNIC Use along with its allocated memory, for an event built in an
+ * arena.
+ *
+ * @param vnic_performance  Pointer to the ::MEASUREMENT_VNIC_PERFORMANCE.
+ *****************************************************************************/
+static void evel_measurement_destroy_vnic_performance(void * vnic_performance)
+{
+  EVEL_ENTER();
+
+  evel_measurement_free_vnic_performance(vnic_performance);
+  free(vnic_performance);
+
+  EVEL_EXIT();
+}
+
 /**************************************************************************//**
  * Set the Accumulated Broadcast Packets Received in measurement interval
  * property of the vNIC performance.
@@ -2875,7 +2918,20 @@ void evel_meas_vnic_performance_add(EVENT_MEASUREMENT * const measurement,
   assert(measurement->header.event_domain == EVEL_DOMAIN_MEASUREMENT);
   assert(vnic_performance != NULL);
 
-  dlist_push_last(&measurement->vnic_usage, vnic_performance);
+  evel_event_list_push(&measurement->header,
+                       &measurement->vnic_usage,
+                       vnic_performance);
+
+  /***************************************************************************/
+  /* The vNIC Use was allocated before the event owned it, so charge it to   */
+  /* the event now.                                                          */
+  /***************************************************************************/
+  measurement->header.size += sizeof(MEASUREMENT_VNIC_PERFORMANCE) +
+                              strlen(vnic_performance->vnic_id) + 1 +
+                              strlen(vnic_performance->valuesaresuspect) + 1;
+  evel_event_adopt(&measurement->header,
+                   evel_measurement_destroy_vnic_performance,
+                   vnic_performance);
 
   EVEL_EXIT();
 }
@@ -3037,7 +3093,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   /***************************************************************************/
   // additional fields
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "additionalFields"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_ADDITIONAL_FIELDS,
+                                    "additionalFields"))
   {
     bool item_added = false;
 
@@ -3048,6 +3106,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(addl_info != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_ADDITIONAL_FIELDS,
                                           "additionalFields",
                                           addl_info->name))
       {
@@ -3071,14 +3130,22 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   }
 
   // TBD additional json objects
-  evel_enc_kv_opt_int(jbuf, "concurrentSessions", &event->concurrent_sessions);
-  evel_enc_kv_opt_int(jbuf, "configuredEntities", &event->configured_entities);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_CONCURRENT_SESSIONS,
+                      "concurrentSessions",
+                      &event->concurrent_sessions);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_CONFIGURED_ENTITIES,
+                      "configuredEntities",
+                      &event->configured_entities);
 
   /***************************************************************************/
   /* CPU Use list.                                                           */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "cpuUsageArray"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_CPU_USAGE_ARRAY,
+                                    "cpuUsageArray"))
   {
     bool item_added = false;
 
@@ -3089,19 +3156,44 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(cpu_use != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_CPU_USAGE_ARRAY,
                                           "cpuUsageArray",
                                           cpu_use->id))
       {
         evel_json_open_object(jbuf);
         evel_enc_kv_string(jbuf, "cpuIdentifier", cpu_use->id);
-        evel_enc_kv_opt_double(jbuf, "cpuIdle", &cpu_use->idle);
-        evel_enc_kv_opt_double(jbuf, "cpuUsageInterrupt", &cpu_use->intrpt);
-        evel_enc_kv_opt_double(jbuf, "cpuUsageNice", &cpu_use->nice);
-        evel_enc_kv_opt_double(jbuf, "cpuUsageSoftIrq", &cpu_use->softirq);
-        evel_enc_kv_opt_double(jbuf, "cpuUsageSteal", &cpu_use->steal);
-        evel_enc_kv_opt_double(jbuf, "cpuUsageSystem", &cpu_use->sys);
-        evel_enc_kv_opt_double(jbuf, "cpuUsageUser", &cpu_use->user);
-        evel_enc_kv_opt_double(jbuf, "cpuWait", &cpu_use->wait);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_CPU_IDLE,
+                               "cpuIdle",
+                               &cpu_use->idle);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_CPU_USAGE_INTERRUPT,
+                               "cpuUsageInterrupt",
+                               &cpu_use->intrpt);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_CPU_USAGE_NICE,
+                               "cpuUsageNice",
+                               &cpu_use->nice);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_CPU_USAGE_SOFT_IRQ,
+                               "cpuUsageSoftIrq",
+                               &cpu_use->softirq);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_CPU_USAGE_STEAL,
+                               "cpuUsageSteal",
+                               &cpu_use->steal);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_CPU_USAGE_SYSTEM,
+                               "cpuUsageSystem",
+                               &cpu_use->sys);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_CPU_USAGE_USER,
+                               "cpuUsageUser",
+                               &cpu_use->user);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_CPU_WAIT,
+                               "cpuWait",
+                               &cpu_use->wait);
         evel_enc_kv_double(jbuf, "percentUsage",cpu_use->usage);
         evel_json_close_object(jbuf);
         item_added = true;
@@ -3124,7 +3216,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   /* Disk Use list.                                                           */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "diskUsageArray"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_DISK_USAGE_ARRAY,
+                                    "diskUsageArray"))
   {
     bool item_added = false;
 
@@ -3135,51 +3229,172 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(disk_use != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_DISK_USAGE_ARRAY,
                                           "diskUsageArray",
                                           disk_use->id))
       {
         evel_json_open_object(jbuf);
         evel_enc_kv_string(jbuf, "diskIdentifier", disk_use->id);
-        evel_enc_kv_opt_double(jbuf, "diskIoTimeAvg", &disk_use->iotimeavg);
-        evel_enc_kv_opt_double(jbuf, "diskIoTimeLast", &disk_use->iotimelast);
-        evel_enc_kv_opt_double(jbuf, "diskIoTimeMax", &disk_use->iotimemax);
-        evel_enc_kv_opt_double(jbuf, "diskIoTimeMin", &disk_use->iotimemin);
-        evel_enc_kv_opt_double(jbuf, "diskMergedReadAvg", &disk_use->mergereadavg);
-        evel_enc_kv_opt_double(jbuf, "diskMergedReadLast", &disk_use->mergereadlast);
-        evel_enc_kv_opt_double(jbuf, "diskMergedReadMax", &disk_use->mergereadmax);
-        evel_enc_kv_opt_double(jbuf, "diskMergedReadMin", &disk_use->mergereadmin);
-        evel_enc_kv_opt_double(jbuf, "diskMergedWriteAvg", &disk_use->mergewriteavg);
-        evel_enc_kv_opt_double(jbuf, "diskMergedWriteLast", &disk_use->mergewritelast);
-        evel_enc_kv_opt_double(jbuf, "diskMergedWriteMax", &disk_use->mergewritemax);
-        evel_enc_kv_opt_double(jbuf, "diskMergedWriteMin", &disk_use->mergewritemin);
-        evel_enc_kv_opt_double(jbuf, "diskOctetsReadAvg", &disk_use->octetsreadavg);
-        evel_enc_kv_opt_double(jbuf, "diskOctetsReadLast", &disk_use->octetsreadlast);
-        evel_enc_kv_opt_double(jbuf, "diskOctetsReadMax", &disk_use->octetsreadmax);
-        evel_enc_kv_opt_double(jbuf, "diskOctetsReadMin", &disk_use->octetsreadmin);
-        evel_enc_kv_opt_double(jbuf, "diskOctetsWriteAvg", &disk_use->octetswriteavg);
-        evel_enc_kv_opt_double(jbuf, "diskOctetsWriteLast", &disk_use->octetswritelast);
-        evel_enc_kv_opt_double(jbuf, "diskOctetsWriteMax", &disk_use->octetswritemax);
-        evel_enc_kv_opt_double(jbuf, "diskOctetsWriteMin", &disk_use->octetswritemin);
-        evel_enc_kv_opt_double(jbuf, "diskOpsReadAvg", &disk_use->opsreadavg);
-        evel_enc_kv_opt_double(jbuf, "diskOpsReadLast", &disk_use->opsreadlast);
-        evel_enc_kv_opt_double(jbuf, "diskOpsReadMax", &disk_use->opsreadmax);
-        evel_enc_kv_opt_double(jbuf, "diskOpsReadMin", &disk_use->opsreadmin);
-        evel_enc_kv_opt_double(jbuf, "diskOpsWriteAvg", &disk_use->opswriteavg);
-        evel_enc_kv_opt_double(jbuf, "diskOpsWriteLast", &disk_use->opswritelast);
-        evel_enc_kv_opt_double(jbuf, "diskOpsWriteMax", &disk_use->opswritemax);
-        evel_enc_kv_opt_double(jbuf, "diskOpsWriteMin", &disk_use->opswritemin);
-        evel_enc_kv_opt_double(jbuf, "diskPendingOperationsAvg", &disk_use->pendingopsavg);
-        evel_enc_kv_opt_double(jbuf, "diskPendingOperationsLast", &disk_use->pendingopslast);
-        evel_enc_kv_opt_double(jbuf, "diskPendingOperationsMax", &disk_use->pendingopsmax);
-        evel_enc_kv_opt_double(jbuf, "diskPendingOperationsMin", &disk_use->pendingopsmin);
-        evel_enc_kv_opt_double(jbuf, "diskTimeReadAvg", &disk_use->timereadavg);
-        evel_enc_kv_opt_double(jbuf, "diskTimeReadLast", &disk_use->timereadlast);
-        evel_enc_kv_opt_double(jbuf, "diskTimeReadMax", &disk_use->timereadmax);
-        evel_enc_kv_opt_double(jbuf, "diskTimeReadMin", &disk_use->timereadmin);
-        evel_enc_kv_opt_double(jbuf, "diskTimeWriteAvg", &disk_use->timewriteavg);
-        evel_enc_kv_opt_double(jbuf, "diskTimeWriteLast", &disk_use->timewritelast);
-        evel_enc_kv_opt_double(jbuf, "diskTimeWriteMax", &disk_use->timewritemax);
-        evel_enc_kv_opt_double(jbuf, "diskTimeWriteMin", &disk_use->timewritemin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_IO_TIME_AVG,
+                               "diskIoTimeAvg",
+                               &disk_use->iotimeavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_IO_TIME_LAST,
+                               "diskIoTimeLast",
+                               &disk_use->iotimelast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_IO_TIME_MAX,
+                               "diskIoTimeMax",
+                               &disk_use->iotimemax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_IO_TIME_MIN,
+                               "diskIoTimeMin",
+                               &disk_use->iotimemin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_MERGED_READ_AVG,
+                               "diskMergedReadAvg",
+                               &disk_use->mergereadavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_MERGED_READ_LAST,
+                               "diskMergedReadLast",
+                               &disk_use->mergereadlast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_MERGED_READ_MAX,
+                               "diskMergedReadMax",
+                               &disk_use->mergereadmax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_MERGED_READ_MIN,
+                               "diskMergedReadMin",
+                               &disk_use->mergereadmin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_MERGED_WRITE_AVG,
+                               "diskMergedWriteAvg",
+                               &disk_use->mergewriteavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_MERGED_WRITE_LAST,
+                               "diskMergedWriteLast",
+                               &disk_use->mergewritelast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_MERGED_WRITE_MAX,
+                               "diskMergedWriteMax",
+                               &disk_use->mergewritemax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_MERGED_WRITE_MIN,
+                               "diskMergedWriteMin",
+                               &disk_use->mergewritemin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OCTETS_READ_AVG,
+                               "diskOctetsReadAvg",
+                               &disk_use->octetsreadavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OCTETS_READ_LAST,
+                               "diskOctetsReadLast",
+                               &disk_use->octetsreadlast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OCTETS_READ_MAX,
+                               "diskOctetsReadMax",
+                               &disk_use->octetsreadmax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OCTETS_READ_MIN,
+                               "diskOctetsReadMin",
+                               &disk_use->octetsreadmin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OCTETS_WRITE_AVG,
+                               "diskOctetsWriteAvg",
+                               &disk_use->octetswriteavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OCTETS_WRITE_LAST,
+                               "diskOctetsWriteLast",
+                               &disk_use->octetswritelast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OCTETS_WRITE_MAX,
+                               "diskOctetsWriteMax",
+                               &disk_use->octetswritemax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OCTETS_WRITE_MIN,
+                               "diskOctetsWriteMin",
+                               &disk_use->octetswritemin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OPS_READ_AVG,
+                               "diskOpsReadAvg",
+                               &disk_use->opsreadavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OPS_READ_LAST,
+                               "diskOpsReadLast",
+                               &disk_use->opsreadlast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OPS_READ_MAX,
+                               "diskOpsReadMax",
+                               &disk_use->opsreadmax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OPS_READ_MIN,
+                               "diskOpsReadMin",
+                               &disk_use->opsreadmin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OPS_WRITE_AVG,
+                               "diskOpsWriteAvg",
+                               &disk_use->opswriteavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OPS_WRITE_LAST,
+                               "diskOpsWriteLast",
+                               &disk_use->opswritelast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OPS_WRITE_MAX,
+                               "diskOpsWriteMax",
+                               &disk_use->opswritemax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_OPS_WRITE_MIN,
+                               "diskOpsWriteMin",
+                               &disk_use->opswritemin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_PENDING_OPERATIONS_AVG,
+                               "diskPendingOperationsAvg",
+                               &disk_use->pendingopsavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_PENDING_OPERATIONS_LAST,
+                               "diskPendingOperationsLast",
+                               &disk_use->pendingopslast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_PENDING_OPERATIONS_MAX,
+                               "diskPendingOperationsMax",
+                               &disk_use->pendingopsmax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_PENDING_OPERATIONS_MIN,
+                               "diskPendingOperationsMin",
+                               &disk_use->pendingopsmin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_TIME_READ_AVG,
+                               "diskTimeReadAvg",
+                               &disk_use->timereadavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_TIME_READ_LAST,
+                               "diskTimeReadLast",
+                               &disk_use->timereadlast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_TIME_READ_MAX,
+                               "diskTimeReadMax",
+                               &disk_use->timereadmax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_TIME_READ_MIN,
+                               "diskTimeReadMin",
+                               &disk_use->timereadmin);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_TIME_WRITE_AVG,
+                               "diskTimeWriteAvg",
+                               &disk_use->timewriteavg);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_TIME_WRITE_LAST,
+                               "diskTimeWriteLast",
+                               &disk_use->timewritelast);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_TIME_WRITE_MAX,
+                               "diskTimeWriteMax",
+                               &disk_use->timewritemax);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_DISK_TIME_WRITE_MIN,
+                               "diskTimeWriteMin",
+                               &disk_use->timewritemin);
         evel_json_close_object(jbuf);
         item_added = true;
       }
@@ -3200,7 +3415,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   /* Filesystem Usage list.                                                  */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "filesystemUsageArray"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_FILESYSTEM_USAGE_ARRAY,
+                                    "filesystemUsageArray"))
   {
     bool item_added = false;
 
@@ -3211,6 +3428,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(fsys_use != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_FILESYSTEM_USAGE_ARRAY,
                                           "filesystemUsageArray",
                                           fsys_use->filesystem_name))
       {
@@ -3245,7 +3463,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   /***************************************************************************/
   item = dlist_get_first(&event->latency_distribution);
   if ((item != NULL) &&
-      evel_json_open_opt_named_list(jbuf, "latencyDistribution"))
+      evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_LATENCY_DISTRIBUTION,
+                                    "latencyDistribution"))
   {
     while (item != NULL)
     {
@@ -3253,10 +3473,14 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(bucket != NULL);
 
       evel_json_open_object(jbuf);
-      evel_enc_kv_opt_double(
-        jbuf, "lowEndOfLatencyBucket", &bucket->low_end);
-      evel_enc_kv_opt_double(
-        jbuf, "highEndOfLatencyBucket", &bucket->high_end);
+      evel_enc_kv_opt_double(jbuf,
+                             EVEL_FIELD_LOW_END_OF_LATENCY_BUCKET,
+                             "lowEndOfLatencyBucket",
+                             &bucket->low_end);
+      evel_enc_kv_opt_double(jbuf,
+                             EVEL_FIELD_HIGH_END_OF_LATENCY_BUCKET,
+                             "highEndOfLatencyBucket",
+                             &bucket->high_end);
       evel_enc_kv_int(jbuf, "countsInTheBucket", bucket->count);
       evel_json_close_object(jbuf);
       item = dlist_get_next(item);
@@ -3264,15 +3488,22 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
     evel_json_close_list(jbuf);
   }
 
-  evel_enc_kv_opt_double(
-    jbuf, "meanRequestLatency", &event->mean_request_latency);
-  evel_enc_kv_opt_int(jbuf, "requestRate", &event->request_rate);
+  evel_enc_kv_opt_double(jbuf,
+                         EVEL_FIELD_MEAN_REQUEST_LATENCY,
+                         "meanRequestLatency",
+                         &event->mean_request_latency);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_REQUEST_RATE,
+                      "requestRate",
+                      &event->request_rate);
 
   /***************************************************************************/
   /* vNIC Usage TBD Performance array                          */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "vNicUsageArray"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_V_NIC_USAGE_ARRAY,
+                                    "vNicUsageArray"))
   {
     bool item_added = false;
 
@@ -3283,6 +3514,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(vnic_performance != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_V_NIC_PERFORMANCE_ARRAY,
                                           "vNicPerformanceArray",
                                           vnic_performance->vnic_id))
       {
@@ -3291,61 +3523,61 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
         /*********************************************************************/
         /* Optional fields.                                                  */
         /*********************************************************************/
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedBroadcastPacketsAccumulated", &vnic_performance->recvd_bcast_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedBroadcastPacketsDelta", &vnic_performance->recvd_bcast_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedDiscardedPacketsAccumulated", &vnic_performance->recvd_discarded_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedDiscardedPacketsDelta", &vnic_performance->recvd_discarded_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedErrorPacketsAccumulated", &vnic_performance->recvd_error_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedErrorPacketsDelta", &vnic_performance->recvd_error_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedMulticastPacketsAccumulated", &vnic_performance->recvd_mcast_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedMulticastPacketsDelta", &vnic_performance->recvd_mcast_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedOctetsAccumulated", &vnic_performance->recvd_octets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedOctetsDelta", &vnic_performance->recvd_octets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedTotalPacketsAccumulated", &vnic_performance->recvd_total_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedTotalPacketsDelta", &vnic_performance->recvd_total_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedUnicastPacketsAccumulated", &vnic_performance->recvd_ucast_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "receivedUnicastPacketsDelta", &vnic_performance->recvd_ucast_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedBroadcastPacketsAccumulated", &vnic_performance->tx_bcast_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedBroadcastPacketsDelta", &vnic_performance->tx_bcast_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedDiscardedPacketsAccumulated", &vnic_performance->tx_discarded_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedDiscardedPacketsDelta", &vnic_performance->tx_discarded_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedErrorPacketsAccumulated", &vnic_performance->tx_error_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedErrorPacketsDelta", &vnic_performance->tx_error_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedMulticastPacketsAccumulated", &vnic_performance->tx_mcast_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedMulticastPacketsDelta", &vnic_performance->tx_mcast_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedOctetsAccumulated", &vnic_performance->tx_octets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedOctetsDelta", &vnic_performance->tx_octets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedTotalPacketsAccumulated", &vnic_performance->tx_total_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedTotalPacketsDelta", &vnic_performance->tx_total_packets_delta);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedUnicastPacketsAccumulated", &vnic_performance->tx_ucast_packets_acc);
-        evel_enc_kv_opt_double( jbuf,
+        evel_enc_kv_opt_double( jbuf, EVEL_MAX_THROTTLE_FIELDS,
 		 "transmittedUnicastPacketsDelta", &vnic_performance->tx_ucast_packets_delta);
 
         /*********************************************************************/
@@ -3376,7 +3608,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   /* Memory Use list.                                                           */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "memoryUsageArray"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_MEMORY_USAGE_ARRAY,
+                                    "memoryUsageArray"))
   {
     bool item_added = false;
 
@@ -3387,17 +3621,36 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(mem_use != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_MEMORY_USAGE_ARRAY,
                                           "memoryUsageArray",
                                           mem_use->id))
       {
         evel_json_open_object(jbuf);
         evel_enc_kv_double(jbuf, "memoryBuffered", mem_use->membuffsz);
-        evel_enc_kv_opt_double(jbuf, "memoryCached", &mem_use->memcache);
-        evel_enc_kv_opt_double(jbuf, "memoryConfigured", &mem_use->memconfig);
-        evel_enc_kv_opt_double(jbuf, "memoryFree", &mem_use->memfree);
-        evel_enc_kv_opt_double(jbuf, "memorySlabRecl", &mem_use->slabrecl);
-        evel_enc_kv_opt_double(jbuf, "memorySlabUnrecl", &mem_use->slabunrecl);
-        evel_enc_kv_opt_double(jbuf, "memoryUsed", &mem_use->memused);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_MEMORY_CACHED,
+                               "memoryCached",
+                               &mem_use->memcache);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_MEMORY_CONFIGURED,
+                               "memoryConfigured",
+                               &mem_use->memconfig);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_MEMORY_FREE,
+                               "memoryFree",
+                               &mem_use->memfree);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_MEMORY_SLAB_RECL,
+                               "memorySlabRecl",
+                               &mem_use->slabrecl);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_MEMORY_SLAB_UNRECL,
+                               "memorySlabUnrecl",
+                               &mem_use->slabunrecl);
+        evel_enc_kv_opt_double(jbuf,
+                               EVEL_FIELD_MEMORY_USED,
+                               "memoryUsed",
+                               &mem_use->memused);
         evel_enc_kv_string(jbuf, "vmIdentifier", mem_use->id);
         evel_json_close_object(jbuf);
         item_added = true;
@@ -3416,16 +3669,20 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   }
 
 
-  evel_enc_kv_opt_int(
-    jbuf, "numberOfMediaPortsInUse", &event->media_ports_in_use);
-  evel_enc_kv_opt_int(
-    jbuf, "vnfcScalingMetric", &event->vnfc_scaling_metric);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_NUMBER_OF_MEDIA_PORTS_IN_USE,
+                      "numberOfMediaPortsInUse",
+                      &event->media_ports_in_use);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_VNFC_SCALING_METRIC,
+                      "vnfcScalingMetric",
+                      &event->vnfc_scaling_metric);
 
   /***************************************************************************/
   /* Errors list.                                                            */
   /***************************************************************************/
   if ((event->errors != NULL) &&
-      evel_json_open_opt_named_object(jbuf, "errors"))
+      evel_json_open_opt_named_object(jbuf, EVEL_FIELD_ERRORS, "errors"))
   {
     errors = event->errors;
     evel_enc_kv_int(jbuf, "receiveDiscards", errors->receive_discards);
@@ -3439,7 +3696,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   /* Feature Utilization list.                                               */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "featureUsageArray"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_FEATURE_USAGE_ARRAY,
+                                    "featureUsageArray"))
   {
     bool item_added = false;
 
@@ -3450,6 +3709,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(feature_use != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_FEATURE_USAGE_ARRAY,
                                           "featureUsageArray",
                                           feature_use->feature_id))
       {
@@ -3477,7 +3737,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   /* Codec Utilization list.                                                 */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "codecUsageArray"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_CODEC_USAGE_ARRAY,
+                                    "codecUsageArray"))
   {
     bool item_added = false;
 
@@ -3488,6 +3750,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(codec_use != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_CODEC_USAGE_ARRAY,
                                           "codecUsageArray",
                                           codec_use->codec_id))
       {
@@ -3514,7 +3777,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
   /* Additional Measurement Groups list.                                     */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "additionalMeasurements"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_ADDITIONAL_MEASUREMENTS,
+                                    "additionalMeasurements"))
   {
     bool item_added = false;
 
@@ -3525,12 +3790,15 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       assert(measurement_group != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_ADDITIONAL_MEASUREMENTS,
                                           "additionalMeasurements",
                                           measurement_group->name))
       {
         evel_json_open_object(jbuf);
         evel_enc_kv_string(jbuf, "name", measurement_group->name);
-        evel_json_open_opt_named_list(jbuf, "measurements");
+        evel_json_open_opt_named_list(jbuf,
+                                      EVEL_FIELD_MEASUREMENTS,
+                                      "measurements");
 
         /*********************************************************************/
         /* Measurements list.                                                */
@@ -72,13 +72,12 @@ EVENT_SIGNALING * evel_new_signaling(const char * const vendor_name,
   /***************************************************************************/
   /* Allocate the Signaling event.                                           */
   /***************************************************************************/
-  event = malloc(sizeof(EVENT_SIGNALING));
+  event = evel_alloc_event(EVEL_DOMAIN_SIPSIGNALING, sizeof(EVENT_SIGNALING));
   if (event == NULL)
   {
     log_error_state("Out of memory");
     goto exit_label;
   }
-  memset(event, 0, sizeof(EVENT_SIGNALING));
   EVEL_DEBUG("New Signaling event is at %lp", event);
 
   /***************************************************************************/
@@ -88,12 +87,29 @@ EVENT_SIGNALING * evel_new_signaling(const char * const vendor_name,
   event->header.event_domain = EVEL_DOMAIN_SIPSIGNALING;
   event->major_version = EVEL_SIGNALING_MAJOR_VERSION;
   event->minor_version = EVEL_SIGNALING_MINOR_VERSION;
-  evel_init_vendor_field(&event->vnfname_field, vendor_name);
-  evel_set_option_string(&event->correlator,correlator,"Init correlator");
-  evel_set_option_string(&event->local_ip_address,local_ip_address,"Init correlator");
-  evel_set_option_string(&event->local_port,local_port,"Init local port");
-  evel_set_option_string(&event->remote_ip_address,remote_ip_address,"Init remote ip");
-  evel_set_option_string(&event->remote_port,remote_port,"Init remote port");
+  evel_init_vendor_field(&event->header,
+                         &event->vnfname_field,
+                         vendor_name);
+  evel_event_set_option_string(&event->header,
+                               &event->correlator,
+                               correlator,
+                               "Init correlator");
+  evel_event_set_option_string(&event->header,
+                               &event->local_ip_address,
+                               local_ip_address,
+                               "Init correlator");
+  evel_event_set_option_string(&event->header,
+                               &event->local_port,
+                               local_port,
+                               "Init local port");
+  evel_event_set_option_string(&event->header,
+                               &event->remote_ip_address,
+                               remote_ip_address,
+                               "Init remote ip");
+  evel_event_set_option_string(&event->header,
+                               &event->remote_port,
+                               remote_port,
+                               "Init remote port");
   evel_init_option_string(&event->compressed_sip);
   evel_init_option_string(&event->summary_sip);
   dlist_initialize(&event->additional_info);
@@ -133,15 +149,15 @@ void evel_signaling_addl_info_add(EVENT_SIGNALING * event, char * name, char * v
   assert(value != NULL);
 
   EVEL_DEBUG("Adding name=%s value=%s", name, value);
-  addl_info = malloc(sizeof(SIGNALING_ADDL_FIELD));
+  addl_info = evel_event_malloc(&event->header, sizeof(SIGNALING_ADDL_FIELD));
   assert(addl_info != NULL);
   memset(addl_info, 0, sizeof(SIGNALING_ADDL_FIELD));
-  addl_info->name = strdup(name);
-  addl_info->value = strdup(value);
+  addl_info->name = evel_event_strdup(&event->header, name);
+  addl_info->value = evel_event_strdup(&event->header, value);
   assert(addl_info->name != NULL);
   assert(addl_info->value != NULL);
 
-  dlist_push_last(&event->additional_info, addl_info);
+  evel_event_list_push(&event->header, &event->additional_info, addl_info);
 
   EVEL_EXIT();
 }
@@ -199,9 +215,10 @@ void evel_signaling_local_ip_address_set(EVENT_SIGNALING * const event,
   assert(event->header.event_domain == EVEL_DOMAIN_SIPSIGNALING);
   assert(local_ip_address != NULL);
 
-  evel_set_option_string(&event->local_ip_address,
-                         local_ip_address,
-                         "Local Ip Address");
+  evel_event_set_option_string(&event->header,
+                               &event->local_ip_address,
+                               local_ip_address,
+                               "Local Ip Address");
 
   EVEL_EXIT();
 }
@@ -230,9 +247,10 @@ void evel_signaling_local_port_set(EVENT_SIGNALING * const event,
   assert(event->header.event_domain == EVEL_DOMAIN_SIPSIGNALING);
   assert(local_port != NULL);
 
-  evel_set_option_string(&event->local_port,
-                         local_port,
-                         "Local Port");
+  evel_event_set_option_string(&event->header,
+                               &event->local_port,
+                               local_port,
+                               "Local Port");
 
   EVEL_EXIT();
 }
@@ -262,9 +280,10 @@ void evel_signaling_remote_ip_address_set(EVENT_SIGNALING * const event,
   assert(event->header.event_domain == EVEL_DOMAIN_SIPSIGNALING);
   assert(remote_ip_address != NULL);
 
-  evel_set_option_string(&event->remote_ip_address,
-                         remote_ip_address,
-                         "Remote Ip Address");
+  evel_event_set_option_string(&event->header,
+                               &event->remote_ip_address,
+                               remote_ip_address,
+                               "Remote Ip Address");
 
   EVEL_EXIT();
 }
@@ -293,9 +312,10 @@ void evel_signaling_remote_port_set(EVENT_SIGNALING * const event,
   assert(event->header.event_domain == EVEL_DOMAIN_SIPSIGNALING);
   assert(remote_port != NULL);
 
-  evel_set_option_string(&event->remote_port,
-                         remote_port,
-                         "Remote Port");
+  evel_event_set_option_string(&event->header,
+                               &event->remote_port,
+                               remote_port,
+                               "Remote Port");
 
   EVEL_EXIT();
 }
@@ -324,7 +344,9 @@ void evel_signaling_vnfmodule_name_set(EVENT_SIGNALING * const event,
   assert(event->header.event_domain == EVEL_DOMAIN_SIPSIGNALING);
   assert(module_name != NULL);
 
-  evel_vendor_field_module_set(&event->vnfname_field, module_name);
+  evel_vendor_field_module_set(&event->header,
+                               &event->vnfname_field,
+                               module_name);
 
   EVEL_EXIT();
 }
@@ -353,7 +375,9 @@ void evel_signaling_vnfname_set(EVENT_SIGNALING * const event,
   assert(event->header.event_domain == EVEL_DOMAIN_SIPSIGNALING);
   assert(vnfname != NULL);
 
-  evel_vendor_field_vnfname_set(&event->vnfname_field, vnfname);
+  evel_vendor_field_vnfname_set(&event->header,
+                                &event->vnfname_field,
+                                vnfname);
 
   EVEL_EXIT();
 }
@@ -383,9 +407,10 @@ void evel_signaling_compressed_sip_set(EVENT_SIGNALING * const event,
   assert(event->header.event_domain == EVEL_DOMAIN_SIPSIGNALING);
   assert(compressed_sip != NULL);
 
-  evel_set_option_string(&event->compressed_sip,
-                         compressed_sip,
-                         "Compressed SIP");
+  evel_event_set_option_string(&event->header,
+                               &event->compressed_sip,
+                               compressed_sip,
+                               "Compressed SIP");
 
   EVEL_EXIT();
 }
@@ -414,9 +439,10 @@ void evel_signaling_summary_sip_set(EVENT_SIGNALING * const event,
   assert(event->header.event_domain == EVEL_DOMAIN_SIPSIGNALING);
   assert(summary_sip != NULL);
 
-  evel_set_option_string(&event->summary_sip,
-                         summary_sip,
-                         "Summary SIP");
+  evel_event_set_option_string(&event->header,
+                               &event->summary_sip,
+                               summary_sip,
+                               "Summary SIP");
 
   EVEL_EXIT();
 }
@@ -443,9 +469,10 @@ void evel_signaling_correlator_set(EVENT_SIGNALING * const event,
   /***************************************************************************/
   assert(event != NULL);
   assert(event->header.event_domain == EVEL_DOMAIN_SIPSIGNALING);
-  evel_set_option_string(&event->correlator,
-                         correlator,
-                         "Correlator");
+  evel_event_set_option_string(&event->header,
+                               &event->correlator,
+                               correlator,
+                               "Correlator");
 
   EVEL_EXIT();
 }
@@ -481,14 +508,35 @@ void evel_json_encode_signaling(EVEL_JSON_BUFFER * const jbuf,
   /***************************************************************************/
   /* Optional fields                                                         */
   /***************************************************************************/
-  evel_enc_kv_opt_string(jbuf, "compressedSip", &event->compressed_sip);
-  evel_enc_kv_opt_string(jbuf, "correlator", &event->correlator);
-  evel_enc_kv_opt_string(jbuf, "localIpAddress", &event->local_ip_address);
-  evel_enc_kv_opt_string(jbuf, "localPort", &event->local_port);
-  evel_enc_kv_opt_string(jbuf, "remoteIpAddress", &event->remote_ip_address);
-  evel_enc_kv_opt_string(jbuf, "remotePort", &event->remote_port);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_COMPRESSED_SIP,
+                         "compressedSip",
+                         &event->compressed_sip);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_CORRELATOR,
+                         "correlator",
+                         &event->correlator);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_LOCAL_IP_ADDRESS,
+                         "localIpAddress",
+                         &event->local_ip_address);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_LOCAL_PORT,
+                         "localPort",
+                         &event->local_port);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_REMOTE_IP_ADDRESS,
+                         "remoteIpAddress",
+                         &event->remote_ip_address);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_REMOTE_PORT,
+                         "remotePort",
+                         &event->remote_port);
   evel_enc_version(jbuf, "signalingFieldsVersion", event->major_version,event->minor_version);
-  evel_enc_kv_opt_string(jbuf, "summarySip", &event->summary_sip);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_SUMMARY_SIP,
+                         "summarySip",
+                         &event->summary_sip);
   evel_json_encode_vendor_field(jbuf, &event->vnfname_field);
 
 
@@ -496,7 +544,9 @@ void evel_json_encode_signaling(EVEL_JSON_BUFFER * const jbuf,
   /* Checkpoint, so that we can wind back if all fields are suppressed.      */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "additionalInformation"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_ADDITIONAL_INFORMATION,
+                                    "additionalInformation"))
   {
     bool item_added = false;
 
@@ -507,6 +557,7 @@ void evel_json_encode_signaling(EVEL_JSON_BUFFER * const jbuf,
       assert(addl_info != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_ADDITIONAL_INFORMATION,
                                           "additionalInformation",
                                           addl_info->name))
       {
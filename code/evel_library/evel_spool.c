@@ -0,0 +1,1018 @@
+/**************************************************************************//**
+ * @file
+ * Store-and-forward spool for posts which could not be delivered.
+ *
+ * The spool is a directory of segment files, each of which is mapped into
+ * memory.  A segment starts with a ::EVEL_SPOOL_HEADER, followed by records
+ * which are appended in turn.  Each record carries a checksum and its magic
+ * number is written last, so a record which was only partly written when
+ * the process stopped is recognized as the end of the segment.  The header
+ * records how far the segment has been replayed, and each record is marked
+ * once it has been delivered, so a restarted process carries on replaying
+ * where the last one left off.  A record which was in flight when the process
+ * stopped is replayed again.
+ *
+ * License
+ * -------
+ *
+ * Copyright(c) <2016>, AT&T Intellectual Property.  All other rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:  This product includes
+ *    software developed by the AT&T.
+ * 4. Neither the name of AT&T nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY AT&T INTELLECTUAL PROPERTY ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL AT&T INTELLECTUAL PROPERTY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <assert.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "evel.h"
+#include "evel_internal.h"
+#include "evel_spool.h"
+
+/*****************************************************************************/
+/* Magic numbers and version of the segment files.                           */
+/*****************************************************************************/
+#define EVEL_SPOOL_MAGIC          0x50535645
+#define EVEL_SPOOL_RECORD_MAGIC   0x43525645
+#define EVEL_SPOOL_VERSION        1
+
+/*****************************************************************************/
+/* Record flags.                                                             */
+/*****************************************************************************/
+#define EVEL_SPOOL_FLAG_BATCH     0x1
+
+/*****************************************************************************/
+/* Segments are sized so that the spool holds no more than about             */
+/* EVEL_SPOOL_SEGMENTS of them, but are at least EVEL_SPOOL_MIN_SEGMENT_SIZE */
+/* unless that would leave a small spool with fewer than                     */
+/* EVEL_SPOOL_MIN_SEGMENTS, as dropping its oldest would lose too much.      */
+/*****************************************************************************/
+#define EVEL_SPOOL_MIN_SEGMENT_SIZE (1024 * 1024)
+#define EVEL_SPOOL_SEGMENTS         64
+#define EVEL_SPOOL_MIN_SEGMENTS     4
+
+/*****************************************************************************/
+/* Records are aligned to this boundary within a segment.                    */
+/*****************************************************************************/
+#define EVEL_SPOOL_ALIGN          8
+
+/*****************************************************************************/
+/* Length of the name of a segment file, "evel-<16 hex digits>.spool".       */
+/*****************************************************************************/
+#define EVEL_SPOOL_NAME_LENGTH    27
+
+/**************************************************************************//**
+ * Header at the start of each segment file.
+ *****************************************************************************/
+typedef struct evel_spool_header {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t sequence;
+  int64_t created;
+  uint32_t size;
+  uint32_t read_offset;
+} EVEL_SPOOL_HEADER;
+
+/**************************************************************************//**
+ * Header of each record in a segment, which is followed by the body of the
+ * post and a terminating NUL.  The checksum covers the length, the number of
+ * events, the flags and the body.
+ *****************************************************************************/
+typedef struct evel_spool_record {
+  uint32_t magic;
+  uint32_t length;
+  uint32_t num_events;
+  uint32_t flags;
+  uint32_t checksum;
+  uint32_t delivered;
+} EVEL_SPOOL_RECORD;
+
+/**************************************************************************//**
+ * A segment of the spool, which is mapped for as long as the spool is open.
+ *****************************************************************************/
+typedef struct evel_spool_segment {
+  struct evel_spool_segment * next;
+  unsigned long long sequence;
+  int size;
+  int write_offset;
+  int fd;
+  char * map;
+} EVEL_SPOOL_SEGMENT;
+
+/*****************************************************************************/
+/* Prototypes of locally scoped functions.                                   */
+/*****************************************************************************/
+static uint32_t evel_spool_checksum(const EVEL_SPOOL_RECORD * const record,
+                                    const char * const body);
+static int evel_spool_record_size(const int length);
+static EVEL_SPOOL_RECORD * evel_spool_record_at(
+  const EVEL_SPOOL_SEGMENT * const segment,
+  const int offset);
+static EVEL_SPOOL_SEGMENT * evel_spool_segment_find(
+  const unsigned long long sequence);
+static EVEL_SPOOL_SEGMENT * evel_spool_segment_map(const char * const name);
+static EVEL_SPOOL_SEGMENT * evel_spool_segment_create(const int size);
+static void evel_spool_segment_insert(EVEL_SPOOL_SEGMENT * const segment);
+static void evel_spool_segment_remove(EVEL_SPOOL_SEGMENT * const segment,
+                                      const bool drop);
+static void evel_spool_expire(void);
+static void evel_spool_path(char * const path,
+                            const size_t path_size,
+                            const unsigned long long sequence);
+
+/**************************************************************************//**
+ * The directory holding the spool, or NULL if there is no spool, and the
+ * limits on what it holds.
+ *****************************************************************************/
+static char * evel_spool_directory = NULL;
+static long long evel_spool_max_bytes = 0;
+static int evel_spool_max_age_s = 0;
+static int evel_spool_segment_size = 0;
+
+/**************************************************************************//**
+ * The segments, oldest first, and the sequence number of the next one.
+ *****************************************************************************/
+static EVEL_SPOOL_SEGMENT * evel_spool_head = NULL;
+static unsigned long long evel_spool_next_sequence = 0;
+
+/**************************************************************************//**
+ * The next record to be replayed.
+ *****************************************************************************/
+static EVEL_SPOOL_REF evel_spool_cursor;
+
+/**************************************************************************//**
+ * Statistics of the spool, which are protected by the mutex since they are
+ * read from the foreground.
+ *****************************************************************************/
+static EVEL_SPOOL_STATS evel_spool_stats;
+static pthread_mutex_t evel_spool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**************************************************************************//**
+ * Open the spool in a directory, picking up any segments left by an earlier
+ * process.
+ *
+ * @param directory     The directory, which must exist.
+ * @param max_bytes     Maximum size of the segment files, in bytes.
+ * @param max_age_s     Maximum age of a segment, in seconds.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_SPOOL_FAIL The directory couldn't be read.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_spool_open(const char * const directory,
+                               const long long max_bytes,
+                               const int max_age_s)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_SPOOL_SEGMENT * segment = NULL;
+  EVEL_SPOOL_HEADER * header = NULL;
+  DIR * dir = NULL;
+  struct dirent * entry = NULL;
+  int pending = 0;
+  int offset = 0;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(directory != NULL);
+  assert(max_bytes > 0);
+  assert(max_age_s > 0);
+  assert(evel_spool_directory == NULL);
+
+  dir = opendir(directory);
+  if (dir == NULL)
+  {
+    rc = EVEL_SPOOL_FAIL;
+    log_error_state("Failed to open spool directory %s", directory);
+    goto exit_label;
+  }
+
+  evel_spool_directory = strdup(directory);
+  assert(evel_spool_directory != NULL);
+  evel_spool_max_bytes = max_bytes;
+  evel_spool_max_age_s = max_age_s;
+  evel_spool_segment_size = (int) min(max(max_bytes / EVEL_SPOOL_SEGMENTS,
+                                          (long long)
+                                          EVEL_SPOOL_MIN_SEGMENT_SIZE),
+                                      min(max_bytes / EVEL_SPOOL_MIN_SEGMENTS,
+                                          (long long) (1 << 30)));
+  evel_spool_next_sequence = 0;
+  pthread_mutex_lock(&evel_spool_mutex);
+  memset(&evel_spool_stats, 0, sizeof(evel_spool_stats));
+  pthread_mutex_unlock(&evel_spool_mutex);
+
+  /***************************************************************************/
+  /* Map every segment left by an earlier process, in sequence order.        */
+  /***************************************************************************/
+  while ((entry = readdir(dir)) != NULL)
+  {
+    if ((strlen(entry->d_name) != EVEL_SPOOL_NAME_LENGTH) ||
+        (strncmp(entry->d_name, "evel-", 5) != 0) ||
+        (strcmp(entry->d_name + EVEL_SPOOL_NAME_LENGTH - 6, ".spool") != 0))
+    {
+      continue;
+    }
+    segment = evel_spool_segment_map(entry->d_name);
+    if (segment != NULL)
+    {
+      evel_spool_segment_insert(segment);
+      evel_spool_next_sequence = max(evel_spool_next_sequence,
+                                     segment->sequence + 1);
+    }
+  }
+  closedir(dir);
+
+  /***************************************************************************/
+  /* Segments which were completely replayed are finished with, and the rest */
+  /* are replayed from where they got to.                                    */
+  /***************************************************************************/
+  segment = evel_spool_head;
+  while (segment != NULL)
+  {
+    EVEL_SPOOL_SEGMENT * next = segment->next;
+    header = (EVEL_SPOOL_HEADER *) segment->map;
+    if ((int) header->read_offset >= segment->write_offset)
+    {
+      evel_spool_segment_remove(segment, false);
+    }
+    else
+    {
+      for (offset = header->read_offset;
+           offset < segment->write_offset;
+           offset += evel_spool_record_size(
+                       evel_spool_record_at(segment, offset)->length))
+      {
+        pending += !evel_spool_record_at(segment, offset)->delivered;
+      }
+    }
+    segment = next;
+  }
+  evel_spool_cursor.sequence = 0;
+  evel_spool_cursor.offset = 0;
+  EVEL_INFO("Spool in %s has %d posts to replay", directory, pending);
+
+exit_label:
+  EVEL_EXIT();
+
+  return rc;
+}
+
+/**************************************************************************//**
+ * Close the spool, leaving its segments for the next process to replay.
+ *****************************************************************************/
+void evel_spool_close(void)
+{
+  EVEL_SPOOL_SEGMENT * segment = NULL;
+
+  EVEL_ENTER();
+
+  while (evel_spool_head != NULL)
+  {
+    segment = evel_spool_head;
+    evel_spool_head = segment->next;
+    msync(segment->map, segment->size, MS_SYNC);
+    munmap(segment->map, segment->size);
+    close(segment->fd);
+    free(segment);
+  }
+  free(evel_spool_directory);
+  evel_spool_directory = NULL;
+
+  pthread_mutex_lock(&evel_spool_mutex);
+  evel_spool_stats.segments = 0;
+  evel_spool_stats.bytes = 0;
+  pthread_mutex_unlock(&evel_spool_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Append a post to the spool.
+ *
+ * If the spool is full, its oldest segments are dropped to make room.
+ *
+ * @param body          The body of the post.
+ * @param size          The size of the body in bytes.
+ * @param batch         Whether the post is to the batch API.
+ * @param num_events    The number of events in the post.
+ * @returns Whether the post was spooled.
+ *****************************************************************************/
+bool evel_spool_append(const char * const body,
+                       const int size,
+                       const bool batch,
+                       const int num_events)
+{
+  EVEL_SPOOL_SEGMENT * tail = NULL;
+  EVEL_SPOOL_RECORD * record = NULL;
+  char * record_body = NULL;
+  int record_size = 0;
+  int segment_size = 0;
+  long page_size = 0;
+  long sync_start = 0;
+  bool spooled = false;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(body != NULL);
+  assert(size >= 0);
+
+  if (evel_spool_directory == NULL)
+  {
+    goto exit_label;
+  }
+  evel_spool_expire();
+
+  /***************************************************************************/
+  /* Start a new segment if the last one doesn't have room for the record,   */
+  /* or is half way to being too old, since segments are dropped whole.  A   */
+  /* record which is larger than a segment gets a segment of its own.        */
+  /***************************************************************************/
+  record_size = evel_spool_record_size(size);
+  for (tail = evel_spool_head;
+       (tail != NULL) && (tail->next != NULL);
+       tail = tail->next)
+  {
+  }
+  if ((tail == NULL) ||
+      (tail->write_offset + record_size > tail->size) ||
+      (((EVEL_SPOOL_HEADER *) tail->map)->created <
+       time(NULL) - evel_spool_max_age_s / 2))
+  {
+    segment_size = max(evel_spool_segment_size,
+                       (int) sizeof(EVEL_SPOOL_HEADER) + record_size);
+    if (segment_size > evel_spool_max_bytes)
+    {
+      EVEL_ERROR("Post of %d bytes is too large to spool", size);
+      goto exit_label;
+    }
+    while ((evel_spool_head != NULL) &&
+           (evel_spool_stats.bytes + segment_size > evel_spool_max_bytes))
+    {
+      EVEL_ERROR("Spool full - dropping oldest segment");
+      evel_spool_segment_remove(evel_spool_head, true);
+    }
+    tail = evel_spool_segment_create(segment_size);
+    if (tail == NULL)
+    {
+      goto exit_label;
+    }
+    evel_spool_segment_insert(tail);
+  }
+
+  /***************************************************************************/
+  /* Write the record, with its magic number last so that it is only valid   */
+  /* once it is complete, then start it on its way to disk.                  */
+  /***************************************************************************/
+  record = (EVEL_SPOOL_RECORD *) (tail->map + tail->write_offset);
+  record_body = (char *) (record + 1);
+  memcpy(record_body, body, size);
+  record_body[size] = '\0';
+  record->length = size;
+  record->num_events = num_events;
+  record->flags = batch ? EVEL_SPOOL_FLAG_BATCH : 0;
+  record->delivered = 0;
+  record->checksum = evel_spool_checksum(record, record_body);
+  __atomic_store_n(&record->magic, EVEL_SPOOL_RECORD_MAGIC, __ATOMIC_RELEASE);
+
+  page_size = sysconf(_SC_PAGESIZE);
+  sync_start = tail->write_offset - (tail->write_offset % page_size);
+  msync(tail->map + sync_start,
+        tail->write_offset + record_size - sync_start,
+        MS_ASYNC);
+  tail->write_offset += record_size;
+  spooled = true;
+
+  pthread_mutex_lock(&evel_spool_mutex);
+  evel_spool_stats.spooled_posts++;
+  evel_spool_stats.spooled_events += num_events;
+  pthread_mutex_unlock(&evel_spool_mutex);
+  EVEL_DEBUG("Spooled post of %d events in segment %llu",
+             num_events, tail->sequence);
+
+exit_label:
+  EVEL_EXIT();
+
+  return spooled;
+}
+
+/**************************************************************************//**
+ * Say whether there may be records in the spool waiting to be replayed.
+ *
+ * @returns Whether ::evel_spool_next may have a record to replay.
+ *****************************************************************************/
+bool evel_spool_pending(void)
+{
+  EVEL_SPOOL_SEGMENT * tail = NULL;
+
+  for (tail = evel_spool_head;
+       (tail != NULL) && (tail->next != NULL);
+       tail = tail->next)
+  {
+  }
+
+  return (tail != NULL) &&
+         ((evel_spool_cursor.sequence < tail->sequence) ||
+          ((evel_spool_cursor.sequence == tail->sequence) &&
+           (evel_spool_cursor.offset < tail->write_offset)));
+}
+
+/**************************************************************************//**
+ * Get the next record to replay from the spool.
+ *
+ * The record stays in the spool until it is released.
+ *
+ * @param ref           Filled in with the reference to the record.
+ * @param body          Filled in with the body of the post, which is only
+ *                      valid until the spool is next changed.
+ * @param size          Filled in with the size of the body in bytes.
+ * @param batch         Filled in with whether the post is to the batch API.
+ * @param num_events    Filled in with the number of events in the post.
+ * @returns Whether there was a record to replay.
+ *****************************************************************************/
+bool evel_spool_next(EVEL_SPOOL_REF * const ref,
+                     const char ** const body,
+                     int * const size,
+                     bool * const batch,
+                     int * const num_events)
+{
+  EVEL_SPOOL_SEGMENT * segment = NULL;
+  EVEL_SPOOL_RECORD * record = NULL;
+  int offset = 0;
+  bool found = false;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(ref != NULL);
+  assert(body != NULL);
+  assert(size != NULL);
+  assert(batch != NULL);
+  assert(num_events != NULL);
+
+  evel_spool_expire();
+
+  /***************************************************************************/
+  /* Starting at the cursor, find the first record which hasn't been         */
+  /* delivered, moving on through the segments.                              */
+  /***************************************************************************/
+  for (segment = evel_spool_head; segment != NULL; segment = segment->next)
+  {
+    if (segment->sequence < evel_spool_cursor.sequence)
+    {
+      continue;
+    }
+    if (segment->sequence > evel_spool_cursor.sequence)
+    {
+      evel_spool_cursor.sequence = segment->sequence;
+      evel_spool_cursor.offset = 0;
+    }
+    offset = max(evel_spool_cursor.offset,
+                 (int) ((EVEL_SPOOL_HEADER *) segment->map)->read_offset);
+    while (offset < segment->write_offset)
+    {
+      record = evel_spool_record_at(segment, offset);
+      assert(record != NULL);
+      if (!record->delivered)
+      {
+        found = true;
+        break;
+      }
+      offset += evel_spool_record_size(record->length);
+    }
+    evel_spool_cursor.offset = offset;
+    if (found)
+    {
+      break;
+    }
+  }
+
+  if (found)
+  {
+    ref->sequence = segment->sequence;
+    ref->offset = offset;
+    *body = (const char *) (record + 1);
+    *size = record->length;
+    *batch = ((record->flags & EVEL_SPOOL_FLAG_BATCH) != 0);
+    *num_events = record->num_events;
+    evel_spool_cursor.offset += evel_spool_record_size(record->length);
+  }
+
+  EVEL_EXIT();
+
+  return found;
+}
+
+/**************************************************************************//**
+ * Release a record which has been replayed, either because it was delivered
+ * or because the listener rejected it.
+ *
+ * Once every record in a segment has been released the segment is removed.
+ *
+ * @param ref           Reference to the record.
+ * @param delivered     Whether the record was delivered.
+ *****************************************************************************/
+void evel_spool_release(const EVEL_SPOOL_REF * const ref,
+                        const bool delivered)
+{
+  EVEL_SPOOL_SEGMENT * segment = NULL;
+  EVEL_SPOOL_HEADER * header = NULL;
+  EVEL_SPOOL_RECORD * record = NULL;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(ref != NULL);
+
+  /***************************************************************************/
+  /* The segment may have been dropped while the record was in flight.       */
+  /***************************************************************************/
+  segment = evel_spool_segment_find(ref->sequence);
+  if ((segment == NULL) ||
+      ((record = evel_spool_record_at(segment, ref->offset)) == NULL) ||
+      (record->delivered))
+  {
+    goto exit_label;
+  }
+  record->delivered = 1;
+
+  pthread_mutex_lock(&evel_spool_mutex);
+  if (delivered)
+  {
+    evel_spool_stats.replayed_posts++;
+    evel_spool_stats.replayed_events += record->num_events;
+  }
+  else
+  {
+    evel_spool_stats.dropped_posts++;
+    evel_spool_stats.dropped_events += record->num_events;
+  }
+  pthread_mutex_unlock(&evel_spool_mutex);
+
+  /***************************************************************************/
+  /* Move the segment's read offset past the records which are done with.    */
+  /***************************************************************************/
+  header = (EVEL_SPOOL_HEADER *) segment->map;
+  while (((int) header->read_offset < segment->write_offset) &&
+         (evel_spool_record_at(segment, header->read_offset)->delivered))
+  {
+    header->read_offset += evel_spool_record_size(
+                 evel_spool_record_at(segment, header->read_offset)->length);
+  }
+  if ((int) header->read_offset >= segment->write_offset)
+  {
+    evel_spool_segment_remove(segment, false);
+  }
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Make sure that a record which failed to be replayed is replayed again.
+ *
+ * @param ref           Reference to the record.
+ *****************************************************************************/
+void evel_spool_rewind(const EVEL_SPOOL_REF * const ref)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(ref != NULL);
+
+  if ((ref->sequence < evel_spool_cursor.sequence) ||
+      ((ref->sequence == evel_spool_cursor.sequence) &&
+       (ref->offset < evel_spool_cursor.offset)))
+  {
+    evel_spool_cursor = *ref;
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the spool statistics.
+ *
+ * @param stats     Pointer to the ::EVEL_SPOOL_STATS to fill in.
+ *****************************************************************************/
+void evel_get_spool_stats(EVEL_SPOOL_STATS * const stats)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(stats != NULL);
+
+  pthread_mutex_lock(&evel_spool_mutex);
+  *stats = evel_spool_stats;
+  pthread_mutex_unlock(&evel_spool_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Calculate the checksum of a record.
+ *
+ * Uses 32-bit FNV-1a.
+ *
+ * @param record        The record header.
+ * @param body          The body of the record.
+ * @returns The checksum.
+ *****************************************************************************/
+static uint32_t evel_spool_checksum(const EVEL_SPOOL_RECORD * const record,
+                                    const char * const body)
+{
+  uint32_t fields[3];
+  const unsigned char * bytes = NULL;
+  uint32_t checksum = 2166136261U;
+  uint32_t ii;
+
+  fields[0] = record->length;
+  fields[1] = record->num_events;
+  fields[2] = record->flags;
+  bytes = (const unsigned char *) fields;
+  for (ii = 0; ii < sizeof(fields); ii++)
+  {
+    checksum = (checksum ^ bytes[ii]) * 16777619U;
+  }
+  bytes = (const unsigned char *) body;
+  for (ii = 0; ii < record->length; ii++)
+  {
+    checksum = (checksum ^ bytes[ii]) * 16777619U;
+  }
+
+  return checksum;
+}
+
+/**************************************************************************//**
+ * Get the space a record takes up in a segment.
+ *
+ * @param length        The length of the body of the record.
+ * @returns The size of the record in bytes.
+ *****************************************************************************/
+static int evel_spool_record_size(const int length)
+{
+  return (sizeof(EVEL_SPOOL_RECORD) + length + 1 + EVEL_SPOOL_ALIGN - 1) &
+         ~(EVEL_SPOOL_ALIGN - 1);
+}
+
+/**************************************************************************//**
+ * Get the record at an offset in a segment, checking that it is complete.
+ *
+ * @param segment       The segment.
+ * @param offset        The offset of the record.
+ * @returns The record, or NULL if there isn't a complete record there.
+ *****************************************************************************/
+static EVEL_SPOOL_RECORD * evel_spool_record_at(
+  const EVEL_SPOOL_SEGMENT * const segment,
+  const int offset)
+{
+  EVEL_SPOOL_RECORD * record = NULL;
+
+  if ((offset < (int) sizeof(EVEL_SPOOL_HEADER)) ||
+      (offset + (int) sizeof(EVEL_SPOOL_RECORD) > segment->size))
+  {
+    goto exit_label;
+  }
+  record = (EVEL_SPOOL_RECORD *) (segment->map + offset);
+  if ((__atomic_load_n(&record->magic, __ATOMIC_ACQUIRE) !=
+       EVEL_SPOOL_RECORD_MAGIC) ||
+      (record->length > (uint32_t) (segment->size - offset)) ||
+      (offset + evel_spool_record_size(record->length) > segment->size) ||
+      (record->checksum != evel_spool_checksum(record,
+                                               (const char *) (record + 1))))
+  {
+    record = NULL;
+  }
+
+exit_label:
+  return record;
+}
+
+/**************************************************************************//**
+ * Find a segment by its sequence number.
+ *
+ * @param sequence      The sequence number.
+ * @returns The segment, or NULL if there is none.
+ *****************************************************************************/
+static EVEL_SPOOL_SEGMENT * evel_spool_segment_find(
+  const unsigned long long sequence)
+{
+  EVEL_SPOOL_SEGMENT * segment = NULL;
+
+  for (segment = evel_spool_head;
+       (segment != NULL) && (segment->sequence != sequence);
+       segment = segment->next)
+  {
+  }
+
+  return segment;
+}
+
+/**************************************************************************//**
+ * Map a segment file left by an earlier process.
+ *
+ * The end of the segment is found by reading its records until one which is
+ * incomplete, or the end of the file.
+ *
+ * @param name          The name of the file in the spool directory.
+ * @returns The segment, or NULL if the file isn't a valid segment.
+ *****************************************************************************/
+static EVEL_SPOOL_SEGMENT * evel_spool_segment_map(const char * const name)
+{
+  EVEL_SPOOL_SEGMENT * segment = NULL;
+  EVEL_SPOOL_HEADER * header = NULL;
+  EVEL_SPOOL_RECORD * record = NULL;
+  char path[PATH_MAX];
+  struct stat file_stat;
+  int fd = -1;
+  char * map = MAP_FAILED;
+
+  EVEL_ENTER();
+
+  snprintf(path, sizeof(path), "%s/%s", evel_spool_directory, name);
+  fd = open(path, O_RDWR);
+  if ((fd < 0) ||
+      (fstat(fd, &file_stat) != 0) ||
+      (file_stat.st_size < (off_t) sizeof(EVEL_SPOOL_HEADER)) ||
+      (file_stat.st_size > (1 << 30)))
+  {
+    EVEL_ERROR("Ignoring unusable spool file %s", path);
+    goto exit_label;
+  }
+  map = mmap(NULL, file_stat.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+             fd, 0);
+  if (map == MAP_FAILED)
+  {
+    EVEL_ERROR("Failed to map spool file %s", path);
+    goto exit_label;
+  }
+  header = (EVEL_SPOOL_HEADER *) map;
+  if ((header->magic != EVEL_SPOOL_MAGIC) ||
+      (header->version != EVEL_SPOOL_VERSION) ||
+      (header->size != file_stat.st_size) ||
+      (header->read_offset < sizeof(EVEL_SPOOL_HEADER)))
+  {
+    EVEL_ERROR("Ignoring invalid spool file %s", path);
+    goto exit_label;
+  }
+
+  segment = malloc(sizeof(EVEL_SPOOL_SEGMENT));
+  assert(segment != NULL);
+  segment->next = NULL;
+  segment->sequence = header->sequence;
+  segment->size = header->size;
+  segment->fd = fd;
+  segment->map = map;
+
+  /***************************************************************************/
+  /* Records before the read offset have all been released.                  */
+  /***************************************************************************/
+  segment->write_offset = header->read_offset;
+  while ((record = evel_spool_record_at(segment,
+                                        segment->write_offset)) != NULL)
+  {
+    segment->write_offset += evel_spool_record_size(record->length);
+  }
+  header->read_offset = min((int) header->read_offset,
+                            segment->write_offset);
+
+  pthread_mutex_lock(&evel_spool_mutex);
+  evel_spool_stats.segments++;
+  evel_spool_stats.bytes += segment->size;
+  pthread_mutex_unlock(&evel_spool_mutex);
+
+exit_label:
+  if (segment == NULL)
+  {
+    if (map != MAP_FAILED)
+    {
+      munmap(map, file_stat.st_size);
+    }
+    if (fd >= 0)
+    {
+      close(fd);
+    }
+  }
+  EVEL_EXIT();
+
+  return segment;
+}
+
+/**************************************************************************//**
+ * Create a new, empty, segment.
+ *
+ * @param size          The size of the segment in bytes.
+ * @returns The segment, or NULL if it couldn't be created.
+ *****************************************************************************/
+static EVEL_SPOOL_SEGMENT * evel_spool_segment_create(const int size)
+{
+  EVEL_SPOOL_SEGMENT * segment = NULL;
+  EVEL_SPOOL_HEADER * header = NULL;
+  char path[PATH_MAX];
+  int fd = -1;
+  char * map = MAP_FAILED;
+
+  EVEL_ENTER();
+
+  evel_spool_path(path, sizeof(path), evel_spool_next_sequence);
+  fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if ((fd < 0) || (ftruncate(fd, size) != 0))
+  {
+    EVEL_ERROR("Failed to create spool file %s", path);
+    goto exit_label;
+  }
+  map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED)
+  {
+    EVEL_ERROR("Failed to map spool file %s", path);
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* The file starts off zeroed, so there are no records in it.              */
+  /***************************************************************************/
+  header = (EVEL_SPOOL_HEADER *) map;
+  header->version = EVEL_SPOOL_VERSION;
+  header->sequence = evel_spool_next_sequence;
+  header->created = time(NULL);
+  header->size = size;
+  header->read_offset = sizeof(EVEL_SPOOL_HEADER);
+  __atomic_store_n(&header->magic, EVEL_SPOOL_MAGIC, __ATOMIC_RELEASE);
+
+  segment = malloc(sizeof(EVEL_SPOOL_SEGMENT));
+  assert(segment != NULL);
+  segment->next = NULL;
+  segment->sequence = evel_spool_next_sequence++;
+  segment->size = size;
+  segment->write_offset = sizeof(EVEL_SPOOL_HEADER);
+  segment->fd = fd;
+  segment->map = map;
+
+  pthread_mutex_lock(&evel_spool_mutex);
+  evel_spool_stats.segments++;
+  evel_spool_stats.bytes += size;
+  pthread_mutex_unlock(&evel_spool_mutex);
+
+exit_label:
+  if (segment == NULL)
+  {
+    if (map != MAP_FAILED)
+    {
+      munmap(map, size);
+    }
+    if (fd >= 0)
+    {
+      close(fd);
+      unlink(path);
+    }
+  }
+  EVEL_EXIT();
+
+  return segment;
+}
+
+/**************************************************************************//**
+ * Add a segment to the list, keeping it in sequence order.
+ *
+ * @param segment       The segment.
+ *****************************************************************************/
+static void evel_spool_segment_insert(EVEL_SPOOL_SEGMENT * const segment)
+{
+  EVEL_SPOOL_SEGMENT ** link = &evel_spool_head;
+
+  while ((*link != NULL) && ((*link)->sequence < segment->sequence))
+  {
+    link = &(*link)->next;
+  }
+  segment->next = *link;
+  *link = segment;
+}
+
+/**************************************************************************//**
+ * Remove a segment from the spool and delete its file.
+ *
+ * @param segment       The segment.
+ * @param drop          Whether the records which haven't been released are
+ *                      being dropped, so should be counted.
+ *****************************************************************************/
+static void evel_spool_segment_remove(EVEL_SPOOL_SEGMENT * const segment,
+                                      const bool drop)
+{
+  EVEL_SPOOL_SEGMENT ** link = &evel_spool_head;
+  EVEL_SPOOL_RECORD * record = NULL;
+  char path[PATH_MAX];
+  int offset = 0;
+
+  EVEL_ENTER();
+
+  while (*link != segment)
+  {
+    assert(*link != NULL);
+    link = &(*link)->next;
+  }
+  *link = segment->next;
+
+  pthread_mutex_lock(&evel_spool_mutex);
+  if (drop)
+  {
+    for (offset = ((EVEL_SPOOL_HEADER *) segment->map)->read_offset;
+         offset < segment->write_offset;
+         offset += evel_spool_record_size(record->length))
+    {
+      record = evel_spool_record_at(segment, offset);
+      if (!record->delivered)
+      {
+        evel_spool_stats.dropped_posts++;
+        evel_spool_stats.dropped_events += record->num_events;
+      }
+    }
+  }
+  evel_spool_stats.segments--;
+  evel_spool_stats.bytes -= segment->size;
+  pthread_mutex_unlock(&evel_spool_mutex);
+
+  evel_spool_path(path, sizeof(path), segment->sequence);
+  munmap(segment->map, segment->size);
+  close(segment->fd);
+  unlink(path);
+  free(segment);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Drop the segments which have been in the spool for longer than the maximum
+ * age.
+ *****************************************************************************/
+static void evel_spool_expire(void)
+{
+  const time_t oldest = time(NULL) - evel_spool_max_age_s;
+
+  while ((evel_spool_head != NULL) &&
+         (((EVEL_SPOOL_HEADER *) evel_spool_head->map)->created < oldest))
+  {
+    EVEL_ERROR("Dropping spool segment %llu which is too old",
+               evel_spool_head->sequence);
+    evel_spool_segment_remove(evel_spool_head, true);
+  }
+}
+
+/**************************************************************************//**
+ * Get the path of a segment file.
+ *
+ * @param path          Filled in with the path.
+ * @param path_size     The size of the path buffer.
+ * @param sequence      The sequence number of the segment.
+ *****************************************************************************/
+static void evel_spool_path(char * const path,
+                            const size_t path_size,
+                            const unsigned long long sequence)
+{
+  snprintf(path, path_size, "%s/evel-%016llx.spool",
+           evel_spool_directory, sequence);
+}
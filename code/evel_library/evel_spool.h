@@ -0,0 +1,79 @@
+#ifndef EVEL_SPOOL_INCLUDED
+#define EVEL_SPOOL_INCLUDED
+
+/**************************************************************************//**
+ * @file
+ * EVEL spool definitions.
+ *
+ * The spool keeps posts which could not be delivered in memory-mapped segment
+ * files on disk, so that they can be replayed once the listener is back.
+ * These are internal definitions, which are required within the library but
+ * are not intended for external consumption.
+ *
+ * @note  No thread protection: the spool is only used by the event handler
+ * thread once the library is running.
+ *
+ * License
+ * -------
+ *
+ * Copyright(c) <2016>, AT&T Intellectual Property.  All other rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:  This product includes
+ *    software developed by the AT&T.
+ * 4. Neither the name of AT&T nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY AT&T INTELLECTUAL PROPERTY ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL AT&T INTELLECTUAL PROPERTY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <stdbool.h>
+
+#include "evel.h"
+
+/**************************************************************************//**
+ * Reference to a record in the spool, which identifies it while it is being
+ * replayed.
+ *****************************************************************************/
+typedef struct evel_spool_ref {
+  unsigned long long sequence;      /** Sequence number of the segment.     */
+  int offset;                       /** Offset of the record in it.         */
+} EVEL_SPOOL_REF;
+
+EVEL_ERR_CODES evel_spool_open(const char * const directory,
+                               const long long max_bytes,
+                               const int max_age_s);
+void evel_spool_close(void);
+bool evel_spool_append(const char * const body,
+                       const int size,
+                       const bool batch,
+                       const int num_events);
+bool evel_spool_pending(void);
+bool evel_spool_next(EVEL_SPOOL_REF * const ref,
+                     const char ** const body,
+                     int * const size,
+                     bool * const batch,
+                     int * const num_events);
+void evel_spool_release(const EVEL_SPOOL_REF * const ref,
+                        const bool delivered);
+void evel_spool_rewind(const EVEL_SPOOL_REF * const ref);
+
+#endif
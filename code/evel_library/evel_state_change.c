@@ -72,13 +72,13 @@ EVENT_STATE_CHANGE * evel_new_state_change(const EVEL_ENTITY_STATE new_state,
   /***************************************************************************/
   /* Allocate the State Change.                                              */
   /***************************************************************************/
-  state_change = malloc(sizeof(EVENT_STATE_CHANGE));
+  state_change = evel_alloc_event(EVEL_DOMAIN_STATE_CHANGE,
+                                  sizeof(EVENT_STATE_CHANGE));
   if (state_change == NULL)
   {
     log_error_state("Out of memory");
     goto exit_label;
   }
-  memset(state_change, 0, sizeof(EVENT_STATE_CHANGE));
   EVEL_DEBUG("New State Change is at %lp", state_change);
 
   /***************************************************************************/
@@ -91,7 +91,8 @@ EVENT_STATE_CHANGE * evel_new_state_change(const EVEL_ENTITY_STATE new_state,
   state_change->minor_version = EVEL_STATE_CHANGE_MINOR_VERSION;
   state_change->new_state = new_state;
   state_change->old_state = old_state;
-  state_change->state_interface = strdup(interface);
+  state_change->state_interface = evel_event_strdup(&state_change->header,
+                                                    interface);
   dlist_initialize(&state_change->additional_fields);
 
 exit_label:
@@ -199,15 +200,18 @@ void evel_state_change_addl_field_add(EVENT_STATE_CHANGE * const state_change,
   assert(value != NULL);
 
   EVEL_DEBUG("Adding name=%s value=%s", name, value);
-  addl_field = malloc(sizeof(STATE_CHANGE_ADDL_FIELD));
+  addl_field = evel_event_malloc(&state_change->header,
+                                 sizeof(STATE_CHANGE_ADDL_FIELD));
   assert(addl_field != NULL);
   memset(addl_field, 0, sizeof(STATE_CHANGE_ADDL_FIELD));
-  addl_field->name = strdup(name);
-  addl_field->value = strdup(value);
+  addl_field->name = evel_event_strdup(&state_change->header, name);
+  addl_field->value = evel_event_strdup(&state_change->header, value);
   assert(addl_field->name != NULL);
   assert(addl_field->value != NULL);
 
-  dlist_push_last(&state_change->additional_fields, addl_field);
+  evel_event_list_push(&state_change->header,
+                       &state_change->additional_fields,
+                       addl_field);
 
   EVEL_EXIT();
 }
@@ -251,7 +255,9 @@ void evel_json_encode_state_change(EVEL_JSON_BUFFER * jbuf,
   /* Optional fields.                                                        */
   /***************************************************************************/
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "additionalFields"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_ADDITIONAL_FIELDS,
+                                    "additionalFields"))
   {
     bool item_added = false;
 
@@ -262,6 +268,7 @@ void evel_json_encode_state_change(EVEL_JSON_BUFFER * jbuf,
       assert(addl_field != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_ADDITIONAL_FIELDS,
                                           "additionalFields",
                                           addl_field->name))
       {
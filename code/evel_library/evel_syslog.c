@@ -70,13 +70,12 @@ EVENT_SYSLOG * evel_new_syslog(EVEL_SOURCE_TYPES event_source_type,
   /***************************************************************************/
   /* Allocate the Syslog.                                                    */
   /***************************************************************************/
-  syslog = malloc(sizeof(EVENT_SYSLOG));
+  syslog = evel_alloc_event(EVEL_DOMAIN_SYSLOG, sizeof(EVENT_SYSLOG));
   if (syslog == NULL)
   {
     log_error_state("Out of memory");
     goto exit_label;
   }
-  memset(syslog, 0, sizeof(EVENT_SYSLOG));
   EVEL_DEBUG("New Syslog is at %lp", syslog);
 
   /***************************************************************************/
@@ -88,8 +87,8 @@ EVENT_SYSLOG * evel_new_syslog(EVEL_SOURCE_TYPES event_source_type,
   syslog->major_version = EVEL_SYSLOG_MAJOR_VERSION;
   syslog->minor_version = EVEL_SYSLOG_MINOR_VERSION;
   syslog->event_source_type = event_source_type;
-  syslog->syslog_msg = strdup(syslog_msg);
-  syslog->syslog_tag = strdup(syslog_tag);
+  syslog->syslog_msg = evel_event_strdup(&syslog->header, syslog_msg);
+  syslog->syslog_tag = evel_event_strdup(&syslog->header, syslog_tag);
   evel_init_option_int(&syslog->syslog_facility);
   evel_init_option_int(&syslog->syslog_proc_id);
   evel_init_option_int(&syslog->syslog_ver);
@@ -159,9 +158,10 @@ void evel_syslog_addl_filter_set(EVENT_SYSLOG * syslog,
   assert(syslog->header.event_domain == EVEL_DOMAIN_SYSLOG);
   assert(filter != NULL);
 
-  evel_set_option_string(&syslog->additional_filters,
-                         filter,
-                         "Syslog filter string");
+  evel_event_set_option_string(&syslog->header,
+                               &syslog->additional_filters,
+                               filter,
+                               "Syslog filter string");
 
   EVEL_EXIT();
 }
@@ -190,9 +190,10 @@ void evel_syslog_event_source_host_set(EVENT_SYSLOG * syslog,
   assert(syslog->header.event_domain == EVEL_DOMAIN_SYSLOG);
   assert(host != NULL);
 
-  evel_set_option_string(&syslog->event_source_host,
-                         host,
-                         "Event Source Host");
+  evel_event_set_option_string(&syslog->header,
+                               &syslog->event_source_host,
+                               host,
+                               "Event Source Host");
   EVEL_EXIT();
 }
 
@@ -248,7 +249,10 @@ void evel_syslog_proc_set(EVENT_SYSLOG * syslog, const char * const proc)
   assert(syslog->header.event_domain == EVEL_DOMAIN_SYSLOG);
   assert(proc != NULL);
 
-  evel_set_option_string(&syslog->syslog_proc, proc, "Process");
+  evel_event_set_option_string(&syslog->header,
+                               &syslog->syslog_proc,
+                               proc,
+                               "Process");
   EVEL_EXIT();
 }
 
@@ -331,9 +335,10 @@ void evel_syslog_s_data_set(EVENT_SYSLOG * syslog, const char * const s_data)
   assert(syslog->header.event_domain == EVEL_DOMAIN_SYSLOG);
   assert(s_data != NULL);
 
-  evel_set_option_string(&syslog->syslog_s_data,
-                         s_data,
-                         "Structured Data");
+  evel_event_set_option_string(&syslog->header,
+                               &syslog->syslog_s_data,
+                               s_data,
+                               "Structured Data");
   EVEL_EXIT();
 }
 
@@ -360,9 +365,10 @@ void evel_syslog_sdid_set(EVENT_SYSLOG * syslog, const char * const sdid)
   assert(syslog->header.event_domain == EVEL_DOMAIN_SYSLOG);
   assert(sdid != NULL);
 
-  evel_set_option_string(&syslog->syslog_sdid,
-                         sdid,
-                         "SdId set");
+  evel_event_set_option_string(&syslog->header,
+                               &syslog->syslog_sdid,
+                               sdid,
+                               "SdId set");
   EVEL_EXIT();
 }
 
@@ -393,9 +399,10 @@ void evel_syslog_severity_set(EVENT_SYSLOG * syslog, const char * const severty)
       !strcmp(severty,"Emergency") || !strcmp(severty,"Error") || !strcmp(severty,"Info") ||
       !strcmp(severty,"Notice") || !strcmp(severty,"Warning") )
   {
-     evel_set_option_string(&syslog->syslog_severity,
-                         severty,
-                         "Severity set");
+     evel_event_set_option_string(&syslog->header,
+                                  &syslog->syslog_severity,
+                                  severty,
+                                  "Severity set");
   }
   EVEL_EXIT();
 }
@@ -424,7 +431,10 @@ void evel_json_encode_syslog(EVEL_JSON_BUFFER * jbuf,
   evel_json_encode_header(jbuf, &event->header);
   evel_json_open_named_object(jbuf, "syslogFields");
 
-  evel_enc_kv_opt_string(jbuf, "additionalFields", &event->additional_filters);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_ADDITIONAL_FIELDS,
+                         "additionalFields",
+                         &event->additional_filters);
   /***************************************************************************/
   /* Mandatory fields                                                        */
   /***************************************************************************/
@@ -437,15 +447,42 @@ void evel_json_encode_syslog(EVEL_JSON_BUFFER * jbuf,
   /***************************************************************************/
   /* Optional fields                                                         */
   /***************************************************************************/
-  evel_enc_kv_opt_string(jbuf, "eventSourceHost", &event->event_source_host);
-  evel_enc_kv_opt_int(jbuf, "syslogFacility", &event->syslog_facility);
-  evel_enc_kv_opt_int(jbuf, "syslogPri", &event->syslog_priority);
-  evel_enc_kv_opt_string(jbuf, "syslogProc", &event->syslog_proc);
-  evel_enc_kv_opt_int(jbuf, "syslogProcId", &event->syslog_proc_id);
-  evel_enc_kv_opt_string(jbuf, "syslogSData", &event->syslog_s_data);
-  evel_enc_kv_opt_string(jbuf, "syslogSdId", &event->syslog_sdid);
-  evel_enc_kv_opt_string(jbuf, "syslogSev", &event->syslog_severity);
-  evel_enc_kv_opt_int(jbuf, "syslogVer", &event->syslog_ver);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_EVENT_SOURCE_HOST,
+                         "eventSourceHost",
+                         &event->event_source_host);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_SYSLOG_FACILITY,
+                      "syslogFacility",
+                      &event->syslog_facility);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_SYSLOG_PRI,
+                      "syslogPri",
+                      &event->syslog_priority);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_SYSLOG_PROC,
+                         "syslogProc",
+                         &event->syslog_proc);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_SYSLOG_PROC_ID,
+                      "syslogProcId",
+                      &event->syslog_proc_id);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_SYSLOG_S_DATA,
+                         "syslogSData",
+                         &event->syslog_s_data);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_SYSLOG_SD_ID,
+                         "syslogSdId",
+                         &event->syslog_sdid);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_SYSLOG_SEV,
+                         "syslogSev",
+                         &event->syslog_severity);
+  evel_enc_kv_opt_int(jbuf,
+                      EVEL_FIELD_SYSLOG_VER,
+                      "syslogVer",
+                      &event->syslog_ver);
   evel_json_close_object(jbuf);
 
   EVEL_CT_ASSERT(EVEL_SYSLOG_FACILITY_KERNEL == 0);
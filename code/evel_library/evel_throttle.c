@@ -43,7 +43,6 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <pthread.h>
-#include <search.h>
 
 #include "evel_throttle.h"
 
@@ -53,9 +52,58 @@
 /*                                                                           */
 /* A given domain is in a throttled state if ::evel_throttle_spec is         */
 /* non-NULL.                                                                 */
+/*                                                                           */
+/* Encoding threads read the specifications without taking any lock, so a    */
+/* specification is replaced by swapping the pointer and the old one is only */
+/* freed once no reader can still be using it.  Readers announce the epoch   */
+/* in which they started reading in their ::EVEL_THROTTLE_READER; each       */
+/* replaced specification is retired with the epoch in which it was          */
+/* replaced, and freed once every active reader started in a later epoch.    */
 /*****************************************************************************/
 static EVEL_THROTTLE_SPEC * evel_throttle_spec[EVEL_MAX_DOMAINS];
 
+/*****************************************************************************/
+/* Incremented each time the specification for a domain is replaced.         */
+/*****************************************************************************/
+static unsigned long evel_throttle_generations[EVEL_MAX_DOMAINS];
+
+/**************************************************************************//**
+ * A thread which reads throttle specifications.  Records are reused by new
+ * threads once their thread exits, and are never freed.
+ *****************************************************************************/
+typedef struct evel_throttle_reader
+{
+  struct evel_throttle_reader * next;
+  unsigned long epoch;
+  int nesting;
+  bool in_use;
+} EVEL_THROTTLE_READER;
+
+/**************************************************************************//**
+ * A replaced throttle specification waiting to be freed.
+ *****************************************************************************/
+typedef struct evel_throttle_retired
+{
+  struct evel_throttle_retired * next;
+  EVEL_THROTTLE_SPEC * throttle_spec;
+  unsigned long epoch;
+} EVEL_THROTTLE_RETIRED;
+
+/*****************************************************************************/
+/* The current epoch, which is never 0 since readers announce 0 when they    */
+/* are not reading, and the list of all reader records.                      */
+/*****************************************************************************/
+static unsigned long evel_throttle_epoch = 1;
+static EVEL_THROTTLE_READER * evel_throttle_readers = NULL;
+static pthread_key_t evel_throttle_reader_key;
+static pthread_once_t evel_throttle_reader_once = PTHREAD_ONCE_INIT;
+
+/*****************************************************************************/
+/* Retired specifications, and the mutex serializing updates.                */
+/*****************************************************************************/
+static EVEL_THROTTLE_RETIRED * evel_throttle_retired = NULL;
+static pthread_mutex_t evel_throttle_update_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /*****************************************************************************/
 /* The current measurement interval.  Default: MEASUREMENT_INTERVAL_UKNOWN.  */
 /* Must be protected by evel_measurement_interval_mutex.                     */
@@ -151,11 +199,192 @@ static const char * evel_domain_strings[EVEL_MAX_DOMAINS] = {
   "maxDomain"
 };
 
+/*****************************************************************************/
+/* The JSON names of the fields throttling can suppress, indexed by          */
+/* ::EVEL_THROTTLE_FIELDS, in strcmp order so they can be binary searched.   */
+/*****************************************************************************/
+static const char * const
+                       evel_throttle_field_names[EVEL_MAX_THROTTLE_FIELDS] = {
+  "additionalFields",
+  "additionalInformation",
+  "additionalMeasurements",
+  "alarmAdditionalInformation",
+  "alarmInterfaceA",
+  "appProtocolType",
+  "appProtocolVersion",
+  "applicationType",
+  "cid",
+  "codecUsageArray",
+  "compressedSip",
+  "concurrentSessions",
+  "configuredEntities",
+  "connectionType",
+  "correlator",
+  "cpuIdle",
+  "cpuUsageArray",
+  "cpuUsageInterrupt",
+  "cpuUsageNice",
+  "cpuUsageSoftIrq",
+  "cpuUsageSteal",
+  "cpuUsageSystem",
+  "cpuUsageUser",
+  "cpuWait",
+  "diskIoTimeAvg",
+  "diskIoTimeLast",
+  "diskIoTimeMax",
+  "diskIoTimeMin",
+  "diskMergedReadAvg",
+  "diskMergedReadLast",
+  "diskMergedReadMax",
+  "diskMergedReadMin",
+  "diskMergedWriteAvg",
+  "diskMergedWriteLast",
+  "diskMergedWriteMax",
+  "diskMergedWriteMin",
+  "diskOctetsReadAvg",
+  "diskOctetsReadLast",
+  "diskOctetsReadMax",
+  "diskOctetsReadMin",
+  "diskOctetsWriteAvg",
+  "diskOctetsWriteLast",
+  "diskOctetsWriteMax",
+  "diskOctetsWriteMin",
+  "diskOpsReadAvg",
+  "diskOpsReadLast",
+  "diskOpsReadMax",
+  "diskOpsReadMin",
+  "diskOpsWriteAvg",
+  "diskOpsWriteLast",
+  "diskOpsWriteMax",
+  "diskOpsWriteMin",
+  "diskPendingOperationsAvg",
+  "diskPendingOperationsLast",
+  "diskPendingOperationsMax",
+  "diskPendingOperationsMin",
+  "diskTimeReadAvg",
+  "diskTimeReadLast",
+  "diskTimeReadMax",
+  "diskTimeReadMin",
+  "diskTimeWriteAvg",
+  "diskTimeWriteLast",
+  "diskTimeWriteMax",
+  "diskTimeWriteMin",
+  "diskUsageArray",
+  "durConnectionFailedStatus",
+  "durTunnelFailedStatus",
+  "ecgi",
+  "endOfCallVqmSummaries",
+  "endpointJitter",
+  "endpointRtpOctetsDiscarded",
+  "endpointRtpOctetsReceived",
+  "endpointRtpOctetsSent",
+  "endpointRtpPacketsDiscarded",
+  "endpointRtpPacketsReceived",
+  "endpointRtpPacketsSent",
+  "errors",
+  "eventCategory",
+  "eventSourceHost",
+  "eventType",
+  "featureUsageArray",
+  "filesystemUsageArray",
+  "flowActivatedBy",
+  "flowActivationTime",
+  "flowDeactivatedBy",
+  "gtpConnectionStatus",
+  "gtpProtocolType",
+  "gtpTunnelStatus",
+  "gtpVersion",
+  "hashOfNameValuePairArrays",
+  "highEndOfLatencyBucket",
+  "httpHeader",
+  "imei",
+  "imsi",
+  "jsonObjects",
+  "keyOrder",
+  "keyValue",
+  "lac",
+  "largePacketRtt",
+  "largePacketThreshold",
+  "latencyDistribution",
+  "localIpAddress",
+  "localJitter",
+  "localPort",
+  "localRtpOctetsDiscarded",
+  "localRtpOctetsReceived",
+  "localRtpOctetsSent",
+  "localRtpPacketsDiscarded",
+  "localRtpPacketsReceived",
+  "localRtpPacketsSent",
+  "lowEndOfLatencyBucket",
+  "maxReceiveBitRate",
+  "maxTransmitBitRate",
+  "mcc",
+  "meanRequestLatency",
+  "measurements",
+  "memoryCached",
+  "memoryConfigured",
+  "memoryFree",
+  "memorySlabRecl",
+  "memorySlabUnrecl",
+  "memoryUsageArray",
+  "memoryUsed",
+  "mnc",
+  "mosCqe",
+  "msisdn",
+  "nameValuePairs",
+  "nfNamingCode",
+  "nfSubscribedObjectName",
+  "nfSubscriptionId",
+  "nfcNamingCode",
+  "numGtpEchoFailures",
+  "numGtpTunnelErrors",
+  "numHttpErrors",
+  "numberOfMediaPortsInUse",
+  "objectInstances",
+  "objectKeys",
+  "objectSchema",
+  "objectSchemaUrl",
+  "otherFunctionalRole",
+  "packetLossPercent",
+  "packetsLost",
+  "phoneNumber",
+  "rFactor",
+  "rac",
+  "radioAccessTechnology",
+  "remoteIpAddress",
+  "remotePort",
+  "reportingEntityId",
+  "requestRate",
+  "roundTripDelay",
+  "sac",
+  "samplingAlgorithm",
+  "sourceId",
+  "summarySip",
+  "syslogFacility",
+  "syslogPri",
+  "syslogProc",
+  "syslogProcId",
+  "syslogSData",
+  "syslogSdId",
+  "syslogSev",
+  "syslogVer",
+  "tac",
+  "tunnelId",
+  "vNicPerformanceArray",
+  "vNicUsageArray",
+  "version",
+  "vfModuleName",
+  "vlanId",
+  "vnfName",
+  "vnfcScalingMetric"
+};
+
 /*****************************************************************************/
 /* Local prototypes.                                                         */
 /*****************************************************************************/
 static void evel_throttle_finalize(EVEL_THROTTLE_SPEC * throttle_spec);
-static struct hsearch_data * evel_throttle_hash_create(DLIST * hash_keys);
+static void evel_throttle_hash_create(HASH_MAP * hash_table,
+                                      DLIST * hash_keys);
 static void evel_throttle_free(EVEL_THROTTLE_SPEC * throttle_spec);
 static void evel_throttle_free_nv_pair(EVEL_SUPPRESSED_NV_PAIRS * nv_pairs);
 static void evel_init_json_stack(EVEL_JSON_STACK * json_stack,
@@ -197,6 +426,20 @@ static void evel_store_nv_pair_field_name(char * const value);
 static void evel_store_nv_pair_name(char * const item);
 static void evel_store_suppressed_field_name(char * const item);
 static EVEL_SUPPRESSED_NV_PAIRS * evel_get_last_nv_pairs();
+static EVEL_THROTTLE_READER * evel_throttle_reader(void);
+static void evel_throttle_reader_key_create(void);
+static void evel_throttle_reader_exit(void * reader);
+static void evel_throttle_publish(const EVEL_EVENT_DOMAINS domain,
+                                  EVEL_THROTTLE_SPEC * const throttle_spec);
+static void evel_throttle_reclaim(const bool all);
+static EVEL_THROTTLE_FIELDS evel_throttle_field_search(
+                                                const char * const field_name);
+static bool evel_throttle_field_suppressed(
+  const EVEL_THROTTLE_SPEC * const throttle_spec,
+  const EVEL_THROTTLE_FIELDS field);
+static bool evel_throttle_nv_pair_name_suppressed(
+  const EVEL_SUPPRESSED_NV_PAIRS * const nv_pairs,
+  const char * const name);
 
 /**************************************************************************//**
  * Return the current measurement interval provided by the Event Listener.
@@ -223,9 +466,53 @@ int evel_get_measurement_interval()
   return result;
 }
 
+/**************************************************************************//**
+ * Start reading throttle specifications.
+ *
+ * Any specification returned by ::evel_get_throttle_spec remains valid until
+ * the matching ::evel_throttle_read_end.  Reading never waits for updates.
+ * Calls may be nested.
+ *****************************************************************************/
+void evel_throttle_read_begin(void)
+{
+  EVEL_THROTTLE_READER * reader = evel_throttle_reader();
+
+  if ((reader != NULL) && (reader->nesting++ == 0))
+  {
+    /*************************************************************************/
+    /* Announce the epoch before reading any pointer, and make sure the      */
+    /* announcement is visible to updaters before the pointers are read.     */
+    /*************************************************************************/
+    __atomic_store_n(&reader->epoch,
+                     __atomic_load_n(&evel_throttle_epoch, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  }
+}
+
+/**************************************************************************//**
+ * Finish reading throttle specifications.
+ *****************************************************************************/
+void evel_throttle_read_end(void)
+{
+  EVEL_THROTTLE_READER * reader = evel_throttle_reader();
+
+  if (reader != NULL)
+  {
+    assert(reader->nesting > 0);
+    if (--reader->nesting == 0)
+    {
+      __atomic_store_n(&reader->epoch, 0, __ATOMIC_RELEASE);
+    }
+  }
+}
+
 /**************************************************************************//**
  * Return the ::EVEL_THROTTLE_SPEC for a given domain.
  *
+ * Must be called between ::evel_throttle_read_begin and
+ * ::evel_throttle_read_end, and the result not used after the latter.
+ *
  * @param domain        The domain for which to return state.
  *****************************************************************************/
 EVEL_THROTTLE_SPEC * evel_get_throttle_spec(EVEL_EVENT_DOMAINS domain)
@@ -239,21 +526,238 @@ EVEL_THROTTLE_SPEC * evel_get_throttle_spec(EVEL_EVENT_DOMAINS domain)
   /***************************************************************************/
   assert(domain < EVEL_MAX_DOMAINS);
 
-  result = evel_throttle_spec[domain];
+  result = __atomic_load_n(&evel_throttle_spec[domain], __ATOMIC_ACQUIRE);
 
   EVEL_EXIT();
 
   return result;
 }
 
+/**************************************************************************//**
+ * Get the calling thread's reader record, taking one on first use.
+ *
+ * @returns Pointer to the record, or NULL if one could not be allocated, in
+ *          which case the thread reads without protection.
+ *****************************************************************************/
+static EVEL_THROTTLE_READER * evel_throttle_reader(void)
+{
+  EVEL_THROTTLE_READER * reader = NULL;
+  bool unused = false;
+
+  pthread_once(&evel_throttle_reader_once, evel_throttle_reader_key_create);
+  reader = pthread_getspecific(evel_throttle_reader_key);
+  if (reader != NULL)
+  {
+    return reader;
+  }
+
+  /***************************************************************************/
+  /* Reuse the record of a thread which has exited, if there is one.         */
+  /***************************************************************************/
+  for (reader = __atomic_load_n(&evel_throttle_readers, __ATOMIC_ACQUIRE);
+       reader != NULL;
+       reader = reader->next)
+  {
+    unused = false;
+    if (__atomic_compare_exchange_n(&reader->in_use, &unused, true, false,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      break;
+    }
+  }
+
+  if (reader == NULL)
+  {
+    reader = calloc(1, sizeof(EVEL_THROTTLE_READER));
+    if (reader == NULL)
+    {
+      log_error_state("Failed to allocate throttle reader");
+      return NULL;
+    }
+    reader->in_use = true;
+    reader->next = __atomic_load_n(&evel_throttle_readers, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&evel_throttle_readers,
+                                        &reader->next,
+                                        reader,
+                                        true,
+                                        __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED))
+    {
+    }
+  }
+
+  pthread_setspecific(evel_throttle_reader_key, reader);
+  return reader;
+}
+
+/**************************************************************************//**
+ * Create the key to each thread's reader record.
+ *****************************************************************************/
+static void evel_throttle_reader_key_create(void)
+{
+  pthread_key_create(&evel_throttle_reader_key, evel_throttle_reader_exit);
+}
+
+/**************************************************************************//**
+ * Release a thread's reader record as the thread exits.
+ *
+ * @param reader        Pointer to the ::EVEL_THROTTLE_READER.
+ *****************************************************************************/
+static void evel_throttle_reader_exit(void * reader)
+{
+  EVEL_THROTTLE_READER * const thread_reader = reader;
+
+  thread_reader->nesting = 0;
+  __atomic_store_n(&thread_reader->epoch, 0, __ATOMIC_RELEASE);
+  __atomic_store_n(&thread_reader->in_use, false, __ATOMIC_RELEASE);
+}
+
+/**************************************************************************//**
+ * Replace the throttle specification for a domain.
+ *
+ * The previous specification is retired, and freed once no reader can still
+ * be using it.
+ *
+ * @param domain        The domain.
+ * @param throttle_spec The new specification, or NULL to stop throttling.
+ *****************************************************************************/
+static void evel_throttle_publish(const EVEL_EVENT_DOMAINS domain,
+                                  EVEL_THROTTLE_SPEC * const throttle_spec)
+{
+  EVEL_THROTTLE_SPEC * old_spec = NULL;
+  EVEL_THROTTLE_RETIRED * retired = NULL;
+
+  EVEL_ENTER();
+
+  pthread_mutex_lock(&evel_throttle_update_mutex);
+  old_spec = __atomic_exchange_n(&evel_throttle_spec[domain],
+                                 throttle_spec,
+                                 __ATOMIC_ACQ_REL);
+  __atomic_fetch_add(&evel_throttle_generations[domain], 1, __ATOMIC_RELEASE);
+  if (old_spec != NULL)
+  {
+    retired = malloc(sizeof(EVEL_THROTTLE_RETIRED));
+    if (retired == NULL)
+    {
+      /***********************************************************************/
+      /* Without memory to track it, leaking the old specification is the    */
+      /* only safe thing to do.                                              */
+      /***********************************************************************/
+      log_error_state("Failed to retire throttle spec");
+    }
+    else
+    {
+      retired->throttle_spec = old_spec;
+      retired->epoch = __atomic_fetch_add(&evel_throttle_epoch,
+                                          1,
+                                          __ATOMIC_SEQ_CST);
+      retired->next = evel_throttle_retired;
+      evel_throttle_retired = retired;
+    }
+  }
+  evel_throttle_reclaim(false);
+  pthread_mutex_unlock(&evel_throttle_update_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Free retired throttle specifications which no reader can be using.
+ *
+ * Must be called with ::evel_throttle_update_mutex held.
+ *
+ * @param all           true to free every retired specification, when there
+ *                      can be no readers.
+ *****************************************************************************/
+static void evel_throttle_reclaim(const bool all)
+{
+  unsigned long oldest = ULONG_MAX;
+  unsigned long epoch;
+  EVEL_THROTTLE_READER * reader = NULL;
+  EVEL_THROTTLE_RETIRED ** link = NULL;
+  EVEL_THROTTLE_RETIRED * retired = NULL;
+
+  /***************************************************************************/
+  /* Find the oldest epoch in which any active reader started.               */
+  /***************************************************************************/
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  for (reader = __atomic_load_n(&evel_throttle_readers, __ATOMIC_ACQUIRE);
+       reader != NULL && !all;
+       reader = reader->next)
+  {
+    epoch = __atomic_load_n(&reader->epoch, __ATOMIC_ACQUIRE);
+    if ((epoch != 0) && (epoch < oldest))
+    {
+      oldest = epoch;
+    }
+  }
+
+  /***************************************************************************/
+  /* Free everything retired before then.                                    */
+  /***************************************************************************/
+  link = &evel_throttle_retired;
+  while (*link != NULL)
+  {
+    retired = *link;
+    if (retired->epoch < oldest)
+    {
+      *link = retired->next;
+      evel_throttle_free(retired->throttle_spec);
+      free(retired);
+    }
+    else
+    {
+      link = &retired->next;
+    }
+  }
+}
+
+/**************************************************************************//**
+ * Find the ::EVEL_THROTTLE_FIELDS with a given name.
+ *
+ * @param field_name    The field name.
+ * @returns The field, or ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
+ *****************************************************************************/
+static EVEL_THROTTLE_FIELDS evel_throttle_field_search(
+                                                 const char * const field_name)
+{
+  int low = 0;
+  int high = EVEL_MAX_THROTTLE_FIELDS - 1;
+  int middle;
+  int compare;
+
+  while (low <= high)
+  {
+    middle = (low + high) / 2;
+    compare = strcmp(field_name, evel_throttle_field_names[middle]);
+    if (compare == 0)
+    {
+      return middle;
+    }
+    if (compare < 0)
+    {
+      high = middle - 1;
+    }
+    else
+    {
+      low = middle + 1;
+    }
+  }
+
+  return EVEL_MAX_THROTTLE_FIELDS;
+}
+
 /**************************************************************************//**
  * Determine whether a field_name should be suppressed.
  *
  * @param throttle_spec Throttle specification for the domain being encoded.
+ * @param field         The ::EVEL_THROTTLE_FIELDS being encoded, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param field_name    The field name to encoded or suppress.
  * @return true if the field_name should be suppressed, false otherwise.
  *****************************************************************************/
 bool evel_throttle_suppress_field(EVEL_THROTTLE_SPEC * throttle_spec,
+                                  const EVEL_THROTTLE_FIELDS field,
                                   const char * const field_name)
 {
   bool suppress = false;
@@ -263,20 +767,24 @@ bool evel_throttle_suppress_field(EVEL_THROTTLE_SPEC * throttle_spec,
   /***************************************************************************/
   /* Check preconditions.                                                    */
   /***************************************************************************/
+  assert(field <= EVEL_MAX_THROTTLE_FIELDS);
   assert(field_name != NULL);
 
-  /***************************************************************************/
-  /* If the throttle spec and hash table exist, query the field_names table. */
-  /***************************************************************************/
-  if ((throttle_spec != NULL) && (throttle_spec->hash_field_names != NULL))
+  if (throttle_spec != NULL)
   {
-    ENTRY hash_query;
-    ENTRY * hash_result;
-    hash_query.key = (char * const) field_name;
-    suppress = (hsearch_r(hash_query,
-                          FIND,
-                          &hash_result,
-                          throttle_spec->hash_field_names) != 0);
+    /*************************************************************************/
+    /* Known fields are suppressed if their bit is set.  Only the names of   */
+    /* others need looking up in the hash table, if there are any.           */
+    /*************************************************************************/
+    if (field < EVEL_MAX_THROTTLE_FIELDS)
+    {
+      suppress = evel_throttle_field_suppressed(throttle_spec, field);
+    }
+    else if (throttle_spec->unknown_field_names)
+    {
+      suppress = (hash_map_get(&throttle_spec->hash_field_names,
+                               field_name) != NULL);
+    }
   }
 
   EVEL_EXIT();
@@ -288,16 +796,18 @@ bool evel_throttle_suppress_field(EVEL_THROTTLE_SPEC * throttle_spec,
  * Determine whether a name-value pair should be allowed (not suppressed).
  *
  * @param throttle_spec Throttle specification for the domain being encoded.
+ * @param field         The ::EVEL_THROTTLE_FIELDS holding the name-value
+ *                      pairs, or ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param field_name    The field name holding the name-value pairs.
  * @param name          The name of the name-value pair to encoded or suppress.
  * @return true if the name-value pair should be suppressed, false otherwise.
  *****************************************************************************/
 bool evel_throttle_suppress_nv_pair(EVEL_THROTTLE_SPEC * throttle_spec,
+                                    const EVEL_THROTTLE_FIELDS field,
                                     const char * const field_name,
                                     const char * const name)
 {
-  EVEL_SUPPRESSED_NV_PAIRS * nv_pairs;
-  bool hit = false;
+  EVEL_SUPPRESSED_NV_PAIRS * nv_pairs = NULL;
   bool suppress = false;
 
   EVEL_ENTER();
@@ -305,47 +815,152 @@ bool evel_throttle_suppress_nv_pair(EVEL_THROTTLE_SPEC * throttle_spec,
   /***************************************************************************/
   /* Check preconditions.                                                    */
   /***************************************************************************/
+  assert(field <= EVEL_MAX_THROTTLE_FIELDS);
   assert(field_name != NULL);
   assert(name != NULL);
 
   /***************************************************************************/
-  /* If the throttle spec and hash table exist, query the nv_pairs table.    */
+  /* Find the nv_pairs for the field: directly for known fields, otherwise   */
+  /* from the hash table, if there are any others.                           */
   /***************************************************************************/
-  if ((throttle_spec != NULL) && (throttle_spec->hash_nv_pairs_list != NULL))
+  if (throttle_spec != NULL)
   {
-    ENTRY hash_query;
-    ENTRY * hash_result;
-    hash_query.key = (char * const) field_name;
-    hit = (hsearch_r(hash_query,
-                     FIND,
-                     &hash_result,
-                     throttle_spec->hash_nv_pairs_list) != 0);
-    if (hit)
+    if (field < EVEL_MAX_THROTTLE_FIELDS)
+    {
+      nv_pairs = throttle_spec->field_nv_pairs[field];
+    }
+    else if (throttle_spec->unknown_nv_pair_fields)
     {
-      nv_pairs = hash_result->data;
+      nv_pairs = hash_map_get(&throttle_spec->hash_nv_pairs_list, field_name);
     }
   }
 
+  suppress = evel_throttle_nv_pair_name_suppressed(nv_pairs, name);
+
+  EVEL_EXIT();
+
+  return suppress;
+}
+
+/**************************************************************************//**
+ * Determine whether a known field is suppressed.
+ *
+ * @param throttle_spec Throttle specification for the domain.
+ * @param field         The field.
+ * @return true if the field is suppressed, false otherwise.
+ *****************************************************************************/
+static bool evel_throttle_field_suppressed(
+  const EVEL_THROTTLE_SPEC * const throttle_spec,
+  const EVEL_THROTTLE_FIELDS field)
+{
+  return (throttle_spec->suppressed_fields[
+            field / EVEL_THROTTLE_FIELD_WORD_BITS] >>
+          (field % EVEL_THROTTLE_FIELD_WORD_BITS)) & 1;
+}
+
+/**************************************************************************//**
+ * Determine whether a name is among a field's suppressed name-value pairs.
+ *
+ * @param nv_pairs      The suppressed name-value pairs for the field, or NULL
+ *                      if none of them are suppressed.
+ * @param name          The name of the name-value pair.
+ * @return true if the name-value pair is suppressed, false otherwise.
+ *****************************************************************************/
+static bool evel_throttle_nv_pair_name_suppressed(
+  const EVEL_SUPPRESSED_NV_PAIRS * const nv_pairs,
+  const char * const name)
+{
+  return (nv_pairs != NULL) &&
+         (hash_map_get(&nv_pairs->hash_nv_pair_names, name) != NULL);
+}
+
+/**************************************************************************//**
+ * Determine whether throttling currently suppresses a field.
+ *
+ * @param domain        The domain of the event being built.
+ * @param field         The field.
+ * @returns true if the field is suppressed, false otherwise.
+ *****************************************************************************/
+bool evel_is_field_suppressed(const EVEL_EVENT_DOMAINS domain,
+                              const EVEL_THROTTLE_FIELDS field)
+{
+  EVEL_THROTTLE_SPEC * throttle_spec = NULL;
+  bool suppress = false;
+
+  EVEL_ENTER();
+
   /***************************************************************************/
-  /* If we got a hit, and the nv_pairs and hash table exist, query the       */
-  /* nv_pairs table.                                                         */
+  /* Check preconditions.                                                    */
   /***************************************************************************/
-  if (hit && (nv_pairs != NULL) && (nv_pairs->hash_nv_pair_names != NULL))
+  assert(domain < EVEL_MAX_DOMAINS);
+  assert(field < EVEL_MAX_THROTTLE_FIELDS);
+
+  evel_throttle_read_begin();
+  throttle_spec = evel_get_throttle_spec(domain);
+  if (throttle_spec != NULL)
   {
-    ENTRY hash_query;
-    ENTRY * hash_result;
-    hash_query.key = (char * const) name;
-    suppress = (hsearch_r(hash_query,
-                          FIND,
-                          &hash_result,
-                          nv_pairs->hash_nv_pair_names) != 0);
+    suppress = evel_throttle_field_suppressed(throttle_spec, field);
   }
+  evel_throttle_read_end();
 
   EVEL_EXIT();
 
   return suppress;
 }
 
+/**************************************************************************//**
+ * Determine whether throttling currently suppresses a name-value pair.
+ *
+ * @param domain        The domain of the event being built.
+ * @param field         The field holding the name-value pairs.
+ * @param name          The name of the name-value pair.
+ * @returns true if the name-value pair is suppressed, false otherwise.
+ *****************************************************************************/
+bool evel_is_nv_pair_suppressed(const EVEL_EVENT_DOMAINS domain,
+                                const EVEL_THROTTLE_FIELDS field,
+                                const char * const name)
+{
+  EVEL_THROTTLE_SPEC * throttle_spec = NULL;
+  bool suppress = false;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(domain < EVEL_MAX_DOMAINS);
+  assert(field < EVEL_MAX_THROTTLE_FIELDS);
+  assert(name != NULL);
+
+  evel_throttle_read_begin();
+  throttle_spec = evel_get_throttle_spec(domain);
+  if (throttle_spec != NULL)
+  {
+    suppress = evel_throttle_nv_pair_name_suppressed(
+                                        throttle_spec->field_nv_pairs[field],
+                                        name);
+  }
+  evel_throttle_read_end();
+
+  EVEL_EXIT();
+
+  return suppress;
+}
+
+/**************************************************************************//**
+ * Return the throttling generation for a domain.
+ *
+ * @param domain        The domain.
+ * @returns The current generation.
+ *****************************************************************************/
+unsigned long evel_throttle_generation(const EVEL_EVENT_DOMAINS domain)
+{
+  assert(domain < EVEL_MAX_DOMAINS);
+
+  return __atomic_load_n(&evel_throttle_generations[domain],
+                         __ATOMIC_ACQUIRE);
+}
+
 /**************************************************************************//**
  * Initialize event throttling to the default state.
  *
@@ -360,7 +975,7 @@ void evel_throttle_initialize()
 
   for (ii = 0; ii < EVEL_MAX_DOMAINS; ii++)
   {
-    evel_throttle_spec[ii] = NULL;
+    __atomic_store_n(&evel_throttle_spec[ii], NULL, __ATOMIC_RELEASE);
   }
 
   pthread_rc = pthread_mutex_init(&evel_measurement_interval_mutex, NULL);
@@ -383,14 +998,17 @@ void evel_throttle_terminate()
 
   EVEL_ENTER();
 
+  /***************************************************************************/
+  /* Nothing may be encoding events any more, so free all specifications     */
+  /* without waiting.                                                        */
+  /***************************************************************************/
   for (ii = 0; ii < EVEL_MAX_DOMAINS; ii++)
   {
-    if (evel_throttle_spec[ii] != NULL)
-    {
-      evel_throttle_free(evel_throttle_spec[ii]);
-      evel_throttle_spec[ii] = NULL;
-    }
+    evel_throttle_publish(ii, NULL);
   }
+  pthread_mutex_lock(&evel_throttle_update_mutex);
+  evel_throttle_reclaim(true);
+  pthread_mutex_unlock(&evel_throttle_update_mutex);
 
   pthread_rc = pthread_mutex_destroy(&evel_measurement_interval_mutex);
   assert(pthread_rc == 0);
@@ -408,9 +1026,8 @@ void evel_throttle_terminate()
  *****************************************************************************/
 void evel_throttle_finalize(EVEL_THROTTLE_SPEC * throttle_spec)
 {
-  int nv_pairs_count;
   DLIST_ITEM * dlist_item;
-  ENTRY * add_result;
+  EVEL_THROTTLE_FIELDS field;
 
   EVEL_ENTER();
 
@@ -422,27 +1039,28 @@ void evel_throttle_finalize(EVEL_THROTTLE_SPEC * throttle_spec)
   /***************************************************************************/
   /* Populate the hash table for suppressed field names.                     */
   /***************************************************************************/
-  throttle_spec->hash_field_names =
-             evel_throttle_hash_create(&throttle_spec->suppressed_field_names);
+  evel_throttle_hash_create(&throttle_spec->hash_field_names,
+                            &throttle_spec->suppressed_field_names);
 
   /***************************************************************************/
-  /* Create the hash table for suppressed nv pairs.                          */
+  /* Set the bits for suppressed field names which we know, noting whether   */
+  /* there are any we don't.                                                 */
   /***************************************************************************/
-  nv_pairs_count = dlist_count(&throttle_spec->suppressed_nv_pairs_list);
-  if (nv_pairs_count > 0)
+  dlist_item = dlist_get_first(&throttle_spec->suppressed_field_names);
+  while (dlist_item != NULL)
   {
-    throttle_spec->hash_nv_pairs_list = calloc(1, sizeof(struct hsearch_data));
-    assert(throttle_spec->hash_nv_pairs_list != NULL);
-
-    /*************************************************************************/
-    /* Provide plenty of space in the table - see hcreate_r notes.           */
-    /*************************************************************************/
-    if (hcreate_r(nv_pairs_count * 2, throttle_spec->hash_nv_pairs_list) == 0)
+    field = evel_throttle_field_search(dlist_item->item);
+    if (field < EVEL_MAX_THROTTLE_FIELDS)
     {
-      EVEL_ERROR("Failed to create hash table");
-      free(throttle_spec->hash_nv_pairs_list);
-      throttle_spec->hash_nv_pairs_list = NULL;
+      throttle_spec->suppressed_fields[
+        field / EVEL_THROTTLE_FIELD_WORD_BITS] |=
+                                1UL << (field % EVEL_THROTTLE_FIELD_WORD_BITS);
     }
+    else
+    {
+      throttle_spec->unknown_field_names = true;
+    }
+    dlist_item = dlist_get_next(dlist_item);
   }
 
   /***************************************************************************/
@@ -452,21 +1070,42 @@ void evel_throttle_finalize(EVEL_THROTTLE_SPEC * throttle_spec)
   while (dlist_item != NULL)
   {
     EVEL_SUPPRESSED_NV_PAIRS * nv_pairs = dlist_item->item;
-    ENTRY hash_add;
 
     /*************************************************************************/
-    /* Set the key to the string, and the item to the nv_pairs.              */
+    /* Set the key to the string, and the item to the nv_pairs.  The first   */
+    /* entry for a field is the one used.                                    */
     /*************************************************************************/
     assert(nv_pairs != NULL);
-    hash_add.key = nv_pairs->nv_pair_field_name;
-    hash_add.data = nv_pairs;
-    hsearch_r(hash_add, ENTER, &add_result, throttle_spec->hash_nv_pairs_list);
+    if ((hash_map_get(&throttle_spec->hash_nv_pairs_list,
+                      nv_pairs->nv_pair_field_name) == NULL) &&
+        !hash_map_set(&throttle_spec->hash_nv_pairs_list,
+                      nv_pairs->nv_pair_field_name,
+                      nv_pairs))
+    {
+      EVEL_ERROR("Failed to add to hash table");
+    }
+
+    /*************************************************************************/
+    /* Index the nv_pairs by field too, if we know the field.                */
+    /*************************************************************************/
+    field = evel_throttle_field_search(nv_pairs->nv_pair_field_name);
+    if (field < EVEL_MAX_THROTTLE_FIELDS)
+    {
+      if (throttle_spec->field_nv_pairs[field] == NULL)
+      {
+        throttle_spec->field_nv_pairs[field] = nv_pairs;
+      }
+    }
+    else
+    {
+      throttle_spec->unknown_nv_pair_fields = true;
+    }
 
     /*************************************************************************/
     /* Create the nv_pair_names hash since we're in here.                    */
     /*************************************************************************/
-    nv_pairs->hash_nv_pair_names =
-      evel_throttle_hash_create(&nv_pairs->suppressed_nv_pair_names);
+    evel_throttle_hash_create(&nv_pairs->hash_nv_pair_names,
+                              &nv_pairs->suppressed_nv_pair_names);
 
     dlist_item = dlist_get_next(dlist_item);
   }
@@ -475,22 +1114,22 @@ void evel_throttle_finalize(EVEL_THROTTLE_SPEC * throttle_spec)
 }
 
 /**************************************************************************//**
- * Create and populate a hash table from a DLIST of keys.
+ * Populate a hash table from a DLIST of keys.
  *
+ * @param hash_table    Pointer to the empty hash table to populate.
  * @param hash_keys     Pointer to a DLIST of hash table keys.
- * @return Pointer to the created hash-table, or NULL on failure.
  *****************************************************************************/
-struct hsearch_data * evel_throttle_hash_create(DLIST * hash_keys)
+void evel_throttle_hash_create(HASH_MAP * hash_table, DLIST * hash_keys)
 {
   int key_count;
-  struct hsearch_data * hash_table;
-  ENTRY * add_result;
+  DLIST_ITEM * dlist_item;
 
   EVEL_ENTER();
 
   /***************************************************************************/
   /* Check preconditions.                                                    */
   /***************************************************************************/
+  assert(hash_table != NULL);
   assert(hash_keys != NULL);
 
   /***************************************************************************/
@@ -501,15 +1140,12 @@ struct hsearch_data * evel_throttle_hash_create(DLIST * hash_keys)
   {
     EVEL_DEBUG("Populating table for %d keys", key_count);
 
-    hash_table = calloc(1, sizeof(struct hsearch_data));
-    assert(hash_table != NULL);
-
-    /*************************************************************************/
-    /* We need to leave plenty of space in the table - see hcreate_r notes.  */
-    /*************************************************************************/
-    if (hcreate_r(key_count * 2, hash_table) != 0)
+    if (!hash_map_reserve(hash_table, key_count))
+    {
+      EVEL_ERROR("Failed to create hash table");
+    }
+    else
     {
-      DLIST_ITEM * dlist_item;
       dlist_item = dlist_get_first(hash_keys);
       while (dlist_item != NULL)
       {
@@ -518,28 +1154,13 @@ struct hsearch_data * evel_throttle_hash_create(DLIST * hash_keys)
         /*********************************************************************/
         /* Set the key and data to the item, which is a string in this case. */
         /*********************************************************************/
-        ENTRY hash_add;
-        hash_add.key = dlist_item->item;
-        hash_add.data = dlist_item->item;
-        hsearch_r(hash_add, ENTER, &add_result, hash_table);
+        hash_map_set(hash_table, dlist_item->item, dlist_item->item);
         dlist_item = dlist_get_next(dlist_item);
       }
     }
-    else
-    {
-      EVEL_ERROR("Failed to create hash table");
-      free(hash_table);
-      hash_table = NULL;
-    }
-  }
-  else
-  {
-    hash_table = NULL;
   }
 
   EVEL_EXIT();
-
-  return hash_table;
 }
 
 /**************************************************************************//**
@@ -562,16 +1183,8 @@ void evel_throttle_free(EVEL_THROTTLE_SPEC * throttle_spec)
   /***************************************************************************/
   /* Free any hash tables.                                                   */
   /***************************************************************************/
-  if (throttle_spec->hash_field_names != NULL)
-  {
-    hdestroy_r(throttle_spec->hash_field_names);
-    free(throttle_spec->hash_field_names);
-  }
-  if (throttle_spec->hash_nv_pairs_list != NULL)
-  {
-    hdestroy_r(throttle_spec->hash_nv_pairs_list);
-    free(throttle_spec->hash_nv_pairs_list);
-  }
+  hash_map_free(&throttle_spec->hash_field_names);
+  hash_map_free(&throttle_spec->hash_nv_pairs_list);
 
   /***************************************************************************/
   /* Iterate through the linked lists, freeing memory.                       */
@@ -614,11 +1227,7 @@ void evel_throttle_free_nv_pair(EVEL_SUPPRESSED_NV_PAIRS * nv_pairs)
   /***************************************************************************/
   /* Free any hash tables.                                                   */
   /***************************************************************************/
-  if (nv_pairs->hash_nv_pair_names != NULL)
-  {
-    hdestroy_r(nv_pairs->hash_nv_pair_names);
-    free(nv_pairs->hash_nv_pair_names);
-  }
+  hash_map_free(&nv_pairs->hash_nv_pair_names);
 
   /***************************************************************************/
   /* Iterate through the linked lists, freeing memory.                       */
@@ -1506,7 +2115,7 @@ int evel_json_encode_throttle(char * const json, const int max_size)
   throttled = false;
   for (domain = EVEL_DOMAIN_FAULT; domain < EVEL_MAX_DOMAINS; domain++)
   {
-    if (evel_throttle_spec[domain] != NULL)
+    if (evel_get_throttle_spec(domain) != NULL)
     {
       throttled = true;
     }
@@ -1529,7 +2138,7 @@ int evel_json_encode_throttle(char * const json, const int max_size)
     domain_added = false;
     for (domain = EVEL_DOMAIN_FAULT; domain < EVEL_MAX_DOMAINS; domain++)
     {
-      if (evel_throttle_spec[domain] != NULL)
+      if (evel_get_throttle_spec(domain) != NULL)
       {
         if (domain_added)
         {
@@ -1574,9 +2183,13 @@ int evel_json_encode_throttle_spec(char * const json,
   /***************************************************************************/
   assert(domain >= EVEL_DOMAIN_FAULT);
   assert(domain < EVEL_MAX_DOMAINS);
-  assert(evel_throttle_spec[domain] != NULL);
 
-  throttle_spec = evel_throttle_spec[domain];
+  /***************************************************************************/
+  /* Specifications are only replaced on this thread, so this one cannot be  */
+  /* freed while we encode it.                                               */
+  /***************************************************************************/
+  throttle_spec = evel_get_throttle_spec(domain);
+  assert(throttle_spec != NULL);
 
   /***************************************************************************/
   /* Encode the domain.                                                      */
@@ -1799,15 +2412,6 @@ void evel_set_throttling_spec()
     EVEL_DEBUG("Updating throttle spec for domain: %s",
                evel_domain_strings[evel_throttle_spec_domain]);
 
-    /*************************************************************************/
-    /* Free off the previous throttle specification for the domain, if there */
-    /* is one.                                                               */
-    /*************************************************************************/
-    if (evel_throttle_spec[evel_throttle_spec_domain] != NULL)
-    {
-      evel_throttle_free(evel_throttle_spec[evel_throttle_spec_domain]);
-    }
-
     /*************************************************************************/
     /* Finalize the working throttling spec, if there is one.                */
     /*************************************************************************/
@@ -1819,9 +2423,10 @@ void evel_set_throttling_spec()
     /*************************************************************************/
     /* Replace the throttle specification for the domain with the working    */
     /* throttle specification.  This could be NULL, if an empty throttle     */
-    /* specification has been received for a domain.                         */
+    /* specification has been received for a domain.  The previous           */
+    /* specification is freed once no encoder can still be using it.         */
     /*************************************************************************/
-    evel_throttle_spec[evel_throttle_spec_domain] = evel_temp_throttle;
+    evel_throttle_publish(evel_throttle_spec_domain, evel_temp_throttle);
     evel_temp_throttle = NULL;
   }
 
@@ -1878,12 +2483,12 @@ void evel_open_throttle_spec()
   /* Allocate and initialize an ::EVEL_THROTTLE_SPEC in which to hold        */
   /* captured JSON elements.                                                 */
   /***************************************************************************/
-  evel_temp_throttle = malloc(sizeof(EVEL_THROTTLE_SPEC));
+  evel_temp_throttle = calloc(1, sizeof(EVEL_THROTTLE_SPEC));
   assert(evel_temp_throttle != NULL);
   dlist_initialize(&evel_temp_throttle->suppressed_field_names);
   dlist_initialize(&evel_temp_throttle->suppressed_nv_pairs_list);
-  evel_temp_throttle->hash_field_names = NULL;
-  evel_temp_throttle->hash_nv_pairs_list = NULL;
+  hash_map_initialize(&evel_temp_throttle->hash_field_names);
+  hash_map_initialize(&evel_temp_throttle->hash_nv_pairs_list);
 
   EVEL_EXIT();
 }
@@ -1978,7 +2583,7 @@ void evel_open_nv_pairs_list_entry()
   assert(nv_pairs != NULL);
   nv_pairs->nv_pair_field_name = NULL;
   dlist_initialize(&nv_pairs->suppressed_nv_pair_names);
-  nv_pairs->hash_nv_pair_names = NULL;
+  hash_map_initialize(&nv_pairs->hash_nv_pair_names);
   dlist_push_last(&evel_temp_throttle->suppressed_nv_pairs_list, nv_pairs);
 
   EVEL_EXIT();
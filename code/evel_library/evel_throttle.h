@@ -196,9 +196,26 @@ bool evel_handle_command_list(const MEMORY_CHUNK * const chunk,
                               const int num_tokens,
                               MEMORY_CHUNK * const post);
 
+/**************************************************************************//**
+ * Start reading throttle specifications.
+ *
+ * Any specification returned by ::evel_get_throttle_spec remains valid until
+ * the matching ::evel_throttle_read_end.  Reading never waits for updates.
+ * Calls may be nested.
+ *****************************************************************************/
+void evel_throttle_read_begin(void);
+
+/**************************************************************************//**
+ * Finish reading throttle specifications.
+ *****************************************************************************/
+void evel_throttle_read_end(void);
+
 /**************************************************************************//**
  * Return the ::EVEL_THROTTLE_SPEC for a given domain.
  *
+ * Must be called between ::evel_throttle_read_begin and
+ * ::evel_throttle_read_end, and the result not used after the latter.
+ *
  * @param domain        The domain for which to return state.
  *****************************************************************************/
 EVEL_THROTTLE_SPEC * evel_get_throttle_spec(EVEL_EVENT_DOMAINS domain);
@@ -207,21 +224,27 @@ EVEL_THROTTLE_SPEC * evel_get_throttle_spec(EVEL_EVENT_DOMAINS domain);
  * Determine whether a field_name should be suppressed.
  *
  * @param throttle_spec Throttle specification for the domain being encoded.
+ * @param field         The ::EVEL_THROTTLE_FIELDS being encoded, or
+ *                      ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param field_name    The field name to encoded or suppress.
  * @return true if the field_name should be suppressed, false otherwise.
  *****************************************************************************/
 bool evel_throttle_suppress_field(EVEL_THROTTLE_SPEC * throttle_spec,
+                                  const EVEL_THROTTLE_FIELDS field,
                                   const char * const field_name);
 
 /**************************************************************************//**
  * Determine whether a name-value pair should be allowed (not suppressed).
  *
  * @param throttle_spec Throttle specification for the domain being encoded.
+ * @param field         The ::EVEL_THROTTLE_FIELDS holding the name-value
+ *                      pairs, or ::EVEL_MAX_THROTTLE_FIELDS if it isn't one.
  * @param field_name    The field name holding the name-value pairs.
  * @param name          The name of the name-value pair to encoded or suppress.
  * @return true if the name-value pair should be suppressed, false otherwise.
  *****************************************************************************/
 bool evel_throttle_suppress_nv_pair(EVEL_THROTTLE_SPEC * throttle_spec,
+                                    const EVEL_THROTTLE_FIELDS field,
                                     const char * const field_name,
                                     const char * const name);
 
@@ -80,7 +80,8 @@ EVENT_VOICE_QUALITY * evel_new_voice_quality(const char * const calleeSideCodec,
     /***************************************************************************/
     /* Allocate the Voice Quality.                                                     */
     /***************************************************************************/
-    voiceQuality = malloc(sizeof(EVENT_VOICE_QUALITY));
+    voiceQuality = evel_alloc_event(EVEL_DOMAIN_VOICE_QUALITY,
+                                    sizeof(EVENT_VOICE_QUALITY));
     
     if (voiceQuality == NULL)
     {
@@ -90,7 +91,6 @@ EVENT_VOICE_QUALITY * evel_new_voice_quality(const char * const calleeSideCodec,
 
     //Only in case of successful allocation initialize data.
     if (inError == false) {
-        memset(voiceQuality, 0, sizeof(EVENT_VOICE_QUALITY));
         EVEL_DEBUG("New Voice Quality is at %lp", voiceQuality);
 
         /***************************************************************************/
@@ -102,11 +102,19 @@ EVENT_VOICE_QUALITY * evel_new_voice_quality(const char * const calleeSideCodec,
         voiceQuality->major_version = EVEL_VOICEQ_MAJOR_VERSION;
         voiceQuality->minor_version = EVEL_VOICEQ_MINOR_VERSION;
 
-        voiceQuality->calleeSideCodec = strdup(calleeSideCodec);
-        voiceQuality->callerSideCodec = strdup(callerSideCodec);
-        voiceQuality->correlator = strdup(correlator);
-        voiceQuality->midCallRtcp = strdup(midCallRtcp);
-        evel_init_vendor_field(&voiceQuality->vendorVnfNameFields, vendorName);
+        voiceQuality->calleeSideCodec = evel_event_strdup(
+          &voiceQuality->header,
+          calleeSideCodec);
+        voiceQuality->callerSideCodec = evel_event_strdup(
+          &voiceQuality->header,
+          callerSideCodec);
+        voiceQuality->correlator = evel_event_strdup(&voiceQuality->header,
+                                                     correlator);
+        voiceQuality->midCallRtcp = evel_event_strdup(&voiceQuality->header,
+                                                      midCallRtcp);
+        evel_init_vendor_field(&voiceQuality->header,
+                               &voiceQuality->vendorVnfNameFields,
+                               vendorName);
         dlist_initialize(&voiceQuality->additionalInformation);
         dlist_initialize(&voiceQuality->endOfCallVqmSummaries);
         evel_init_option_string(&voiceQuality->phoneNumber);
@@ -145,15 +153,18 @@ void evel_voice_quality_addl_info_add(EVENT_VOICE_QUALITY * voiceQ, char * name,
     assert(value != NULL);
 
     EVEL_DEBUG("Adding name=%s value=%s", name, value);
-    addlInfo = malloc(sizeof(VOICE_QUALITY_ADDL_INFO));
+    addlInfo = evel_event_malloc(&voiceQ->header,
+                                 sizeof(VOICE_QUALITY_ADDL_INFO));
     assert(addlInfo != NULL);
     memset(addlInfo, 0, sizeof(VOICE_QUALITY_ADDL_INFO));
-    addlInfo->name = strdup(name);
-    addlInfo->value = strdup(value);
+    addlInfo->name = evel_event_strdup(&voiceQ->header, name);
+    addlInfo->value = evel_event_strdup(&voiceQ->header, value);
     assert(addlInfo->name != NULL);
     assert(addlInfo->value != NULL);
 
-    dlist_push_last(&voiceQ->additionalInformation, addlInfo);
+    evel_event_list_push(&voiceQ->header,
+                         &voiceQ->additionalInformation,
+                         addlInfo);
 
     EVEL_EXIT();
 }
@@ -182,7 +193,8 @@ void evel_voice_quality_callee_codec_set(EVENT_VOICE_QUALITY * voiceQuality,
     assert(voiceQuality->header.event_domain == EVEL_DOMAIN_VOICE_QUALITY);
     assert(calleeCodecForCall != NULL);
 
-    voiceQuality->calleeSideCodec = strdup(calleeCodecForCall);
+    voiceQuality->calleeSideCodec = evel_event_strdup(&voiceQuality->header,
+                                                      calleeCodecForCall);
 
     EVEL_EXIT();
 }
@@ -211,7 +223,8 @@ void evel_voice_quality_caller_codec_set(EVENT_VOICE_QUALITY * voiceQuality,
     assert(voiceQuality->header.event_domain == EVEL_DOMAIN_VOICE_QUALITY);
     assert(callerCodecForCall != NULL);
 
-    voiceQuality->calleeSideCodec = strdup(callerCodecForCall);
+    voiceQuality->calleeSideCodec = evel_event_strdup(&voiceQuality->header,
+                                                      callerCodecForCall);
 
     EVEL_EXIT();
 }
@@ -240,7 +253,8 @@ void evel_voice_quality_correlator_set(EVENT_VOICE_QUALITY * voiceQuality,
     assert(voiceQuality->header.event_domain == EVEL_DOMAIN_VOICE_QUALITY);
     assert(vCorrelator != NULL);
 
-    voiceQuality->correlator = strdup(vCorrelator);
+    voiceQuality->correlator = evel_event_strdup(&voiceQuality->header,
+                                                 vCorrelator);
 
     EVEL_EXIT();
 }
@@ -269,7 +283,8 @@ void evel_voice_quality_rtcp_data_set(EVENT_VOICE_QUALITY * voiceQuality,
     assert(voiceQuality->header.event_domain == EVEL_DOMAIN_VOICE_QUALITY);
     assert(rtcpCallData != NULL);
 
-    voiceQuality->midCallRtcp = strdup(rtcpCallData);
+    voiceQuality->midCallRtcp = evel_event_strdup(&voiceQuality->header,
+                                                  rtcpCallData);
 
     EVEL_EXIT();
 }
@@ -298,7 +313,9 @@ void evel_voice_quality_vnfmodule_name_set(EVENT_VOICE_QUALITY * voiceQuality,
     assert(voiceQuality->header.event_domain == EVEL_DOMAIN_VOICE_QUALITY);
     assert(module_name != NULL);
 
-    evel_vendor_field_module_set(&voiceQuality->vendorVnfNameFields, module_name);
+    evel_vendor_field_module_set(&voiceQuality->header,
+                                 &voiceQuality->vendorVnfNameFields,
+                                 module_name);
 
     EVEL_EXIT();
 }
@@ -327,7 +344,9 @@ void evel_voice_quality_vnfname_set(EVENT_VOICE_QUALITY * voiceQuality,
     assert(voiceQuality->header.event_domain == EVEL_DOMAIN_VOICE_QUALITY);
     assert(vnfname != NULL);
 
-    evel_vendor_field_vnfname_set(&voiceQuality->vendorVnfNameFields, vnfname);
+    evel_vendor_field_vnfname_set(&voiceQuality->header,
+                                  &voiceQuality->vendorVnfNameFields,
+                                  vnfname);
 
     EVEL_EXIT();
 }
@@ -356,7 +375,10 @@ void evel_voice_quality_phone_number_set(EVENT_VOICE_QUALITY * voiceQuality,
     assert(voiceQuality->header.event_domain == EVEL_DOMAIN_VOICE_QUALITY);
     assert(phoneNumber != NULL);
 
-    evel_set_option_string(&voiceQuality->phoneNumber, phoneNumber, "Phone_Number");
+    evel_event_set_option_string(&voiceQuality->header,
+                                 &voiceQuality->phoneNumber,
+                                 phoneNumber,
+                                 "Phone_Number");
 
     EVEL_EXIT();
 }
@@ -431,11 +453,13 @@ void evel_voice_quality_end_metrics_add(EVENT_VOICE_QUALITY * voiceQuality,
     /* Allocate a container for the value and push onto the list.              */
     /***************************************************************************/
     EVEL_DEBUG("Adding adjacencyName=%s endpointDescription=%d", adjacencyName, endpointDescription);
-    vQMetrices = malloc(sizeof(END_OF_CALL_VOICE_QUALITY_METRICS));
+    vQMetrices = evel_event_malloc(&voiceQuality->header,
+                                   sizeof(END_OF_CALL_VOICE_QUALITY_METRICS));
     assert(vQMetrices != NULL);
     memset(vQMetrices, 0, sizeof(END_OF_CALL_VOICE_QUALITY_METRICS));
 
-    vQMetrices->adjacencyName = strdup(adjacencyName);
+    vQMetrices->adjacencyName = evel_event_strdup(&voiceQuality->header,
+                                                  adjacencyName);
     vQMetrices->endpointDescription = evel_service_endpoint_desc(endpointDescription);
 
     evel_set_option_int(&vQMetrices->endpointJitter, endpointJitter, "Endpoint jitter");
@@ -458,7 +482,9 @@ void evel_voice_quality_end_metrics_add(EVENT_VOICE_QUALITY * voiceQuality,
     evel_set_option_int(&vQMetrices->rFactor, rFactor, "rFactor ");
     evel_set_option_int(&vQMetrices->roundTripDelay, roundTripDelay, "Round trip delay in milliseconds ");
 
-    dlist_push_last(&voiceQuality->endOfCallVqmSummaries, vQMetrices);
+    evel_event_list_push(&voiceQuality->header,
+                         &voiceQuality->endOfCallVqmSummaries,
+                         vQMetrices);
 
     EVEL_EXIT();
 }
@@ -504,7 +530,10 @@ void evel_json_encode_voice_quality(EVEL_JSON_BUFFER * jbuf,
   /***************************************************************************/
   /* Optional fields.                                                        */
   /***************************************************************************/
-  evel_enc_kv_opt_string(jbuf, "phoneNumber", &event->phoneNumber);
+  evel_enc_kv_opt_string(jbuf,
+                         EVEL_FIELD_PHONE_NUMBER,
+                         "phoneNumber",
+                         &event->phoneNumber);
   /***************************************************************************/
   /* Checkpoint, so that we can wind back if all fields are suppressed.      */
   /***************************************************************************/
@@ -512,7 +541,9 @@ void evel_json_encode_voice_quality(EVEL_JSON_BUFFER * jbuf,
   bool item_added = false;
  
   evel_json_checkpoint(jbuf);
-  if (evel_json_open_opt_named_list(jbuf, "additionalInformation"))
+  if (evel_json_open_opt_named_list(jbuf,
+                                    EVEL_FIELD_ADDITIONAL_INFORMATION,
+                                    "additionalInformation"))
   {
 
     addlInfoItem = dlist_get_first(&event->additionalInformation);
@@ -522,6 +553,7 @@ void evel_json_encode_voice_quality(EVEL_JSON_BUFFER * jbuf,
       assert(addlInfo != NULL);
 
       if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                                          EVEL_FIELD_ADDITIONAL_INFORMATION,
                                           "additionalInformation",
                                           addlInfo->name))
       {
@@ -538,7 +570,9 @@ void evel_json_encode_voice_quality(EVEL_JSON_BUFFER * jbuf,
 
     //endOfCallVqmSummaries
     evel_json_checkpoint(jbuf);
-    if (evel_json_open_opt_named_list(jbuf, "endOfCallVqmSummaries"))
+    if (evel_json_open_opt_named_list(jbuf,
+                                      EVEL_FIELD_END_OF_CALL_VQM_SUMMARIES,
+                                      "endOfCallVqmSummaries"))
     {
         vQMetricsItem = dlist_get_first(&event->endOfCallVqmSummaries);
         while (vQMetricsItem != NULL)
@@ -547,31 +581,89 @@ void evel_json_encode_voice_quality(EVEL_JSON_BUFFER * jbuf,
             assert(vQMetrics != NULL);
 
             if (!evel_throttle_suppress_nv_pair(jbuf->throttle_spec,
+                EVEL_FIELD_END_OF_CALL_VQM_SUMMARIES,
                 "endOfCallVqmSummaries",
                 vQMetrics->adjacencyName))
             {
                 evel_json_open_object(jbuf);
                 evel_enc_kv_string(jbuf, "adjacencyName", vQMetrics->adjacencyName);
                 evel_enc_kv_string(jbuf, "endpointDescription", vQMetrics->endpointDescription);
-                evel_enc_kv_opt_int(jbuf, "endpointJitter", &vQMetrics->endpointJitter);
-                evel_enc_kv_opt_int(jbuf, "endpointRtpOctetsDiscarded", &vQMetrics->endpointRtpOctetsDiscarded);
-                evel_enc_kv_opt_int(jbuf, "endpointRtpOctetsReceived", &vQMetrics->endpointRtpOctetsReceived);
-                evel_enc_kv_opt_int(jbuf, "endpointRtpOctetsSent", &vQMetrics->endpointRtpOctetsSent);
-                evel_enc_kv_opt_int(jbuf, "endpointRtpPacketsDiscarded", &vQMetrics->endpointRtpPacketsDiscarded);
-                evel_enc_kv_opt_int(jbuf, "endpointRtpPacketsReceived", &vQMetrics->endpointRtpPacketsReceived);
-                evel_enc_kv_opt_int(jbuf, "endpointRtpPacketsSent", &vQMetrics->endpointRtpPacketsSent);
-                evel_enc_kv_opt_int(jbuf, "localJitter", &vQMetrics->localJitter);
-                evel_enc_kv_opt_int(jbuf, "localRtpOctetsDiscarded", &vQMetrics->localRtpOctetsDiscarded);
-                evel_enc_kv_opt_int(jbuf, "localRtpOctetsReceived", &vQMetrics->localRtpOctetsReceived);
-                evel_enc_kv_opt_int(jbuf, "localRtpOctetsSent", &vQMetrics->localRtpOctetsSent);
-                evel_enc_kv_opt_int(jbuf, "localRtpPacketsDiscarded", &vQMetrics->localRtpPacketsDiscarded);
-                evel_enc_kv_opt_int(jbuf, "localRtpPacketsReceived", &vQMetrics->localRtpPacketsReceived);
-                evel_enc_kv_opt_int(jbuf, "localRtpPacketsSent", &vQMetrics->localRtpPacketsSent);
-                evel_enc_kv_opt_int(jbuf, "mosCqe", &vQMetrics->mosCqe);
-                evel_enc_kv_opt_int(jbuf, "packetsLost", &vQMetrics->packetsLost);
-                evel_enc_kv_opt_int(jbuf, "packetLossPercent", &vQMetrics->packetLossPercent);
-                evel_enc_kv_opt_int(jbuf, "rFactor", &vQMetrics->rFactor);
-                evel_enc_kv_opt_int(jbuf, "roundTripDelay", &vQMetrics->roundTripDelay);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_ENDPOINT_JITTER,
+                                    "endpointJitter",
+                                    &vQMetrics->endpointJitter);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_ENDPOINT_RTP_OCTETS_DISCARDED,
+                                    "endpointRtpOctetsDiscarded",
+                                    &vQMetrics->endpointRtpOctetsDiscarded);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_ENDPOINT_RTP_OCTETS_RECEIVED,
+                                    "endpointRtpOctetsReceived",
+                                    &vQMetrics->endpointRtpOctetsReceived);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_ENDPOINT_RTP_OCTETS_SENT,
+                                    "endpointRtpOctetsSent",
+                                    &vQMetrics->endpointRtpOctetsSent);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_ENDPOINT_RTP_PACKETS_DISCARDED,
+                                    "endpointRtpPacketsDiscarded",
+                                    &vQMetrics->endpointRtpPacketsDiscarded);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_ENDPOINT_RTP_PACKETS_RECEIVED,
+                                    "endpointRtpPacketsReceived",
+                                    &vQMetrics->endpointRtpPacketsReceived);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_ENDPOINT_RTP_PACKETS_SENT,
+                                    "endpointRtpPacketsSent",
+                                    &vQMetrics->endpointRtpPacketsSent);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_LOCAL_JITTER,
+                                    "localJitter",
+                                    &vQMetrics->localJitter);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_LOCAL_RTP_OCTETS_DISCARDED,
+                                    "localRtpOctetsDiscarded",
+                                    &vQMetrics->localRtpOctetsDiscarded);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_LOCAL_RTP_OCTETS_RECEIVED,
+                                    "localRtpOctetsReceived",
+                                    &vQMetrics->localRtpOctetsReceived);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_LOCAL_RTP_OCTETS_SENT,
+                                    "localRtpOctetsSent",
+                                    &vQMetrics->localRtpOctetsSent);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_LOCAL_RTP_PACKETS_DISCARDED,
+                                    "localRtpPacketsDiscarded",
+                                    &vQMetrics->localRtpPacketsDiscarded);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_LOCAL_RTP_PACKETS_RECEIVED,
+                                    "localRtpPacketsReceived",
+                                    &vQMetrics->localRtpPacketsReceived);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_LOCAL_RTP_PACKETS_SENT,
+                                    "localRtpPacketsSent",
+                                    &vQMetrics->localRtpPacketsSent);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_MOS_CQE,
+                                    "mosCqe",
+                                    &vQMetrics->mosCqe);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_PACKETS_LOST,
+                                    "packetsLost",
+                                    &vQMetrics->packetsLost);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_PACKET_LOSS_PERCENT,
+                                    "packetLossPercent",
+                                    &vQMetrics->packetLossPercent);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_R_FACTOR,
+                                    "rFactor",
+                                    &vQMetrics->rFactor);
+                evel_enc_kv_opt_int(jbuf,
+                                    EVEL_FIELD_ROUND_TRIP_DELAY,
+                                    "roundTripDelay",
+                                    &vQMetrics->roundTripDelay);
 
                 evel_json_close_object(jbuf);
                 item_added = true;
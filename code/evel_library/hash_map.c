@@ -0,0 +1,333 @@
+/**************************************************************************//**
+ * @file
+ * A simple hash map from strings to pointers.
+ *
+ * @note  No thread protection so you will need to use appropriate
+ * synchronization if use spans multiple threads.
+ *
+ * License
+ * -------
+ *
+ * Copyright(c) <2016>, AT&T Intellectual Property.  All other rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:  This product includes
+ *    software developed by the AT&T.
+ * 4. Neither the name of AT&T nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY AT&T INTELLECTUAL PROPERTY ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL AT&T INTELLECTUAL PROPERTY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash_map.h"
+
+/*****************************************************************************/
+/* The number of slots a map starts with, which must be a power of two.      */
+/* The slots are grown whenever they would otherwise become more than half   */
+/* full, which keeps probe sequences short.                                  */
+/*****************************************************************************/
+#define HASH_MAP_MIN_SLOTS 8
+
+/**************************************************************************//**
+ * Hash a key.
+ *
+ * Uses 32-bit FNV-1a.
+ *
+ * @param key           The key.
+ * @returns The hash.
+ *****************************************************************************/
+static unsigned int hash_map_hash(const char * key)
+{
+  unsigned int hash = 2166136261u;
+
+  while (*key != '\0')
+  {
+    hash ^= (unsigned char) *key++;
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+/**************************************************************************//**
+ * Find the slot for a key, which either refers to its entry or is the free
+ * slot where its entry belongs.
+ *
+ * @param map           Pointer to the map, which has slots.
+ * @param key           The key.
+ * @param hash          The hash of the key.
+ * @returns Index of the slot.
+ *****************************************************************************/
+static int hash_map_find_slot(const HASH_MAP * const map,
+                              const char * const key,
+                              const unsigned int hash)
+{
+  const unsigned int mask = map->slots_size - 1;
+  unsigned int slot = hash & mask;
+  const HASH_MAP_ENTRY * entry = NULL;
+
+  while (map->slots[slot] != 0)
+  {
+    entry = &map->entries[map->slots[slot] - 1];
+    if ((entry->hash == hash) && (strcmp(entry->key, key) == 0))
+    {
+      break;
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  return slot;
+}
+
+/**************************************************************************//**
+ * Resize the slots, and reindex the entries in them.
+ *
+ * @param map           Pointer to the map.
+ * @param slots_size    The new number of slots, a power of two larger than
+ *                      twice the number of entries.
+ * @returns true on success, false if memory could not be allocated, in which
+ *          case the map is unchanged.
+ *****************************************************************************/
+static bool hash_map_resize_slots(HASH_MAP * map, const int slots_size)
+{
+  unsigned int * slots = NULL;
+  unsigned int mask = slots_size - 1;
+  unsigned int slot;
+  int ii;
+
+  slots = calloc(slots_size, sizeof(unsigned int));
+  if (slots == NULL)
+  {
+    return false;
+  }
+
+  for (ii = 0; ii < map->count; ii++)
+  {
+    slot = map->entries[ii].hash & mask;
+    while (slots[slot] != 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = ii + 1;
+  }
+
+  free(map->slots);
+  map->slots = slots;
+  map->slots_size = slots_size;
+
+  return true;
+}
+
+/**************************************************************************//**
+ * Hash map initialization.
+ *
+ * Initialize the map supplied to be empty.  No memory is allocated until the
+ * first entry is added.
+ *
+ * @param   map   Pointer to the map to initialize.
+ *****************************************************************************/
+void hash_map_initialize(HASH_MAP * map)
+{
+  assert(map != NULL);
+
+  map->entries = NULL;
+  map->count = 0;
+  map->entries_size = 0;
+  map->slots = NULL;
+  map->slots_size = 0;
+}
+
+/**************************************************************************//**
+ * Make room in a map for a number of entries in total.
+ *
+ * @param   map   Pointer to the map.
+ * @param   count The number of entries to make room for.
+ * @returns true on success, false if memory could not be allocated.
+ *****************************************************************************/
+bool hash_map_reserve(HASH_MAP * map, const int count)
+{
+  HASH_MAP_ENTRY * entries = NULL;
+  int slots_size;
+
+  assert(map != NULL);
+  assert(count >= 0);
+
+  if (count > map->entries_size)
+  {
+    entries = realloc(map->entries, count * sizeof(HASH_MAP_ENTRY));
+    if (entries == NULL)
+    {
+      return false;
+    }
+    map->entries = entries;
+    map->entries_size = count;
+  }
+
+  slots_size = (map->slots_size > 0) ? map->slots_size : HASH_MAP_MIN_SLOTS;
+  while (slots_size < count * 2 + 1)
+  {
+    slots_size *= 2;
+  }
+  if (slots_size > map->slots_size)
+  {
+    return hash_map_resize_slots(map, slots_size);
+  }
+
+  return true;
+}
+
+/**************************************************************************//**
+ * Set the value for a key, adding an entry if there is none.
+ *
+ * The key is not copied, and must remain valid until the map is freed.
+ *
+ * @param   map   Pointer to the map.
+ * @param   key   The key.
+ * @param   value The value.
+ * @returns true on success, false if memory could not be allocated.
+ *****************************************************************************/
+bool hash_map_set(HASH_MAP * map, const char * const key, void * value)
+{
+  unsigned int hash;
+  int slot;
+  HASH_MAP_ENTRY * entry = NULL;
+
+  assert(map != NULL);
+  assert(key != NULL);
+
+  /***************************************************************************/
+  /* Make sure there's room for another entry, doubling as we go so that     */
+  /* adding entries takes constant time on average.                          */
+  /***************************************************************************/
+  if ((map->count == map->entries_size) &&
+      !hash_map_reserve(map, (map->entries_size > 0) ?
+                               map->entries_size * 2 :
+                               HASH_MAP_MIN_SLOTS / 2))
+  {
+    return false;
+  }
+
+  hash = hash_map_hash(key);
+  slot = hash_map_find_slot(map, key, hash);
+  if (map->slots[slot] != 0)
+  {
+    map->entries[map->slots[slot] - 1].value = value;
+  }
+  else
+  {
+    entry = &map->entries[map->count];
+    entry->key = key;
+    entry->value = value;
+    entry->hash = hash;
+    map->slots[slot] = ++map->count;
+  }
+
+  return true;
+}
+
+/**************************************************************************//**
+ * Get the value for a key.
+ *
+ * @param   map   Pointer to the map.
+ * @param   key   The key.
+ * @returns The value, or NULL if the key has no entry.
+ *****************************************************************************/
+void * hash_map_get(const HASH_MAP * const map, const char * const key)
+{
+  int slot;
+  void * value = NULL;
+
+  assert(map != NULL);
+  assert(key != NULL);
+
+  if (map->count > 0)
+  {
+    slot = hash_map_find_slot(map, key, hash_map_hash(key));
+    if (map->slots[slot] != 0)
+    {
+      value = map->entries[map->slots[slot] - 1].value;
+    }
+  }
+
+  return value;
+}
+
+/**************************************************************************//**
+ * Get the number of entries in a map.
+ *
+ * @param   map   Pointer to the map.
+ * @returns The number of entries.
+ *****************************************************************************/
+int hash_map_count(const HASH_MAP * const map)
+{
+  assert(map != NULL);
+
+  return map->count;
+}
+
+/**************************************************************************//**
+ * Get the key of an entry, in the order the entries were added.
+ *
+ * @param   map   Pointer to the map.
+ * @param   index Index of the entry, from 0 to one less than the count.
+ * @returns The key.
+ *****************************************************************************/
+const char * hash_map_key(const HASH_MAP * const map, const int index)
+{
+  assert(map != NULL);
+  assert((index >= 0) && (index < map->count));
+
+  return map->entries[index].key;
+}
+
+/**************************************************************************//**
+ * Get the value of an entry, in the order the entries were added.
+ *
+ * @param   map   Pointer to the map.
+ * @param   index Index of the entry, from 0 to one less than the count.
+ * @returns The value.
+ *****************************************************************************/
+void * hash_map_value(const HASH_MAP * const map, const int index)
+{
+  assert(map != NULL);
+  assert((index >= 0) && (index < map->count));
+
+  return map->entries[index].value;
+}
+
+/**************************************************************************//**
+ * Free the memory used by a map, but not its keys or values, leaving it
+ * empty.
+ *
+ * @param   map   Pointer to the map.
+ *****************************************************************************/
+void hash_map_free(HASH_MAP * map)
+{
+  assert(map != NULL);
+
+  free(map->entries);
+  free(map->slots);
+  hash_map_initialize(map);
+}
@@ -0,0 +1,85 @@
+#ifndef HASH_MAP_INCLUDED
+#define HASH_MAP_INCLUDED
+
+/**************************************************************************//**
+ * @file
+ * A simple hash map from strings to pointers.
+ *
+ * Entries are kept in an array in the order they were added, so iterating
+ * over the map visits only the entries, in that order.  A separate table of
+ * slots, which is open addressed and grows as entries are added, indexes the
+ * entries by the hash of their key, which is computed once and kept with the
+ * entry.  Entries cannot be removed.
+ *
+ * The map doesn't copy or free keys or values, which must outlive it.
+ *
+ * @note  No thread protection so you will need to use appropriate
+ * synchronization if use spans multiple threads.
+ *
+ * License
+ * -------
+ *
+ * Copyright(c) <2016>, AT&T Intellectual Property.  All other rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:  This product includes
+ *    software developed by the AT&T.
+ * 4. Neither the name of AT&T nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY AT&T INTELLECTUAL PROPERTY ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL AT&T INTELLECTUAL PROPERTY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdbool.h>
+
+/**************************************************************************//**
+ * An entry in a hash map.
+ *****************************************************************************/
+typedef struct hash_map_entry
+{
+  const char * key;
+  void * value;
+  unsigned int hash;
+} HASH_MAP_ENTRY;
+
+/**************************************************************************//**
+ * Hash map structure.  Each slot holds the index of an entry plus one, or 0
+ * if it is free.
+ *****************************************************************************/
+typedef struct hash_map
+{
+  HASH_MAP_ENTRY * entries;
+  int count;
+  int entries_size;
+  unsigned int * slots;
+  int slots_size;
+} HASH_MAP;
+
+void hash_map_initialize(HASH_MAP * map);
+bool hash_map_reserve(HASH_MAP * map, const int count);
+bool hash_map_set(HASH_MAP * map, const char * const key, void * value);
+void * hash_map_get(const HASH_MAP * const map, const char * const key);
+int hash_map_count(const HASH_MAP * const map);
+const char * hash_map_key(const HASH_MAP * const map, const int index);
+void * hash_map_value(const HASH_MAP * const map, const int index);
+void hash_map_free(HASH_MAP * map);
+
+#endif
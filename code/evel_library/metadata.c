@@ -73,6 +73,11 @@ static char vm_uuid[MAX_METADATA_STRING+1] = {0};
  *****************************************************************************/
 static char vm_name[MAX_METADATA_STRING+1] = {0};
 
+/**************************************************************************//**
+ * Generation of the metadata, bumped each time it is (re)loaded.
+ *****************************************************************************/
+static unsigned long metadata_generation = 0;
+
 /**************************************************************************//**
  * How many metadata elements we allow for in the retrieved JSON.
  *****************************************************************************/
@@ -318,6 +323,11 @@ exit_label:
   }
   free(rx_chunk.memory);
 
+  /***************************************************************************/
+  /* Whatever happened, the VM name and UUID may have changed.               */
+  /***************************************************************************/
+  __atomic_add_fetch(&metadata_generation, 1, __ATOMIC_RELEASE);
+
   EVEL_EXIT();
   return rc;
 }
@@ -333,6 +343,7 @@ void openstack_metadata_initialize()
   strncpy(vm_name,
           "Dummy VM name - No Metadata available",
           MAX_METADATA_STRING);
+  __atomic_add_fetch(&metadata_generation, 1, __ATOMIC_RELEASE);
 }
 
 /**************************************************************************//**
@@ -605,3 +616,14 @@ const char *openstack_vm_uuid()
 {
   return vm_uuid;
 }
+
+/**************************************************************************//**
+ * Get the generation of the metadata, which changes whenever the VM name or
+ * UUID may have changed.
+ *
+ * @returns Metadata generation
+ *****************************************************************************/
+unsigned long openstack_metadata_generation()
+{
+  return __atomic_load_n(&metadata_generation, __ATOMIC_ACQUIRE);
+}
@@ -69,4 +69,12 @@ const char *openstack_vm_name();
  *****************************************************************************/
 const char *openstack_vm_uuid();
 
+/**************************************************************************//**
+ * Get the generation of the metadata, which changes whenever the VM name or
+ * UUID may have changed.
+ *
+ * @returns Metadata generation
+ *****************************************************************************/
+unsigned long openstack_metadata_generation();
+
 #endif
@@ -35,6 +35,7 @@
  *****************************************************************************/
 
 #include <assert.h>
+#include <errno.h>
 #include <malloc.h>
 
 #include "ring_buffer.h"
@@ -43,7 +44,8 @@
 /**************************************************************************//**
  * Ring buffer initialization.
  *
- * Initialize the buffer supplied to the specified size.
+ * Initialize the buffer supplied to the specified size.  The size is rounded
+ * up to a power of two.
  *
  * @param   buffer  Pointer to the ring-buffer to be initialized.
  * @param   size    How many elements to be stored in the ring-buffer.
@@ -52,7 +54,10 @@
 ******************************************************************************/
 void ring_buffer_initialize(ring_buffer * buffer, int size)
 {
+  pthread_condattr_t cond_attr;
   int pthread_rc = 0;
+  int capacity = 1;
+  int ii;
 
   EVEL_ENTER();
 
@@ -63,34 +68,181 @@ void ring_buffer_initialize(ring_buffer * buffer, int size)
   assert(size > 0);
 
   /***************************************************************************/
-  /* Initialize the synchronization objects.                                 */
+  /* Initialize the synchronization objects.  Timed waits are measured on    */
+  /* the monotonic clock, so that they aren't upset by changes to the time   */
+  /* of day.                                                                 */
   /***************************************************************************/
   pthread_rc = pthread_mutex_init(&buffer->ring_mutex, NULL);
   assert(pthread_rc == 0);
-  pthread_rc = pthread_cond_init(&buffer->ring_cv, NULL);
+  pthread_rc = pthread_condattr_init(&cond_attr);
   assert(pthread_rc == 0);
+  pthread_rc = pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+  assert(pthread_rc == 0);
+  pthread_rc = pthread_cond_init(&buffer->ring_cv, &cond_attr);
+  assert(pthread_rc == 0);
+  pthread_rc = pthread_cond_init(&buffer->space_cv, &cond_attr);
+  assert(pthread_rc == 0);
+  pthread_condattr_destroy(&cond_attr);
 
   /***************************************************************************/
-  /* Allocate the ring buffer itself.                                        */
+  /* Allocate the ring buffer itself, with a power of two number of cells so */
+  /* that positions map onto cells with a mask.                              */
   /***************************************************************************/
-  buffer->ring = malloc(size * sizeof(void *));
+  while (capacity < size)
+  {
+    capacity <<= 1;
+  }
+  buffer->ring = malloc(capacity * sizeof(ring_buffer_cell));
   assert(buffer->ring != NULL);
 
   /***************************************************************************/
-  /* Initialize the ring as empty.                                           */
+  /* Initialize the ring as empty, with every cell ready to be written at    */
+  /* its own position.                                                       */
   /***************************************************************************/
+  for (ii = 0; ii < capacity; ii++)
+  {
+    buffer->ring[ii].sequence = ii;
+    buffer->ring[ii].msg = NULL;
+  }
   buffer->next_write = 0;
   buffer->next_read = 0;
-  buffer->size = size;
+  buffer->reader_waiting = 0;
+  buffer->writers_waiting = 0;
+  buffer->waker = buffer;
+  buffer->mask = capacity - 1;
+  buffer->size = capacity;
 
   EVEL_EXIT();
 }
 
+/**************************************************************************//**
+ * Take as many elements as are available from a ring_buffer, up to a limit,
+ * without blocking.
+ *
+ * @param   buffer    Pointer to the ring-buffer to be read.
+ * @param   msgs      Array in which to return the elements, oldest first.
+ * @param   max_msgs  Size of the array.
+ *
+ * @returns Number of elements taken.
+******************************************************************************/
+static int ring_buffer_take(ring_buffer * buffer, void ** msgs, int max_msgs)
+{
+  int count = 0;
+  int ii;
+  unsigned long pos = 0;
+  unsigned long sequence = 0;
+  ring_buffer_cell * cell = NULL;
+
+  /***************************************************************************/
+  /* A cell holds an element once its producer has moved its sequence on to  */
+  /* one past the position.  Count the run of cells holding elements from    */
+  /* the next-read position, then claim them all by moving the next-read     */
+  /* position on past them, which only fails if a producer discarding the    */
+  /* oldest element claimed it first, in which case try again.               */
+  /***************************************************************************/
+  pos = __atomic_load_n(&buffer->next_read, __ATOMIC_RELAXED);
+  while (1)
+  {
+    count = 0;
+    while (count < max_msgs)
+    {
+      cell = &buffer->ring[(pos + count) & buffer->mask];
+      sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+      if (sequence != pos + count + 1)
+      {
+        break;
+      }
+      count++;
+    }
+    if ((count == 0) ||
+        (__atomic_compare_exchange_n(&buffer->next_read,
+                                     &pos,
+                                     pos + count,
+                                     0,
+                                     __ATOMIC_RELAXED,
+                                     __ATOMIC_RELAXED)))
+    {
+      break;
+    }
+  }
+
+  /***************************************************************************/
+  /* Having taken the elements, move the sequence of each cell on to the     */
+  /* position it will next be written at, one lap later.                     */
+  /***************************************************************************/
+  for (ii = 0; ii < count; ii++)
+  {
+    cell = &buffer->ring[(pos + ii) & buffer->mask];
+    msgs[ii] = cell->msg;
+    cell->msg = NULL;
+    __atomic_store_n(&cell->sequence,
+                     pos + ii + buffer->mask + 1,
+                     __ATOMIC_RELEASE);
+  }
+
+  /***************************************************************************/
+  /* Only wake writers if they're waiting for the ring to have room.         */
+  /***************************************************************************/
+  if (count > 0)
+  {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&buffer->writers_waiting, __ATOMIC_RELAXED))
+    {
+      pthread_mutex_lock(&buffer->ring_mutex);
+      pthread_cond_broadcast(&buffer->space_cv);
+      pthread_mutex_unlock(&buffer->ring_mutex);
+    }
+  }
+
+  return count;
+}
+
+/**************************************************************************//**
+ * Work out the deadline for a timed wait.
+ *
+ * @param   deadline    Returns the time, on the monotonic clock, to stop
+ *                      waiting.
+ * @param   timeout_ms  How long to wait, in milliseconds.
+ *
+ * @returns Nothing
+******************************************************************************/
+static void ring_buffer_deadline(struct timespec * deadline, int timeout_ms)
+{
+  clock_gettime(CLOCK_MONOTONIC, deadline);
+  deadline->tv_sec += timeout_ms / 1000;
+  deadline->tv_nsec += (timeout_ms % 1000) * 1000000L;
+  if (deadline->tv_nsec >= 1000000000L)
+  {
+    deadline->tv_sec++;
+    deadline->tv_nsec -= 1000000000L;
+  }
+}
+
+/**************************************************************************//**
+ * Try to read an element from a ring_buffer without blocking.
+ *
+ * Unlike the other reads, this may be called by any thread, so that a
+ * producer can make room by discarding the oldest element.
+ *
+ * @param   buffer  Pointer to the ring-buffer to be read.
+ *
+ * @returns Pointer to the element read from the buffer, or NULL if there is
+ *          none available.
+******************************************************************************/
+void * ring_buffer_try_read(ring_buffer * buffer)
+{
+  void * msg = NULL;
+
+  ring_buffer_take(buffer, &msg, 1);
+
+  return msg;
+}
+
 /**************************************************************************//**
  * Read an element from a ring_buffer.
  *
  * Reads an element from the ring_buffer, advancing the next-read position.
- * Operation is synchronized and therefore MT-safe.  Blocks if no data is
+ * Only one thread may read from the ring_buffer.  Blocks if no data is
  * available.
  *
  * @param   buffer  Pointer to the ring-buffer to be read.
@@ -100,41 +252,280 @@ void ring_buffer_initialize(ring_buffer * buffer, int size)
 void * ring_buffer_read(ring_buffer * buffer)
 {
   void *msg = NULL;
-  EVEL_DEBUG("RBR: Ring buffer read");
 
-  pthread_mutex_lock(&buffer->ring_mutex);
+  while ((msg = ring_buffer_try_read(buffer)) == NULL)
+  {
+    ring_buffer_wait(buffer, 1, NULL);
+  }
+  return msg;
+}
+
+/**************************************************************************//**
+ * Read an element from a ring_buffer, waiting no longer than a timeout.
+ *
+ * Only one thread may read from the ring_buffer.
+ *
+ * @param   buffer      Pointer to the ring-buffer to be read.
+ * @param   timeout_ms  How long to wait for an element, in milliseconds, or
+ *                      0 not to wait, or -1 to wait indefinitely.
+ *
+ * @returns Pointer to the element read from the buffer, or NULL if none
+ *          became available before the timeout.
+******************************************************************************/
+void * ring_buffer_read_timed(ring_buffer * buffer, int timeout_ms)
+{
+  void * msg = NULL;
+
+  ring_buffer_read_many(buffer, &msg, 1, timeout_ms);
+
+  return msg;
+}
+
+/**************************************************************************//**
+ * Read as many elements as are available from a ring_buffer, up to a limit.
+ *
+ * Waits no longer than the timeout for the first element, then takes every
+ * element available, up to the limit, advancing the next-read position once
+ * for all of them.  Only one thread may read from the ring_buffer.
+ *
+ * @param   buffer      Pointer to the ring-buffer to be read.
+ * @param   msgs        Array in which to return the elements, oldest first.
+ * @param   max_msgs    Size of the array.  Must be > 0.
+ * @param   timeout_ms  How long to wait for an element, in milliseconds, or
+ *                      0 not to wait, or -1 to wait indefinitely.
+ *
+ * @returns Number of elements read, which is 0 if none became available
+ *          before the timeout.
+******************************************************************************/
+int ring_buffer_read_many(ring_buffer * buffer,
+                          void ** msgs,
+                          int max_msgs,
+                          int timeout_ms)
+{
+  struct timespec deadline;
+  int count = 0;
+
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(buffer != NULL);
+  assert(msgs != NULL);
+  assert(max_msgs > 0);
+  assert(timeout_ms >= -1);
+
+  /***************************************************************************/
+  /* Work out the deadline up front, so that waking for an element written   */
+  /* to another ring-buffer sharing the reader doesn't extend the wait.      */
+  /***************************************************************************/
+  if (timeout_ms > 0)
+  {
+    ring_buffer_deadline(&deadline, timeout_ms);
+  }
+
+  while (((count = ring_buffer_take(buffer, msgs, max_msgs)) == 0) &&
+         (timeout_ms != 0))
+  {
+    if (!ring_buffer_wait(buffer, 1, (timeout_ms > 0) ? &deadline : NULL))
+    {
+      break;
+    }
+  }
+
+  return count;
+}
+
+/**************************************************************************//**
+ * Share the reader of one ring_buffer with another.
+ *
+ * Writes to the ring_buffer wake the reader through the waker, so that a
+ * single reader can wait on a set of ring-buffers with ::ring_buffer_wait.
+ *
+ * @param   buffer  Pointer to the ring-buffer to share.
+ * @param   waker   Pointer to the ring-buffer whose reader it shares, which
+ *                  must not itself share another's reader.
+ *
+ * @returns Nothing
+******************************************************************************/
+void ring_buffer_share_reader(ring_buffer * buffer, ring_buffer * waker)
+{
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(buffer != NULL);
+  assert(waker != NULL);
+  assert(waker->waker == waker);
+
+  buffer->waker = waker;
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Wait for data in any of a set of ring-buffers.
+ *
+ * Blocks until at least one of the ring-buffers is non-empty, or the
+ * deadline passes.  The ring-buffers must all share the reader of the first.
+ *
+ * @param   buffers     Array of the ring-buffers to wait on.
+ * @param   num_buffers How many ring-buffers are in the array.
+ * @param   deadline    The time, on the monotonic clock, to stop waiting, or
+ *                      NULL to wait indefinitely.
+ *
+ * @returns Whether there is data in any of the ring-buffers.
+ * @retval  0       The deadline passed with all of the ring-buffers empty.
+ * @retval  1       There is data in at least one of the ring-buffers.
+******************************************************************************/
+int ring_buffer_wait(ring_buffer * buffers,
+                     int num_buffers,
+                     const struct timespec * deadline)
+{
+  ring_buffer * waker = buffers[0].waker;
+  int empty = 1;
+  int timed_out = 0;
+  int ii;
+
+  /***************************************************************************/
+  /* Say that we're waiting before checking again under the lock, so that a  */
+  /* writer either sees us waiting or we see its element.  Writers only      */
+  /* signal while holding the lock, so the wakeup can't be missed.           */
+  /***************************************************************************/
+  pthread_mutex_lock(&waker->ring_mutex);
+  __atomic_store_n(&waker->reader_waiting, 1, __ATOMIC_SEQ_CST);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
   while (1)
   {
-    EVEL_DEBUG("RBR: got lock. NR=%d NW=%d",
-               buffer->next_read,
-               buffer->next_write);
-    if(buffer->next_read != buffer->next_write)
+    empty = 1;
+    for (ii = 0; (ii < num_buffers) && empty; ii++)
+    {
+      assert(buffers[ii].waker == waker);
+      empty = ring_buffer_is_empty(&buffers[ii]);
+    }
+    if ((!empty) || timed_out)
     {
-      EVEL_DEBUG("RBR: buffer has item available");
-      msg = (buffer->ring)[buffer->next_read];
-      buffer->ring[buffer->next_read] = NULL;
-      buffer->next_read = (buffer->next_read + 1) % buffer->size;
-      EVEL_DEBUG("RBR: next read location is %d", buffer->next_read);
-      pthread_mutex_unlock(&buffer->ring_mutex);
       break;
     }
+    EVEL_DEBUG("RBR: Waiting for condition variable");
+    if (deadline == NULL)
+    {
+      pthread_cond_wait(&waker->ring_cv, &waker->ring_mutex);
+    }
     else
     {
-      EVEL_DEBUG("RBR: Waiting for condition variable");
-      pthread_cond_wait(&buffer->ring_cv, &buffer->ring_mutex);
-      EVEL_DEBUG("RBR: Condition variable wait completed");
+      timed_out = (pthread_cond_timedwait(&waker->ring_cv,
+                                          &waker->ring_mutex,
+                                          deadline) == ETIMEDOUT);
     }
+    EVEL_DEBUG("RBR: Condition variable wait completed");
   }
-  EVEL_DEBUG("RBR: Ring buffer read returning data at %lp", msg);
-  return msg;
+  __atomic_store_n(&waker->reader_waiting, 0, __ATOMIC_RELAXED);
+  pthread_mutex_unlock(&waker->ring_mutex);
+
+  return !empty;
+}
+
+/**************************************************************************//**
+ * Put an element into a ring_buffer if there is room, without logging.
+ *
+ * Writes an element into the ring_buffer, advancing the next-write position.
+ * Operation is lock-free and MT-safe.  Only wakes the reader if it is
+ * waiting for the ring_buffer to become non-empty.
+ *
+ * @param   buffer  Pointer to the ring-buffer to be written.
+ * @param   msg     Pointer to data to be stored in the ring_buffer.
+ *
+ * @returns Number of items written.
+ * @retval  1       The data was written successfully.
+ * @retval  0       The ring_buffer was full so no data written.
+******************************************************************************/
+static int ring_buffer_put(ring_buffer * buffer, void * msg)
+{
+  int items_written = 0;
+  unsigned long pos = 0;
+  unsigned long sequence = 0;
+  long diff = 0;
+  ring_buffer_cell * cell = NULL;
+
+  /***************************************************************************/
+  /* Claim the next position by moving the next-write position on past it,   */
+  /* so long as its cell has been emptied since it was last written.  If     */
+  /* another writer claims it first, try again at the new position.          */
+  /***************************************************************************/
+  pos = __atomic_load_n(&buffer->next_write, __ATOMIC_RELAXED);
+  while (1)
+  {
+    cell = &buffer->ring[pos & buffer->mask];
+    sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    diff = (long) sequence - (long) pos;
+    if (diff == 0)
+    {
+      if (__atomic_compare_exchange_n(&buffer->next_write,
+                                      &pos,
+                                      pos + 1,
+                                      1,
+                                      __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED))
+      {
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      goto exit_label;
+    }
+    else
+    {
+      pos = __atomic_load_n(&buffer->next_write, __ATOMIC_RELAXED);
+    }
+  }
+
+  /***************************************************************************/
+  /* Fill the cell and hand it to the reader.                                */
+  /***************************************************************************/
+  cell->msg = msg;
+  __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+  items_written = 1;
+
+  /***************************************************************************/
+  /* Only wake the reader if it's waiting for the ring to become non-empty.  */
+  /***************************************************************************/
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&buffer->waker->reader_waiting, __ATOMIC_RELAXED))
+  {
+    pthread_mutex_lock(&buffer->waker->ring_mutex);
+    pthread_cond_signal(&buffer->waker->ring_cv);
+    pthread_mutex_unlock(&buffer->waker->ring_mutex);
+    EVEL_DEBUG("RBW: woke reader");
+  }
+
+exit_label:
+  return items_written;
+}
+
+/**************************************************************************//**
+ * Check whether a ring_buffer is full.
+ *
+ * @param   buffer  Pointer to the ring-buffer to be tested.
+ *
+ * @returns Whether the next position to be written is still to be read.
+******************************************************************************/
+static int ring_buffer_is_full(ring_buffer * buffer)
+{
+  unsigned long pos = __atomic_load_n(&buffer->next_write, __ATOMIC_RELAXED);
+  ring_buffer_cell * cell = &buffer->ring[pos & buffer->mask];
+  unsigned long sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+
+  return ((long) sequence - (long) pos < 0);
 }
 
 /**************************************************************************//**
  * Write an element into a ring_buffer.
  *
  * Writes an element into the ring_buffer, advancing the next-write position.
- * Operation is synchronized and therefore MT-safe.  Fails if the buffer is
- * full without blocking.
+ * Operation is lock-free and MT-safe.  Fails if the buffer is full without
+ * blocking.  Only wakes the reader if it is waiting for the ring_buffer to
+ * become non-empty.
  *
  * @param   buffer  Pointer to the ring-buffer to be written.
  * @param   msg     Pointer to data to be stored in the ring_buffer.
@@ -145,38 +536,81 @@ void * ring_buffer_read(ring_buffer * buffer)
 ******************************************************************************/
 int ring_buffer_write(ring_buffer * buffer, void * msg)
 {
-  int item_count = 0;
+  int items_written = ring_buffer_put(buffer, msg);
+
+  if (items_written == 0)
+  {
+    EVEL_ERROR("RBW: ring buffer full - unable to write event");
+  }
+
+  return items_written;
+}
+
+/**************************************************************************//**
+ * Write an element into a ring_buffer, waiting no longer than a timeout for
+ * there to be room.
+ *
+ * @param   buffer      Pointer to the ring-buffer to be written.
+ * @param   msg         Pointer to data to be stored in the ring_buffer.
+ * @param   timeout_ms  How long to wait for room, in milliseconds, or 0 not
+ *                      to wait, or -1 to wait indefinitely.
+ *
+ * @returns Number of items written.
+ * @retval  1       The data was written successfully.
+ * @retval  0       The ring_buffer stayed full so no data written.
+******************************************************************************/
+int ring_buffer_write_timed(ring_buffer * buffer, void * msg, int timeout_ms)
+{
+  struct timespec deadline;
   int items_written = 0;
-  EVEL_DEBUG("RBW: Ring Buffer Write message at %lp", msg);
+  int timed_out = 0;
 
-  pthread_mutex_lock(&buffer->ring_mutex);
-  EVEL_DEBUG("RBW: got lock. NR=%d NW=%d SZ=%d",
-             buffer->next_read,
-             buffer->next_write,
-             buffer->size);
+  /***************************************************************************/
+  /* Check assumptions.                                                      */
+  /***************************************************************************/
+  assert(buffer != NULL);
+  assert(timeout_ms >= -1);
 
-  item_count = (buffer->next_write - buffer->next_read) % buffer->size;
-  if (item_count < 0)
+  if (timeout_ms > 0)
   {
-    item_count += buffer->size;
+    ring_buffer_deadline(&deadline, timeout_ms);
   }
-  if (item_count < buffer->size - 1)
+
+  /***************************************************************************/
+  /* Say that we're waiting before checking again under the lock, so that a  */
+  /* reader either sees us waiting or we see the room it made.  Readers only */
+  /* wake writers while holding the lock, so the wakeup can't be missed.     */
+  /***************************************************************************/
+  while (((items_written = ring_buffer_put(buffer, msg)) == 0) &&
+         (timeout_ms != 0) &&
+         (!timed_out))
   {
-    EVEL_DEBUG("RBW: %d items in buffer", item_count);
-    buffer->ring[buffer->next_write] = msg;
-    buffer->next_write = (buffer->next_write + 1) % buffer->size;
-    EVEL_DEBUG("RBW: next write location is %d", buffer->next_write);
-    items_written = 1;
+    pthread_mutex_lock(&buffer->ring_mutex);
+    __atomic_add_fetch(&buffer->writers_waiting, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (ring_buffer_is_full(buffer))
+    {
+      EVEL_DEBUG("RBW: Waiting for room in ring buffer");
+      if (timeout_ms < 0)
+      {
+        pthread_cond_wait(&buffer->space_cv, &buffer->ring_mutex);
+      }
+      else
+      {
+        timed_out = (pthread_cond_timedwait(&buffer->space_cv,
+                                            &buffer->ring_mutex,
+                                            &deadline) == ETIMEDOUT);
+      }
+    }
+    __atomic_sub_fetch(&buffer->writers_waiting, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&buffer->ring_mutex);
   }
-  else
+
+  if (items_written == 0)
   {
     EVEL_ERROR("RBW: ring buffer full - unable to write event");
   }
 
-  pthread_mutex_unlock(&buffer->ring_mutex);
-  EVEL_DEBUG("RBW: released lock");
-  pthread_cond_signal(&buffer->ring_cv);
-
   return items_written;
 }
 
@@ -194,13 +628,13 @@ int ring_buffer_write(ring_buffer * buffer, void * msg)
 int ring_buffer_is_empty(ring_buffer * buffer)
 {
   int is_empty = 0;
-  EVEL_DEBUG("RBE: Ring empty check");
+  unsigned long pos = __atomic_load_n(&buffer->next_read, __ATOMIC_RELAXED);
+  ring_buffer_cell * cell = &buffer->ring[pos & buffer->mask];
 
-  pthread_mutex_lock(&buffer->ring_mutex);
-  is_empty = (buffer->next_read == buffer->next_write);
-  pthread_mutex_unlock(&buffer->ring_mutex);
+  /***************************************************************************/
+  /* An element which has been claimed but not yet written doesn't count.    */
+  /***************************************************************************/
+  is_empty = (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != pos + 1);
 
-  EVEL_DEBUG("RBE: Ring state= %d", is_empty);
   return is_empty;
 }
-
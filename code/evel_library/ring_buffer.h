@@ -38,24 +38,58 @@
  *****************************************************************************/
 
 #include <pthread.h>
+#include <time.h>
+
+/*****************************************************************************/
+/* Size of a cache line.  The indexes written by the producers and by the    */
+/* consumer are kept on separate cache lines so that they don't contend.     */
+/*****************************************************************************/
+#define RING_BUFFER_CACHE_LINE 64
+
+/**************************************************************************//**
+ * Ring buffer cell.
+ *
+ * The sequence number of a cell says whose turn it is: a producer may fill
+ * the cell when its sequence equals the position being written, and the
+ * consumer may empty it when its sequence is one more than the position
+ * being read.
+ *****************************************************************************/
+typedef struct ring_buffer_cell
+{
+    unsigned long sequence;
+    void * msg;
+} ring_buffer_cell;
 
 /**************************************************************************//**
  * Ring buffer structure.
+ *
+ * A bounded lock-free queue for many producers and a single consumer, though
+ * producers may also take elements to make room.  The mutex and condition
+ * variables are only used to put the consumer to sleep when the ring is
+ * empty, or producers to sleep when it is full, and to wake them up again.
+ * Several ring-buffers can share a consumer, in which case writes to any of
+ * them wake the consumer through the synchronization objects of the waker.
  *****************************************************************************/
 typedef struct ring_buffer
 {
     int size;
-    int next_write;
-    int next_read;
-    void ** ring;
+    unsigned long mask;
+    ring_buffer_cell * ring;
     pthread_cond_t ring_cv;
+    pthread_cond_t space_cv;
     pthread_mutex_t ring_mutex;
+    struct ring_buffer * waker;
+    unsigned long next_write __attribute__ ((aligned (RING_BUFFER_CACHE_LINE)));
+    unsigned long next_read __attribute__ ((aligned (RING_BUFFER_CACHE_LINE)));
+    int reader_waiting __attribute__ ((aligned (RING_BUFFER_CACHE_LINE)));
+    int writers_waiting;
 } ring_buffer;
 
 /**************************************************************************//**
  * Ring buffer initialization.
  *
- * Initialize the buffer supplied to the specified size.
+ * Initialize the buffer supplied to the specified size.  The size is rounded
+ * up to a power of two.
  *
  * @param   buffer  Pointer to the ring-buffer to be initialized.
  * @param   size    How many elements to be stored in the ring-buffer.
@@ -68,7 +102,7 @@ void ring_buffer_initialize(ring_buffer * buffer, int size);
  * Read an element from a ring_buffer.
  *
  * Reads an element from the ring_buffer, advancing the next-read position.
- * Operation is synchronized and therefore MT-safe.  Blocks if no data is
+ * Only one thread may read from the ring_buffer.  Blocks if no data is
  * available.
  *
  * @param   buffer  Pointer to the ring-buffer to be read.
@@ -77,12 +111,94 @@ void ring_buffer_initialize(ring_buffer * buffer, int size);
 ******************************************************************************/
 void * ring_buffer_read(ring_buffer * buffer);
 
+/**************************************************************************//**
+ * Read an element from a ring_buffer, waiting no longer than a timeout.
+ *
+ * Only one thread may read from the ring_buffer.
+ *
+ * @param   buffer      Pointer to the ring-buffer to be read.
+ * @param   timeout_ms  How long to wait for an element, in milliseconds, or
+ *                      0 not to wait, or -1 to wait indefinitely.
+ *
+ * @returns Pointer to the element read from the buffer, or NULL if none
+ *          became available before the timeout.
+******************************************************************************/
+void * ring_buffer_read_timed(ring_buffer * buffer, int timeout_ms);
+
+/**************************************************************************//**
+ * Read as many elements as are available from a ring_buffer, up to a limit.
+ *
+ * Waits no longer than the timeout for the first element, then takes every
+ * element available, up to the limit, advancing the next-read position once
+ * for all of them.  Only one thread may read from the ring_buffer.
+ *
+ * @param   buffer      Pointer to the ring-buffer to be read.
+ * @param   msgs        Array in which to return the elements, oldest first.
+ * @param   max_msgs    Size of the array.  Must be > 0.
+ * @param   timeout_ms  How long to wait for an element, in milliseconds, or
+ *                      0 not to wait, or -1 to wait indefinitely.
+ *
+ * @returns Number of elements read, which is 0 if none became available
+ *          before the timeout.
+******************************************************************************/
+int ring_buffer_read_many(ring_buffer * buffer,
+                          void ** msgs,
+                          int max_msgs,
+                          int timeout_ms);
+
+/**************************************************************************//**
+ * Try to read an element from a ring_buffer without blocking.
+ *
+ * Unlike the other reads, this may be called by any thread, so that a
+ * producer can make room by discarding the oldest element.
+ *
+ * @param   buffer  Pointer to the ring-buffer to be read.
+ *
+ * @returns Pointer to the element read from the buffer, or NULL if there is
+ *          none available.
+******************************************************************************/
+void * ring_buffer_try_read(ring_buffer * buffer);
+
+/**************************************************************************//**
+ * Share the reader of one ring_buffer with another.
+ *
+ * Writes to the ring_buffer wake the reader through the waker, so that a
+ * single reader can wait on a set of ring-buffers with ::ring_buffer_wait.
+ *
+ * @param   buffer  Pointer to the ring-buffer to share.
+ * @param   waker   Pointer to the ring-buffer whose reader it shares, which
+ *                  must not itself share another's reader.
+ *
+ * @returns Nothing
+******************************************************************************/
+void ring_buffer_share_reader(ring_buffer * buffer, ring_buffer * waker);
+
+/**************************************************************************//**
+ * Wait for data in any of a set of ring-buffers.
+ *
+ * Blocks until at least one of the ring-buffers is non-empty, or the
+ * deadline passes.  The ring-buffers must all share the reader of the first.
+ *
+ * @param   buffers     Array of the ring-buffers to wait on.
+ * @param   num_buffers How many ring-buffers are in the array.
+ * @param   deadline    The time, on the monotonic clock, to stop waiting, or
+ *                      NULL to wait indefinitely.
+ *
+ * @returns Whether there is data in any of the ring-buffers.
+ * @retval  0       The deadline passed with all of the ring-buffers empty.
+ * @retval  1       There is data in at least one of the ring-buffers.
+******************************************************************************/
+int ring_buffer_wait(ring_buffer * buffers,
+                     int num_buffers,
+                     const struct timespec * deadline);
+
 /**************************************************************************//**
  * Write an element into a ring_buffer.
  *
  * Writes an element into the ring_buffer, advancing the next-write position.
- * Operation is synchronized and therefore MT-safe.  Fails if the buffer is
- * full without blocking.
+ * Operation is lock-free and MT-safe.  Fails if the buffer is full without
+ * blocking.  Only wakes the reader if it is waiting for the ring_buffer to
+ * become non-empty.
  *
  * @param   buffer  Pointer to the ring-buffer to be written.
  * @param   msg     Pointer to data to be stored in the ring_buffer.
@@ -93,6 +209,21 @@ void * ring_buffer_read(ring_buffer * buffer);
 ******************************************************************************/
 int ring_buffer_write(ring_buffer * buffer, void * msg);
 
+/**************************************************************************//**
+ * Write an element into a ring_buffer, waiting no longer than a timeout for
+ * there to be room.
+ *
+ * @param   buffer      Pointer to the ring-buffer to be written.
+ * @param   msg         Pointer to data to be stored in the ring_buffer.
+ * @param   timeout_ms  How long to wait for room, in milliseconds, or 0 not
+ *                      to wait, or -1 to wait indefinitely.
+ *
+ * @returns Number of items written.
+ * @retval  1       The data was written successfully.
+ * @retval  0       The ring_buffer stayed full so no data written.
+******************************************************************************/
+int ring_buffer_write_timed(ring_buffer * buffer, void * msg, int timeout_ms);
+
 /**************************************************************************//**
  * Tests whether there is data in the ring_buffer.
  *
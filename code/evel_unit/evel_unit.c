@@ -41,11 +41,19 @@
 #include <string.h>
 #include <assert.h>
 #include <stdlib.h>
+#include <malloc.h>
 #include <sys/time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 
 #include "evel.h"
 #include "evel_internal.h"
 #include "evel_throttle.h"
+#include "evel_spool.h"
+#include "ring_buffer.h"
 #include "metadata.h"
 
 typedef enum {
@@ -74,6 +82,32 @@ static void test_encode_service_subset(const SERVICE_TEST service_test);
 static void test_encode_signaling();
 static void test_encode_state_change();
 static void test_encode_syslog();
+static void test_encode_event_list_entry();
+static void test_encode_encoded_event();
+static void test_encode_large_event();
+static void test_encode_string_escaping();
+static void test_event_arena();
+static void test_event_pool();
+static void test_event_size();
+static void test_event_sequence();
+static void * test_event_sequence_thread(void * arg);
+static void test_throttle_publish();
+static void * test_throttle_publish_thread(void * arg);
+static void test_throttle_fields();
+static void test_throttle_query();
+static void test_hash_map();
+static void test_spool();
+static void test_endpoints();
+static void test_retry_delay();
+static void test_flush();
+static void test_priority_posts();
+static void test_ring_buffer_lanes();
+static void * test_ring_buffer_lanes_thread(void * arg);
+static void test_ring_buffer_read_many();
+static void test_ring_buffer_write_timed();
+static void * test_ring_buffer_write_timed_thread(void * arg);
+static void test_encode_other_named_arrays();
+static static void handle_json_response(char * json, MEMORY_CHUNK * post);
 static void test_json_response_junk();
 static void test_json_provide_throttle_state();
 static void test_json_measurement_interval();
@@ -139,6 +173,27 @@ int main(int argc, char ** argv)
   test_encode_signaling();
   test_encode_state_change();
   test_encode_syslog();
+  test_encode_event_list_entry();
+  test_encode_encoded_event();
+  test_encode_large_event();
+  test_encode_string_escaping();
+  test_event_arena();
+  test_event_pool();
+  test_event_size();
+  test_event_sequence();
+  test_throttle_publish();
+  test_throttle_fields();
+  test_throttle_query();
+  test_hash_map();
+  test_spool();
+  test_endpoints();
+  test_retry_delay();
+  test_flush();
+  test_priority_posts();
+  test_ring_buffer_lanes();
+  test_ring_buffer_read_many();
+  test_ring_buffer_write_timed();
+  test_encode_other_named_arrays();
 
   /***************************************************************************/
   /* Test JSON Throttle.                                                     */
@@ -224,6 +279,1306 @@ void test_encode_heartbeat()
   evel_free_event(heartbeat);
 }
 
+void test_encode_event_list_entry()
+{
+  int event_size = 0;
+  int entry_size = 0;
+  char event_body[EVEL_MAX_JSON_BODY];
+  char entry_body[EVEL_MAX_JSON_BODY];
+  char expected[EVEL_MAX_JSON_BODY];
+
+  /***************************************************************************/
+  /* An eventList entry is exactly the "event" object of a single post.      */
+  /***************************************************************************/
+  evel_set_next_event_sequence(121);
+  EVENT_HEADER * heartbeat = evel_new_heartbeat();
+  assert(heartbeat != NULL);
+
+  event_size = evel_json_encode_event(
+    event_body, EVEL_MAX_JSON_BODY, heartbeat);
+  entry_size = evel_json_encode_event_list_entry(
+    entry_body, EVEL_MAX_JSON_BODY, heartbeat);
+  snprintf(expected, EVEL_MAX_JSON_BODY, "{\"event\": %s}", entry_body);
+
+  compare_strings(expected, event_body, EVEL_MAX_JSON_BODY, "List entry");
+  assert((entry_size == (int)strlen(entry_body)) && "Bad size returned");
+  assert((entry_size == event_size - 11) && "Bad entry size");
+
+  evel_free_event(heartbeat);
+}
+
+void test_encode_encoded_event()
+{
+  int entry_size = 0;
+  char entry_body[EVEL_MAX_JSON_BODY];
+  EVENT_ENCODED * encoded = NULL;
+
+  /***************************************************************************/
+  /* An encoded event holds the eventList entry for the event, and keeps its */
+  /* priority so that it is queued in the same place.                        */
+  /***************************************************************************/
+  evel_set_next_event_sequence(122);
+  EVENT_FAULT * fault = evel_new_fault("My alarm condition",
+                                       "It broke very badly",
+                                       EVEL_PRIORITY_HIGH,
+                                       EVEL_SEVERITY_MAJOR,
+                                       EVEL_SOURCE_HOST,
+                                       EVEL_VF_STATUS_ACTIVE);
+  assert(fault != NULL);
+
+  entry_size = evel_json_encode_event_list_entry(
+    entry_body, EVEL_MAX_JSON_BODY, (EVENT_HEADER *) fault);
+  encoded = evel_new_encoded_event((EVENT_HEADER *) fault);
+  assert(encoded != NULL);
+  evel_free_event(fault);
+
+  assert(encoded->internal.header.event_domain == EVEL_DOMAIN_INTERNAL);
+  assert(encoded->internal.header.priority == EVEL_PRIORITY_HIGH);
+  assert(encoded->internal.command == EVT_CMD_POST_ENCODED);
+  assert((encoded->json_size == entry_size) && "Bad encoded size");
+  compare_strings(entry_body, encoded->json, EVEL_MAX_JSON_BODY,
+                  "Encoded event");
+
+  evel_free_event(encoded);
+}
+
+void test_encode_large_event()
+{
+  int ii;
+  int arena_size = 0;
+  int fixed_size = 0;
+  char cpu_id[32];
+  char fixed_body[EVEL_MAX_JSON_BODY];
+  EVEL_JSON_ARENA * arena = NULL;
+
+  /***************************************************************************/
+  /* A measurement with enough CPUs to overflow a fixed size buffer.         */
+  /***************************************************************************/
+  EVENT_MEASUREMENT * measurement = evel_new_measurement(5.5);
+  assert(measurement != NULL);
+  for (ii = 0; ii < 1000; ii++)
+  {
+    sprintf(cpu_id, "cpu%d", ii);
+    evel_measurement_new_cpu_use_add(measurement, cpu_id, ii);
+  }
+
+  /***************************************************************************/
+  /* The arena grows to hold the whole event.                                */
+  /***************************************************************************/
+  arena = evel_json_thread_arena();
+  assert(arena != NULL);
+  arena_size = evel_json_encode_event_arena(arena, (EVENT_HEADER *) measurement);
+  assert((arena_size > EVEL_MAX_JSON_BODY) && "Event not large enough");
+  assert((arena_size == (int)strlen(arena->json)) && "Bad size returned");
+  assert((strstr(arena->json, "\"cpu999\"") != NULL) && "Event truncated");
+  assert((strcmp(arena->json + arena_size - 3, "}}}") == 0) && "Bad JSON");
+
+  /***************************************************************************/
+  /* A fixed size buffer stops at the end of the buffer, without overflow.   */
+  /***************************************************************************/
+  fixed_size = evel_json_encode_event(
+    fixed_body, EVEL_MAX_JSON_BODY, (EVENT_HEADER *) measurement);
+  assert((fixed_size < EVEL_MAX_JSON_BODY) && "Bad truncated size");
+  assert((strncmp(fixed_body, arena->json, fixed_size) == 0) &&
+         "Bad truncated JSON");
+
+  evel_free_event(measurement);
+}
+
+void test_encode_string_escaping()
+{
+  char * expected =
+    "{\"clean\": \"A string long enough to take the vector path, twice over\", "
+    "\"escaped\": \"A \\\"quoted\\\" C:\\\\path, then \\b\\f\\n\\r\\t, "
+    "then \\u0001\\u001f and 40\u00b0 at the end of a long run\\n\"}";
+  int ii;
+  char json_body[EVEL_MAX_JSON_BODY];
+  char all_controls[33];
+  EVEL_JSON_BUFFER jbuf;
+
+  evel_json_buffer_init(&jbuf, json_body, EVEL_MAX_JSON_BODY, NULL);
+  evel_json_open_object(&jbuf);
+  evel_enc_kv_string(
+    &jbuf, "clean", "A string long enough to take the vector path, twice over");
+  evel_enc_kv_string(
+    &jbuf,
+    "escaped",
+    "A \"quoted\" C:\\path, then \b\f\n\r\t, "
+    "then \x01\x1f and 40\u00b0 at the end of a long run\n");
+  evel_json_close_object(&jbuf);
+  compare_strings(expected, json_body, EVEL_MAX_JSON_BODY, "Escaping");
+
+  /***************************************************************************/
+  /* Every control character is escaped, none is passed through raw.         */
+  /***************************************************************************/
+  for (ii = 0; ii < 32; ii++)
+  {
+    all_controls[ii] = (char) (ii + 1);
+  }
+  all_controls[31] = '\x1f';
+  all_controls[32] = '\0';
+
+  evel_json_buffer_init(&jbuf, json_body, EVEL_MAX_JSON_BODY, NULL);
+  evel_enc_kv_string(&jbuf, "controls", all_controls);
+  for (ii = 0; ii < jbuf.offset; ii++)
+  {
+    assert(((unsigned char) json_body[ii] >= 0x20) && "Unescaped control");
+  }
+  assert((strstr(json_body, "\\u0002\\u0003") != NULL) && "Bad escape");
+  assert((strcmp(json_body + jbuf.offset - 7, "\\u001f\"") == 0) &&
+         "Bad final escape");
+}
+
+void test_event_arena()
+{
+  int pass;
+  char json_body[2][EVEL_MAX_JSON_BODY];
+  EVENT_MEASUREMENT * measurement = NULL;
+  MEASUREMENT_CPU_USE * cpu_use = NULL;
+  MEASUREMENT_LATENCY_BUCKET * bucket = NULL;
+  MEASUREMENT_VNIC_PERFORMANCE * vnic_performance = NULL;
+
+  /***************************************************************************/
+  /* Build the same measurement without and then with an arena, with a first */
+  /* chunk small enough that the arena has to grow.                          */
+  /***************************************************************************/
+  for (pass = 0; pass < 2; pass++)
+  {
+    evel_set_event_arena_size(pass * 256);
+    evel_set_next_event_sequence(2000);
+    measurement = evel_new_measurement(5.5);
+    assert(measurement != NULL);
+    assert(((measurement->header.arena != NULL) == (pass == 1)) &&
+           "Bad arena");
+    evel_start_epoch_set(&measurement->header, 2000);
+    evel_last_epoch_set(&measurement->header, 3000);
+    evel_reporting_entity_name_set(&measurement->header, "entity_name");
+    evel_measurement_type_set(measurement, "Perf management...");
+    evel_measurement_custom_measurement_add(measurement, "group1", "name1",
+                                            "value1");
+
+    cpu_use = evel_measurement_new_cpu_use_add(measurement, "cpu1", 11.11);
+    evel_measurement_cpu_use_idle_set(cpu_use, 22.22);
+    evel_measurement_new_mem_use_add(measurement, "mem1", "vm1", 100.0);
+
+    bucket = evel_new_meas_latency_bucket(20);
+    evel_meas_latency_bucket_high_end_set(bucket, 20.0);
+    evel_meas_latency_bucket_add(measurement, bucket);
+
+    vnic_performance = evel_measurement_new_vnic_performance("eth0", "true");
+    evel_vnic_performance_rx_bcast_pkt_acc_set(vnic_performance, 11);
+    evel_meas_vnic_performance_add(measurement, vnic_performance);
+
+    evel_json_encode_event(
+      json_body[pass], EVEL_MAX_JSON_BODY, (EVENT_HEADER *) measurement);
+    evel_free_event(measurement);
+  }
+  evel_set_event_arena_size(0);
+
+  compare_strings(json_body[0], json_body[1], EVEL_MAX_JSON_BODY, "Arena");
+  assert((strstr(json_body[1], "\"eth0\"") != NULL) && "Bad arena event");
+}
+
+void test_event_pool()
+{
+  int pass;
+  EVENT_HEADER * heartbeat = NULL;
+  EVENT_HEADER * reused = NULL;
+  EVENT_STATE_CHANGE * state_change = NULL;
+
+  /***************************************************************************/
+  /* A freed event's structure is reused by the next event in its domain,    */
+  /* with and without arenas, and comes back zeroed.                         */
+  /***************************************************************************/
+  for (pass = 0; pass < 2; pass++)
+  {
+    evel_set_event_arena_size(pass * 256);
+    heartbeat = evel_new_heartbeat();
+    assert(heartbeat != NULL);
+    evel_reporting_entity_name_set(heartbeat, "entity_name");
+    evel_free_event(heartbeat);
+
+    state_change = evel_new_state_change(EVEL_ENTITY_STATE_IN_SERVICE,
+                                         EVEL_ENTITY_STATE_OUT_OF_SERVICE,
+                                         "eth0");
+    assert(state_change != NULL);
+    assert(((EVENT_HEADER *) state_change != heartbeat) && "Wrong domain");
+    evel_state_change_addl_field_add(state_change, "name1", "value1");
+
+    reused = evel_new_heartbeat();
+    assert((reused == heartbeat) && "Heartbeat not reused");
+    assert((reused->event_domain == EVEL_DOMAIN_HEARTBEAT) && "Bad domain");
+    assert(((reused->arena != NULL) == (pass == 1)) && "Bad arena");
+    assert((reused->reporting_entity_name == NULL) && "Not reinitialized");
+    evel_free_event(reused);
+    evel_free_event(state_change);
+  }
+  evel_set_event_arena_size(0);
+}
+
+/*****************************************************************************/
+/* Threads and events per thread for the sequence test.                      */
+/*****************************************************************************/
+#define TEST_SEQUENCE_THREADS 4
+#define TEST_SEQUENCE_EVENTS 1000
+#define TEST_SEQUENCE_BLOCK 16
+
+void test_event_size()
+{
+  EVENT_HEADER * heartbeat = NULL;
+  EVENT_MEASUREMENT * measurement = NULL;
+  MEASUREMENT_VNIC_PERFORMANCE * vnic_performance = NULL;
+  MOBILE_GTP_PER_FLOW_METRICS * metrics = NULL;
+  EVENT_MOBILE_FLOW * mobile_flow = NULL;
+  EVENT_ENCODED * encoded = NULL;
+  size_t size = 0;
+
+  /***************************************************************************/
+  /* An event's size covers its structure and everything it owns.            */
+  /***************************************************************************/
+  heartbeat = evel_new_heartbeat();
+  assert(heartbeat != NULL);
+  assert(heartbeat->size >=
+         sizeof(EVENT_HEADER) + strlen(heartbeat->event_name) + 1);
+
+  measurement = evel_new_measurement(5.5);
+  assert(measurement != NULL);
+  assert(measurement->header.size > sizeof(EVENT_MEASUREMENT));
+  size = measurement->header.size;
+  evel_measurement_new_cpu_use_add(measurement, "cpu1", 11.11);
+  assert(measurement->header.size >=
+         size + sizeof(MEASUREMENT_CPU_USE) + strlen("cpu1") + 1);
+
+  /***************************************************************************/
+  /* Objects built before they are attached are charged when attached.       */
+  /***************************************************************************/
+  size = measurement->header.size;
+  vnic_performance = evel_measurement_new_vnic_performance("eth0", "true");
+  assert(vnic_performance != NULL);
+  evel_meas_vnic_performance_add(measurement, vnic_performance);
+  assert(measurement->header.size >=
+         size + sizeof(MEASUREMENT_VNIC_PERFORMANCE) +
+         strlen("eth0") + 1 + strlen("true") + 1);
+
+  metrics = evel_new_mobile_gtp_flow_metrics(12.3, 3.12, 100, 2100, 500,
+                                             1470409421, 987, 1470409431, 11,
+                                             (time_t)1470409431, "Working",
+                                             87, 3, 17, 123654, 4561, 0, 12,
+                                             10, 1, 3, 7, 899, 901, 302, 6, 2,
+                                             0, 110, 225);
+  assert(metrics != NULL);
+  evel_mobile_gtp_metrics_act_by_set(metrics, "Remote");
+  mobile_flow = evel_new_mobile_flow("Outbound", metrics, "TCP", "IPv4",
+                                     "2.3.4.1", 2341, "4.2.3.1", 4321);
+  assert(mobile_flow != NULL);
+  assert(mobile_flow->header.size >=
+         sizeof(EVENT_MOBILE_FLOW) + sizeof(MOBILE_GTP_PER_FLOW_METRICS) +
+         strlen("Working") + 1 + strlen("Remote") + 1);
+
+  /***************************************************************************/
+  /* An encoded event's size is that of its JSON.                            */
+  /***************************************************************************/
+  encoded = evel_new_encoded_event(heartbeat);
+  assert(encoded != NULL);
+  assert(encoded->internal.header.size ==
+         sizeof(EVENT_ENCODED) + encoded->json_size + 1);
+
+  evel_free_event(heartbeat);
+  evel_free_event(measurement);
+  evel_free_event(mobile_flow);
+  evel_free_event(encoded);
+}
+
+void test_event_sequence()
+{
+  char json_body[EVEL_MAX_JSON_BODY];
+  char expected_id[32];
+  int sequences[TEST_SEQUENCE_THREADS * TEST_SEQUENCE_EVENTS];
+  char seen[TEST_SEQUENCE_THREADS *
+            (TEST_SEQUENCE_EVENTS + TEST_SEQUENCE_BLOCK)];
+  pthread_t threads[TEST_SEQUENCE_THREADS];
+  EVENT_HEADER * heartbeat = NULL;
+  int block_size;
+  int ii;
+
+  /***************************************************************************/
+  /* The event id is the sequence number, formatted when encoded.            */
+  /***************************************************************************/
+  evel_set_next_event_sequence(4321);
+  heartbeat = evel_new_heartbeat();
+  assert(heartbeat != NULL);
+  assert((heartbeat->sequence == 4321) && "Bad sequence");
+  evel_json_encode_event(json_body, EVEL_MAX_JSON_BODY, heartbeat);
+  assert((strstr(json_body, "\"eventId\": \"4321\", ") != NULL) &&
+         "Bad eventId");
+  evel_free_event(heartbeat);
+
+  /***************************************************************************/
+  /* Threads raising events concurrently never get the same number, whether  */
+  /* they take them singly or in blocks.                                     */
+  /***************************************************************************/
+  for (block_size = 0;
+       block_size <= TEST_SEQUENCE_BLOCK;
+       block_size += TEST_SEQUENCE_BLOCK)
+  {
+    evel_set_event_sequence_block(block_size);
+    evel_set_next_event_sequence(1);
+    for (ii = 0; ii < TEST_SEQUENCE_THREADS; ii++)
+    {
+      pthread_create(&threads[ii],
+                     NULL,
+                     test_event_sequence_thread,
+                     &sequences[ii * TEST_SEQUENCE_EVENTS]);
+    }
+    for (ii = 0; ii < TEST_SEQUENCE_THREADS; ii++)
+    {
+      pthread_join(threads[ii], NULL);
+    }
+
+    memset(seen, 0, sizeof(seen));
+    for (ii = 0; ii < TEST_SEQUENCE_THREADS * TEST_SEQUENCE_EVENTS; ii++)
+    {
+      assert((sequences[ii] >= 1) &&
+             (sequences[ii] <= (int) sizeof(seen)) &&
+             "Sequence out of range");
+      assert(!seen[sequences[ii] - 1] && "Duplicate sequence");
+      seen[sequences[ii] - 1] = 1;
+    }
+  }
+  evel_set_event_sequence_block(0);
+
+  /***************************************************************************/
+  /* Resetting the sequence discards this thread's block.                    */
+  /***************************************************************************/
+  evel_set_event_sequence_block(TEST_SEQUENCE_BLOCK);
+  heartbeat = evel_new_heartbeat();
+  evel_free_event(heartbeat);
+  evel_set_next_event_sequence(500);
+  heartbeat = evel_new_heartbeat();
+  assert((heartbeat->sequence == 500) && "Block not discarded");
+  sprintf(expected_id, "\"eventId\": \"%d\"", heartbeat->sequence);
+  evel_json_encode_event(json_body, EVEL_MAX_JSON_BODY, heartbeat);
+  assert((strstr(json_body, expected_id) != NULL) && "Bad eventId");
+  evel_free_event(heartbeat);
+  evel_set_event_sequence_block(0);
+}
+
+static void * test_event_sequence_thread(void * arg)
+{
+  int * sequences = arg;
+  EVENT_HEADER * heartbeat = NULL;
+  int ii;
+
+  for (ii = 0; ii < TEST_SEQUENCE_EVENTS; ii++)
+  {
+    heartbeat = evel_new_heartbeat();
+    assert(heartbeat != NULL);
+    sequences[ii] = heartbeat->sequence;
+    evel_free_event(heartbeat);
+  }
+  return NULL;
+}
+
+#define TEST_THROTTLE_THREADS 4
+#define TEST_THROTTLE_UPDATES 200
+
+/*****************************************************************************/
+/* Specifications which suppress, and then stop suppressing, eventType in    */
+/* the fault domain.                                                         */
+/*****************************************************************************/
+static char * test_throttle_suppress =
+  "{"
+  "\"commandList\": ["
+  "{"
+  "\"command\": {"
+  "\"commandType\": \"throttlingSpecification\", "
+  "\"eventDomainThrottleSpecification\": {"
+  "\"eventDomain\": \"fault\", "
+  "\"suppressedFieldNames\": [\"eventType\"]}}}"
+  "]"
+  "}";
+static char * test_throttle_release =
+  "{"
+  "\"commandList\": ["
+  "{"
+  "\"command\": {"
+  "\"commandType\": \"throttlingSpecification\", "
+  "\"eventDomainThrottleSpecification\": {"
+  "\"eventDomain\": \"fault\"}}}"
+  "]"
+  "}";
+
+void test_throttle_publish()
+{
+  MEMORY_CHUNK post;
+  pthread_t threads[TEST_THROTTLE_THREADS];
+  EVEL_THROTTLE_SPEC * throttle_spec = NULL;
+  DLIST_ITEM * dlist_item = NULL;
+  bool stop = false;
+  int ii;
+
+  evel_throttle_initialize();
+  handle_json_response(test_throttle_suppress, &post);
+  assert(post.memory == NULL);
+
+  /***************************************************************************/
+  /* A specification being read survives being replaced, and the reader      */
+  /* doesn't see the replacement until it reads again.                       */
+  /***************************************************************************/
+  evel_throttle_read_begin();
+  throttle_spec = evel_get_throttle_spec(EVEL_DOMAIN_FAULT);
+  assert(throttle_spec != NULL);
+  handle_json_response(test_throttle_release, &post);
+  handle_json_response(test_throttle_suppress, &post);
+  assert(evel_get_throttle_spec(EVEL_DOMAIN_FAULT) != throttle_spec);
+  dlist_item = dlist_get_first(&throttle_spec->suppressed_field_names);
+  assert(dlist_item != NULL);
+  assert(strcmp(dlist_item->item, "eventType") == 0);
+  assert(evel_throttle_suppress_field(throttle_spec,
+                                      EVEL_FIELD_EVENT_TYPE,
+                                      "eventType"));
+  evel_throttle_read_end();
+
+  /***************************************************************************/
+  /* Threads encoding events carry on while the specification is replaced    */
+  /* under them.                                                             */
+  /***************************************************************************/
+  for (ii = 0; ii < TEST_THROTTLE_THREADS; ii++)
+  {
+    pthread_create(&threads[ii], NULL, test_throttle_publish_thread, &stop);
+  }
+  for (ii = 0; ii < TEST_THROTTLE_UPDATES; ii++)
+  {
+    handle_json_response((ii % 2) ? test_throttle_suppress :
+                                    test_throttle_release,
+                         &post);
+    assert(post.memory == NULL);
+  }
+  __atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+  for (ii = 0; ii < TEST_THROTTLE_THREADS; ii++)
+  {
+    pthread_join(threads[ii], NULL);
+  }
+
+  evel_throttle_terminate();
+  assert(evel_get_throttle_spec(EVEL_DOMAIN_FAULT) == NULL);
+}
+
+static void * test_throttle_publish_thread(void * arg)
+{
+  bool * stop = arg;
+  char json_body[EVEL_MAX_JSON_BODY];
+  EVENT_FAULT * fault = NULL;
+
+  while (!__atomic_load_n(stop, __ATOMIC_ACQUIRE))
+  {
+    fault = evel_new_fault("My alarm condition",
+                           "It broke very badly",
+                           EVEL_PRIORITY_NORMAL,
+                           EVEL_SEVERITY_MAJOR,
+                           EVEL_SOURCE_HOST,
+                           EVEL_VF_STATUS_ACTIVE);
+    assert(fault != NULL);
+    evel_fault_type_set(fault, "Bad things happen...");
+    evel_json_encode_event(json_body,
+                           EVEL_MAX_JSON_BODY,
+                           (EVENT_HEADER *) fault);
+    assert((strstr(json_body, "\"alarmCondition\"") != NULL) &&
+           "Bad encoding");
+    evel_free_event(fault);
+  }
+  return NULL;
+}
+
+void test_throttle_fields()
+{
+  MEMORY_CHUNK post;
+  EVEL_THROTTLE_SPEC * throttle_spec = NULL;
+  char field_name[32];
+
+  char * json_command_list =
+    "{"
+    "\"commandList\": ["
+    "{"
+    "\"command\": {"
+    "\"commandType\": \"throttlingSpecification\", "
+    "\"eventDomainThrottleSpecification\": {"
+    "\"eventDomain\": \"measurementsForVfScaling\", "
+    "\"suppressedFieldNames\": ["
+    "\"concurrentSessions\", "
+    "\"vnfcScalingMetric\", "
+    "\"notAField\"], "
+    "\"suppressedNvPairsList\": ["
+    "{"
+    "\"nvPairFieldName\": \"cpuUsageArray\", "
+    "\"suppressedNvPairNames\": [\"cpu1\"]"
+    "}, "
+    "{"
+    "\"nvPairFieldName\": \"notAnArray\", "
+    "\"suppressedNvPairNames\": [\"item2\"]"
+    "}]}}}"
+    "]"
+    "}";
+
+  evel_throttle_initialize();
+  handle_json_response(json_command_list, &post);
+  assert(post.memory == NULL);
+
+  evel_throttle_read_begin();
+  throttle_spec = evel_get_throttle_spec(EVEL_DOMAIN_MEASUREMENT);
+  assert(throttle_spec != NULL);
+
+  /***************************************************************************/
+  /* Known and unknown field names, including the first and last known.      */
+  /***************************************************************************/
+  assert(evel_throttle_suppress_field(throttle_spec,
+                                      EVEL_FIELD_CONCURRENT_SESSIONS,
+                                      "concurrentSessions"));
+  assert(evel_throttle_suppress_field(throttle_spec,
+                                      EVEL_FIELD_VNFC_SCALING_METRIC,
+                                      "vnfcScalingMetric"));
+  assert(evel_throttle_suppress_field(throttle_spec,
+                                      EVEL_MAX_THROTTLE_FIELDS,
+                                      "notAField"));
+  assert(!evel_throttle_suppress_field(throttle_spec,
+                                       EVEL_FIELD_CONFIGURED_ENTITIES,
+                                       "configuredEntities"));
+  assert(!evel_throttle_suppress_field(throttle_spec,
+                                       EVEL_FIELD_ADDITIONAL_FIELDS,
+                                       "additionalFields"));
+  assert(!evel_throttle_suppress_field(throttle_spec,
+                                       EVEL_MAX_THROTTLE_FIELDS,
+                                       "notAnotherField"));
+  assert(evel_throttle_suppress_nv_pair(throttle_spec,
+                                        EVEL_FIELD_CPU_USAGE_ARRAY,
+                                        "cpuUsageArray",
+                                        "cpu1"));
+  assert(!evel_throttle_suppress_nv_pair(throttle_spec,
+                                         EVEL_FIELD_CPU_USAGE_ARRAY,
+                                         "cpuUsageArray",
+                                         "cpu2"));
+  assert(evel_throttle_suppress_nv_pair(throttle_spec,
+                                        EVEL_MAX_THROTTLE_FIELDS,
+                                        "notAnArray",
+                                        "item2"));
+  assert(evel_is_nv_pair_suppressed(EVEL_DOMAIN_MEASUREMENT,
+                                    EVEL_FIELD_CPU_USAGE_ARRAY,
+                                    "cpu1"));
+  assert(!evel_is_nv_pair_suppressed(EVEL_DOMAIN_MEASUREMENT,
+                                     EVEL_FIELD_CPU_USAGE_ARRAY,
+                                     "cpu2"));
+  assert(!evel_throttle_suppress_nv_pair(throttle_spec,
+                                         EVEL_FIELD_DISK_USAGE_ARRAY,
+                                         "diskUsageArray",
+                                         "cpu1"));
+
+  /***************************************************************************/
+  /* Unknown fields are looked up by the name itself, not its address.       */
+  /***************************************************************************/
+  strcpy(field_name, "notAField");
+  assert(evel_throttle_suppress_field(throttle_spec,
+                                      EVEL_MAX_THROTTLE_FIELDS,
+                                      field_name));
+  strcpy(field_name, "notAnotherField");
+  assert(!evel_throttle_suppress_field(throttle_spec,
+                                       EVEL_MAX_THROTTLE_FIELDS,
+                                       field_name));
+
+  evel_throttle_read_end();
+  evel_throttle_terminate();
+}
+
+void test_throttle_query()
+{
+  MEMORY_CHUNK post;
+  unsigned long fault_generation;
+  unsigned long measurement_generation;
+
+  evel_throttle_initialize();
+  fault_generation = evel_throttle_generation(EVEL_DOMAIN_FAULT);
+  measurement_generation = evel_throttle_generation(EVEL_DOMAIN_MEASUREMENT);
+  assert(!evel_is_field_suppressed(EVEL_DOMAIN_FAULT, EVEL_FIELD_EVENT_TYPE));
+
+  /***************************************************************************/
+  /* Applications see what the fault specification suppresses, and that      */
+  /* only the fault generation moved on.                                     */
+  /***************************************************************************/
+  handle_json_response(test_throttle_suppress, &post);
+  assert(evel_throttle_generation(EVEL_DOMAIN_FAULT) != fault_generation);
+  assert(evel_throttle_generation(EVEL_DOMAIN_MEASUREMENT) ==
+         measurement_generation);
+  assert(evel_is_field_suppressed(EVEL_DOMAIN_FAULT, EVEL_FIELD_EVENT_TYPE));
+  assert(!evel_is_field_suppressed(EVEL_DOMAIN_FAULT, EVEL_FIELD_SOURCE_ID));
+  assert(!evel_is_field_suppressed(EVEL_DOMAIN_MEASUREMENT,
+                                   EVEL_FIELD_EVENT_TYPE));
+  assert(!evel_is_nv_pair_suppressed(EVEL_DOMAIN_FAULT,
+                                     EVEL_FIELD_ALARM_ADDITIONAL_INFORMATION,
+                                     "name1"));
+
+  /***************************************************************************/
+  /* Clearing the specification moves the generation on again.               */
+  /***************************************************************************/
+  fault_generation = evel_throttle_generation(EVEL_DOMAIN_FAULT);
+  handle_json_response(test_throttle_release, &post);
+  assert(evel_throttle_generation(EVEL_DOMAIN_FAULT) != fault_generation);
+  assert(!evel_is_field_suppressed(EVEL_DOMAIN_FAULT, EVEL_FIELD_EVENT_TYPE));
+
+  evel_throttle_terminate();
+}
+
+void test_hash_map()
+{
+  HASH_MAP map;
+  char keys[100][8];
+  int i;
+
+  /***************************************************************************/
+  /* Add enough keys that the map has to grow a few times, replacing some    */
+  /* values on the way.                                                      */
+  /***************************************************************************/
+  hash_map_initialize(&map);
+  assert(hash_map_get(&map, "key0") == NULL);
+  for (i = 0; i < 100; i++)
+  {
+    snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+    assert(hash_map_set(&map, keys[i], &keys[i]));
+  }
+  for (i = 0; i < 100; i += 2)
+  {
+    assert(hash_map_set(&map, keys[i], &keys[99 - i]));
+  }
+  assert(hash_map_count(&map) == 100);
+
+  /***************************************************************************/
+  /* Lookups find the latest value, and iteration is in insertion order.     */
+  /***************************************************************************/
+  for (i = 0; i < 100; i++)
+  {
+    assert(hash_map_get(&map, keys[i]) ==
+           ((i % 2 == 0) ? &keys[99 - i] : &keys[i]));
+    assert(hash_map_key(&map, i) == keys[i]);
+    assert(hash_map_value(&map, i) == hash_map_get(&map, keys[i]));
+  }
+  assert(hash_map_get(&map, "key100") == NULL);
+
+  hash_map_free(&map);
+  assert(hash_map_count(&map) == 0);
+  assert(hash_map_get(&map, "key0") == NULL);
+}
+
+void test_spool()
+{
+  char directory[] = "/tmp/evel_unit_spool_XXXXXX";
+  EVEL_SPOOL_REF refs[3];
+  EVEL_SPOOL_STATS stats;
+  static char big_body[4000];
+  static char huge_body[65 * 1024];
+  const char * body;
+  int size;
+  bool batch;
+  int num_events;
+  int ii;
+
+  assert(mkdtemp(directory) != NULL);
+
+  /***************************************************************************/
+  /* Spool three posts and replay them, failing the second.                  */
+  /***************************************************************************/
+  assert(evel_spool_open(directory, 1 << 20, 3600) == EVEL_SUCCESS);
+  assert(!evel_spool_pending());
+  assert(evel_spool_append("{\"a\": 1}", 8, false, 1));
+  assert(evel_spool_append("{\"b\": 2}", 8, true, 2));
+  assert(evel_spool_append("{\"c\": 3}", 8, false, 1));
+  assert(evel_spool_pending());
+
+  assert(evel_spool_next(&refs[0], &body, &size, &batch, &num_events));
+  assert((size == 8) && (strcmp(body, "{\"a\": 1}") == 0));
+  assert(!batch && (num_events == 1));
+  assert(evel_spool_next(&refs[1], &body, &size, &batch, &num_events));
+  assert((strcmp(body, "{\"b\": 2}") == 0) && batch && (num_events == 2));
+  evel_spool_release(&refs[0], true);
+  evel_spool_rewind(&refs[1]);
+
+  /***************************************************************************/
+  /* After a rewind the failed post comes round again.                       */
+  /***************************************************************************/
+  assert(evel_spool_next(&refs[1], &body, &size, &batch, &num_events));
+  assert(strcmp(body, "{\"b\": 2}") == 0);
+  assert(evel_spool_next(&refs[2], &body, &size, &batch, &num_events));
+  assert(strcmp(body, "{\"c\": 3}") == 0);
+  assert(!evel_spool_next(&refs[0], &body, &size, &batch, &num_events));
+  evel_spool_release(&refs[2], false);
+  evel_get_spool_stats(&stats);
+  assert(stats.spooled_posts == 3);
+  assert(stats.replayed_posts == 1);
+  assert(stats.dropped_posts == 1);
+  assert(stats.segments == 1);
+  evel_spool_close();
+
+  /***************************************************************************/
+  /* Reopening the spool finds only the post which was never released.       */
+  /***************************************************************************/
+  assert(evel_spool_open(directory, 1 << 20, 3600) == EVEL_SUCCESS);
+  assert(evel_spool_pending());
+  assert(evel_spool_next(&refs[1], &body, &size, &batch, &num_events));
+  assert(strcmp(body, "{\"b\": 2}") == 0);
+  assert(!evel_spool_next(&refs[0], &body, &size, &batch, &num_events));
+  evel_spool_release(&refs[1], true);
+  assert(!evel_spool_pending());
+
+  evel_get_spool_stats(&stats);
+  assert(stats.spooled_posts == 0);
+  assert(stats.replayed_posts == 1);
+  assert(stats.segments == 0);
+  evel_spool_close();
+
+  /***************************************************************************/
+  /* A small spool is split into several segments, so filling it drops only  */
+  /* the oldest posts, and keeps within its size.                            */
+  /***************************************************************************/
+  memset(big_body, 'x', sizeof(big_body));
+  assert(evel_spool_open(directory, 64 * 1024, 3600) == EVEL_SUCCESS);
+  for (ii = 0; ii < 40; ii++)
+  {
+    assert(evel_spool_append(big_body, sizeof(big_body), false, 1));
+  }
+  evel_get_spool_stats(&stats);
+  assert(stats.segments > 1);
+  assert(stats.bytes <= 64 * 1024);
+  assert(stats.spooled_posts == 40);
+  assert((stats.dropped_posts > 0) && (stats.dropped_posts < 40));
+  assert(evel_spool_next(&refs[0], &body, &size, &batch, &num_events));
+  assert(size == sizeof(big_body));
+  evel_spool_release(&refs[0], true);
+
+  /***************************************************************************/
+  /* A post larger than the whole spool is refused.                          */
+  /***************************************************************************/
+  assert(!evel_spool_append(huge_body, sizeof(huge_body), false, 1));
+  while (evel_spool_next(&refs[0], &body, &size, &batch, &num_events))
+  {
+    evel_spool_release(&refs[0], true);
+  }
+  evel_spool_close();
+
+  assert(rmdir(directory) == 0);
+}
+
+void test_endpoints()
+{
+  EVEL_ENDPOINT * endpoints[3];
+  EVEL_ENDPOINT * endpoint;
+  EVEL_ENDPOINT_STATS stats;
+  int ii;
+
+  for (ii = 0; ii < 3; ii++)
+  {
+    event_handler_add_endpoint("http://listener/event",
+                               "http://listener/batch",
+                               "http://listener/throttle");
+  }
+
+  /***************************************************************************/
+  /* Posts go to the primary until enough fail in a row to take it out of    */
+  /* use, and then fail over to the backup.                                  */
+  /***************************************************************************/
+  evel_set_endpoint_policy(EVEL_ENDPOINT_PRIMARY_BACKUP, 2, 100);
+  endpoints[0] = evel_endpoint_select();
+  evel_endpoint_posted(endpoints[0]);
+  assert(!evel_endpoint_completed(endpoints[0], false));
+  assert(evel_endpoint_select() == endpoints[0]);
+  evel_endpoint_posted(endpoints[0]);
+  assert(evel_endpoint_completed(endpoints[0], false));
+  endpoints[1] = evel_endpoint_select();
+  assert(endpoints[1] != endpoints[0]);
+  assert(evel_get_endpoint_stats(0, &stats));
+  assert(!stats.healthy);
+  assert((stats.posts == 2) && (stats.failures == 2));
+  assert((stats.hold_downs == 1) && (stats.outstanding == 0));
+
+  /***************************************************************************/
+  /* Once the hold down is over the primary is used again.  It is taken      */
+  /* straight back out if that post fails, and back into use if it works.    */
+  /***************************************************************************/
+  usleep(150 * 1000);
+  assert(evel_endpoint_select() == endpoints[0]);
+  evel_endpoint_posted(endpoints[0]);
+  assert(evel_endpoint_completed(endpoints[0], false));
+  assert(evel_endpoint_select() == endpoints[1]);
+  assert(evel_get_endpoint_stats(0, &stats));
+  assert(!stats.healthy && (stats.hold_downs == 2));
+  usleep(150 * 1000);
+  assert(evel_endpoint_select() == endpoints[0]);
+  evel_endpoint_posted(endpoints[0]);
+  assert(!evel_endpoint_completed(endpoints[0], true));
+  assert(evel_endpoint_select() == endpoints[0]);
+  assert(evel_get_endpoint_stats(0, &stats));
+  assert(stats.healthy);
+
+  /***************************************************************************/
+  /* Round robin takes each endpoint in turn, skipping those out of use.     */
+  /***************************************************************************/
+  evel_set_endpoint_policy(EVEL_ENDPOINT_ROUND_ROBIN, 1, 100);
+  for (ii = 0; ii < 3; ii++)
+  {
+    endpoints[ii] = evel_endpoint_select();
+  }
+  assert((endpoints[0] != endpoints[1]) && (endpoints[1] != endpoints[2]));
+  assert(endpoints[2] != endpoints[0]);
+  assert(evel_endpoint_select() == endpoints[0]);
+  evel_endpoint_posted(endpoints[1]);
+  assert(evel_endpoint_completed(endpoints[1], false));
+  for (ii = 0; ii < 6; ii++)
+  {
+    endpoint = evel_endpoint_select();
+    assert(endpoint == endpoints[(ii % 2 == 0) ? 2 : 0]);
+  }
+
+  /***************************************************************************/
+  /* With every endpoint out of use, the one out of use longest is picked.   */
+  /* No post fails over when the last endpoint in use is taken out.          */
+  /***************************************************************************/
+  usleep(10 * 1000);
+  evel_endpoint_posted(endpoints[0]);
+  assert(evel_endpoint_completed(endpoints[0], false));
+  evel_endpoint_posted(endpoints[2]);
+  assert(!evel_endpoint_completed(endpoints[2], false));
+  assert(evel_endpoint_select() == endpoints[1]);
+
+  event_handler_terminate();
+}
+
+void test_retry_delay()
+{
+  unsigned int jitter;
+  long delay_ms;
+  int ii;
+
+  /***************************************************************************/
+  /* Without jitter the delay doubles with each attempt, up to the maximum.  */
+  /***************************************************************************/
+  assert(evel_retry_delay_ms(0, 100, 1000, 0, 0) == 100);
+  assert(evel_retry_delay_ms(1, 100, 1000, 0, 0) == 200);
+  assert(evel_retry_delay_ms(2, 100, 1000, 0, 0) == 400);
+  assert(evel_retry_delay_ms(3, 100, 1000, 0, 0) == 800);
+  assert(evel_retry_delay_ms(4, 100, 1000, 0, 0) == 1000);
+  assert(evel_retry_delay_ms(100, 100, 1000, 0, 0) == 1000);
+
+  /***************************************************************************/
+  /* Jitter takes off up to half the delay.                                  */
+  /***************************************************************************/
+  for (ii = 0; ii < 8; ii++)
+  {
+    for (jitter = 0; jitter < 2000; jitter += 7)
+    {
+      delay_ms = evel_retry_delay_ms(ii, 100, 1000, jitter, 0);
+      assert(delay_ms <= evel_retry_delay_ms(ii, 100, 1000, 0, 0));
+      assert(delay_ms >= evel_retry_delay_ms(ii, 100, 1000, 0, 0) / 2);
+    }
+  }
+  assert(evel_retry_delay_ms(0, 100, 1000, 50, 0) == 50);
+  assert(evel_retry_delay_ms(10, 100, 1000, 500, 0) == 500);
+
+  /***************************************************************************/
+  /* The delay asked for by the listener is a floor, not a cap.              */
+  /***************************************************************************/
+  assert(evel_retry_delay_ms(1, 100, 1000, 0, 5000) == 5000);
+  assert(evel_retry_delay_ms(1, 100, 1000, 0, 150) == 200);
+  assert(evel_retry_delay_ms(1, 100, 1000, 100, 150) == 150);
+  assert(evel_retry_delay_ms(1, 100, 1000, 100, 10) == 100);
+}
+
+void test_flush()
+{
+  struct sockaddr_in address;
+  socklen_t address_size = sizeof(address);
+  char event_url[64];
+  char batch_url[64];
+  char throt_url[64];
+  int listener;
+
+  /***************************************************************************/
+  /* There is nothing to wait for without an event handler.                  */
+  /***************************************************************************/
+  assert(evel_flush(0) == EVEL_EVENT_HANDLER_INACTIVE);
+  assert(evel_flush(100) == EVEL_EVENT_HANDLER_INACTIVE);
+
+  /***************************************************************************/
+  /* Point the event handler at a socket which accepts connections but never */
+  /* answers, so that a post stays in flight.                                */
+  /***************************************************************************/
+  listener = socket(AF_INET, SOCK_STREAM, 0);
+  assert(listener >= 0);
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  assert(bind(listener, (struct sockaddr *) &address, sizeof(address)) == 0);
+  assert(listen(listener, 4) == 0);
+  assert(getsockname(listener,
+                     (struct sockaddr *) &address,
+                     &address_size) == 0);
+  sprintf(event_url, "http://127.0.0.1:%d/event", ntohs(address.sin_port));
+  sprintf(batch_url, "http://127.0.0.1:%d/batch", ntohs(address.sin_port));
+  sprintf(throt_url, "http://127.0.0.1:%d/throttle", ntohs(address.sin_port));
+  assert(event_handler_initialize(event_url, batch_url, throt_url,
+                                  "user", "password", 0,
+                                  EVEL_EVENT_BUFFER_DEPTH, 0) == EVEL_SUCCESS);
+  assert(event_handler_run() == EVEL_SUCCESS);
+
+  /***************************************************************************/
+  /* With nothing posted the flush succeeds, but a post which gets no answer */
+  /* makes it time out.                                                      */
+  /***************************************************************************/
+  assert(evel_flush(1000) == EVEL_SUCCESS);
+  assert(evel_post_event(evel_new_heartbeat()) == EVEL_SUCCESS);
+  assert(evel_flush(0) == EVEL_FLUSH_TIMEOUT);
+  assert(evel_flush(200) == EVEL_FLUSH_TIMEOUT);
+
+  /***************************************************************************/
+  /* Given a deadline, terminating abandons the post rather than waiting for */
+  /* it to time out.                                                         */
+  /***************************************************************************/
+  evel_set_terminate_timeout(100);
+  event_handler_terminate();
+  evel_set_terminate_timeout(0);
+  close(listener);
+
+  /***************************************************************************/
+  /* Once the event handler has gone there is nothing to wait for again.     */
+  /***************************************************************************/
+  assert(evel_flush(100) == EVEL_EVENT_HANDLER_INACTIVE);
+}
+
+/*****************************************************************************/
+/* Memory given to each post in the priority post queue test.                */
+/*****************************************************************************/
+#define TEST_PRIORITY_POST_SIZE 65536
+
+/**************************************************************************//**
+ * Make a priority post for the priority post queue tests.
+ *
+ * The memory is much bigger than the text, so that freeing it shows up in the
+ * heap statistics.
+ *
+ * @param post  The post to fill in.
+ * @param id    Which post this is.
+ *****************************************************************************/
+static void test_priority_post_make(MEMORY_CHUNK * const post, const int id)
+{
+  post->memory = malloc(TEST_PRIORITY_POST_SIZE);
+  assert(post->memory != NULL);
+  sprintf(post->memory, "post %d", id);
+  post->size = strlen(post->memory);
+}
+
+/**************************************************************************//**
+ * Take a post off the priority post queue and check that it's the one
+ * expected.
+ *
+ * @param id        Which post is expected.
+ * @param endpoint  The endpoint expected to have asked for it.
+ *****************************************************************************/
+static void test_priority_post_check(const int id,
+                                     EVEL_ENDPOINT * const endpoint)
+{
+  MEMORY_CHUNK post;
+  EVEL_ENDPOINT * taken_endpoint = NULL;
+  char expected[16];
+
+  sprintf(expected, "post %d", id);
+  assert(evel_priority_post_take(false, &post, &taken_endpoint));
+  assert(post.size == strlen(expected));
+  assert(strcmp(post.memory, expected) == 0);
+  assert(taken_endpoint == endpoint);
+  free(post.memory);
+}
+
+void test_priority_posts()
+{
+  EVEL_ENDPOINT * endpoints[2];
+  MEMORY_CHUNK post;
+  EVEL_ENDPOINT * taken_endpoint = NULL;
+  size_t heap_in_use;
+  int ii;
+
+  /***************************************************************************/
+  /* The queue never looks inside an endpoint, so any distinct pointers do.  */
+  /***************************************************************************/
+  endpoints[0] = (EVEL_ENDPOINT *) &endpoints[0];
+  endpoints[1] = (EVEL_ENDPOINT *) &endpoints[1];
+
+  /***************************************************************************/
+  /* Nothing is taken from an empty queue.                                   */
+  /***************************************************************************/
+  assert(!evel_priority_post_take(false, &post, &taken_endpoint));
+
+  /***************************************************************************/
+  /* Posts come off the queue in the order they were queued, along with the  */
+  /* endpoint which asked for each, and the queue takes over their memory.   */
+  /***************************************************************************/
+  for (ii = 1; ii <= 3; ii++)
+  {
+    test_priority_post_make(&post, ii);
+    evel_priority_post_queue(&post, endpoints[ii % 2]);
+    assert(post.memory == NULL);
+    assert(post.size == 0);
+  }
+  for (ii = 1; ii <= 3; ii++)
+  {
+    test_priority_post_check(ii, endpoints[ii % 2]);
+  }
+  assert(!evel_priority_post_take(false, &post, &taken_endpoint));
+
+  /***************************************************************************/
+  /* Once the queue is full, queuing another post drops the oldest and frees */
+  /* its memory, and the rest keep their order.  Logging the drop may take a */
+  /* little from the heap, so only most of the memory is looked for.         */
+  /***************************************************************************/
+  for (ii = 1; ii <= EVEL_PRIORITY_QUEUE_SIZE; ii++)
+  {
+    test_priority_post_make(&post, ii);
+    evel_priority_post_queue(&post, endpoints[0]);
+  }
+  test_priority_post_make(&post, EVEL_PRIORITY_QUEUE_SIZE + 1);
+  heap_in_use = mallinfo2().uordblks;
+  evel_priority_post_queue(&post, endpoints[0]);
+  assert(post.memory == NULL);
+  assert(heap_in_use - mallinfo2().uordblks > TEST_PRIORITY_POST_SIZE / 2);
+  for (ii = 2; ii <= EVEL_PRIORITY_QUEUE_SIZE + 1; ii++)
+  {
+    test_priority_post_check(ii, endpoints[0]);
+  }
+  assert(!evel_priority_post_take(false, &post, &taken_endpoint));
+
+  /***************************************************************************/
+  /* The queue drains one post at a time, each only once the priority        */
+  /* transfer has finished with the one before it.                           */
+  /***************************************************************************/
+  for (ii = 1; ii <= 3; ii++)
+  {
+    test_priority_post_make(&post, ii);
+    evel_priority_post_queue(&post, endpoints[1]);
+  }
+  for (ii = 1; ii <= 3; ii++)
+  {
+    assert(!evel_priority_post_take(true, &post, &taken_endpoint));
+    test_priority_post_check(ii, endpoints[1]);
+  }
+  assert(!evel_priority_post_take(true, &post, &taken_endpoint));
+  assert(!evel_priority_post_take(false, &post, &taken_endpoint));
+}
+
+void test_ring_buffer_lanes()
+{
+  ring_buffer lanes[3];
+  pthread_t thread;
+  int msgs[3];
+  int ii;
+
+  for (ii = 0; ii < 3; ii++)
+  {
+    ring_buffer_initialize(&lanes[ii], 4);
+    if (ii > 0)
+    {
+      ring_buffer_share_reader(&lanes[ii], &lanes[0]);
+    }
+  }
+
+  /***************************************************************************/
+  /* Data in any of the lanes ends the wait, and each lane keeps its own     */
+  /* data.                                                                   */
+  /***************************************************************************/
+  assert(ring_buffer_write(&lanes[2], &msgs[2]) == 1);
+  assert(ring_buffer_wait(lanes, 3, NULL));
+  assert(ring_buffer_try_read(&lanes[0]) == NULL);
+  assert(ring_buffer_try_read(&lanes[1]) == NULL);
+  assert(ring_buffer_try_read(&lanes[2]) == &msgs[2]);
+  assert(ring_buffer_try_read(&lanes[2]) == NULL);
+
+  /***************************************************************************/
+  /* A write to a lane other than the first wakes the reader waiting on all  */
+  /* of them.                                                                */
+  /***************************************************************************/
+  pthread_create(&thread, NULL, test_ring_buffer_lanes_thread, &lanes[1]);
+  assert(ring_buffer_wait(lanes, 3, NULL));
+  assert(ring_buffer_try_read(&lanes[1]) == &lanes[1]);
+  pthread_join(thread, NULL);
+
+  /***************************************************************************/
+  /* A full lane doesn't stop the others being written.                      */
+  /***************************************************************************/
+  for (ii = 0; ii < 4; ii++)
+  {
+    assert(ring_buffer_write(&lanes[2], &msgs[2]) == 1);
+  }
+  assert(ring_buffer_write(&lanes[2], &msgs[2]) == 0);
+  assert(ring_buffer_write(&lanes[0], &msgs[0]) == 1);
+  assert(ring_buffer_read(&lanes[0]) == &msgs[0]);
+  for (ii = 0; ii < 4; ii++)
+  {
+    assert(ring_buffer_read(&lanes[2]) == &msgs[2]);
+  }
+  for (ii = 0; ii < 3; ii++)
+  {
+    assert(ring_buffer_is_empty(&lanes[ii]));
+    free(lanes[ii].ring);
+  }
+}
+
+void * test_ring_buffer_lanes_thread(void * arg)
+{
+  ring_buffer * lane = arg;
+
+  usleep(10000);
+  ring_buffer_write(lane, lane);
+
+  return NULL;
+}
+
+void test_ring_buffer_read_many()
+{
+  ring_buffer buffer;
+  pthread_t thread;
+  void * msgs[8];
+  int items[5];
+  struct timespec start;
+  struct timespec end;
+  long elapsed_ms;
+  int ii;
+
+  ring_buffer_initialize(&buffer, 8);
+
+  /***************************************************************************/
+  /* Timed reads of an empty buffer give up once the timeout passes.         */
+  /***************************************************************************/
+  assert(ring_buffer_read_timed(&buffer, 0) == NULL);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  assert(ring_buffer_read_timed(&buffer, 20) == NULL);
+  assert(ring_buffer_read_many(&buffer, msgs, 8, 20) == 0);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  elapsed_ms = (end.tv_sec - start.tv_sec) * 1000 +
+               (end.tv_nsec - start.tv_nsec) / 1000000;
+  assert(elapsed_ms >= 40);
+
+  /***************************************************************************/
+  /* A batch read takes what's there, oldest first, up to the limit.         */
+  /***************************************************************************/
+  for (ii = 0; ii < 5; ii++)
+  {
+    assert(ring_buffer_write(&buffer, &items[ii]) == 1);
+  }
+  assert(ring_buffer_read_many(&buffer, msgs, 3, 0) == 3);
+  assert((msgs[0] == &items[0]) && (msgs[1] == &items[1]) &&
+         (msgs[2] == &items[2]));
+  assert(ring_buffer_read_many(&buffer, msgs, 8, -1) == 2);
+  assert((msgs[0] == &items[3]) && (msgs[1] == &items[4]));
+  assert(ring_buffer_is_empty(&buffer));
+
+  /***************************************************************************/
+  /* Timed reads return as soon as an element is written.                    */
+  /***************************************************************************/
+  pthread_create(&thread, NULL, test_ring_buffer_lanes_thread, &buffer);
+  assert(ring_buffer_read_many(&buffer, msgs, 8, 10000) == 1);
+  assert(msgs[0] == &buffer);
+  pthread_join(thread, NULL);
+  pthread_create(&thread, NULL, test_ring_buffer_lanes_thread, &buffer);
+  assert(ring_buffer_read_timed(&buffer, 10000) == &buffer);
+  pthread_join(thread, NULL);
+
+  free(buffer.ring);
+}
+
+void test_ring_buffer_write_timed()
+{
+  ring_buffer buffer;
+  pthread_t thread;
+  int items[3];
+  struct timespec start;
+  struct timespec end;
+  long elapsed_ms;
+
+  ring_buffer_initialize(&buffer, 2);
+  assert(ring_buffer_write_timed(&buffer, &items[0], 0) == 1);
+  assert(ring_buffer_write_timed(&buffer, &items[1], 0) == 1);
+
+  /***************************************************************************/
+  /* Timed writes to a full buffer give up once the timeout passes.          */
+  /***************************************************************************/
+  assert(ring_buffer_write_timed(&buffer, &items[2], 0) == 0);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  assert(ring_buffer_write_timed(&buffer, &items[2], 20) == 0);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  elapsed_ms = (end.tv_sec - start.tv_sec) * 1000 +
+               (end.tv_nsec - start.tv_nsec) / 1000000;
+  assert(elapsed_ms >= 20);
+
+  /***************************************************************************/
+  /* Timed writes go ahead as soon as an element is read, and a thread other */
+  /* than the reader can take the oldest element to make room.               */
+  /***************************************************************************/
+  pthread_create(&thread, NULL, test_ring_buffer_write_timed_thread, &buffer);
+  assert(ring_buffer_write_timed(&buffer, &items[2], 10000) == 1);
+  pthread_join(thread, NULL);
+  assert(ring_buffer_try_read(&buffer) == &items[1]);
+  assert(ring_buffer_try_read(&buffer) == &items[2]);
+  assert(ring_buffer_is_empty(&buffer));
+
+  free(buffer.ring);
+}
+
+void * test_ring_buffer_write_timed_thread(void * arg)
+{
+  ring_buffer * buffer = arg;
+
+  usleep(10000);
+  assert(ring_buffer_try_read(buffer) != NULL);
+
+  return NULL;
+}
+
+void test_encode_other_named_arrays()
+{
+  char * expected =
+    "\"hashOfNameValuePairArrays\": ["
+    "{\"name\": \"array2\", "
+    "\"arrayOfFields\": ["
+    "{\"name\": \"name1\", \"value\": \"value1\"}, "
+    "{\"name\": \"name3\", \"value\": \"value3\"}]}, "
+    "{\"name\": \"array1\", "
+    "\"arrayOfFields\": ["
+    "{\"name\": \"name2\", \"value\": \"value2\"}]}]";
+  int pass;
+  char json_body[2][EVEL_MAX_JSON_BODY];
+  EVENT_OTHER * other = NULL;
+
+  /***************************************************************************/
+  /* Named arrays are encoded in the order they were first added, with and   */
+  /* without an arena.                                                       */
+  /***************************************************************************/
+  for (pass = 0; pass < 2; pass++)
+  {
+    evel_set_event_arena_size(pass * 256);
+    evel_set_next_event_sequence(3000);
+    other = evel_new_other();
+    assert(other != NULL);
+    evel_start_epoch_set(&other->header, 3000);
+    evel_last_epoch_set(&other->header, 3000);
+    evel_other_field_set_namedarraysize(other, 1);
+    evel_other_field_add_namedarray(other, "array2", "name1", "value1");
+    evel_other_field_add_namedarray(other, "array1", "name2", "value2");
+    evel_other_field_add_namedarray(other, "array2", "name3", "value3");
+
+    evel_json_encode_event(
+      json_body[pass], EVEL_MAX_JSON_BODY, (EVENT_HEADER *) other);
+    evel_free_event(other);
+  }
+  evel_set_event_arena_size(0);
+
+  compare_strings(json_body[0], json_body[1], EVEL_MAX_JSON_BODY,
+                  "Named arrays");
+  assert((strstr(json_body[0], expected) != NULL) && "Bad named arrays");
+}
+
 void test_encode_header_overrides()
 {
   char * expected =
@@ -347,37 +1702,37 @@ void test_encode_measurement()
     "}, "
     "\"measurementsForVfScalingFields\": "
     "{"
-    "\"measurementInterval\": 5.500000, "
+    "\"measurementInterval\": 5.5, "
     "\"concurrentSessions\": 1, "
     "\"configuredEntities\": 2, "
     "\"cpuUsageArray\": ["
     "{\"cpuIdentifier\": \"cpu1\", "
-    "\"percentUsage\": 11.110000}, "
+    "\"percentUsage\": 11.11}, "
     "{\"cpuIdentifier\": \"cpu2\", "
-    "\"percentUsage\": 22.220000}], "
+    "\"percentUsage\": 22.22}], "
     "\"filesystemUsageArray\": ["
-    "{\"blockConfigured\": 100.110000, "
+    "{\"blockConfigured\": 100.11, "
     "\"blockIops\": 33, "
-    "\"blockUsed\": 100.220000, "
-    "\"ephemeralConfigured\": 100.110000, "
+    "\"blockUsed\": 100.22, "
+    "\"ephemeralConfigured\": 100.11, "
     "\"ephemeralIops\": 44, "
-    "\"ephemeralUsed\": 200.220000, "
+    "\"ephemeralUsed\": 200.22, "
     "\"filesystemName\": \"00-11-22\"}, "
-    "{\"blockConfigured\": 300.110000, "
+    "{\"blockConfigured\": 300.11, "
     "\"blockIops\": 55, "
-    "\"blockUsed\": 300.220000, "
-    "\"ephemeralConfigured\": 300.110000, "
+    "\"blockUsed\": 300.22, "
+    "\"ephemeralConfigured\": 300.11, "
     "\"ephemeralIops\": 66, "
-    "\"ephemeralUsed\": 400.220000, "
+    "\"ephemeralUsed\": 400.22, "
     "\"filesystemName\": \"33-44-55\"}], "
     "\"latencyDistribution\": ["
     "{\"countsInTheBucket\": 20}, "
-    "{\"lowEndOfLatencyBucket\": 10.000000, "
-    "\"highEndOfLatencyBucket\": 20.000000, "
+    "{\"lowEndOfLatencyBucket\": 10, "
+    "\"highEndOfLatencyBucket\": 20, "
     "\"countsInTheBucket\": 30}], "
-    "\"meanRequestLatency\": 4.400000, "
-    "\"memoryConfigured\": 6.600000, "
-    "\"memoryUsed\": 3.300000, "
+    "\"meanRequestLatency\": 4.4, "
+    "\"memoryConfigured\": 6.6, "
+    "\"memoryUsed\": 3.3, "
     "\"requestRate\": 7, "
     "\"vNicUsageArray\": ["
     "{"
@@ -401,9 +1756,9 @@ void test_encode_measurement()
     "\"unicastPacketsOut\": 18"
     "}"
     "], "
-    "\"aggregateCpuUsage\": 8.800000, "
+    "\"aggregateCpuUsage\": 8.8, "
     "\"numberOfMediaPortsInUse\": 1234, "
-    "\"vnfcScalingMetric\": 1234.567800, "
+    "\"vnfcScalingMetric\": 1234.5678, "
     "\"errors\": {"
     "\"receiveDiscards\": 1, "
     "\"receiveErrors\": 0, "
@@ -561,8 +1916,8 @@ void test_encode_mobile_mand()
     "\"mobileFlowFields\": {"
     "\"flowDirection\": \"Outbound\", "
     "\"gtpPerFlowMetrics\": {"
-    "\"avgBitErrorRate\": 12.300000, "
-    "\"avgPacketDelayVariation\": 3.120000, "
+    "\"avgBitErrorRate\": 12.3, "
+    "\"avgPacketDelayVariation\": 3.12, "
     "\"avgPacketLatency\": 100, "
     "\"avgReceiveThroughput\": 2100, "
     "\"avgTransmitThroughput\": 500, "
@@ -681,8 +2036,8 @@ void test_encode_mobile_opts()
     "\"mobileFlowFields\": {"
     "\"flowDirection\": \"Inbound\", "
     "\"gtpPerFlowMetrics\": {"
-    "\"avgBitErrorRate\": 132.000100, "
-    "\"avgPacketDelayVariation\": 31.200000, "
+    "\"avgBitErrorRate\": 132.0001, "
+    "\"avgPacketDelayVariation\": 31.2, "
     "\"avgPacketLatency\": 101, "
     "\"avgReceiveThroughput\": 2101, "
     "\"avgTransmitThroughput\": 501, "
@@ -728,7 +2083,7 @@ void test_encode_mobile_opts()
     "\"gtpConnectionStatus\": \"Connected\", "
     "\"gtpTunnelStatus\": \"Not tunneling\", "
     "\"largePacketRtt\": 80, "
-    "\"largePacketThreshold\": 600.000000, "
+    "\"largePacketThreshold\": 600, "
     "\"maxReceiveBitRate\": 1357924680, "
     "\"maxTransmitBitRate\": 235711, "
     "\"numGtpEchoFailures\": 1, "
@@ -896,7 +2251,7 @@ void test_encode_report()
     "\"sourceId\": \"Dummy VM UUID - No Metadata available\""
     "}, "
     "\"measurementsForVfReportingFields\": "
-    "{\"measurementInterval\": 1.100000, "
+    "{\"measurementInterval\": 1.1, "
     "\"featureUsageArray\": ["
     "{\"featureIdentifier\": \"FeatureA\", "
     "\"featureUtilization\": 123}, "
@@ -1020,9 +2375,9 @@ void test_encode_service_subset(const SERVICE_TEST service_test)
     "\"localRtpPacketsDiscarded\": 450, "
     "\"localRtpPacketsReceived\": 550, "
     "\"localRtpPacketsSent\": 650, "
-    "\"mosCqe\": 12.255000, "
+    "\"mosCqe\": 12.255, "
     "\"packetsLost\": 157, "
-    "\"packetLossPercent\": 0.232000, "
+    "\"packetLossPercent\": 0.232, "
     "\"rFactor\": 11, "
     "\"roundTripDelay\": 15"
     "}";
@@ -2471,19 +3826,19 @@ void test_encode_measurement_throttled()
     "}, "
     "\"measurementsForVfScalingFields\": "
     "{"
-    "\"measurementInterval\": 5.500000, "
+    "\"measurementInterval\": 5.5, "
     "\"cpuUsageArray\": ["
     "{\"cpuIdentifier\": \"cpu1\", "
-    "\"percentUsage\": 11.110000}, "
+    "\"percentUsage\": 11.11}, "
     "{\"cpuIdentifier\": \"cpu2\", "
-    "\"percentUsage\": 22.220000}], "
+    "\"percentUsage\": 22.22}], "
     "\"filesystemUsageArray\": ["
-    "{\"blockConfigured\": 500.110000, "
+    "{\"blockConfigured\": 500.11, "
     "\"blockIops\": 77, "
-    "\"blockUsed\": 500.220000, "
-    "\"ephemeralConfigured\": 500.110000, "
+    "\"blockUsed\": 500.22, "
+    "\"ephemeralConfigured\": 500.11, "
     "\"ephemeralIops\": 88, "
-    "\"ephemeralUsed\": 600.220000, "
+    "\"ephemeralUsed\": 600.22, "
     "\"filesystemName\": \"66-77-88\"}], "
     "\"featureUsageArray\": ["
     "{\"featureIdentifier\": \"FeatureA\", "
@@ -2670,8 +4025,8 @@ void test_encode_mobile_throttled()
     "\"mobileFlowFields\": {"
     "\"flowDirection\": \"Inbound\", "
     "\"gtpPerFlowMetrics\": {"
-    "\"avgBitErrorRate\": 132.000100, "
-    "\"avgPacketDelayVariation\": 31.200000, "
+    "\"avgBitErrorRate\": 132.0001, "
+    "\"avgPacketDelayVariation\": 31.2, "
     "\"avgPacketLatency\": 101, "
     "\"avgReceiveThroughput\": 2101, "
     "\"avgTransmitThroughput\": 501, "
@@ -2717,7 +4072,7 @@ void test_encode_mobile_throttled()
     "\"gtpConnectionStatus\": \"Connected\", "
     "\"gtpTunnelStatus\": \"Not tunneling\", "
     "\"largePacketRtt\": 80, "
-    "\"largePacketThreshold\": 600.000000, "
+    "\"largePacketThreshold\": 600, "
     "\"maxReceiveBitRate\": 1357924680, "
     "\"maxTransmitBitRate\": 235711, "
     "\"numGtpEchoFailures\": 1, "
@@ -2983,7 +4338,7 @@ void test_encode_report_throttled()
     "\"version\": 1.2"
     "}, "
     "\"measurementsForVfReportingFields\": "
-    "{\"measurementInterval\": 1.100000, "
+    "{\"measurementInterval\": 1.1, "
     "\"featureUsageArray\": ["
     "{\"featureIdentifier\": \"FeatureA\", "
     "\"featureUtilization\": 123}], "